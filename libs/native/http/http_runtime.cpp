@@ -1,21 +1,41 @@
-// http_runtime.cpp - Cm HTTP クライアント stdバッキング実装
-// TCP (std::net) ベースの HTTP/1.1 クライアント
-// リクエスト構築・レスポンス解析をC++側で実装
+// http_runtime.cpp - Cm HTTP クライアント/サーバ stdバッキング実装
+// TCP (std::net) ベースの HTTP/1.1 クライアント・サーバ
+// リクエスト構築・レスポンス解析、イベント駆動サーバをC++側で実装
 
+#include <algorithm>
 #include <arpa/inet.h>
+#include <atomic>
+#include <cerrno>
+#include <climits>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <ctime>
+#include <deque>
 #include <fcntl.h>
 #include <map>
+#include <mutex>
 #include <netdb.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <poll.h>
+#include <pthread.h>
 #include <string>
+#include <string_view>
+#include <strings.h>
 #include <sys/socket.h>
+#include <sys/time.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 
 // HTTPS (TLS) 対応 — OpenSSLが利用可能な場合のみ
 #ifdef CM_HAS_OPENSSL
@@ -80,7 +100,8 @@ static const char* method_string(int method) {
 }
 
 // HTTPリクエスト文字列を構築
-static std::string build_request(const CmHttpRequest* req) {
+// keep_alive: falseならConnection: closeを付ける（ユーザーがConnectionを指定した場合はそれに従う）
+static std::string build_request(const CmHttpRequest* req, bool keep_alive) {
     std::string request;
     request += method_string(req->method);
     request += " ";
@@ -109,8 +130,9 @@ static std::string build_request(const CmHttpRequest* req) {
         request += "Content-Type: application/json\r\n";
     }
 
-    // 接続管理
-    request += "Connection: close\r\n";
+    // 接続管理（HTTP/1.1は既定で持続接続）
+    if (!keep_alive && req->headers.find("Connection") == req->headers.end())
+        request += "Connection: close\r\n";
     request += "\r\n";
 
     // ボディ
@@ -194,178 +216,1558 @@ static CmHttpResponse* parse_response(const std::string& raw) {
     return resp;
 }
 
-// TCP接続してデータ送受信
-static int tcp_connect_and_communicate(const std::string& host, int port,
-                                       const std::string& request, std::string& response) {
-    struct addrinfo hints, *result;
-    memset(&hints, 0, sizeof(hints));
-    hints.ai_family = AF_INET;
-    hints.ai_socktype = SOCK_STREAM;
+// ============================================================
+// TLS (HTTPS) 通信
+// ============================================================
+#ifdef CM_HAS_OPENSSL
 
-    std::string port_str = std::to_string(port);
-    if (getaddrinfo(host.c_str(), port_str.c_str(), &hints, &result) != 0) {
+// TLSセッションキャッシュ（接続先キーごとに最新のセッションを1つ保持し、再接続時に再開する）
+static std::mutex tls_session_mutex;
+static std::unordered_map<std::string, SSL_SESSION*> tls_sessions;
+
+// 新しいセッションを保存（TLS 1.3ではハンドシェイク後のチケット受信時に呼ばれる）
+// SSLのapp_dataには接続先キー（std::string*）を設定しておく
+static int tls_new_session(SSL* ssl, SSL_SESSION* session) {
+    auto* key = static_cast<const std::string*>(SSL_get_app_data(ssl));
+    if (!key)
+        return 0;
+    std::lock_guard<std::mutex> lock(tls_session_mutex);
+    SSL_SESSION*& slot = tls_sessions[*key];
+    if (slot)
+        SSL_SESSION_free(slot);
+    slot = session;
+    return 1;  // 所有権を受け取る
+}
+
+// 保存済みのセッションがあれば再開を試みる
+static void tls_restore_session(SSL* ssl, const std::string& key) {
+    std::lock_guard<std::mutex> lock(tls_session_mutex);
+    auto it = tls_sessions.find(key);
+    if (it != tls_sessions.end())
+        SSL_set_session(ssl, it->second);
+}
+
+static void tls_clear_sessions() {
+    std::lock_guard<std::mutex> lock(tls_session_mutex);
+    for (auto& entry : tls_sessions)
+        SSL_SESSION_free(entry.second);
+    tls_sessions.clear();
+}
+
+static SSL_CTX* create_ssl_context() {
+    SSL_CTX* ctx = SSL_CTX_new(TLS_client_method());
+    if (ctx) {
+        // システムのCA証明書を読み込み
+        SSL_CTX_set_default_verify_paths(ctx);
+        // TLS 1.2以上を要求
+        SSL_CTX_set_min_proto_version(ctx, TLS1_2_VERSION);
+        // 非ブロッキングソケットで使うため部分書き込みを許可
+        SSL_CTX_set_mode(ctx, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+        // セッションは内部キャッシュではなく接続先ごとに保存する
+        SSL_CTX_set_session_cache_mode(ctx,
+                                       SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(ctx, tls_new_session);
+    }
+    return ctx;
+}
+
+// OpenSSL初期化（プロセスで1度だけ、複数スレッドから呼ばれても安全）
+static SSL_CTX* get_ssl_context() {
+    static SSL_CTX* ctx = create_ssl_context();
+    return ctx;
+}
+
+#endif  // CM_HAS_OPENSSL
+
+// ============================================================
+// イベント駆動HTTPサーバ（keep-alive / パイプライン）
+// ============================================================
+// 各ワーカースレッドが自分のepoll（Linux以外はpoll）で待機し、共有のlistenソケットから
+// 受け付けた接続を閉じるまで担当する。受信データは接続ごとのバッファに貯め、
+// リクエストはそのバッファを指すstring_viewとして解析する（ヘッダーをコピーしない）。
+// レスポンスは送信キューに積み、ギャザー書き込み（writev相当のsendmsg）でまとめて送る。
+
+static const int EV_MAX_HEADERS = 64;
+static const size_t EV_MAX_HEAD_SIZE = 64 * 1024;        // ヘッダー部の上限
+static const int64_t EV_MAX_BODY_SIZE = 8 * 1024 * 1024;  // ボディの上限
+static const size_t EV_READ_CHUNK = 16 * 1024;            // 1回の読み込みで確保する空き
+static const size_t EV_MAX_PENDING_OUT = 1024 * 1024;     // 超えたら次のリクエストを処理しない
+static const int EV_MAX_IOV = 64;
+
+#ifdef MSG_NOSIGNAL
+static const int EV_SEND_FLAGS = MSG_NOSIGNAL;  // 切断済みソケットへの送信でSIGPIPEを出さない
+#else
+static const int EV_SEND_FLAGS = 0;  // macOSは接続ごとにSO_NOSIGPIPEを設定する
+#endif
+
+struct EvHeader {
+    std::string_view name;
+    std::string_view value;
+};
+
+// 解析済みリクエスト（各ビューは接続の受信バッファを指す）
+struct EvRequestView {
+    std::string_view method;
+    std::string_view path;
+    std::string_view body;
+    EvHeader headers[EV_MAX_HEADERS];
+    int header_count = 0;
+    bool http10 = false;
+    bool keep_alive = true;
+};
+
+// 受信途中のリクエストの状態（追加受信のたびに先頭から探し直さないため）
+struct EvParseState {
+    size_t scan_from = 0;  // ヘッダー終端を探し始める位置
+    size_t head_len = 0;   // 空行までのヘッダー部の長さ（0=未受信）
+    size_t body_len = 0;
+};
+
+enum class EvParse { Done, More, Bad, TooLarge, Unsupported };
+
+// 大文字小文字を区別しない比較（ヘッダー名・トークン用）
+static bool ev_iequals(std::string_view a, std::string_view b) {
+    return a.size() == b.size() && strncasecmp(a.data(), b.data(), a.size()) == 0;
+}
+
+// 前後の空白（SP/HTAB）を除去
+static std::string_view ev_trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t'))
+        s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t'))
+        s.remove_suffix(1);
+    return s;
+}
+
+// ヘッダー値を名前で探す（なければ空）
+static std::string_view ev_find_header(const EvHeader* headers, int count, std::string_view name) {
+    for (int i = 0; i < count; i++) {
+        if (ev_iequals(headers[i].name, name))
+            return headers[i].value;
+    }
+    return {};
+}
+
+// Content-Lengthを解析（-1=不正, -2=上限超過）
+static int64_t ev_parse_length(std::string_view s, int64_t limit = EV_MAX_BODY_SIZE) {
+    if (s.empty())
         return -1;
+    int64_t n = 0;
+    for (char c : s) {
+        if (c < '0' || c > '9')
+            return -1;
+        n = n * 10 + (c - '0');
+        if (n > limit)
+            return -2;
     }
+    return n;
+}
 
-    int fd = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
-    if (fd < 0) {
-        freeaddrinfo(result);
-        return -2;
+// リクエストラインとヘッダー部（末尾の空行を含むhead_lenバイト）を解析
+static EvParse ev_parse_head(const char* data, size_t head_len, EvRequestView& req,
+                             size_t& body_len) {
+    // 最後の空行のCRLFを除くと、各行がCRLFで終わる
+    std::string_view head(data, head_len - 2);
+    size_t line_end = head.find("\r\n");
+    std::string_view line = head.substr(0, line_end);
+    size_t sp1 = line.find(' ');
+    size_t sp2 = sp1 == std::string_view::npos ? sp1 : line.find(' ', sp1 + 1);
+    if (sp1 == 0 || sp2 == std::string_view::npos)
+        return EvParse::Bad;
+    std::string_view version = line.substr(sp2 + 1);
+    if (version.substr(0, 5) != "HTTP/")
+        return EvParse::Bad;
+    req.method = line.substr(0, sp1);
+    req.path = line.substr(sp1 + 1, sp2 - sp1 - 1);
+    req.http10 = version == "HTTP/1.0";
+    req.header_count = 0;
+
+    int64_t length = 0;
+    bool chunked = false;
+    std::string_view connection;
+    size_t pos = line_end + 2;
+    while (pos < head.size()) {
+        size_t end = head.find("\r\n", pos);
+        std::string_view field = head.substr(pos, end - pos);
+        pos = end + 2;
+        size_t colon = field.find(':');
+        if (colon == 0 || colon == std::string_view::npos)
+            return EvParse::Bad;
+        if (req.header_count >= EV_MAX_HEADERS)
+            return EvParse::TooLarge;
+        EvHeader& h = req.headers[req.header_count++];
+        h.name = field.substr(0, colon);
+        h.value = ev_trim(field.substr(colon + 1));
+        if (ev_iequals(h.name, "Content-Length")) {
+            length = ev_parse_length(h.value);
+            if (length < 0)
+                return length == -2 ? EvParse::TooLarge : EvParse::Bad;
+        } else if (ev_iequals(h.name, "Transfer-Encoding")) {
+            chunked = true;
+        } else if (ev_iequals(h.name, "Connection")) {
+            connection = h.value;
+        }
     }
+    // チャンク形式のリクエストボディは未対応（501を返して切断する）
+    if (chunked)
+        return EvParse::Unsupported;
+
+    // HTTP/1.1は既定で持続接続、HTTP/1.0は明示された場合のみ
+    req.keep_alive =
+        req.http10 ? ev_iequals(connection, "keep-alive") : !ev_iequals(connection, "close");
+    body_len = static_cast<size_t>(length);
+    return EvParse::Done;
+}
 
-    if (connect(fd, result->ai_addr, result->ai_addrlen) < 0) {
-        close(fd);
-        freeaddrinfo(result);
-        return -3;
+// data[0, len)の先頭からリクエストを1件解析する
+// 完了時はconsumedにリクエスト全体の長さを返し、stを次のリクエスト用に戻す
+static EvParse ev_parse_request(const char* data, size_t len, EvParseState& st,
+                                EvRequestView& req, size_t& consumed) {
+    if (st.head_len == 0) {
+        // 前回までに調べた範囲はスキップする（終端が区切られて届く場合に備えて3バイト戻る）
+        const void* hit = len > st.scan_from
+                              ? memmem(data + st.scan_from, len - st.scan_from, "\r\n\r\n", 4)
+                              : nullptr;
+        if (!hit) {
+            if (len > EV_MAX_HEAD_SIZE)
+                return EvParse::TooLarge;
+            st.scan_from = len >= 3 ? len - 3 : 0;
+            return EvParse::More;
+        }
+        st.head_len = static_cast<size_t>(static_cast<const char*>(hit) - data) + 4;
+        EvParse r = ev_parse_head(data, st.head_len, req, st.body_len);
+        if (r != EvParse::Done)
+            return r;
+    } else if (len >= st.head_len + st.body_len) {
+        // ボディ待ちの間に受信バッファが移動していることがあるため、ビューを取り直す
+        ev_parse_head(data, st.head_len, req, st.body_len);
     }
-    freeaddrinfo(result);
+    if (len < st.head_len + st.body_len)
+        return EvParse::More;
 
-    // TCP_NODELAY
-    int opt = 1;
-    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+    req.body = std::string_view(data + st.head_len, st.body_len);
+    consumed = st.head_len + st.body_len;
+    st = EvParseState();
+    return EvParse::Done;
+}
 
-    // リクエスト送信
-    const char* data = request.c_str();
-    size_t total = request.size();
-    size_t sent = 0;
-    while (sent < total) {
-        ssize_t n = write(fd, data + sent, total - sent);
-        if (n <= 0) {
+// ステータステキスト
+static const char* http_status_text(int status) {
+    switch (status) {
+        case 200:
+            return "OK";
+        case 201:
+            return "Created";
+        case 204:
+            return "No Content";
+        case 400:
+            return "Bad Request";
+        case 404:
+            return "Not Found";
+        case 413:
+            return "Payload Too Large";
+        case 500:
+            return "Internal Server Error";
+        case 501:
+            return "Not Implemented";
+        default:
+            return "OK";
+    }
+}
+
+// 接続ごとの状態（1つのワーカーだけが触る）
+struct EvConn {
+    int fd = -1;
+    std::vector<char> in;  // 受信バッファ
+    size_t in_start = 0;   // 未処理データの先頭
+    size_t in_end = 0;     // 受信済みデータの末尾
+    EvParseState parse;
+    std::deque<std::string> out;  // 送信待ちチャンク（レスポンスヘッダーとボディ）
+    size_t out_off = 0;           // out.front()の送信済みバイト数
+    size_t out_bytes = 0;         // 送信待ちの合計
+    bool close_after_flush = false;
+    bool peer_closed = false;
+    bool want_read = true;  // ポーラーに登録中の関心
+    bool want_write = false;
+};
+
+// ハンドラに渡すリクエスト（ハンドラから戻った時点で無効になる）
+struct CmHttpEvRequest {
+    EvRequestView view;
+    EvConn* conn;
+    bool responded;
+};
+
+// レスポンスを送信キューに積む（ヘッダーとボディは別チャンクのまま送る）
+static void ev_queue_response(EvConn* conn, const EvRequestView& req, int status,
+                              const char* content_type, const char* body, size_t body_len) {
+    std::string head;
+    head.reserve(128);
+    head += "HTTP/1.1 ";
+    head += std::to_string(status);
+    head += ' ';
+    head += http_status_text(status);
+    head += "\r\nContent-Type: ";
+    head += content_type;
+    head += "\r\nContent-Length: ";
+    head += std::to_string(body_len);
+    if (!req.keep_alive)
+        head += "\r\nConnection: close";
+    else if (req.http10)
+        head += "\r\nConnection: keep-alive";
+    head += "\r\n\r\n";
+
+    conn->out_bytes += head.size() + body_len;
+    conn->out.push_back(std::move(head));
+    if (body_len > 0)
+        conn->out.emplace_back(body, body_len);
+    if (!req.keep_alive)
+        conn->close_after_flush = true;
+}
+
+// 送信キューをまとめて送る（送り切れない分はキューに残る）
+// 戻り値: false=接続エラー
+static bool ev_flush(EvConn* conn) {
+    while (!conn->out.empty()) {
+        struct iovec iov[EV_MAX_IOV];
+        int count = 0;
+        for (auto it = conn->out.begin(); it != conn->out.end() && count < EV_MAX_IOV; ++it) {
+            size_t off = count == 0 ? conn->out_off : 0;
+            iov[count].iov_base = const_cast<char*>(it->data()) + off;
+            iov[count].iov_len = it->size() - off;
+            count++;
+        }
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        ssize_t n = sendmsg(conn->fd, &msg, EV_SEND_FLAGS);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        size_t left = static_cast<size_t>(n);
+        conn->out_bytes -= left;
+        while (left > 0) {
+            size_t avail = conn->out.front().size() - conn->out_off;
+            if (left < avail) {
+                conn->out_off += left;
+                break;
+            }
+            left -= avail;
+            conn->out.pop_front();
+            conn->out_off = 0;
+        }
+    }
+    return true;
+}
+
+// 受信する（空きが足りなければ前詰め・拡張する）
+// 戻り値: false=接続エラー
+static bool ev_read(EvConn* conn) {
+    while (true) {
+        if (conn->in_start == conn->in_end) {
+            conn->in_start = conn->in_end = 0;
+        } else if (conn->in.size() - conn->in_end < EV_READ_CHUNK / 4 && conn->in_start > 0) {
+            // 解析位置はin_startからの相対値なので、前詰めしても状態は変わらない
+            memmove(conn->in.data(), conn->in.data() + conn->in_start,
+                    conn->in_end - conn->in_start);
+            conn->in_end -= conn->in_start;
+            conn->in_start = 0;
+        }
+        if (conn->in.size() - conn->in_end < EV_READ_CHUNK / 4)
+            conn->in.resize(conn->in.empty() ? EV_READ_CHUNK : conn->in.size() * 2);
+
+        size_t space = conn->in.size() - conn->in_end;
+        ssize_t n = read(conn->fd, conn->in.data() + conn->in_end, space);
+        if (n > 0) {
+            conn->in_end += static_cast<size_t>(n);
+            // 空きを使い切った場合だけ続けて読む（残りは次のイベントで）
+            if (static_cast<size_t>(n) < space)
+                return true;
+            continue;
+        }
+        if (n == 0) {
+            conn->peer_closed = true;
+            return true;
+        }
+        if (errno == EINTR)
+            continue;
+        return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+}
+
+struct EvServer {
+    int listen_fd = -1;
+    int workers = 1;
+    int wake_fds[2] = {-1, -1};  // stop()で書き込み、全ワーカーを起こす
+    void (*handler)(int64_t) = nullptr;
+    int64_t max_requests = 0;
+    std::atomic<int64_t> served{0};
+    std::atomic<bool> stopping{false};
+};
+
+// 受信バッファ内の完了したリクエストを順に処理する（パイプライン）
+// 戻り値: true=送信待ちが多すぎて途中で止めた
+static bool ev_process(EvServer* srv, EvConn* conn) {
+    while (!conn->close_after_flush) {
+        if (conn->out_bytes >= EV_MAX_PENDING_OUT)
+            return true;
+        CmHttpEvRequest req;
+        size_t consumed = 0;
+        const char* data = conn->in.data() + conn->in_start;
+        size_t len = conn->in_end - conn->in_start;
+        EvParse r = ev_parse_request(data, len, conn->parse, req.view, consumed);
+        if (r == EvParse::More)
+            break;
+        if (r != EvParse::Done) {
+            int status = r == EvParse::TooLarge      ? 413
+                         : r == EvParse::Unsupported ? 501
+                                                     : 400;
+            req.view.keep_alive = false;
+            ev_queue_response(conn, req.view, status, "application/json", "", 0);
+            break;
+        }
+        req.conn = conn;
+        req.responded = false;
+        srv->handler(reinterpret_cast<int64_t>(&req));
+        if (!req.responded)
+            ev_queue_response(conn, req.view, 500, "application/json", "", 0);
+        conn->in_start += consumed;
+        srv->served.fetch_add(1, std::memory_order_relaxed);
+    }
+    return false;
+}
+
+// ワーカーのイベント待ち（Linuxはepoll、それ以外はpoll）
+class EvPoller {
+   public:
+    struct Event {
+        void* tag;
+        bool readable;
+        bool writable;
+        bool error;
+    };
+
+#ifdef __linux__
+    ~EvPoller() {
+        if (epfd_ >= 0)
+            close(epfd_);
+    }
+
+    bool open() {
+        epfd_ = epoll_create1(EPOLL_CLOEXEC);
+        return epfd_ >= 0;
+    }
+
+    // exclusive: 共有listenソケットで全ワーカーが一斉に起きないようにする
+    bool add(int fd, void* tag, bool read, bool write, bool exclusive = false) {
+        struct epoll_event ev;
+        ev.events = mask(read, write);
+        ev.data.ptr = tag;
+#ifdef EPOLLEXCLUSIVE
+        if (exclusive) {
+            ev.events |= EPOLLEXCLUSIVE;
+            if (epoll_ctl(epfd_, EPOLL_CTL_ADD, fd, &ev) == 0)
+                return true;
+            ev.events &= ~static_cast<uint32_t>(EPOLLEXCLUSIVE);
+        }
+#else
+        (void)exclusive;
+#endif
+        return epoll_ctl(epfd_, EPOLL_CTL_ADD, fd, &ev) == 0;
+    }
+
+    void modify(int fd, void* tag, bool read, bool write) {
+        struct epoll_event ev;
+        ev.events = mask(read, write);
+        ev.data.ptr = tag;
+        epoll_ctl(epfd_, EPOLL_CTL_MOD, fd, &ev);
+    }
+
+    void remove(int fd) { epoll_ctl(epfd_, EPOLL_CTL_DEL, fd, nullptr); }
+
+    int wait(std::vector<Event>& out, int timeout_ms) {
+        struct epoll_event evs[256];
+        int n = epoll_wait(epfd_, evs, 256, timeout_ms);
+        out.clear();
+        for (int i = 0; i < n; i++) {
+            uint32_t e = evs[i].events;
+            out.push_back({evs[i].data.ptr, (e & (EPOLLIN | EPOLLHUP)) != 0, (e & EPOLLOUT) != 0,
+                           (e & EPOLLERR) != 0});
+        }
+        return static_cast<int>(out.size());
+    }
+
+   private:
+    static uint32_t mask(bool read, bool write) {
+        uint32_t events = 0;
+        if (read)
+            events |= EPOLLIN | EPOLLRDHUP;
+        if (write)
+            events |= EPOLLOUT;
+        return events;
+    }
+
+    int epfd_ = -1;
+#else
+    bool open() { return true; }
+
+    bool add(int fd, void* tag, bool read, bool write, bool exclusive = false) {
+        (void)exclusive;
+        index_[fd] = fds_.size();
+        fds_.push_back({fd, mask(read, write), 0});
+        tags_.push_back(tag);
+        return true;
+    }
+
+    void modify(int fd, void* tag, bool read, bool write) {
+        auto it = index_.find(fd);
+        if (it == index_.end())
+            return;
+        fds_[it->second].events = mask(read, write);
+        tags_[it->second] = tag;
+    }
+
+    void remove(int fd) {
+        auto it = index_.find(fd);
+        if (it == index_.end())
+            return;
+        size_t slot = it->second;
+        index_.erase(it);
+        if (slot + 1 != fds_.size()) {
+            fds_[slot] = fds_.back();
+            tags_[slot] = tags_.back();
+            index_[fds_[slot].fd] = slot;
+        }
+        fds_.pop_back();
+        tags_.pop_back();
+    }
+
+    int wait(std::vector<Event>& out, int timeout_ms) {
+        out.clear();
+        int n = ::poll(fds_.data(), static_cast<nfds_t>(fds_.size()), timeout_ms);
+        for (size_t i = 0; n > 0 && i < fds_.size(); i++) {
+            short re = fds_[i].revents;
+            if (re == 0)
+                continue;
+            out.push_back({tags_[i], (re & (POLLIN | POLLHUP)) != 0, (re & POLLOUT) != 0,
+                           (re & (POLLERR | POLLNVAL)) != 0});
+            n--;
+        }
+        return static_cast<int>(out.size());
+    }
+
+   private:
+    static short mask(bool read, bool write) {
+        return static_cast<short>((read ? POLLIN : 0) | (write ? POLLOUT : 0));
+    }
+
+    std::vector<struct pollfd> fds_;
+    std::vector<void*> tags_;
+    std::unordered_map<int, size_t> index_;
+#endif
+};
+
+// listenソケットと起床用パイプを見分けるタグ
+static char ev_listen_tag;
+static char ev_wake_tag;
+
+// 全ワーカーに停止を通知（パイプは読み出さないので、全員が読み込み可能として起きる）
+static void ev_stop(EvServer* srv) {
+    if (!srv->stopping.exchange(true)) {
+        char c = 1;
+        ssize_t n = write(srv->wake_fds[1], &c, 1);
+        (void)n;
+    }
+}
+
+// 受け付け可能な接続をすべて受け付ける
+static void ev_accept(EvServer* srv, EvPoller& poller, std::unordered_set<EvConn*>& conns) {
+    while (true) {
+#ifdef __linux__
+        int fd = accept4(srv->listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else
+        int fd = accept(srv->listen_fd, nullptr, nullptr);
+        if (fd >= 0)
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+#endif
+        if (fd < 0)
+            return;  // EAGAIN（他のワーカーが先に受け付けた場合を含む）
+
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+#ifdef SO_NOSIGPIPE
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+        auto* conn = new EvConn();
+        conn->fd = fd;
+        if (!poller.add(fd, conn, true, false)) {
             close(fd);
-            return -4;
+            delete conn;
+            continue;
         }
-        sent += static_cast<size_t>(n);
+        conns.insert(conn);
     }
+}
 
-    // レスポンス受信（最大64KB）
-    char buf[4096];
-    response.clear();
+// 1回のイベントを処理する: 受信 → パース・ハンドラ呼び出し → 送信 → 関心の更新
+// 戻り値: false=接続を閉じる
+static bool ev_on_event(EvServer* srv, EvPoller& poller, EvConn* conn,
+                        const EvPoller::Event& ev) {
+    if (ev.error && !ev.readable)
+        return false;
+    if (ev.readable && conn->want_read && !ev_read(conn))
+        return false;
     while (true) {
-        ssize_t n = read(fd, buf, sizeof(buf) - 1);
-        if (n <= 0)
+        bool blocked = ev_process(srv, conn);
+        if (!ev_flush(conn))
+            return false;
+        // 送信待ちが減った分だけ、止めていたパイプラインの残りを進める
+        if (!blocked || conn->out_bytes >= EV_MAX_PENDING_OUT)
             break;
-        buf[n] = '\0';
-        response += buf;
-        // レスポンス完了判定（Connection: close前提）
-        if (response.size() > 65536)
+    }
+    if (conn->out.empty() && (conn->close_after_flush || conn->peer_closed))
+        return false;
+
+    // 送信待ちが多い間は読み込みを止める（レベルトリガーで空回りしないように）
+    bool want_read =
+        !conn->close_after_flush && !conn->peer_closed && conn->out_bytes < EV_MAX_PENDING_OUT;
+    bool want_write = !conn->out.empty();
+    if (want_read != conn->want_read || want_write != conn->want_write) {
+        poller.modify(conn->fd, conn, want_read, want_write);
+        conn->want_read = want_read;
+        conn->want_write = want_write;
+    }
+    return true;
+}
+
+static void ev_worker_loop(EvServer* srv) {
+    EvPoller poller;
+    if (!poller.open() || !poller.add(srv->listen_fd, &ev_listen_tag, true, false, true) ||
+        !poller.add(srv->wake_fds[0], &ev_wake_tag, true, false)) {
+        ev_stop(srv);
+        return;
+    }
+
+    std::unordered_set<EvConn*> conns;
+    std::vector<EvPoller::Event> events;
+    while (!srv->stopping.load(std::memory_order_acquire)) {
+        int n = poller.wait(events, -1);
+        if (n < 0 && errno != EINTR)
             break;
+        for (int i = 0; i < n; i++) {
+            const auto& ev = events[i];
+            if (ev.tag == &ev_wake_tag)
+                continue;
+            if (ev.tag == &ev_listen_tag) {
+                ev_accept(srv, poller, conns);
+                continue;
+            }
+            auto* conn = static_cast<EvConn*>(ev.tag);
+            if (!ev_on_event(srv, poller, conn, ev)) {
+                poller.remove(conn->fd);
+                close(conn->fd);
+                conns.erase(conn);
+                delete conn;
+            }
+        }
+        if (srv->max_requests > 0 &&
+            srv->served.load(std::memory_order_relaxed) >= srv->max_requests)
+            ev_stop(srv);
+    }
+
+    // 送信待ちのレスポンスは送り切ってから閉じる（相手が受け取らない場合は1秒で諦める）
+    for (auto* conn : conns) {
+        if (!conn->out.empty()) {
+            fcntl(conn->fd, F_SETFL, fcntl(conn->fd, F_GETFL, 0) & ~O_NONBLOCK);
+            struct timeval tv = {1, 0};
+            setsockopt(conn->fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+            ev_flush(conn);
+        }
+        close(conn->fd);
+        delete conn;
+    }
+}
+
+static void* ev_worker_main(void* arg) {
+    ev_worker_loop(static_cast<EvServer*>(arg));
+    return nullptr;
+}
+
+// ============================================================
+// 負荷試験クライアント（ベンチマーク・テスト用）
+// ============================================================
+
+struct EvLoadJob {
+    struct sockaddr_in addr;
+    const std::string* batch;  // pipeline件分のリクエストを連結したもの
+    size_t request_size;
+    int requests;
+    int pipeline;
+    int64_t ok = 0;  // 2xxのレスポンス数
+};
+
+// レスポンスを1件解析する（完了時は長さ、データ不足は0、不正は-1）
+static int64_t ev_parse_response(const char* data, size_t len, int& status, bool& close_conn) {
+    const void* hit = memmem(data, len, "\r\n\r\n", 4);
+    if (!hit)
+        return 0;
+    size_t head_len = static_cast<size_t>(static_cast<const char*>(hit) - data) + 4;
+    std::string_view head(data, head_len - 2);
+    if (head.size() < 12 || head.substr(0, 5) != "HTTP/")
+        return -1;
+    status = atoi(head.data() + 9);
+
+    int64_t body_len = -1;
+    close_conn = false;
+    size_t pos = head.find("\r\n") + 2;
+    while (pos < head.size()) {
+        size_t end = head.find("\r\n", pos);
+        std::string_view field = head.substr(pos, end - pos);
+        pos = end + 2;
+        size_t colon = field.find(':');
+        if (colon == std::string_view::npos)
+            continue;
+        std::string_view name = field.substr(0, colon);
+        std::string_view value = ev_trim(field.substr(colon + 1));
+        if (ev_iequals(name, "Content-Length"))
+            body_len = ev_parse_length(value);
+        else if (ev_iequals(name, "Connection"))
+            close_conn = ev_iequals(value, "close");
+    }
+    if (body_len < 0)
+        return -1;
+    if (len < head_len + static_cast<size_t>(body_len))
+        return 0;
+    return static_cast<int64_t>(head_len) + body_len;
+}
+
+// 1接続ぶんの負荷をかける（切断されたら再接続し、応答のなかった分を送り直す）
+static void* ev_load_main(void* arg) {
+    auto* job = static_cast<EvLoadJob*>(arg);
+    std::vector<char> buf(64 * 1024);
+    int done = 0;
+    int failures = 0;
+    int fd = -1;
+    while (done < job->requests && failures < 3) {
+        if (fd < 0) {
+            fd = socket(AF_INET, SOCK_STREAM, 0);
+            if (fd < 0)
+                break;
+            if (connect(fd, reinterpret_cast<struct sockaddr*>(&job->addr), sizeof(job->addr)) <
+                0) {
+                close(fd);
+                fd = -1;
+                failures++;
+                continue;
+            }
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        }
+
+        // 最大pipeline件を1回の書き込みで送る
+        int count = std::min(job->pipeline, job->requests - done);
+        size_t total = job->request_size * static_cast<size_t>(count);
+        size_t sent = 0;
+        while (sent < total) {
+            ssize_t n = send(fd, job->batch->data() + sent, total - sent, EV_SEND_FLAGS);
+            if (n <= 0)
+                break;
+            sent += static_cast<size_t>(n);
+        }
+
+        // 送った分の応答を待つ
+        int got = 0;
+        bool closed = sent < total;
+        size_t start = 0;
+        size_t end = 0;
+        while (!closed && got < count) {
+            int status = 0;
+            bool close_conn = false;
+            int64_t len = ev_parse_response(buf.data() + start, end - start, status, close_conn);
+            if (len > 0) {
+                start += static_cast<size_t>(len);
+                got++;
+                if (status >= 200 && status < 300)
+                    job->ok++;
+                if (close_conn)
+                    closed = true;
+                continue;
+            }
+            if (len < 0) {
+                closed = true;
+                break;
+            }
+            if (start == end) {
+                start = end = 0;
+            } else if (end == buf.size()) {
+                memmove(buf.data(), buf.data() + start, end - start);
+                end -= start;
+                start = 0;
+                if (end == buf.size())
+                    buf.resize(buf.size() * 2);
+            }
+            ssize_t n = read(fd, buf.data() + end, buf.size() - end);
+            if (n <= 0)
+                closed = true;
+            else
+                end += static_cast<size_t>(n);
+        }
+        done += got;
+        failures = got > 0 ? 0 : failures + 1;
+        if (closed) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    if (fd >= 0)
+        close(fd);
+    return nullptr;
+}
+
+extern "C" {
+
+// ============================================================
+// HTTPクライアント（コネクションプール・keep-alive）
+// ============================================================
+// 接続は接続先（host:port、TLSは別枠）ごとのアイドルプールへ戻して再利用する。
+// レスポンスの終端はContent-Length／chunkedで判定し、読み切った接続だけをプールへ戻す。
+// ソケットは常に非ブロッキングで、同期APIはpoll()で、非同期APIは呼び出し側の
+// イベントループで待機する。
+
+static const size_t CLIENT_READ_CHUNK = 16 * 1024;
+static const size_t CLIENT_MAX_HEAD_SIZE = 64 * 1024;
+static const int64_t CLIENT_MAX_BODY_SIZE = 64 * 1024 * 1024;
+
+static std::atomic<int32_t> client_pool_size{8};            // 接続先ごとのアイドル接続数の上限
+static std::atomic<int32_t> client_idle_timeout_ms{30000};  // これより長くアイドルなら捨てる
+static std::atomic<int32_t> client_dns_ttl_ms{30000};       // 名前解決結果の保持期間
+
+static std::atomic<int64_t> client_connects{0};
+static std::atomic<int64_t> client_reuses{0};
+static std::atomic<int64_t> client_dns_lookups{0};
+static std::atomic<int64_t> client_tls_resumptions{0};
+
+static uint64_t client_now_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000 + static_cast<uint64_t>(ts.tv_nsec) / 1000000;
+}
+
+// ------------------------------------------------------------
+// DNSキャッシュ
+// getaddrinfoはレコードのTTLを返さないため、保持期間は設定値（client_dns_ttl_ms）を使う
+// ------------------------------------------------------------
+
+struct DnsEntry {
+    struct sockaddr_in addr;
+    uint64_t expires_ms;
+};
+
+static std::mutex dns_mutex;
+static std::unordered_map<std::string, DnsEntry> dns_cache;
+
+// ホスト名を解決する（保持期間内はキャッシュを返す、失敗時false）
+static bool client_resolve(const std::string& host, int port, struct sockaddr_in& out) {
+    int32_t ttl = client_dns_ttl_ms.load(std::memory_order_relaxed);
+    uint64_t now = client_now_ms();
+    bool cached = false;
+    if (ttl > 0) {
+        std::lock_guard<std::mutex> lock(dns_mutex);
+        auto it = dns_cache.find(host);
+        if (it != dns_cache.end() && it->second.expires_ms > now) {
+            out = it->second.addr;
+            cached = true;
+        }
+    }
+
+    if (!cached) {
+        struct addrinfo hints, *result;
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        client_dns_lookups.fetch_add(1, std::memory_order_relaxed);
+        if (getaddrinfo(host.c_str(), nullptr, &hints, &result) != 0)
+            return false;
+        memcpy(&out, result->ai_addr, sizeof(out));
+        freeaddrinfo(result);
+        if (ttl > 0) {
+            std::lock_guard<std::mutex> lock(dns_mutex);
+            dns_cache[host] = DnsEntry{out, now + static_cast<uint64_t>(ttl)};
+        }
+    }
+    out.sin_port = htons(static_cast<uint16_t>(port));
+    return true;
+}
+
+// 接続できなかったホストはキャッシュから外す（アドレスが変わった可能性がある）
+static void client_forget_host(const std::string& host) {
+    std::lock_guard<std::mutex> lock(dns_mutex);
+    dns_cache.erase(host);
+}
+
+// ------------------------------------------------------------
+// コネクションプール
+// ------------------------------------------------------------
+
+struct ClientConn {
+    int fd = -1;
+#ifdef CM_HAS_OPENSSL
+    SSL* ssl = nullptr;
+#endif
+    std::string key;  // 接続先キー（"host:port"、TLSは"tls:host:port"）
+    uint64_t idle_since = 0;
+};
+
+static void client_conn_close(ClientConn* conn) {
+#ifdef CM_HAS_OPENSSL
+    if (conn->ssl) {
+        SSL_shutdown(conn->ssl);
+        SSL_free(conn->ssl);
+    }
+#endif
+    if (conn->fd >= 0)
+        close(conn->fd);
+    delete conn;
+}
+
+static std::mutex pool_mutex;
+static std::unordered_map<std::string, std::vector<ClientConn*>> client_pool;
+
+// アイドル中に相手が閉じた接続、想定外のデータが届いた接続は使わない
+static bool client_conn_alive(const ClientConn* conn) {
+    char c;
+    ssize_t n = recv(conn->fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+}
+
+// アイドル接続を取り出す（最後に戻されたものから、なければnullptr）
+static ClientConn* client_pool_take(const std::string& key) {
+    uint64_t now = client_now_ms();
+    int32_t timeout_ms = client_idle_timeout_ms.load(std::memory_order_relaxed);
+    uint64_t timeout = static_cast<uint64_t>(timeout_ms);
+    ClientConn* found = nullptr;
+    std::vector<ClientConn*> stale;
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        auto it = client_pool.find(key);
+        if (it != client_pool.end()) {
+            std::vector<ClientConn*>& idle = it->second;
+            while (!idle.empty() && !found) {
+                ClientConn* conn = idle.back();
+                idle.pop_back();
+                if (now - conn->idle_since < timeout && client_conn_alive(conn))
+                    found = conn;
+                else
+                    stale.push_back(conn);
+            }
+            // 古いものは先頭側に溜まる
+            while (!idle.empty() && now - idle.front()->idle_since >= timeout) {
+                stale.push_back(idle.front());
+                idle.erase(idle.begin());
+            }
+        }
+    }
+    for (ClientConn* conn : stale)
+        client_conn_close(conn);
+    return found;
+}
+
+// レスポンスを読み切った接続をプールへ戻す（上限を超える場合は閉じる）
+static void client_pool_put(ClientConn* conn) {
+    int32_t limit = client_pool_size.load(std::memory_order_relaxed);
+    conn->idle_since = client_now_ms();
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        std::vector<ClientConn*>& idle = client_pool[conn->key];
+        if (static_cast<int32_t>(idle.size()) < limit) {
+            idle.push_back(conn);
+            return;
+        }
+    }
+    client_conn_close(conn);
+}
+
+static void client_pool_clear() {
+    std::vector<ClientConn*> all;
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        for (auto& entry : client_pool)
+            all.insert(all.end(), entry.second.begin(), entry.second.end());
+        client_pool.clear();
+    }
+    for (ClientConn* conn : all)
+        client_conn_close(conn);
+}
+
+// ------------------------------------------------------------
+// リクエストの実行（非ブロッキングの状態機械）
+// ------------------------------------------------------------
+
+enum class ClientState { Connect, Handshake, Send, RecvHead, RecvBody, Done };
+enum class ClientBody { None, Length, Chunked, UntilClose };
+
+// エラーコード（cm_http_executeのエラーメッセージに対応）
+static const int CLIENT_ERR_DNS = -1;
+static const int CLIENT_ERR_SOCKET = -2;
+static const int CLIENT_ERR_CONNECT = -3;
+static const int CLIENT_ERR_SEND = -4;
+static const int CLIENT_ERR_TLS_INIT = -5;
+static const int CLIENT_ERR_TLS_HANDSHAKE = -6;
+static const int CLIENT_ERR_EMPTY = -7;
+static const int CLIENT_ERR_CLOSED = -8;
+static const int CLIENT_ERR_INVALID = -9;
+static const int CLIENT_ERR_TOO_LARGE = -10;
+static const int CLIENT_ERR_TIMEOUT = -11;
+
+struct CmHttpCall {
+    std::string host;
+    int port = 0;
+    bool tls = false;
+    bool idempotent = true;  // 再送してよいメソッドか（POST/PATCH以外）
+    std::string key;
+    std::string request;
+    uint64_t deadline_ms = 0;  // 0=無制限
+
+    ClientConn* conn = nullptr;
+    bool reused = false;   // プールから取り出した接続か
+    bool retried = false;  // 新しい接続でやり直したか
+    ClientState state = ClientState::Connect;
+    bool want_write = false;  // 待機するのは書き込み可能か（falseなら読み込み可能）
+    size_t sent = 0;
+
+    std::string in;  // 受信済みで未解析のデータ
+    ClientBody framing = ClientBody::None;
+    int64_t remaining = 0;  // Length: ボディの残り, Chunked: 現在のチャンクの残り
+    int chunk_step = 0;     // Chunked: 0=サイズ行, 1=データ, 2=データ後の改行, 3=トレーラ
+    bool keep_alive = true;
+
+    int error = 0;
+    CmHttpResponse* response = nullptr;
+};
+
+static void client_fail(CmHttpCall* call, int error) {
+    if (call->conn) {
+        client_conn_close(call->conn);
+        call->conn = nullptr;
+    }
+    delete call->response;
+    call->response = nullptr;
+    call->error = error;
+    call->state = ClientState::Done;
+}
+
+// 接続を読み切ったらプールへ戻す（未解析のデータが残る接続は戻さない）
+static void client_finish(CmHttpCall* call) {
+    if (call->keep_alive && call->in.empty())
+        client_pool_put(call->conn);
+    else
+        client_conn_close(call->conn);
+    call->conn = nullptr;
+    call->state = ClientState::Done;
+}
+
+// プールの接続を使うか、新しい接続を始める
+static void client_open(CmHttpCall* call) {
+    call->sent = 0;
+    call->in.clear();
+    call->want_write = false;
+
+    // やり直しでは、同じ理由で閉じられている可能性が高いプールの接続は使わない
+    call->conn = call->retried ? nullptr : client_pool_take(call->key);
+    if (call->conn) {
+        call->reused = true;
+        call->state = ClientState::Send;
+        client_reuses.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    call->reused = false;
+
+    struct sockaddr_in addr;
+    if (!client_resolve(call->host, call->port, addr)) {
+        client_fail(call, CLIENT_ERR_DNS);
+        return;
+    }
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        client_fail(call, CLIENT_ERR_SOCKET);
+        return;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    int opt = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+#ifdef SO_NOSIGPIPE
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &opt, sizeof(opt));
+#endif
+    call->conn = new ClientConn();
+    call->conn->fd = fd;
+    call->conn->key = call->key;
+    client_connects.fetch_add(1, std::memory_order_relaxed);
+
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0 && errno != EINPROGRESS) {
+        client_forget_host(call->host);
+        client_fail(call, CLIENT_ERR_CONNECT);
+        return;
+    }
+    call->state = ClientState::Connect;
+
+#ifdef CM_HAS_OPENSSL
+    if (call->tls) {
+        SSL_CTX* ctx = get_ssl_context();
+        SSL* ssl = ctx ? SSL_new(ctx) : nullptr;
+        if (!ssl) {
+            client_fail(call, CLIENT_ERR_TLS_INIT);
+            return;
+        }
+        call->conn->ssl = ssl;
+        SSL_set_app_data(ssl, &call->conn->key);
+        // SNI (Server Name Indication) 設定
+        SSL_set_tlsext_host_name(ssl, call->host.c_str());
+        SSL_set_fd(ssl, fd);
+        tls_restore_session(ssl, call->key);
+    }
+#endif
+}
+
+// プールから取り出した接続が使えなかった場合に、新しい接続で1度だけやり直す
+// アイドル中に相手が閉じた接続には、送信できても応答が返らないことがある。
+// 非冪等なメソッドは、送信し終えていればサーバが処理した可能性があるのでやり直さない
+// 戻り値: やり直したか（新しい接続の失敗はcall->errorに入る）
+static bool client_retry(CmHttpCall* call) {
+    if (!call->reused || call->retried)
+        return false;
+    if (!call->idempotent && call->sent == call->request.size())
+        return false;
+    client_conn_close(call->conn);
+    call->conn = nullptr;
+    call->retried = true;
+    client_open(call);
+    return true;
+}
+
+#ifdef CM_HAS_OPENSSL
+// SSL_*の失敗を分類する（-1=待機が必要, 0=相手が閉じた, -2=エラー）
+static ssize_t client_tls_status(CmHttpCall* call, int ret) {
+    switch (SSL_get_error(call->conn->ssl, ret)) {
+        case SSL_ERROR_WANT_READ:
+            call->want_write = false;
+            return -1;
+        case SSL_ERROR_WANT_WRITE:
+            call->want_write = true;
+            return -1;
+        case SSL_ERROR_ZERO_RETURN:
+            return 0;
+        default:
+            return -2;
+    }
+}
+#endif
+
+// 送信（転送バイト数、-1=待機が必要、-2=エラー）
+static ssize_t client_send(CmHttpCall* call, const char* data, size_t len) {
+#ifdef CM_HAS_OPENSSL
+    if (call->conn->ssl) {
+        ERR_clear_error();
+        int n = SSL_write(call->conn->ssl, data, static_cast<int>(std::min<size_t>(len, INT_MAX)));
+        return n > 0 ? n : client_tls_status(call, n);
+    }
+#endif
+    ssize_t n = send(call->conn->fd, data, len, EV_SEND_FLAGS);
+    if (n > 0)
+        return n;
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+        call->want_write = true;
+        return -1;
+    }
+    return -2;
+}
+
+// 受信（受信バイト数、0=相手が閉じた、-1=待機が必要、-2=エラー）
+static ssize_t client_recv(CmHttpCall* call, char* buf, size_t len) {
+#ifdef CM_HAS_OPENSSL
+    if (call->conn->ssl) {
+        ERR_clear_error();
+        int n = SSL_read(call->conn->ssl, buf, static_cast<int>(std::min<size_t>(len, INT_MAX)));
+        return n > 0 ? n : client_tls_status(call, n);
+    }
+#endif
+    ssize_t n = recv(call->conn->fd, buf, len, 0);
+    if (n >= 0)
+        return n;
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+        call->want_write = false;
+        return -1;
     }
-
-    close(fd);
-    return 0;
+    return -2;
 }
 
-// ============================================================
-// TLS (HTTPS) 通信
-// ============================================================
-#ifdef CM_HAS_OPENSSL
+// 受信して追記する
+// 解析待ちのデータがない間は、Content-Length／切断までのボディを直接レスポンスへ読み込む
+static ssize_t client_read_more(CmHttpCall* call) {
+    bool direct = call->state == ClientState::RecvBody && call->in.empty() &&
+                  call->framing != ClientBody::Chunked;
+    std::string& dst = direct ? call->response->body : call->in;
+    size_t want = CLIENT_READ_CHUNK;
+    if (direct && call->framing == ClientBody::Length)
+        want = std::min(want, static_cast<size_t>(call->remaining));
+    size_t old = dst.size();
+    dst.resize(old + want);
+    ssize_t n = client_recv(call, &dst[old], want);
+    dst.resize(old + (n > 0 ? static_cast<size_t>(n) : 0));
+    if (n > 0 && direct && call->framing == ClientBody::Length)
+        call->remaining -= n;
+    return n;
+}
 
-// OpenSSL初期化（プロセスで1度だけ）
-static SSL_CTX* get_ssl_context() {
-    static SSL_CTX* ctx = nullptr;
-    if (!ctx) {
-        const SSL_METHOD* method = TLS_client_method();
-        ctx = SSL_CTX_new(method);
-        if (ctx) {
-            // システムのCA証明書を読み込み
-            SSL_CTX_set_default_verify_paths(ctx);
-            // TLS 1.2以上を要求
-            SSL_CTX_set_min_proto_version(ctx, TLS1_2_VERSION);
-        }
+// チャンクサイズ（16進）を解析（-1=不正または上限超過）
+static int64_t client_parse_hex(std::string_view s) {
+    if (s.empty())
+        return -1;
+    int64_t n = 0;
+    for (char c : s) {
+        int digit;
+        if (c >= '0' && c <= '9')
+            digit = c - '0';
+        else if (c >= 'a' && c <= 'f')
+            digit = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F')
+            digit = c - 'A' + 10;
+        else
+            return -1;
+        n = n * 16 + digit;
+        if (n > CLIENT_MAX_BODY_SIZE)
+            return -1;
     }
-    return ctx;
+    return n;
 }
 
-// TLS接続してデータ送受信
-static int tls_connect_and_communicate(const std::string& host, int port,
-                                       const std::string& request, std::string& response) {
-    // TCP接続
-    struct addrinfo hints, *result;
-    memset(&hints, 0, sizeof(hints));
-    hints.ai_family = AF_INET;
-    hints.ai_socktype = SOCK_STREAM;
-
-    std::string port_str = std::to_string(port);
-    if (getaddrinfo(host.c_str(), port_str.c_str(), &hints, &result) != 0) {
-        return -1;  // DNS解決失敗
+// ステータスラインとヘッダー部を解析し、ボディの終端の判定方法を決める
+static int client_parse_head(CmHttpCall* call, size_t head_len) {
+    CmHttpResponse* resp = parse_response(call->in.substr(0, head_len));
+    if (resp->is_error || call->in.compare(0, 5, "HTTP/") != 0) {
+        delete resp;
+        return CLIENT_ERR_INVALID;
+    }
+    delete call->response;
+    call->response = resp;
+
+    std::string_view length, encoding, connection;
+    for (const auto& h : resp->headers) {
+        if (ev_iequals(h.first, "Content-Length"))
+            length = ev_trim(h.second);
+        else if (ev_iequals(h.first, "Transfer-Encoding"))
+            encoding = ev_trim(h.second);
+        else if (ev_iequals(h.first, "Connection"))
+            connection = ev_trim(h.second);
+    }
+    // HTTP/1.1は既定で持続接続、HTTP/1.0は明示された場合のみ
+    bool http10 = call->in.compare(0, 8, "HTTP/1.0") == 0;
+    call->keep_alive = call->keep_alive && (http10 ? ev_iequals(connection, "keep-alive")
+                                                   : !ev_iequals(connection, "close"));
+
+    int status = resp->status_code;
+    if ((status >= 100 && status < 200) || status == 204 || status == 304) {
+        call->framing = ClientBody::None;
+    } else if (!encoding.empty()) {
+        // chunkedが最後のコーディングでなければ、切断までがボディ
+        bool chunked = encoding.size() >= 7 &&
+                       ev_iequals(encoding.substr(encoding.size() - 7), "chunked");
+        call->framing = chunked ? ClientBody::Chunked : ClientBody::UntilClose;
+        call->chunk_step = 0;
+    } else if (!length.empty()) {
+        int64_t n = ev_parse_length(length, CLIENT_MAX_BODY_SIZE);
+        if (n < 0)
+            return n == -2 ? CLIENT_ERR_TOO_LARGE : CLIENT_ERR_INVALID;
+        call->framing = ClientBody::Length;
+        call->remaining = n;
+        resp->body.reserve(static_cast<size_t>(n));
+    } else {
+        call->framing = ClientBody::UntilClose;
     }
+    if (call->framing == ClientBody::UntilClose)
+        call->keep_alive = false;
+    return 0;
+}
 
-    int fd = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
-    if (fd < 0) {
-        freeaddrinfo(result);
-        return -2;  // ソケット作成失敗
+// チャンク形式のボディを復号する（1=完了, 0=データ不足, 負=エラーコード）
+static int client_parse_chunks(CmHttpCall* call) {
+    std::string& in = call->in;
+    std::string& body = call->response->body;
+    size_t pos = 0;
+    int result = 0;
+    while (result == 0) {
+        if (call->chunk_step == 1) {
+            size_t take = std::min(in.size() - pos, static_cast<size_t>(call->remaining));
+            body.append(in, pos, take);
+            pos += take;
+            call->remaining -= static_cast<int64_t>(take);
+            if (call->remaining > 0)
+                break;
+            call->chunk_step = 2;
+            continue;
+        }
+        size_t end = in.find("\r\n", pos);
+        if (end == std::string::npos) {
+            if (in.size() - pos > CLIENT_MAX_HEAD_SIZE)
+                result = CLIENT_ERR_INVALID;
+            break;
+        }
+        std::string_view line(in.data() + pos, end - pos);
+        pos = end + 2;
+        if (call->chunk_step == 0) {
+            // サイズ行（チャンク拡張は無視する）
+            int64_t size = client_parse_hex(ev_trim(line.substr(0, line.find(';'))));
+            if (size < 0)
+                result = CLIENT_ERR_INVALID;
+            else if (static_cast<int64_t>(body.size()) + size > CLIENT_MAX_BODY_SIZE)
+                result = CLIENT_ERR_TOO_LARGE;
+            call->remaining = size;
+            call->chunk_step = size == 0 ? 3 : 1;
+        } else if (call->chunk_step == 2) {
+            // データ直後の改行
+            if (!line.empty())
+                result = CLIENT_ERR_INVALID;
+            call->chunk_step = 0;
+        } else if (line.empty()) {
+            // トレーラは読み飛ばし、空行で終了
+            result = 1;
+        }
     }
+    in.erase(0, pos);
+    return result;
+}
 
-    if (connect(fd, result->ai_addr, result->ai_addrlen) < 0) {
-        close(fd);
-        freeaddrinfo(result);
-        return -3;  // 接続拒否
+// 受信済みデータを解析する（1=レスポンス完了, 0=データ不足, 負=エラーコード）
+static int client_parse(CmHttpCall* call) {
+    while (call->state == ClientState::RecvHead) {
+        const void* hit = memmem(call->in.data(), call->in.size(), "\r\n\r\n", 4);
+        if (!hit)
+            return call->in.size() > CLIENT_MAX_HEAD_SIZE ? CLIENT_ERR_TOO_LARGE : 0;
+        size_t head_len = static_cast<size_t>(static_cast<const char*>(hit) - call->in.data()) + 4;
+        int r = client_parse_head(call, head_len);
+        if (r < 0)
+            return r;
+        call->in.erase(0, head_len);
+        // 1xxは中間レスポンスなので読み捨てて次のヘッダーを待つ
+        int status = call->response->status_code;
+        if (status < 100 || status >= 200)
+            call->state = ClientState::RecvBody;
     }
-    freeaddrinfo(result);
 
-    // SSL コンテキスト取得
-    SSL_CTX* ctx = get_ssl_context();
-    if (!ctx) {
-        close(fd);
-        return -5;  // SSL初期化失敗
+    CmHttpResponse* resp = call->response;
+    switch (call->framing) {
+        case ClientBody::None:
+            return 1;
+        case ClientBody::Length: {
+            size_t take = std::min(call->in.size(), static_cast<size_t>(call->remaining));
+            resp->body.append(call->in, 0, take);
+            call->in.erase(0, take);
+            call->remaining -= static_cast<int64_t>(take);
+            return call->remaining == 0 ? 1 : 0;
+        }
+        case ClientBody::Chunked:
+            return client_parse_chunks(call);
+        case ClientBody::UntilClose:
+            resp->body += call->in;
+            call->in.clear();
+            return static_cast<int64_t>(resp->body.size()) > CLIENT_MAX_BODY_SIZE
+                       ? CLIENT_ERR_TOO_LARGE
+                       : 0;
     }
+    return CLIENT_ERR_INVALID;
+}
 
-    // SSL接続作成
-    SSL* ssl = SSL_new(ctx);
-    if (!ssl) {
-        close(fd);
-        return -5;
+// 進められるところまで進める（完了したらtrue、待機が必要ならfalse）
+static bool client_step(CmHttpCall* call) {
+    while (true) {
+        switch (call->state) {
+            case ClientState::Connect: {
+                struct pollfd p = {call->conn->fd, POLLOUT, 0};
+                if (poll(&p, 1, 0) <= 0) {
+                    call->want_write = true;
+                    return false;
+                }
+                int err = 0;
+                socklen_t len = sizeof(err);
+                getsockopt(call->conn->fd, SOL_SOCKET, SO_ERROR, &err, &len);
+                if (err != 0) {
+                    client_forget_host(call->host);
+                    client_fail(call, CLIENT_ERR_CONNECT);
+                    return true;
+                }
+                call->state = call->tls ? ClientState::Handshake : ClientState::Send;
+                break;
+            }
+            case ClientState::Handshake: {
+#ifdef CM_HAS_OPENSSL
+                ERR_clear_error();
+                int r = SSL_connect(call->conn->ssl);
+                if (r <= 0) {
+                    if (client_tls_status(call, r) == -1)
+                        return false;
+                    client_fail(call, CLIENT_ERR_TLS_HANDSHAKE);
+                    return true;
+                }
+                if (SSL_session_reused(call->conn->ssl))
+                    client_tls_resumptions.fetch_add(1, std::memory_order_relaxed);
+#endif
+                call->state = ClientState::Send;
+                break;
+            }
+            case ClientState::Send: {
+                ssize_t n = client_send(call, call->request.data() + call->sent,
+                                        call->request.size() - call->sent);
+                if (n == -1)
+                    return false;
+                if (n < 0) {
+                    if (!client_retry(call))
+                        client_fail(call, CLIENT_ERR_SEND);
+                    break;
+                }
+                call->sent += static_cast<size_t>(n);
+                if (call->sent == call->request.size())
+                    call->state = ClientState::RecvHead;
+                break;
+            }
+            case ClientState::RecvHead:
+            case ClientState::RecvBody: {
+                int r = client_parse(call);
+                if (r < 0) {
+                    client_fail(call, r);
+                    return true;
+                }
+                if (r > 0) {
+                    client_finish(call);
+                    return true;
+                }
+                ssize_t n = client_read_more(call);
+                if (n == -1)
+                    return false;
+                if (n > 0)
+                    break;
+                if (n == 0 && call->framing == ClientBody::UntilClose &&
+                    call->state == ClientState::RecvBody) {
+                    client_finish(call);
+                    return true;
+                }
+                // 1バイトも届かないまま閉じられた
+                bool nothing = call->state == ClientState::RecvHead && call->in.empty();
+                if (!(nothing && client_retry(call)))
+                    client_fail(call, nothing ? CLIENT_ERR_EMPTY : CLIENT_ERR_CLOSED);
+                break;
+            }
+            case ClientState::Done:
+                return true;
+        }
     }
+}
 
-    // SNI (Server Name Indication) 設定
-    SSL_set_tlsext_host_name(ssl, host.c_str());
-    SSL_set_fd(ssl, fd);
+// リクエストを開始する（接続の確立まで進むとは限らない）
+static CmHttpCall* client_start(const CmHttpRequest* req) {
+    auto* call = new CmHttpCall();
+    call->host = req->host;
+    call->port = req->port;
+#ifdef CM_HAS_OPENSSL
+    call->tls = req->port == 443;
+#endif
+    call->idempotent = req->method != HTTP_POST && req->method != HTTP_PATCH;
+    call->key = (call->tls ? "tls:" : "") + req->host + ":" + std::to_string(req->port);
+
+    bool keep_alive = client_pool_size.load(std::memory_order_relaxed) > 0;
+    auto conn_header = req->headers.find("Connection");
+    if (conn_header != req->headers.end() && ev_iequals(conn_header->second, "close"))
+        keep_alive = false;
+    call->keep_alive = keep_alive;
+    call->request = build_request(req, keep_alive);
+    if (req->timeout_ms > 0)
+        call->deadline_ms = client_now_ms() + static_cast<uint64_t>(req->timeout_ms);
+
+    client_open(call);
+    return call;
+}
 
-    // TLSハンドシェイク
-    if (SSL_connect(ssl) <= 0) {
-        SSL_free(ssl);
-        close(fd);
-        return -6;  // TLSハンドシェイク失敗
-    }
+// 期限を過ぎていたらタイムアウトで終わらせる
+static bool client_expired(CmHttpCall* call) {
+    if (call->state == ClientState::Done || call->deadline_ms == 0 ||
+        client_now_ms() < call->deadline_ms)
+        return false;
+    client_fail(call, CLIENT_ERR_TIMEOUT);
+    return true;
+}
 
-    // リクエスト送信
-    const char* data = request.c_str();
-    int total = static_cast<int>(request.size());
-    int sent = 0;
-    while (sent < total) {
-        int n = SSL_write(ssl, data + sent, total - sent);
-        if (n <= 0) {
-            SSL_shutdown(ssl);
-            SSL_free(ssl);
-            close(fd);
-            return -4;  // 送信失敗
-        }
-        sent += n;
+// 完了するまでpoll()で待機しながら進める
+static void client_run(CmHttpCall* call) {
+    while (!client_step(call)) {
+        if (client_expired(call))
+            return;
+        int timeout = -1;
+        if (call->deadline_ms != 0)
+            timeout = static_cast<int>(call->deadline_ms - client_now_ms());
+        struct pollfd p = {call->conn->fd, static_cast<short>(call->want_write ? POLLOUT : POLLIN),
+                           0};
+        poll(&p, 1, timeout);
     }
+}
 
-    // レスポンス受信
-    char buf[4096];
-    response.clear();
-    while (true) {
-        int n = SSL_read(ssl, buf, sizeof(buf) - 1);
-        if (n <= 0)
+// 失敗した呼び出しのエラーレスポンスを作る
+static CmHttpResponse* client_error_response(const CmHttpCall* call) {
+    auto* resp = new CmHttpResponse();
+    resp->is_error = true;
+    resp->status_code = -1;
+    std::string target = call->host + ":" + std::to_string(call->port);
+    switch (call->error) {
+        case CLIENT_ERR_DNS:
+            resp->error_message = "DNS resolution failed for host: " + call->host;
             break;
-        buf[n] = '\0';
-        response.append(buf, n);
-        if (response.size() > 65536)
+        case CLIENT_ERR_SOCKET:
+            resp->error_message = "Socket creation failed";
+            break;
+        case CLIENT_ERR_CONNECT:
+            resp->error_message = "Connection refused: " + target;
+            break;
+        case CLIENT_ERR_SEND:
+            resp->error_message = "Failed to send request";
+            break;
+        case CLIENT_ERR_TLS_INIT:
+            resp->error_message = "TLS initialization failed";
+            break;
+        case CLIENT_ERR_TLS_HANDSHAKE:
+            resp->error_message = "TLS handshake failed: " + target;
+            break;
+        case CLIENT_ERR_EMPTY:
+            resp->error_message = "Empty response from server";
+            break;
+        case CLIENT_ERR_CLOSED:
+            resp->error_message = "Connection closed before response completed: " + target;
+            break;
+        case CLIENT_ERR_INVALID:
+            resp->error_message = "Invalid HTTP response";
+            break;
+        case CLIENT_ERR_TOO_LARGE:
+            resp->error_message = "HTTP response too large";
+            break;
+        case CLIENT_ERR_TIMEOUT:
+            resp->error_message = "Request timed out: " + target;
+            break;
+        default:
+            resp->error_message = "Unknown network error";
             break;
     }
-
-    // クリーンアップ
-    SSL_shutdown(ssl);
-    SSL_free(ssl);
-    close(fd);
-    return 0;
+    return resp;
 }
 
-#endif  // CM_HAS_OPENSSL
-
-extern "C" {
+// 完了した呼び出しからレスポンスを取り出して呼び出しを破棄する
+static CmHttpResponse* client_take_response(CmHttpCall* call) {
+    CmHttpResponse* resp = call->error != 0 ? client_error_response(call) : call->response;
+    call->response = nullptr;
+    // 完了前に破棄する接続は途中までしか読んでいないのでプールへ戻さない
+    if (call->conn)
+        client_conn_close(call->conn);
+    delete call;
+    return resp;
+}
 
 // ============================================================
 // HTTPリクエスト API
@@ -438,64 +1840,10 @@ int64_t cm_http_execute(int64_t req_handle) {
         return reinterpret_cast<int64_t>(resp);
     }
 
-    // リクエスト文字列を構築
-    std::string request_str = build_request(req);
-
-    // 通信（ポート443の場合はTLS、それ以外はTCP）
-    std::string raw_response;
-    int err;
-#ifdef CM_HAS_OPENSSL
-    if (req->port == 443) {
-        err = tls_connect_and_communicate(req->host, req->port, request_str, raw_response);
-    } else {
-        err = tcp_connect_and_communicate(req->host, req->port, request_str, raw_response);
-    }
-#else
-    err = tcp_connect_and_communicate(req->host, req->port, request_str, raw_response);
-#endif
-    if (err != 0) {
-        auto* resp = new CmHttpResponse();
-        resp->is_error = true;
-        resp->status_code = -1;
-        switch (err) {
-            case -1:
-                resp->error_message = "DNS resolution failed for host: " + req->host;
-                break;
-            case -2:
-                resp->error_message = "Socket creation failed";
-                break;
-            case -3:
-                resp->error_message =
-                    "Connection refused: " + req->host + ":" + std::to_string(req->port);
-                break;
-            case -4:
-                resp->error_message = "Failed to send request";
-                break;
-            case -5:
-                resp->error_message = "TLS initialization failed";
-                break;
-            case -6:
-                resp->error_message =
-                    "TLS handshake failed: " + req->host + ":" + std::to_string(req->port);
-                break;
-            default:
-                resp->error_message = "Unknown network error";
-                break;
-        }
-        return reinterpret_cast<int64_t>(resp);
-    }
-
-    if (raw_response.empty()) {
-        auto* resp = new CmHttpResponse();
-        resp->is_error = true;
-        resp->error_message = "Empty response from server";
-        resp->status_code = -1;
-        return reinterpret_cast<int64_t>(resp);
-    }
-
-    // レスポンスパース
-    CmHttpResponse* resp = parse_response(raw_response);
-    return reinterpret_cast<int64_t>(resp);
+    // 接続先のプールから接続を借りて送受信（ポート443の場合はTLS）
+    CmHttpCall* call = client_start(req);
+    client_run(call);
+    return reinterpret_cast<int64_t>(client_take_response(call));
 }
 
 // ============================================================
@@ -599,6 +1947,145 @@ int64_t cm_http_delete(const char* host, int32_t port, const char* path) {
     return resp;
 }
 
+// ============================================================
+// 非同期リクエスト API（イベントループ連携）
+// ============================================================
+// cm_http_execute_asyncで開始し、cm_http_call_pollが1を返すまで進める。
+// 0（未完了）の間は、cm_http_call_fdが読み込み可能（cm_http_call_wants_writeが1なら
+// 書き込み可能）になるのを待ってから再びpollする。std::core::asyncのタスクからは
+// wait_readable / wait_writable で待機できる。
+
+// リクエストを開始（リクエストハンドルは開始後に破棄してよい）
+// 戻り値: 呼び出しハンドル（0=リクエストハンドル不正）
+int64_t cm_http_execute_async(int64_t req_handle) {
+    auto* req = reinterpret_cast<CmHttpRequest*>(req_handle);
+    if (!req)
+        return 0;
+    return reinterpret_cast<int64_t>(client_start(req));
+}
+
+// GETリクエストを開始
+int64_t cm_http_get_async(const char* host, int32_t port, const char* path) {
+    int64_t req = cm_http_request_create();
+    cm_http_request_set_method(req, HTTP_GET);
+    cm_http_request_set_url(req, host, port, path);
+    int64_t call = cm_http_execute_async(req);
+    cm_http_request_destroy(req);
+    return call;
+}
+
+// POSTリクエストを開始
+int64_t cm_http_post_async(const char* host, int32_t port, const char* path, const char* body) {
+    int64_t req = cm_http_request_create();
+    cm_http_request_set_method(req, HTTP_POST);
+    cm_http_request_set_url(req, host, port, path);
+    if (body)
+        cm_http_request_set_body(req, body);
+    int64_t call = cm_http_execute_async(req);
+    cm_http_request_destroy(req);
+    return call;
+}
+
+// 進められるところまで進める（1=完了, 0=未完了）
+int32_t cm_http_call_poll(int64_t handle) {
+    auto* call = reinterpret_cast<CmHttpCall*>(handle);
+    if (!call)
+        return 1;
+    if (client_expired(call))
+        return 1;
+    return client_step(call) ? 1 : 0;
+}
+
+// 待機するファイルディスクリプタ（完了済みは-1）
+int32_t cm_http_call_fd(int64_t handle) {
+    auto* call = reinterpret_cast<CmHttpCall*>(handle);
+    if (!call || !call->conn || call->state == ClientState::Done)
+        return -1;
+    return call->conn->fd;
+}
+
+// 書き込み可能を待つべきか（0なら読み込み可能を待つ）
+int32_t cm_http_call_wants_write(int64_t handle) {
+    auto* call = reinterpret_cast<CmHttpCall*>(handle);
+    return call && call->want_write ? 1 : 0;
+}
+
+// 完了まで待ち、レスポンスハンドルを返して呼び出しハンドルを解放する
+int64_t cm_http_call_finish(int64_t handle) {
+    auto* call = reinterpret_cast<CmHttpCall*>(handle);
+    if (!call) {
+        auto* resp = new CmHttpResponse();
+        resp->is_error = true;
+        resp->error_message = "Invalid call handle";
+        resp->status_code = -1;
+        return reinterpret_cast<int64_t>(resp);
+    }
+    client_run(call);
+    return reinterpret_cast<int64_t>(client_take_response(call));
+}
+
+// 完了を待たずに呼び出しハンドルを解放する（途中の接続は閉じる）
+void cm_http_call_cancel(int64_t handle) {
+    auto* call = reinterpret_cast<CmHttpCall*>(handle);
+    if (call)
+        delete client_take_response(call);
+}
+
+// ============================================================
+// HTTPクライアント設定（コネクションプール・キャッシュ）
+// ============================================================
+
+// 接続先ごとに保持するアイドル接続数（0でkeep-aliveを使わない）
+void cm_http_client_set_pool_size(int32_t per_host) {
+    client_pool_size.store(per_host < 0 ? 0 : per_host, std::memory_order_relaxed);
+}
+
+// アイドル接続を保持する時間（ミリ秒）
+void cm_http_client_set_idle_timeout(int32_t timeout_ms) {
+    client_idle_timeout_ms.store(timeout_ms < 0 ? 0 : timeout_ms, std::memory_order_relaxed);
+}
+
+// 名前解決結果を保持する時間（ミリ秒、0でキャッシュしない）
+void cm_http_client_set_dns_ttl(int32_t ttl_ms) {
+    client_dns_ttl_ms.store(ttl_ms < 0 ? 0 : ttl_ms, std::memory_order_relaxed);
+}
+
+// アイドル接続を閉じ、DNS・TLSセッションのキャッシュと統計を消去
+void cm_http_client_reset() {
+    client_pool_clear();
+    {
+        std::lock_guard<std::mutex> lock(dns_mutex);
+        dns_cache.clear();
+    }
+#ifdef CM_HAS_OPENSSL
+    tls_clear_sessions();
+#endif
+    client_connects.store(0);
+    client_reuses.store(0);
+    client_dns_lookups.store(0);
+    client_tls_resumptions.store(0);
+}
+
+// 統計: 新しく確立した接続数
+int64_t cm_http_client_connects() {
+    return client_connects.load();
+}
+
+// 統計: プールの接続を再利用した回数
+int64_t cm_http_client_reuses() {
+    return client_reuses.load();
+}
+
+// 統計: 名前解決（getaddrinfo）を行った回数
+int64_t cm_http_client_dns_lookups() {
+    return client_dns_lookups.load();
+}
+
+// 統計: TLSセッションを再開できたハンドシェイク数
+int64_t cm_http_client_tls_resumptions() {
+    return client_tls_resumptions.load();
+}
+
 // ============================================================
 // HTTPサーバ API（Cm側でルーティング・レスポンスを制御）
 // ============================================================
@@ -783,19 +2270,8 @@ void cm_http_server_respond(int64_t handle, int32_t status, const char* body) {
     if (!req)
         return;
 
-    // ステータステキスト
-    const char* status_text = "OK";
-    if (status == 201)
-        status_text = "Created";
-    else if (status == 400)
-        status_text = "Bad Request";
-    else if (status == 404)
-        status_text = "Not Found";
-    else if (status == 500)
-        status_text = "Internal Server Error";
-
     std::string response;
-    response += "HTTP/1.1 " + std::to_string(status) + " " + status_text + "\r\n";
+    response += "HTTP/1.1 " + std::to_string(status) + " " + http_status_text(status) + "\r\n";
     response += "Content-Type: application/json\r\n";
     std::string body_str = body ? body : "";
     response += "Content-Length: " + std::to_string(body_str.size()) + "\r\n";
@@ -826,6 +2302,151 @@ void cm_http_server_req_destroy(int64_t handle) {
     }
 }
 
+// ============================================================
+// イベント駆動HTTPサーバ API（keep-alive / パイプライン / マルチワーカー）
+// ============================================================
+
+// サーバソケットを作成（非ブロッキング、bind+listen）
+// workers: ワーカースレッド数（1未満は1）
+// 戻り値: サーバハンドル（失敗時 -1=ソケット作成, -2=bind, -3=listen）
+int64_t cm_http_evserver_create(int32_t port, int32_t workers) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+
+    int opt = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = INADDR_ANY;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -2;
+    }
+
+    if (listen(fd, SOMAXCONN) < 0) {
+        close(fd);
+        return -3;
+    }
+
+    auto* srv = new EvServer();
+    if (pipe(srv->wake_fds) < 0) {
+        close(fd);
+        delete srv;
+        return -1;
+    }
+    srv->listen_fd = fd;
+    srv->workers = workers < 1 ? 1 : workers;
+    return reinterpret_cast<int64_t>(srv);
+}
+
+// リクエスト処理ループを実行（呼び出したスレッドもワーカーの1つとして働く）
+// handler: void handler(long req) — ワーカースレッドから各リクエストごとに呼ばれる
+// max_requests: この件数を処理したら終了（0以下はstopまで継続）
+// 戻り値: 処理したリクエスト数（-1=ハンドル不正）
+int64_t cm_http_evserver_run(int64_t handle, void* handler, int32_t max_requests) {
+    auto* srv = reinterpret_cast<EvServer*>(handle);
+    if (!srv || handle < 0 || !handler)
+        return -1;
+    srv->handler = reinterpret_cast<void (*)(int64_t)>(handler);
+    srv->max_requests = max_requests;
+
+    std::vector<pthread_t> threads;
+    for (int i = 1; i < srv->workers; i++) {
+        pthread_t tid;
+        if (pthread_create(&tid, nullptr, ev_worker_main, srv) == 0)
+            threads.push_back(tid);
+    }
+    ev_worker_loop(srv);
+    for (pthread_t tid : threads)
+        pthread_join(tid, nullptr);
+    return srv->served.load();
+}
+
+// 処理ループに停止を要求（別スレッド・ハンドラ内から呼べる）
+void cm_http_evserver_stop(int64_t handle) {
+    auto* srv = reinterpret_cast<EvServer*>(handle);
+    if (srv && handle > 0)
+        ev_stop(srv);
+}
+
+// サーバを破棄（runから戻った後に呼ぶ）
+void cm_http_evserver_destroy(int64_t handle) {
+    auto* srv = reinterpret_cast<EvServer*>(handle);
+    if (!srv || handle < 0)
+        return;
+    close(srv->listen_fd);
+    close(srv->wake_fds[0]);
+    close(srv->wake_fds[1]);
+    delete srv;
+}
+
+// ビューをCm側へ渡す文字列にする（malloc、Cm側へ所有権移譲）
+static const char* ev_dup(std::string_view s) {
+    auto* p = static_cast<char*>(malloc(s.size() + 1));
+    if (!p)
+        return nullptr;
+    memcpy(p, s.data(), s.size());
+    p[s.size()] = '\0';
+    return p;
+}
+
+// リクエストのHTTPメソッド取得
+const char* cm_http_evreq_method(int64_t handle) {
+    auto* req = reinterpret_cast<CmHttpEvRequest*>(handle);
+    return ev_dup(req ? req->view.method : std::string_view());
+}
+
+// リクエストパス取得
+const char* cm_http_evreq_path(int64_t handle) {
+    auto* req = reinterpret_cast<CmHttpEvRequest*>(handle);
+    return ev_dup(req ? req->view.path : std::string_view());
+}
+
+// リクエストボディ取得
+const char* cm_http_evreq_body(int64_t handle) {
+    auto* req = reinterpret_cast<CmHttpEvRequest*>(handle);
+    return ev_dup(req ? req->view.body : std::string_view());
+}
+
+// ヘッダー値取得（名前の大文字小文字は区別しない、なければ空文字列）
+const char* cm_http_evreq_header(int64_t handle, const char* key) {
+    auto* req = reinterpret_cast<CmHttpEvRequest*>(handle);
+    if (!req || !key)
+        return ev_dup(std::string_view());
+    return ev_dup(ev_find_header(req->view.headers, req->view.header_count, key));
+}
+
+// メソッドとパスが一致するか（文字列を作らずにルーティングする用）
+int32_t cm_http_evreq_is(int64_t handle, const char* method, const char* path) {
+    auto* req = reinterpret_cast<CmHttpEvRequest*>(handle);
+    if (!req || !method || !path)
+        return 0;
+    return req->view.method == method && req->view.path == path ? 1 : 0;
+}
+
+// レスポンスを送信キューに積む（Content-Type指定、1リクエストにつき1回のみ有効）
+void cm_http_evreq_respond_type(int64_t handle, int32_t status, const char* content_type,
+                                const char* body) {
+    auto* req = reinterpret_cast<CmHttpEvRequest*>(handle);
+    if (!req || req->responded)
+        return;
+    req->responded = true;
+    ev_queue_response(req->conn, req->view, status,
+                      content_type ? content_type : "application/json", body ? body : "",
+                      body ? strlen(body) : 0);
+}
+
+// レスポンスを送信キューに積む（application/json）
+void cm_http_evreq_respond(int64_t handle, int32_t status, const char* body) {
+    cm_http_evreq_respond_type(handle, status, "application/json", body);
+}
+
 // ============================================================
 // テスト用ミニHTTPサーバ（レガシー: 後方互換性維持）
 // ============================================================
@@ -1009,6 +2630,58 @@ int64_t cm_http_test_server_start(int32_t port, int32_t max_requests) {
     return 0;
 }
 
+// 負荷試験: connections本の接続から合計requests件のGETを送る（keep-alive）
+// pipeline: 応答を待たずに1接続から続けて送る件数（1=パイプラインなし）
+// 戻り値: 2xxで応答されたリクエスト数（-1=ホスト解決失敗）
+int64_t cm_http_test_load(const char* host, int32_t port, const char* path, int32_t connections,
+                          int32_t requests, int32_t pipeline) {
+    if (!host || !path || connections < 1 || requests < 0)
+        return -1;
+    if (pipeline < 1)
+        pipeline = 1;
+
+    struct addrinfo hints, *result;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    std::string port_str = std::to_string(port);
+    if (getaddrinfo(host, port_str.c_str(), &hints, &result) != 0)
+        return -1;
+    struct sockaddr_in addr;
+    memcpy(&addr, result->ai_addr, sizeof(addr));
+    freeaddrinfo(result);
+
+    std::string request = std::string("GET ") + path + " HTTP/1.1\r\nHost: " + host + "\r\n\r\n";
+    std::string batch;
+    batch.reserve(request.size() * static_cast<size_t>(pipeline));
+    for (int i = 0; i < pipeline; i++)
+        batch += request;
+
+    std::vector<EvLoadJob> jobs(static_cast<size_t>(connections));
+    for (int i = 0; i < connections; i++) {
+        EvLoadJob& job = jobs[static_cast<size_t>(i)];
+        job.addr = addr;
+        job.batch = &batch;
+        job.request_size = request.size();
+        job.requests = requests / connections + (i < requests % connections ? 1 : 0);
+        job.pipeline = pipeline;
+    }
+
+    std::vector<pthread_t> threads(static_cast<size_t>(connections));
+    std::vector<bool> started(static_cast<size_t>(connections), false);
+    for (size_t i = 0; i < jobs.size(); i++)
+        started[i] = pthread_create(&threads[i], nullptr, ev_load_main, &jobs[i]) == 0;
+
+    int64_t ok = 0;
+    for (size_t i = 0; i < jobs.size(); i++) {
+        if (!started[i])
+            continue;
+        pthread_join(threads[i], nullptr);
+        ok += jobs[i].ok;
+    }
+    return ok;
+}
+
 // ============================================================
 // URLパース
 // ============================================================
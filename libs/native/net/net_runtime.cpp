@@ -1,7 +1,8 @@
 // net_runtime.cpp - Cm ネットワーク stdバッキング実装
-// POSIXソケットAPI + kqueue(macOS)/poll(Linux) ベースの非同期I/O
+// POSIXソケットAPI + kqueue(macOS)/epoll・io_uring・poll(Linux) ベースの非同期I/O
 
 #include <arpa/inet.h>
+#include <cerrno>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
@@ -12,36 +13,477 @@
 #include <netinet/tcp.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>  // readv/writev
 #include <unistd.h>
 
 // プラットフォーム固有のイベント多重化
 #ifdef __APPLE__
 #include <sys/event.h>  // kqueue
 #else
-#include <poll.h>  // poll
+#include <poll.h>          // poll
+#include <sys/epoll.h>     // epoll
+#include <sys/sendfile.h>  // sendfile
+#if __has_include(<linux/io_uring.h>)
+// io_uring（liburingには依存せず、システムコールを直接呼ぶ）
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define CM_HAVE_IO_URING 1
+#endif
+#endif
+
+// イベントタイプ定数（Cm側と共有）
+// ビットフラグ: 1=読み取り可能, 2=書き込み可能, 4=エラー/切断
+static const int CM_POLL_READ = 1;
+static const int CM_POLL_WRITE = 2;
+static const int CM_POLL_ERROR = 4;
+static const int CM_POLL_HUP = 8;
+// 登録時のみ有効: エッジトリガ（状態が変化したときだけ通知する）
+// epoll: EPOLLET, kqueue: EV_CLEAR, io_uring: マルチショットpoll。poll()では無視する
+static const int CM_POLL_EDGE = 16;
+
+// バックエンド（cm_tcp_poll_create_backendの引数、Cm側と共有）
+// 使えないバックエンドを指定した場合はプラットフォーム既定に切り替える
+static const int CM_POLL_BACKEND_AUTO = 0;  // 既定（macOS: kqueue, Linux: epoll）
+static const int CM_POLL_BACKEND_POLL = 1;
+static const int CM_POLL_BACKEND_EPOLL = 2;
+static const int CM_POLL_BACKEND_IO_URING = 3;
+static const int CM_POLL_BACKEND_KQUEUE = 4;
+
+#ifdef CM_HAVE_IO_URING
+struct CmUring;
 #endif
 
 // イベントループ内部構造
 struct CmPollHandle {
+    int backend;      // 実際に使っているバックエンド（CM_POLL_BACKEND_*）
+    int event_count;  // 最後のwaitで取得したイベント数
 #ifdef __APPLE__
     int kq;                 // kqueueファイルディスクリプタ
     struct kevent* events;  // イベント結果配列
-    int event_count;        // 最後のwaitで取得したイベント数
     int max_events;         // イベント配列サイズ
 #else
+    // poll
     struct pollfd* fds;  // pollfd配列
     int fd_count;        // 登録済みFD数
     int max_fds;         // 配列サイズ
-    int event_count;     // 最後のwaitで取得したイベント数
+    int* ready;          // 最後のwaitでreventsが立ったfdsの添字（event_count個）
+
+    // epoll
+    int epfd;                    // epollファイルディスクリプタ
+    struct epoll_event* events;  // イベント結果配列
+    int max_events;              // イベント配列サイズ
+
+#ifdef CM_HAVE_IO_URING
+    CmUring* ring;
+#endif
 #endif
 };
 
-// イベントタイプ定数（Cm側と共有）
-// ビットフラグ: 1=読み取り可能, 2=書き込み可能, 4=エラー/切断
-static const int CM_POLL_READ = 1;
-static const int CM_POLL_WRITE = 2;
-static const int CM_POLL_ERROR = 4;
-static const int CM_POLL_HUP = 8;
+#if !defined(__APPLE__)
+
+// epollの結果配列の初期サイズと上限
+// 1回のwaitで配列が埋まったら倍にする（大量の接続でもwait回数が増えすぎないように）
+static const int kEpollInitialEvents = 64;
+static const int kEpollMaxEvents = 4096;
+
+static uint32_t to_epoll_events(int events) {
+    uint32_t ev = EPOLLRDHUP;
+    if (events & CM_POLL_READ)
+        ev |= EPOLLIN;
+    if (events & CM_POLL_WRITE)
+        ev |= EPOLLOUT;
+    if (events & CM_POLL_EDGE)
+        ev |= EPOLLET;
+    return ev;
+}
+
+// poll系のビット（POLLIN等とEPOLLIN等は同じ値）をCmのフラグに変換
+static int from_poll_bits(uint32_t revents) {
+    int result = 0;
+    if (revents & POLLIN)
+        result |= CM_POLL_READ;
+    if (revents & POLLOUT)
+        result |= CM_POLL_WRITE;
+    if (revents & (POLLERR | POLLNVAL))
+        result |= CM_POLL_ERROR;
+    if (revents & (POLLHUP | POLLRDHUP))
+        result |= CM_POLL_HUP;
+    return result;
+}
+
+#ifdef CM_HAVE_IO_URING
+
+// ============================================================
+// io_uringバックエンド
+// FDごとにIORING_OP_POLL_ADDを投入し、完了キューからイベントを取り出す。
+// レベルトリガはワンショットpollを次のwaitで掛け直し、エッジトリガはマルチショットpollを使う。
+// 削除・再登録したFDの古い完了は、user_dataに埋め込んだ登録世代で読み捨てる。
+// ============================================================
+
+static const unsigned kUringEntries = 1024;
+
+// 完了を変換したイベント
+struct CmUringEvent {
+    int fd;
+    int events;    // CM_POLL_*
+    uint32_t gen;  // 完了したpollの登録世代
+    bool rearm;    // 次のwaitで掛け直す（ワンショットが完了した）
+};
+
+struct CmUring {
+    int fd;
+
+    // 投入キュー（カーネルと共有）
+    unsigned* sq_head;
+    unsigned* sq_tail;
+    unsigned sq_mask;
+    unsigned sq_entries;
+    unsigned* sq_array;
+    struct io_uring_sqe* sqes;
+
+    // 完了キュー（カーネルと共有）
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned cq_mask;
+    struct io_uring_cqe* cqes;
+
+    void* ring_ptr;
+    size_t ring_size;
+    size_t sqes_size;
+
+    // FDごとの登録状態（添字=FD）
+    uint32_t* gen;  // 登録世代（0=未登録）
+    int* mask;      // 登録イベント（CM_POLL_*）
+    int fd_cap;
+    uint32_t next_gen;
+
+    CmUringEvent* results;  // 最後のwaitで取り出したイベント
+    int max_results;
+};
+
+static uint64_t uring_user_data(int fd, uint32_t gen) {
+    return (static_cast<uint64_t>(gen) << 32) | static_cast<uint32_t>(fd);
+}
+
+static void uring_destroy(CmUring* r) {
+    if (!r)
+        return;
+    if (r->sqes)
+        munmap(r->sqes, r->sqes_size);
+    if (r->ring_ptr)
+        munmap(r->ring_ptr, r->ring_size);
+    if (r->fd >= 0)
+        close(r->fd);
+    free(r->gen);
+    free(r->mask);
+    free(r->results);
+    free(r);
+}
+
+// リングを作成（カーネルが対応していなければnullptr）
+static CmUring* uring_create() {
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    int fd = static_cast<int>(syscall(__NR_io_uring_setup, kUringEntries, &p));
+    if (fd < 0)
+        return nullptr;
+
+    // 単一mmap・完了の取りこぼしなし・waitのタイムアウト引数・マルチショットpoll（5.13以降）
+    const unsigned required =
+        IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG | IORING_FEAT_RSRC_TAGS;
+    if ((p.features & required) != required) {
+        close(fd);
+        return nullptr;
+    }
+
+    auto* r = static_cast<CmUring*>(calloc(1, sizeof(CmUring)));
+    if (!r) {
+        close(fd);
+        return nullptr;
+    }
+    r->fd = fd;
+
+    size_t sq_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    size_t cq_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    r->ring_size = sq_size > cq_size ? sq_size : cq_size;
+    void* ring = mmap(nullptr, r->ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                      IORING_OFF_SQ_RING);
+    if (ring == MAP_FAILED) {
+        uring_destroy(r);
+        return nullptr;
+    }
+    r->ring_ptr = ring;
+
+    r->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    void* sqes = mmap(nullptr, r->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                      IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        uring_destroy(r);
+        return nullptr;
+    }
+    r->sqes = static_cast<struct io_uring_sqe*>(sqes);
+
+    auto* base = static_cast<char*>(ring);
+    r->sq_head = reinterpret_cast<unsigned*>(base + p.sq_off.head);
+    r->sq_tail = reinterpret_cast<unsigned*>(base + p.sq_off.tail);
+    r->sq_mask = *reinterpret_cast<unsigned*>(base + p.sq_off.ring_mask);
+    r->sq_entries = p.sq_entries;
+    r->sq_array = reinterpret_cast<unsigned*>(base + p.sq_off.array);
+    r->cq_head = reinterpret_cast<unsigned*>(base + p.cq_off.head);
+    r->cq_tail = reinterpret_cast<unsigned*>(base + p.cq_off.tail);
+    r->cq_mask = *reinterpret_cast<unsigned*>(base + p.cq_off.ring_mask);
+    r->cqes = reinterpret_cast<struct io_uring_cqe*>(base + p.cq_off.cqes);
+
+    r->max_results = static_cast<int>(p.cq_entries);
+    r->results = static_cast<CmUringEvent*>(malloc(sizeof(CmUringEvent) * r->max_results));
+    if (!r->results) {
+        uring_destroy(r);
+        return nullptr;
+    }
+    r->next_gen = 1;
+    return r;
+}
+
+// 未投入のSQEを投入し、min_complete > 0なら完了を待つ
+// 戻り値: 0=成功（タイムアウト含む）, -1=エラー
+static int uring_enter(CmUring* r, unsigned min_complete, int timeout_ms) {
+    unsigned to_submit = *r->sq_tail - __atomic_load_n(r->sq_head, __ATOMIC_ACQUIRE);
+    unsigned flags = 0;
+    struct __kernel_timespec ts;
+    struct io_uring_getevents_arg arg;
+    void* argp = nullptr;
+    size_t argsz = 0;
+    if (min_complete > 0) {
+        flags |= IORING_ENTER_GETEVENTS;
+        if (timeout_ms >= 0) {
+            ts.tv_sec = timeout_ms / 1000;
+            ts.tv_nsec = (timeout_ms % 1000) * 1000000L;
+            memset(&arg, 0, sizeof(arg));
+            arg.ts = reinterpret_cast<uint64_t>(&ts);
+            flags |= IORING_ENTER_EXT_ARG;
+            argp = &arg;
+            argsz = sizeof(arg);
+        }
+    }
+    if (to_submit == 0 && min_complete == 0)
+        return 0;
+    if (syscall(__NR_io_uring_enter, r->fd, to_submit, min_complete, flags, argp, argsz) < 0) {
+        return errno == ETIME ? 0 : -1;
+    }
+    return 0;
+}
+
+// SQEを1つ確保して投入キューに積む（満杯ならいったん投入する）
+static struct io_uring_sqe* uring_push(CmUring* r) {
+    unsigned tail = *r->sq_tail;
+    if (tail - __atomic_load_n(r->sq_head, __ATOMIC_ACQUIRE) >= r->sq_entries) {
+        if (uring_enter(r, 0, 0) < 0)
+            return nullptr;
+        if (tail - __atomic_load_n(r->sq_head, __ATOMIC_ACQUIRE) >= r->sq_entries)
+            return nullptr;
+    }
+    unsigned index = tail & r->sq_mask;
+    struct io_uring_sqe* sqe = &r->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    r->sq_array[index] = index;
+    __atomic_store_n(r->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    return sqe;
+}
+
+// 登録中のFDにpollを掛ける
+static int uring_arm(CmUring* r, int fd) {
+    struct io_uring_sqe* sqe = uring_push(r);
+    if (!sqe)
+        return -1;
+    int events = r->mask[fd];
+    uint32_t poll_mask = POLLRDHUP;
+    if (events & CM_POLL_READ)
+        poll_mask |= POLLIN;
+    if (events & CM_POLL_WRITE)
+        poll_mask |= POLLOUT;
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    // poll32_eventsはリトルエンディアンの16bit単位で解釈される
+    poll_mask = (poll_mask << 16) | (poll_mask >> 16);
+#endif
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->poll32_events = poll_mask;
+    sqe->len = (events & CM_POLL_EDGE) ? IORING_POLL_ADD_MULTI : 0;
+    sqe->user_data = uring_user_data(fd, r->gen[fd]);
+    return 0;
+}
+
+// 登録中のFDのpollを取り消す（取り消されたpollの完了は世代で読み捨てる）
+static void uring_cancel(CmUring* r, int fd) {
+    struct io_uring_sqe* sqe = uring_push(r);
+    if (!sqe)
+        return;
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->addr = uring_user_data(fd, r->gen[fd]);
+    sqe->user_data = 0;  // 取り消し自体の完了は無視する
+}
+
+static int uring_add(CmUring* r, int fd, int events) {
+    if (fd < 0)
+        return -1;
+    if (fd >= r->fd_cap) {
+        int new_cap = r->fd_cap ? r->fd_cap : 64;
+        while (new_cap <= fd)
+            new_cap *= 2;
+        auto* new_gen = static_cast<uint32_t*>(realloc(r->gen, sizeof(uint32_t) * new_cap));
+        if (!new_gen)
+            return -1;
+        r->gen = new_gen;
+        auto* new_mask = static_cast<int*>(realloc(r->mask, sizeof(int) * new_cap));
+        if (!new_mask)
+            return -1;
+        r->mask = new_mask;
+        memset(r->gen + r->fd_cap, 0, sizeof(uint32_t) * (new_cap - r->fd_cap));
+        memset(r->mask + r->fd_cap, 0, sizeof(int) * (new_cap - r->fd_cap));
+        r->fd_cap = new_cap;
+    }
+    // 登録済みなら取り消してから新しいイベントで掛け直す
+    if (r->gen[fd] != 0)
+        uring_cancel(r, fd);
+    r->gen[fd] = r->next_gen++;
+    if (r->next_gen == 0)
+        r->next_gen = 1;
+    r->mask[fd] = events;
+    return uring_arm(r, fd);
+}
+
+static void uring_remove(CmUring* r, int fd) {
+    if (fd < 0 || fd >= r->fd_cap || r->gen[fd] == 0)
+        return;
+    uring_cancel(r, fd);
+    r->gen[fd] = 0;
+}
+
+// 完了を待ってイベントを取り出す
+// 戻り値: 取り出したイベント数（0=タイムアウト、-1=エラー）
+static int uring_wait(CmUring* r, int prev_count, int timeout_ms) {
+    // レベルトリガ: 前回通知したFDのpollを掛け直す（まだ準備できていればすぐ完了する）
+    for (int i = 0; i < prev_count; i++) {
+        const CmUringEvent& ev = r->results[i];
+        if (ev.rearm && ev.fd < r->fd_cap && r->gen[ev.fd] == ev.gen)
+            uring_arm(r, ev.fd);
+    }
+
+    unsigned head = *r->cq_head;
+    if (head == __atomic_load_n(r->cq_tail, __ATOMIC_ACQUIRE)) {
+        if (uring_enter(r, 1, timeout_ms) < 0)
+            return -1;
+    } else if (uring_enter(r, 0, 0) < 0) {
+        return -1;
+    }
+
+    int n = 0;
+    unsigned tail = __atomic_load_n(r->cq_tail, __ATOMIC_ACQUIRE);
+    while (head != tail && n < r->max_results) {
+        const struct io_uring_cqe* cqe = &r->cqes[head & r->cq_mask];
+        head++;
+        if (cqe->user_data == 0)
+            continue;
+        int fd = static_cast<int>(cqe->user_data & 0xffffffffu);
+        auto gen = static_cast<uint32_t>(cqe->user_data >> 32);
+        // 削除・再登録済みの古いpoll
+        if (fd >= r->fd_cap || r->gen[fd] != gen)
+            continue;
+        CmUringEvent& ev = r->results[n++];
+        ev.fd = fd;
+        ev.gen = gen;
+        if (cqe->res < 0) {
+            ev.events = CM_POLL_ERROR;
+            ev.rearm = false;
+        } else {
+            ev.events = from_poll_bits(static_cast<uint32_t>(cqe->res));
+            // マルチショットは続く限り掛け直さない
+            ev.rearm = !(cqe->flags & IORING_CQE_F_MORE);
+        }
+    }
+    __atomic_store_n(r->cq_head, head, __ATOMIC_RELEASE);
+    return n;
+}
+
+#endif  // CM_HAVE_IO_URING
+
+#endif  // !__APPLE__
+
+// バルクバッファ
+// 先頭をランタイムのスライス構造体（runtime_slice.cのCmSlice）と同じレイアウトにしてあり、
+// ハンドルをそのままutiny[]としてCm側に渡せる（要素アクセスでコピーも外部呼び出しの往復もしない）。
+// dataはmallocで確保するので、ビュー側でpush等の伸長操作をしてはならない。
+struct CmBulkBuf {
+    uint8_t* data;      // CmSlice::data
+    int64_t len;        // CmSlice::len（有効バイト数）
+    int64_t cap;        // CmSlice::cap
+    int64_t elem_size;  // CmSlice::elem_size（常に1）
+};
+
+// スキャッタ・ギャザーI/O用の要素リスト
+// 各要素はバルクバッファの範囲（size < 0は、読み込みなら容量まで・書き込みなら有効長まで）。
+// UDPのバッチ送受信では1要素が1データグラムになる。
+struct CmIoList {
+    CmBulkBuf** bufs;
+    int64_t* offsets;
+    int64_t* sizes;
+    int32_t* results;     // 直近の操作で各要素が転送したバイト数
+    struct iovec* iov;    // システムコールに渡す作業領域
+    int count;
+    int max;
+};
+
+// 要素の範囲をiovecに展開（for_read: 空き領域まで含める）
+static void io_list_fill(CmIoList* list, bool for_read) {
+    for (int i = 0; i < list->count; i++) {
+        CmBulkBuf* buf = list->bufs[i];
+        int64_t offset = list->offsets[i];
+        int64_t end = for_read ? buf->cap : buf->len;
+        int64_t size = list->sizes[i] < 0 ? end - offset : list->sizes[i];
+        if (offset < 0 || offset > buf->cap)
+            offset = buf->cap;
+        if (size < 0 || offset + size > buf->cap)
+            size = buf->cap - offset;
+        list->iov[i].iov_base = buf->data + offset;
+        list->iov[i].iov_len = static_cast<size_t>(size);
+        list->results[i] = 0;
+    }
+}
+
+// 読み込んだバイトを各要素の転送量と有効長に反映
+static void io_list_commit_read(CmIoList* list, int i, size_t n) {
+    CmBulkBuf* buf = list->bufs[i];
+    list->results[i] = static_cast<int32_t>(n);
+    int64_t end = (static_cast<uint8_t*>(list->iov[i].iov_base) - buf->data) +
+                  static_cast<int64_t>(n);
+    if (end > buf->len)
+        buf->len = end;
+}
+
+// 送信先アドレスを解決（IPアドレス文字列またはホスト名）
+// 戻り値: 0=成功, -1=失敗
+static int resolve_udp_addr(const char* host, int32_t port, struct sockaddr_in* dest_addr) {
+    memset(dest_addr, 0, sizeof(*dest_addr));
+    dest_addr->sin_family = AF_INET;
+    dest_addr->sin_port = htons(static_cast<uint16_t>(port));
+
+    // IPアドレスまたはホスト名で解決
+    if (inet_pton(AF_INET, host, &dest_addr->sin_addr) <= 0) {
+        // ホスト名の場合はDNS解決
+        struct addrinfo hints, *result;
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_DGRAM;
+        if (getaddrinfo(host, nullptr, &hints, &result) != 0) {
+            return -1;
+        }
+        memcpy(&dest_addr->sin_addr, &((struct sockaddr_in*)result->ai_addr)->sin_addr,
+               sizeof(struct in_addr));
+        freeaddrinfo(result);
+    }
+    return 0;
+}
 
 extern "C" {
 
@@ -194,6 +636,382 @@ void cm_buf_destroy(int64_t buf_handle) {
     free(buf);
 }
 
+// ============================================================
+// バルクバッファ（ゼロコピー）
+// cm_buf_*は1バイトごとに外部呼び出しになるため、まとまったデータはこちらを使う。
+// cm_bulk_viewのスライスはバッファと同じ領域を指し、読み込み結果がそのまま見える。
+// ============================================================
+
+// バルクバッファ作成（有効長0）
+// 戻り値: バッファハンドル（失敗時0）
+int64_t cm_bulk_create(int32_t capacity) {
+    if (capacity < 0)
+        return 0;
+    auto* buf = static_cast<CmBulkBuf*>(malloc(sizeof(CmBulkBuf)));
+    if (!buf)
+        return 0;
+    buf->data = static_cast<uint8_t*>(malloc(capacity > 0 ? static_cast<size_t>(capacity) : 1));
+    if (!buf->data) {
+        free(buf);
+        return 0;
+    }
+    buf->len = 0;
+    buf->cap = capacity;
+    buf->elem_size = 1;
+    return reinterpret_cast<int64_t>(buf);
+}
+
+// バルクバッファ破棄（ビューもこの時点で無効になる）
+void cm_bulk_destroy(int64_t buf_handle) {
+    auto* buf = reinterpret_cast<CmBulkBuf*>(buf_handle);
+    if (!buf)
+        return;
+    free(buf->data);
+    free(buf);
+}
+
+// 有効データをutiny[]として参照（コピーしない、長さは有効長に追従する）
+void* cm_bulk_view(int64_t buf_handle) {
+    return reinterpret_cast<void*>(buf_handle);
+}
+
+// データ先頭のアドレス（cm_tcp_read等のbuf_ptrとして使える）
+int64_t cm_bulk_data(int64_t buf_handle) {
+    auto* buf = reinterpret_cast<CmBulkBuf*>(buf_handle);
+    return buf ? reinterpret_cast<int64_t>(buf->data) : 0;
+}
+
+// 有効長
+int32_t cm_bulk_len(int64_t buf_handle) {
+    auto* buf = reinterpret_cast<CmBulkBuf*>(buf_handle);
+    return buf ? static_cast<int32_t>(buf->len) : 0;
+}
+
+// 容量
+int32_t cm_bulk_cap(int64_t buf_handle) {
+    auto* buf = reinterpret_cast<CmBulkBuf*>(buf_handle);
+    return buf ? static_cast<int32_t>(buf->cap) : 0;
+}
+
+// 有効長を設定（容量で切り詰める）
+void cm_bulk_set_len(int64_t buf_handle, int32_t len) {
+    auto* buf = reinterpret_cast<CmBulkBuf*>(buf_handle);
+    if (!buf)
+        return;
+    buf->len = len < 0 ? 0 : (len > buf->cap ? buf->cap : len);
+}
+
+// 容量を拡張（既存データは保持、ビューは新しい領域を指す）
+// 戻り値: 0=成功, -1=失敗
+int32_t cm_bulk_reserve(int64_t buf_handle, int32_t capacity) {
+    auto* buf = reinterpret_cast<CmBulkBuf*>(buf_handle);
+    if (!buf)
+        return -1;
+    if (capacity <= buf->cap)
+        return 0;
+    auto* data = static_cast<uint8_t*>(realloc(buf->data, static_cast<size_t>(capacity)));
+    if (!data)
+        return -1;
+    buf->data = data;
+    buf->cap = capacity;
+    return 0;
+}
+
+// 文字列を末尾に追加（容量が足りなければ拡張する）
+// 戻り値: 追加後の有効長（-1=失敗）
+int32_t cm_bulk_append(int64_t buf_handle, const char* text) {
+    auto* buf = reinterpret_cast<CmBulkBuf*>(buf_handle);
+    if (!buf || !text)
+        return -1;
+    int64_t n = static_cast<int64_t>(strlen(text));
+    if (buf->len + n > buf->cap) {
+        int64_t cap = buf->cap > 0 ? buf->cap : 16;
+        while (cap < buf->len + n)
+            cap *= 2;
+        if (cap > INT32_MAX || cm_bulk_reserve(buf_handle, static_cast<int32_t>(cap)) != 0)
+            return -1;
+    }
+    memcpy(buf->data + buf->len, text, static_cast<size_t>(n));
+    buf->len += n;
+    return static_cast<int32_t>(buf->len);
+}
+
+// 先頭からnバイトを取り除き、残りを前に詰める（パーサが処理済みの部分を捨てる用）
+void cm_bulk_consume(int64_t buf_handle, int32_t n) {
+    auto* buf = reinterpret_cast<CmBulkBuf*>(buf_handle);
+    if (!buf || n <= 0)
+        return;
+    if (n >= buf->len) {
+        buf->len = 0;
+        return;
+    }
+    memmove(buf->data, buf->data + n, static_cast<size_t>(buf->len - n));
+    buf->len -= n;
+}
+
+// offset以降で最初にvalueが現れる位置（見つからなければ-1）
+int32_t cm_bulk_find(int64_t buf_handle, int32_t offset, int32_t value) {
+    auto* buf = reinterpret_cast<CmBulkBuf*>(buf_handle);
+    if (!buf || offset < 0 || offset >= buf->len)
+        return -1;
+    const void* hit =
+        memchr(buf->data + offset, value & 0xff, static_cast<size_t>(buf->len - offset));
+    if (!hit)
+        return -1;
+    return static_cast<int32_t>(static_cast<const uint8_t*>(hit) - buf->data);
+}
+
+// 空き領域（有効長〜容量）に読み込み、有効長を進める
+// 戻り値: 読み取りバイト数（0=接続断または空きなし、-1=エラー）
+int32_t cm_bulk_read(int64_t fd, int64_t buf_handle) {
+    auto* buf = reinterpret_cast<CmBulkBuf*>(buf_handle);
+    if (!buf)
+        return -1;
+    if (buf->len >= buf->cap)
+        return 0;
+    ssize_t n =
+        read(static_cast<int>(fd), buf->data + buf->len, static_cast<size_t>(buf->cap - buf->len));
+    if (n > 0)
+        buf->len += n;
+    return static_cast<int32_t>(n);
+}
+
+// 有効データのoffsetからsizeバイトを書き込み（size < 0は有効長まで）
+// 戻り値: 書き込みバイト数（-1=エラー）
+int32_t cm_bulk_write(int64_t fd, int64_t buf_handle, int32_t offset, int32_t size) {
+    auto* buf = reinterpret_cast<CmBulkBuf*>(buf_handle);
+    if (!buf || offset < 0 || offset > buf->len)
+        return -1;
+    if (size < 0 || offset + size > buf->len)
+        size = static_cast<int32_t>(buf->len - offset);
+    ssize_t n = write(static_cast<int>(fd), buf->data + offset, static_cast<size_t>(size));
+    return static_cast<int32_t>(n);
+}
+
+// ============================================================
+// スキャッタ・ギャザーI/O（readv/writev）
+// ============================================================
+
+// 要素リスト作成
+// 戻り値: リストハンドル（失敗時0）
+int64_t cm_iov_create(int32_t max_entries) {
+    if (max_entries <= 0)
+        return 0;
+    auto* list = static_cast<CmIoList*>(calloc(1, sizeof(CmIoList)));
+    if (!list)
+        return 0;
+    size_t n = static_cast<size_t>(max_entries);
+    list->bufs = static_cast<CmBulkBuf**>(malloc(sizeof(CmBulkBuf*) * n));
+    list->offsets = static_cast<int64_t*>(malloc(sizeof(int64_t) * n));
+    list->sizes = static_cast<int64_t*>(malloc(sizeof(int64_t) * n));
+    list->results = static_cast<int32_t*>(calloc(n, sizeof(int32_t)));
+    list->iov = static_cast<struct iovec*>(malloc(sizeof(struct iovec) * n));
+    if (!list->bufs || !list->offsets || !list->sizes || !list->results || !list->iov) {
+        free(list->bufs);
+        free(list->offsets);
+        free(list->sizes);
+        free(list->results);
+        free(list->iov);
+        free(list);
+        return 0;
+    }
+    list->max = max_entries;
+    return reinterpret_cast<int64_t>(list);
+}
+
+// 要素を追加（size < 0は、読み込みなら容量まで・書き込みなら有効長まで）
+// 戻り値: 要素番号（満杯・無効な引数は-1）
+int32_t cm_iov_add(int64_t iov_handle, int64_t buf_handle, int32_t offset, int32_t size) {
+    auto* list = reinterpret_cast<CmIoList*>(iov_handle);
+    auto* buf = reinterpret_cast<CmBulkBuf*>(buf_handle);
+    if (!list || !buf || list->count >= list->max || offset < 0)
+        return -1;
+    int index = list->count++;
+    list->bufs[index] = buf;
+    list->offsets[index] = offset;
+    list->sizes[index] = size;
+    list->results[index] = 0;
+    return index;
+}
+
+// 直近の操作でindex番目の要素が転送したバイト数
+int32_t cm_iov_result(int64_t iov_handle, int32_t index) {
+    auto* list = reinterpret_cast<CmIoList*>(iov_handle);
+    if (!list || index < 0 || index >= list->count)
+        return 0;
+    return list->results[index];
+}
+
+// 要素数
+int32_t cm_iov_count(int64_t iov_handle) {
+    auto* list = reinterpret_cast<CmIoList*>(iov_handle);
+    return list ? list->count : 0;
+}
+
+// 全要素を外す（バッファ自体は破棄しない）
+void cm_iov_clear(int64_t iov_handle) {
+    auto* list = reinterpret_cast<CmIoList*>(iov_handle);
+    if (list)
+        list->count = 0;
+}
+
+// 要素リスト破棄
+void cm_iov_destroy(int64_t iov_handle) {
+    auto* list = reinterpret_cast<CmIoList*>(iov_handle);
+    if (!list)
+        return;
+    free(list->bufs);
+    free(list->offsets);
+    free(list->sizes);
+    free(list->results);
+    free(list->iov);
+    free(list);
+}
+
+// 各要素の範囲へ1回のシステムコールで読み込む（各バッファの有効長も進める）
+// 戻り値: 読み取りバイト数の合計（0=接続断、-1=エラー）
+int32_t cm_tcp_readv(int64_t fd, int64_t iov_handle) {
+    auto* list = reinterpret_cast<CmIoList*>(iov_handle);
+    if (!list)
+        return -1;
+    io_list_fill(list, true);
+    ssize_t n = readv(static_cast<int>(fd), list->iov, list->count);
+    if (n <= 0)
+        return static_cast<int32_t>(n);
+    size_t remaining = static_cast<size_t>(n);
+    for (int i = 0; i < list->count && remaining > 0; i++) {
+        size_t filled = remaining < list->iov[i].iov_len ? remaining : list->iov[i].iov_len;
+        io_list_commit_read(list, i, filled);
+        remaining -= filled;
+    }
+    return static_cast<int32_t>(n);
+}
+
+// 各要素の範囲を1回のシステムコールで書き込む
+// 戻り値: 書き込みバイト数の合計（-1=エラー）
+int32_t cm_tcp_writev(int64_t fd, int64_t iov_handle) {
+    auto* list = reinterpret_cast<CmIoList*>(iov_handle);
+    if (!list)
+        return -1;
+    io_list_fill(list, false);
+    ssize_t n = writev(static_cast<int>(fd), list->iov, list->count);
+    if (n <= 0)
+        return static_cast<int32_t>(n);
+    size_t remaining = static_cast<size_t>(n);
+    for (int i = 0; i < list->count && remaining > 0; i++) {
+        size_t sent = remaining < list->iov[i].iov_len ? remaining : list->iov[i].iov_len;
+        list->results[i] = static_cast<int32_t>(sent);
+        remaining -= sent;
+    }
+    return static_cast<int32_t>(n);
+}
+
+// ============================================================
+// ファイル転送（カーネル内コピー）
+// ============================================================
+
+// ファイルの内容をソケットへ送信（ユーザ空間を経由しない）
+// offset: ファイル内の開始位置, count: 最大送信バイト数
+// 戻り値: 送信バイト数（-1=エラー）
+int64_t cm_sendfile(int64_t sock_fd, int64_t file_fd, int64_t offset, int64_t count) {
+#ifdef __APPLE__
+    off_t len = static_cast<off_t>(count);
+    int r = sendfile(static_cast<int>(file_fd), static_cast<int>(sock_fd),
+                     static_cast<off_t>(offset), &len, nullptr, 0);
+    // EAGAIN/EINTRでもlenには送信済みのバイト数が入る
+    if (r < 0 && len == 0)
+        return -1;
+    return static_cast<int64_t>(len);
+#else
+    off_t off = static_cast<off_t>(offset);
+    int64_t total = 0;
+    while (total < count) {
+        ssize_t n = sendfile(static_cast<int>(sock_fd), static_cast<int>(file_fd), &off,
+                             static_cast<size_t>(count - total));
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            if (total > 0 && errno == EAGAIN)
+                break;
+            return total > 0 ? total : -1;
+        }
+        if (n == 0)
+            break;  // ファイル終端
+        total += n;
+    }
+    return total;
+#endif
+}
+
+// FD間でcountバイトまで転送する（ソケット同士・ファイルからソケットなど）
+// Linuxではパイプを介したspliceでカーネル内に留め、その他は読み書きで転送する
+// 戻り値: 転送バイト数（-1=エラー）
+int64_t cm_splice(int64_t in_fd, int64_t out_fd, int64_t count) {
+    int in = static_cast<int>(in_fd);
+    int out = static_cast<int>(out_fd);
+    int64_t total = 0;
+#ifndef __APPLE__
+    int pipe_fds[2];
+    if (pipe2(pipe_fds, O_CLOEXEC) == 0) {
+        bool failed = false;
+        while (total < count) {
+            ssize_t n = splice(in, nullptr, pipe_fds[1], nullptr,
+                               static_cast<size_t>(count - total), SPLICE_F_MOVE);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0) {
+                failed = n < 0 && !(errno == EAGAIN && total > 0);
+                break;
+            }
+            // パイプに入った分をすべて出力側へ流す
+            ssize_t pending = n;
+            while (pending > 0) {
+                ssize_t m = splice(pipe_fds[0], nullptr, out, nullptr, static_cast<size_t>(pending),
+                                   SPLICE_F_MOVE);
+                if (m < 0 && errno == EINTR)
+                    continue;
+                if (m <= 0) {
+                    failed = true;
+                    break;
+                }
+                pending -= m;
+                total += m;
+            }
+            if (failed)
+                break;
+        }
+        close(pipe_fds[0]);
+        close(pipe_fds[1]);
+        if (failed && total == 0)
+            return -1;
+        return total;
+    }
+#endif
+    char chunk[64 * 1024];
+    while (total < count) {
+        size_t want = static_cast<size_t>(count - total);
+        ssize_t n = read(in, chunk, want < sizeof(chunk) ? want : sizeof(chunk));
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0) {
+            if (n < 0 && total == 0)
+                return -1;
+            break;
+        }
+        ssize_t written = 0;
+        while (written < n) {
+            ssize_t m = write(out, chunk + written, static_cast<size_t>(n - written));
+            if (m < 0 && errno == EINTR)
+                continue;
+            if (m <= 0)
+                return total > 0 ? total : -1;
+            written += m;
+            total += m;
+        }
+    }
+    return total;
+}
+
 // ソケットをノンブロッキングに設定
 // 戻り値: 0=成功, -1=失敗
 int32_t cm_tcp_set_nonblocking(int64_t fd) {
@@ -204,12 +1022,13 @@ int32_t cm_tcp_set_nonblocking(int64_t fd) {
 }
 
 // ============================================================
-// イベント多重化（kqueue/poll）
+// イベント多重化（kqueue/epoll/io_uring/poll）
 // ============================================================
 
-// イベントループ作成
+// 指定バックエンドでイベントループ作成
+// backend: CM_POLL_BACKEND_*（使えない場合はプラットフォーム既定）
 // 戻り値: ポールハンドル（失敗時0）
-int64_t cm_tcp_poll_create() {
+int64_t cm_tcp_poll_create_backend(int32_t backend) {
     auto* ph = static_cast<CmPollHandle*>(malloc(sizeof(CmPollHandle)));
     if (!ph)
         return 0;
@@ -217,7 +1036,9 @@ int64_t cm_tcp_poll_create() {
     memset(ph, 0, sizeof(CmPollHandle));
 
 #ifdef __APPLE__
-    // kqueue作成
+    // kqueue作成（macOSではバックエンド指定に関わらずkqueue）
+    (void)backend;
+    ph->backend = CM_POLL_BACKEND_KQUEUE;
     ph->kq = kqueue();
     if (ph->kq < 0) {
         free(ph);
@@ -232,22 +1053,72 @@ int64_t cm_tcp_poll_create() {
     }
     ph->event_count = 0;
 #else
-    // poll用配列
-    ph->max_fds = 64;
-    ph->fds = static_cast<struct pollfd*>(malloc(sizeof(struct pollfd) * ph->max_fds));
-    if (!ph->fds) {
-        free(ph);
-        return 0;
+    ph->epfd = -1;
+
+#ifdef CM_HAVE_IO_URING
+    if (backend == CM_POLL_BACKEND_IO_URING) {
+        ph->ring = uring_create();
+        if (ph->ring) {
+            ph->backend = CM_POLL_BACKEND_IO_URING;
+            return reinterpret_cast<int64_t>(ph);
+        }
+        // カーネルが未対応・無効化されている場合はepoll
+    }
+#endif
+
+    if (backend == CM_POLL_BACKEND_POLL) {
+        // poll用配列
+        ph->backend = CM_POLL_BACKEND_POLL;
+        ph->max_fds = 64;
+        ph->fds = static_cast<struct pollfd*>(malloc(sizeof(struct pollfd) * ph->max_fds));
+        ph->ready = static_cast<int*>(malloc(sizeof(int) * ph->max_fds));
+        if (!ph->fds || !ph->ready) {
+            free(ph->fds);
+            free(ph->ready);
+            free(ph);
+            return 0;
+        }
+        ph->fd_count = 0;
+    } else {
+        // epoll作成
+        ph->backend = CM_POLL_BACKEND_EPOLL;
+        ph->epfd = epoll_create1(EPOLL_CLOEXEC);
+        if (ph->epfd < 0) {
+            free(ph);
+            return 0;
+        }
+        ph->max_events = kEpollInitialEvents;
+        ph->events =
+            static_cast<struct epoll_event*>(malloc(sizeof(struct epoll_event) * ph->max_events));
+        if (!ph->events) {
+            close(ph->epfd);
+            free(ph);
+            return 0;
+        }
     }
-    ph->fd_count = 0;
     ph->event_count = 0;
 #endif
 
     return reinterpret_cast<int64_t>(ph);
 }
 
-// イベントループにFDを登録
-// events: ビットフラグ（CM_POLL_READ=1, CM_POLL_WRITE=2）
+// イベントループ作成（プラットフォーム既定のバックエンド）
+// 戻り値: ポールハンドル（失敗時0）
+int64_t cm_tcp_poll_create() {
+    return cm_tcp_poll_create_backend(CM_POLL_BACKEND_AUTO);
+}
+
+// 実際に使っているバックエンドを取得
+// 戻り値: CM_POLL_BACKEND_*（無効なハンドルは-1）
+int32_t cm_tcp_poll_backend(int64_t poll_handle) {
+    auto* ph = reinterpret_cast<CmPollHandle*>(poll_handle);
+    if (!ph)
+        return -1;
+    return ph->backend;
+}
+
+// イベントループにFDを登録（登録済みのFDは監視イベントを置き換える）
+// events: ビットフラグ（CM_POLL_READ=1, CM_POLL_WRITE=2, CM_POLL_EDGE=16）
 // 戻り値: 0=成功, -1=失敗
 int32_t cm_tcp_poll_add(int64_t poll_handle, int64_t fd, int32_t events) {
     auto* ph = reinterpret_cast<CmPollHandle*>(poll_handle);
@@ -260,12 +1131,15 @@ int32_t cm_tcp_poll_add(int64_t poll_handle, int64_t fd, int32_t events) {
     // kqueueにFD登録
     struct kevent ev[2];
     int n = 0;
+    unsigned short flags = EV_ADD | EV_ENABLE;
+    if (events & CM_POLL_EDGE)
+        flags |= EV_CLEAR;
     if (events & CM_POLL_READ) {
-        EV_SET(&ev[n], raw_fd, EVFILT_READ, EV_ADD | EV_ENABLE, 0, 0, nullptr);
+        EV_SET(&ev[n], raw_fd, EVFILT_READ, flags, 0, 0, nullptr);
         n++;
     }
     if (events & CM_POLL_WRITE) {
-        EV_SET(&ev[n], raw_fd, EVFILT_WRITE, EV_ADD | EV_ENABLE, 0, 0, nullptr);
+        EV_SET(&ev[n], raw_fd, EVFILT_WRITE, flags, 0, 0, nullptr);
         n++;
     }
     if (n > 0) {
@@ -274,6 +1148,36 @@ int32_t cm_tcp_poll_add(int64_t poll_handle, int64_t fd, int32_t events) {
         }
     }
 #else
+#ifdef CM_HAVE_IO_URING
+    if (ph->backend == CM_POLL_BACKEND_IO_URING)
+        return uring_add(ph->ring, raw_fd, events);
+#endif
+
+    if (ph->backend == CM_POLL_BACKEND_EPOLL) {
+        // epollにFD登録（O(1)）
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = to_epoll_events(events);
+        ev.data.fd = raw_fd;
+        if (epoll_ctl(ph->epfd, EPOLL_CTL_ADD, raw_fd, &ev) < 0) {
+            if (errno != EEXIST || epoll_ctl(ph->epfd, EPOLL_CTL_MOD, raw_fd, &ev) < 0)
+                return -1;
+        }
+        return 0;
+    }
+
+    short poll_events = 0;
+    if (events & CM_POLL_READ)
+        poll_events |= POLLIN;
+    if (events & CM_POLL_WRITE)
+        poll_events |= POLLOUT;
+    for (int i = 0; i < ph->fd_count; i++) {
+        if (ph->fds[i].fd == raw_fd) {
+            ph->fds[i].events = poll_events;
+            return 0;
+        }
+    }
+
     // poll配列にFD追加
     if (ph->fd_count >= ph->max_fds) {
         // 配列拡張
@@ -283,15 +1187,15 @@ int32_t cm_tcp_poll_add(int64_t poll_handle, int64_t fd, int32_t events) {
         if (!new_fds)
             return -1;
         ph->fds = new_fds;
+        auto* new_ready = static_cast<int*>(realloc(ph->ready, sizeof(int) * new_max));
+        if (!new_ready)
+            return -1;
+        ph->ready = new_ready;
         ph->max_fds = new_max;
     }
     struct pollfd* pfd = &ph->fds[ph->fd_count++];
     pfd->fd = raw_fd;
-    pfd->events = 0;
-    if (events & CM_POLL_READ)
-        pfd->events |= POLLIN;
-    if (events & CM_POLL_WRITE)
-        pfd->events |= POLLOUT;
+    pfd->events = poll_events;
     pfd->revents = 0;
 #endif
 
@@ -315,6 +1219,19 @@ int32_t cm_tcp_poll_remove(int64_t poll_handle, int64_t fd) {
     // エラーを無視（既に削除済みの場合）
     kevent(ph->kq, ev, 2, nullptr, 0, nullptr);
 #else
+#ifdef CM_HAVE_IO_URING
+    if (ph->backend == CM_POLL_BACKEND_IO_URING) {
+        uring_remove(ph->ring, raw_fd);
+        return 0;
+    }
+#endif
+
+    if (ph->backend == CM_POLL_BACKEND_EPOLL) {
+        // epollからFD削除（O(1)、既に削除済み・クローズ済みのエラーは無視）
+        epoll_ctl(ph->epfd, EPOLL_CTL_DEL, raw_fd, nullptr);
+        return 0;
+    }
+
     // poll配列からFD削除
     for (int i = 0; i < ph->fd_count; i++) {
         if (ph->fds[i].fd == raw_fd) {
@@ -349,8 +1266,38 @@ int32_t cm_tcp_poll_wait(int64_t poll_handle, int32_t timeout_ms) {
     ph->event_count = (n > 0) ? n : 0;
     return n;
 #else
+#ifdef CM_HAVE_IO_URING
+    if (ph->backend == CM_POLL_BACKEND_IO_URING) {
+        int n = uring_wait(ph->ring, ph->event_count, timeout_ms);
+        ph->event_count = (n > 0) ? n : 0;
+        return n;
+    }
+#endif
+
+    if (ph->backend == CM_POLL_BACKEND_EPOLL) {
+        // 前回の結果で配列が埋まっていれば拡張（失敗しても現在のサイズで続行）
+        if (ph->event_count == ph->max_events && ph->max_events < kEpollMaxEvents) {
+            int new_max = ph->max_events * 2;
+            auto* new_events = static_cast<struct epoll_event*>(
+                realloc(ph->events, sizeof(struct epoll_event) * new_max));
+            if (new_events) {
+                ph->events = new_events;
+                ph->max_events = new_max;
+            }
+        }
+        int n = epoll_wait(ph->epfd, ph->events, ph->max_events, timeout_ms);
+        ph->event_count = (n > 0) ? n : 0;
+        return n;
+    }
+
     int n = poll(ph->fds, static_cast<nfds_t>(ph->fd_count), timeout_ms);
-    ph->event_count = (n > 0) ? n : 0;
+    // reventsが立った添字を集めておき、get_fd/get_eventsを添字アクセスにする
+    int count = 0;
+    for (int i = 0; i < ph->fd_count && count < n; i++) {
+        if (ph->fds[i].revents != 0)
+            ph->ready[count++] = i;
+    }
+    ph->event_count = count;
     return n;
 #endif
 }
@@ -362,23 +1309,19 @@ int64_t cm_tcp_poll_get_fd(int64_t poll_handle, int32_t index) {
     auto* ph = reinterpret_cast<CmPollHandle*>(poll_handle);
     if (!ph)
         return -1;
-
-#ifdef __APPLE__
     if (index < 0 || index >= ph->event_count)
         return -1;
+
+#ifdef __APPLE__
     return static_cast<int64_t>(ph->events[index].ident);
 #else
-    // pollの場合、reventsが非ゼロのFDをindex番目まで探す
-    int found = 0;
-    for (int i = 0; i < ph->fd_count; i++) {
-        if (ph->fds[i].revents != 0) {
-            if (found == index) {
-                return static_cast<int64_t>(ph->fds[i].fd);
-            }
-            found++;
-        }
-    }
-    return -1;
+#ifdef CM_HAVE_IO_URING
+    if (ph->backend == CM_POLL_BACKEND_IO_URING)
+        return static_cast<int64_t>(ph->ring->results[index].fd);
+#endif
+    if (ph->backend == CM_POLL_BACKEND_EPOLL)
+        return static_cast<int64_t>(ph->events[index].data.fd);
+    return static_cast<int64_t>(ph->fds[ph->ready[index]].fd);
 #endif
 }
 
@@ -389,10 +1332,10 @@ int32_t cm_tcp_poll_get_events(int64_t poll_handle, int32_t index) {
     auto* ph = reinterpret_cast<CmPollHandle*>(poll_handle);
     if (!ph)
         return 0;
-
-#ifdef __APPLE__
     if (index < 0 || index >= ph->event_count)
         return 0;
+
+#ifdef __APPLE__
     int result = 0;
     struct kevent* ev = &ph->events[index];
     if (ev->filter == EVFILT_READ)
@@ -405,25 +1348,13 @@ int32_t cm_tcp_poll_get_events(int64_t poll_handle, int32_t index) {
         result |= CM_POLL_ERROR;
     return result;
 #else
-    int found = 0;
-    for (int i = 0; i < ph->fd_count; i++) {
-        if (ph->fds[i].revents != 0) {
-            if (found == index) {
-                int result = 0;
-                if (ph->fds[i].revents & POLLIN)
-                    result |= CM_POLL_READ;
-                if (ph->fds[i].revents & POLLOUT)
-                    result |= CM_POLL_WRITE;
-                if (ph->fds[i].revents & (POLLERR | POLLNVAL))
-                    result |= CM_POLL_ERROR;
-                if (ph->fds[i].revents & POLLHUP)
-                    result |= CM_POLL_HUP;
-                return result;
-            }
-            found++;
-        }
-    }
-    return 0;
+#ifdef CM_HAVE_IO_URING
+    if (ph->backend == CM_POLL_BACKEND_IO_URING)
+        return ph->ring->results[index].events;
+#endif
+    if (ph->backend == CM_POLL_BACKEND_EPOLL)
+        return from_poll_bits(ph->events[index].events);
+    return from_poll_bits(static_cast<uint32_t>(ph->fds[ph->ready[index]].revents));
 #endif
 }
 
@@ -437,7 +1368,14 @@ void cm_tcp_poll_destroy(int64_t poll_handle) {
     close(ph->kq);
     free(ph->events);
 #else
+#ifdef CM_HAVE_IO_URING
+    uring_destroy(ph->ring);
+#endif
+    if (ph->epfd >= 0)
+        close(ph->epfd);
+    free(ph->events);
     free(ph->fds);
+    free(ph->ready);
 #endif
     free(ph);
 }
@@ -483,23 +1421,8 @@ int32_t cm_udp_sendto(int64_t fd, int64_t host_ptr, int32_t port, int64_t buf_pt
     const char* host = reinterpret_cast<const char*>(host_ptr);
 
     struct sockaddr_in dest_addr;
-    memset(&dest_addr, 0, sizeof(dest_addr));
-    dest_addr.sin_family = AF_INET;
-    dest_addr.sin_port = htons(static_cast<uint16_t>(port));
-
-    // IPアドレスまたはホスト名で解決
-    if (inet_pton(AF_INET, host, &dest_addr.sin_addr) <= 0) {
-        // ホスト名の場合はDNS解決
-        struct addrinfo hints, *result;
-        memset(&hints, 0, sizeof(hints));
-        hints.ai_family = AF_INET;
-        hints.ai_socktype = SOCK_DGRAM;
-        if (getaddrinfo(host, nullptr, &hints, &result) != 0) {
-            return -1;
-        }
-        memcpy(&dest_addr.sin_addr, &((struct sockaddr_in*)result->ai_addr)->sin_addr,
-               sizeof(struct in_addr));
-        freeaddrinfo(result);
+    if (resolve_udp_addr(host, port, &dest_addr) < 0) {
+        return -1;
     }
 
     const void* buf = reinterpret_cast<const void*>(buf_ptr);
@@ -522,6 +1445,108 @@ int32_t cm_udp_recvfrom(int64_t fd, int64_t buf_ptr, int32_t size) {
     return static_cast<int32_t>(received);
 }
 
+// UDPデータグラムをまとめて受信（1要素に1データグラム、各バッファの有効長も進める）
+// 最初の1件が届くまで待ち、その時点で届いている分を1回のシステムコールで取り出す
+// 戻り値: 受信したデータグラム数（-1=エラー）、各サイズはcm_iov_resultで取得
+int32_t cm_udp_recv_batch(int64_t fd, int64_t iov_handle) {
+    auto* list = reinterpret_cast<CmIoList*>(iov_handle);
+    if (!list)
+        return -1;
+    io_list_fill(list, true);
+    int s = static_cast<int>(fd);
+#ifdef __APPLE__
+    int received = 0;
+    for (int i = 0; i < list->count; i++) {
+        ssize_t n = recv(s, list->iov[i].iov_base, list->iov[i].iov_len,
+                         received == 0 ? 0 : MSG_DONTWAIT);
+        if (n < 0)
+            return received > 0 ? received : -1;
+        io_list_commit_read(list, i, static_cast<size_t>(n));
+        received++;
+    }
+    return received;
+#else
+    struct mmsghdr msgs[64];
+    int received = 0;
+    // mmsghdrはスタックに置くので64件ずつ処理する
+    while (received < list->count) {
+        int batch = list->count - received;
+        if (batch > 64)
+            batch = 64;
+        memset(msgs, 0, sizeof(struct mmsghdr) * batch);
+        for (int i = 0; i < batch; i++) {
+            msgs[i].msg_hdr.msg_iov = &list->iov[received + i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        int flags = received == 0 ? MSG_WAITFORONE : MSG_DONTWAIT;
+        int n = recvmmsg(s, msgs, static_cast<unsigned>(batch), flags, nullptr);
+        if (n <= 0) {
+            if (received > 0)
+                break;
+            return n;
+        }
+        for (int i = 0; i < n; i++)
+            io_list_commit_read(list, received + i, msgs[i].msg_len);
+        received += n;
+        if (n < batch)
+            break;
+    }
+    return received;
+#endif
+}
+
+// 各要素を1データグラムとして同じ宛先へまとめて送信
+// 戻り値: 送信したデータグラム数（-1=エラー）、各サイズはcm_iov_resultで取得
+int32_t cm_udp_send_batch(int64_t fd, int64_t host_ptr, int32_t port, int64_t iov_handle) {
+    auto* list = reinterpret_cast<CmIoList*>(iov_handle);
+    if (!list)
+        return -1;
+    struct sockaddr_in dest_addr;
+    if (resolve_udp_addr(reinterpret_cast<const char*>(host_ptr), port, &dest_addr) < 0)
+        return -1;
+    io_list_fill(list, false);
+    int s = static_cast<int>(fd);
+#ifdef __APPLE__
+    int sent = 0;
+    for (int i = 0; i < list->count; i++) {
+        ssize_t n = sendto(s, list->iov[i].iov_base, list->iov[i].iov_len, 0,
+                           (struct sockaddr*)&dest_addr, sizeof(dest_addr));
+        if (n < 0)
+            return sent > 0 ? sent : -1;
+        list->results[i] = static_cast<int32_t>(n);
+        sent++;
+    }
+    return sent;
+#else
+    struct mmsghdr msgs[64];
+    int sent = 0;
+    while (sent < list->count) {
+        int batch = list->count - sent;
+        if (batch > 64)
+            batch = 64;
+        memset(msgs, 0, sizeof(struct mmsghdr) * batch);
+        for (int i = 0; i < batch; i++) {
+            msgs[i].msg_hdr.msg_name = &dest_addr;
+            msgs[i].msg_hdr.msg_namelen = sizeof(dest_addr);
+            msgs[i].msg_hdr.msg_iov = &list->iov[sent + i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        int n = sendmmsg(s, msgs, static_cast<unsigned>(batch), 0);
+        if (n <= 0) {
+            if (sent > 0)
+                break;
+            return n;
+        }
+        for (int i = 0; i < n; i++)
+            list->results[sent + i] = static_cast<int32_t>(msgs[i].msg_len);
+        sent += n;
+        if (n < batch)
+            break;
+    }
+    return sent;
+#endif
+}
+
 // UDPソケットクローズ
 void cm_udp_close(int64_t fd) {
     close(static_cast<int>(fd));
@@ -1,10 +1,22 @@
 // channel_runtime.cpp - Cm チャネル stdバッキング実装
-// pthread_mutex + pthread_cond ベースのバウンデッドチャネル（リングバッファ）
+// - cm_channel_*: pthread_mutex + pthread_cond ベースのバウンデッドチャネル（リングバッファ）
+// - cm_channel_spsc_*: ロックフリーSPSCリング（送信1スレッド・受信1スレッド専用）
+// - cm_channel_mpmc_*: ロックフリーMPMCキュー（Vyukov方式、送受信とも複数スレッド可）
+// ロックフリー版の容量は2の累乗に切り上げられ、ブロッキング待機はfutex（Linux）で行う
 
+#include <atomic>
+#include <climits>
 #include <cstdint>
 #include <cstdlib>
 #include <pthread.h>
 
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
 // チャネル内部構造
 struct CmChannel {
     int64_t* buffer;           // リングバッファ
@@ -18,6 +30,400 @@ struct CmChannel {
     bool closed;               // クローズフラグ
 };
 
+// ============================================================
+// ロックフリーチャネル共通部品
+// ============================================================
+
+namespace {
+
+constexpr size_t kCacheLine = 64;
+// ブロッキング待機でfutexに入る前にスピンする回数（シングルコアではスピンしない）
+int spin_limit() {
+    static const int limit = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? 128 : 0;
+    return limit;
+}
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+// 容量を2の累乗に切り上げ（インデックスをマスクで計算するため）
+uint64_t round_up_pow2(int32_t capacity) {
+    uint64_t cap = 1;
+    while (cap < static_cast<uint64_t>(capacity > 0 ? capacity : 1))
+        cap <<= 1;
+    return cap;
+}
+
+// 待機キュー（イベントカウント）
+// seqの最下位ビットが「待機者あり」フラグ。
+// 待機側: prepare() → 条件を再確認 → wait()（再確認で成立したらそのまま抜けてよい）
+// 通知側: 状態を公開した後にnotify()。フラグが立っていなければシステムコールを発行せず、
+// 立っていればフラグを落として全待機者を起こす（次に誰かが待機するまで通知は空振り）
+struct alignas(kCacheLine) WaitQueue {
+    std::atomic<uint32_t> seq{0};
+#ifndef __linux__
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
+#endif
+
+    uint32_t prepare() { return seq.fetch_or(1, std::memory_order_seq_cst) | 1; }
+
+    void wait(uint32_t observed) {
+#ifdef __linux__
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&seq), FUTEX_WAIT_PRIVATE, observed,
+                nullptr, nullptr, 0);
+#else
+        pthread_mutex_lock(&mutex);
+        while (seq.load(std::memory_order_acquire) == observed) {
+            pthread_cond_wait(&cond, &mutex);
+        }
+        pthread_mutex_unlock(&mutex);
+#endif
+    }
+
+    void notify() {
+        // 待機側のprepare()と対になるフェンス（公開した状態かフラグのどちらかが必ず見える）
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint32_t current = seq.load(std::memory_order_relaxed);
+        if ((current & 1) == 0)
+            return;
+        // CASに負けた場合は他の通知側がフラグを落として起こしている
+        if (!seq.compare_exchange_strong(current, (current + 2) & ~1u,
+                                         std::memory_order_release))
+            return;
+#ifdef __linux__
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&seq), FUTEX_WAKE_PRIVATE, INT_MAX,
+                nullptr, nullptr, 0);
+#else
+        pthread_mutex_lock(&mutex);
+        pthread_cond_broadcast(&cond);
+        pthread_mutex_unlock(&mutex);
+#endif
+    }
+
+#ifndef __linux__
+    ~WaitQueue() {
+        pthread_mutex_destroy(&mutex);
+        pthread_cond_destroy(&cond);
+    }
+#endif
+};
+
+// SPSCリング
+// head/tailを別キャッシュラインに置き、相手側のインデックスはキャッシュして
+// 満杯/空に見えたときだけ読み直す
+struct SpscRing {
+    alignas(kCacheLine) std::atomic<uint64_t> head{0};  // 受信側が更新
+    uint64_t cached_tail = 0;                           // 受信側のみ使用
+    alignas(kCacheLine) std::atomic<uint64_t> tail{0};  // 送信側が更新
+    uint64_t cached_head = 0;                           // 送信側のみ使用
+    alignas(kCacheLine) std::atomic<bool> closed{false};
+    uint64_t mask;
+    int64_t* buffer;
+    WaitQueue not_empty;
+    WaitQueue not_full;
+
+    explicit SpscRing(uint64_t capacity) : mask(capacity - 1), buffer(new int64_t[capacity]) {}
+    ~SpscRing() { delete[] buffer; }
+
+    size_t try_push_n(const int64_t* values, size_t n) {
+        uint64_t t = tail.load(std::memory_order_relaxed);
+        uint64_t free_slots = mask + 1 - (t - cached_head);
+        if (free_slots < n) {
+            cached_head = head.load(std::memory_order_acquire);
+            free_slots = mask + 1 - (t - cached_head);
+        }
+        if (n > free_slots)
+            n = free_slots;
+        for (size_t i = 0; i < n; i++) {
+            buffer[(t + i) & mask] = values[i];
+        }
+        if (n > 0)
+            tail.store(t + n, std::memory_order_release);
+        return n;
+    }
+
+    size_t try_pop_n(int64_t* values, size_t max) {
+        uint64_t h = head.load(std::memory_order_relaxed);
+        uint64_t available = cached_tail - h;
+        if (available < max) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            available = cached_tail - h;
+        }
+        if (max > available)
+            max = available;
+        for (size_t i = 0; i < max; i++) {
+            values[i] = buffer[(h + i) & mask];
+        }
+        if (max > 0)
+            head.store(h + max, std::memory_order_release);
+        return max;
+    }
+
+    bool try_push(int64_t value) { return try_push_n(&value, 1) == 1; }
+    bool try_pop(int64_t* value) { return try_pop_n(value, 1) == 1; }
+
+    int32_t size() const {
+        return static_cast<int32_t>(tail.load(std::memory_order_acquire) -
+                                    head.load(std::memory_order_acquire));
+    }
+};
+
+// MPMCキュー（Dmitry Vyukovのbounded MPMC queue）
+// 各セルのシーケンス番号で「書き込み可能」「読み出し可能」を判定し、
+// 位置の確保はenqueue_pos/dequeue_posへのCAS 1回で行う
+struct MpmcQueue {
+    struct Cell {
+        std::atomic<uint64_t> seq;
+        int64_t value;
+    };
+
+    alignas(kCacheLine) std::atomic<uint64_t> enqueue_pos{0};
+    alignas(kCacheLine) std::atomic<uint64_t> dequeue_pos{0};
+    alignas(kCacheLine) std::atomic<bool> closed{false};
+    uint64_t mask;
+    Cell* cells;
+    WaitQueue not_empty;
+    WaitQueue not_full;
+
+    explicit MpmcQueue(uint64_t capacity) : mask(capacity - 1), cells(new Cell[capacity]) {
+        for (uint64_t i = 0; i < capacity; i++) {
+            cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+    ~MpmcQueue() { delete[] cells; }
+
+    // 連続して書き込み可能なセルを最大n個まとめて確保する
+    size_t try_push_n(const int64_t* values, size_t n) {
+        uint64_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            size_t count = 0;
+            while (count < n && count <= mask &&
+                   cells[(pos + count) & mask].seq.load(std::memory_order_acquire) == pos + count) {
+                count++;
+            }
+            if (count == 0) {
+                int64_t diff = static_cast<int64_t>(
+                                   cells[pos & mask].seq.load(std::memory_order_acquire)) -
+                               static_cast<int64_t>(pos);
+                if (diff < 0)
+                    return 0;  // 満杯
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (enqueue_pos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+                for (size_t i = 0; i < count; i++) {
+                    Cell& cell = cells[(pos + i) & mask];
+                    cell.value = values[i];
+                    cell.seq.store(pos + i + 1, std::memory_order_release);
+                }
+                return count;
+            }
+        }
+    }
+
+    size_t try_pop_n(int64_t* values, size_t max) {
+        uint64_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            size_t count = 0;
+            while (count < max && count <= mask &&
+                   cells[(pos + count) & mask].seq.load(std::memory_order_acquire) ==
+                       pos + count + 1) {
+                count++;
+            }
+            if (count == 0) {
+                int64_t diff = static_cast<int64_t>(
+                                   cells[pos & mask].seq.load(std::memory_order_acquire)) -
+                               static_cast<int64_t>(pos + 1);
+                if (diff < 0)
+                    return 0;  // 空
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (dequeue_pos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+                for (size_t i = 0; i < count; i++) {
+                    Cell& cell = cells[(pos + i) & mask];
+                    values[i] = cell.value;
+                    cell.seq.store(pos + i + mask + 1, std::memory_order_release);
+                }
+                return count;
+            }
+        }
+    }
+
+    bool try_push(int64_t value) { return try_push_n(&value, 1) == 1; }
+    bool try_pop(int64_t* value) { return try_pop_n(value, 1) == 1; }
+
+    int32_t size() const {
+        uint64_t enq = enqueue_pos.load(std::memory_order_acquire);
+        uint64_t deq = dequeue_pos.load(std::memory_order_acquire);
+        return enq > deq ? static_cast<int32_t>(enq - deq) : 0;
+    }
+};
+
+// ブロッキング送信: スピン → 待機キュー登録 → 再試行 → futex待機
+template <typename Queue>
+int32_t queue_send(Queue* q, int64_t value) {
+    for (int spins = 0;; spins++) {
+        if (q->closed.load(std::memory_order_acquire))
+            return -1;
+        if (q->try_push(value)) {
+            q->not_empty.notify();
+            return 0;
+        }
+        if (spins < spin_limit()) {
+            cpu_relax();
+            continue;
+        }
+        uint32_t observed = q->not_full.prepare();
+        if (q->closed.load(std::memory_order_acquire))
+            return -1;
+        if (q->try_push(value)) {
+            q->not_empty.notify();
+            return 0;
+        }
+        q->not_full.wait(observed);
+    }
+}
+
+// ブロッキング受信（クローズ後も残りのデータは受信できる）
+template <typename Queue>
+int32_t queue_recv(Queue* q, int64_t* value) {
+    for (int spins = 0;; spins++) {
+        if (q->try_pop(value)) {
+            q->not_full.notify();
+            return 0;
+        }
+        if (q->closed.load(std::memory_order_acquire)) {
+            // クローズ前に書き込まれたデータを取りこぼさないよう再確認
+            if (q->try_pop(value)) {
+                q->not_full.notify();
+                return 0;
+            }
+            return -1;
+        }
+        if (spins < spin_limit()) {
+            cpu_relax();
+            continue;
+        }
+        uint32_t observed = q->not_empty.prepare();
+        if (q->try_pop(value)) {
+            q->not_full.notify();
+            return 0;
+        }
+        if (q->closed.load(std::memory_order_acquire))
+            continue;
+        q->not_empty.wait(observed);
+    }
+}
+
+template <typename Queue>
+int32_t queue_try_send(Queue* q, int64_t value) {
+    if (q->closed.load(std::memory_order_acquire))
+        return -1;
+    if (!q->try_push(value))
+        return -2;
+    q->not_empty.notify();
+    return 0;
+}
+
+template <typename Queue>
+int32_t queue_try_recv(Queue* q, int64_t* value) {
+    if (q->try_pop(value)) {
+        q->not_full.notify();
+        return 0;
+    }
+    if (!q->closed.load(std::memory_order_acquire))
+        return -2;
+    if (!q->try_pop(value))
+        return -1;
+    q->not_full.notify();
+    return 0;
+}
+
+// バッチ送信: 空いている分をまとめて書き込み、全部送るまで待機
+template <typename Queue>
+int32_t queue_send_n(Queue* q, const int64_t* values, int32_t n) {
+    int32_t sent = 0;
+    int spins = 0;
+    while (sent < n) {
+        if (q->closed.load(std::memory_order_acquire))
+            break;
+        size_t pushed = q->try_push_n(values + sent, static_cast<size_t>(n - sent));
+        if (pushed > 0) {
+            sent += static_cast<int32_t>(pushed);
+            q->not_empty.notify();
+            spins = 0;
+            continue;
+        }
+        if (spins++ < spin_limit()) {
+            cpu_relax();
+            continue;
+        }
+        uint32_t observed = q->not_full.prepare();
+        if (q->closed.load(std::memory_order_acquire))
+            break;
+        pushed = q->try_push_n(values + sent, static_cast<size_t>(n - sent));
+        if (pushed > 0) {
+            sent += static_cast<int32_t>(pushed);
+            q->not_empty.notify();
+            spins = 0;
+            continue;
+        }
+        q->not_full.wait(observed);
+    }
+    return (sent == 0 && n > 0) ? -1 : sent;
+}
+
+// バッチ受信: 1個以上届くまで待機し、取り出せる分を最大max個まとめて受信
+template <typename Queue>
+int32_t queue_recv_n(Queue* q, int64_t* values, int32_t max) {
+    if (max <= 0)
+        return -1;
+    for (int spins = 0;; spins++) {
+        size_t popped = q->try_pop_n(values, static_cast<size_t>(max));
+        if (popped > 0) {
+            q->not_full.notify();
+            return static_cast<int32_t>(popped);
+        }
+        if (q->closed.load(std::memory_order_acquire)) {
+            popped = q->try_pop_n(values, static_cast<size_t>(max));
+            if (popped > 0) {
+                q->not_full.notify();
+                return static_cast<int32_t>(popped);
+            }
+            return -1;
+        }
+        if (spins < spin_limit()) {
+            cpu_relax();
+            continue;
+        }
+        uint32_t observed = q->not_empty.prepare();
+        popped = q->try_pop_n(values, static_cast<size_t>(max));
+        if (popped > 0) {
+            q->not_full.notify();
+            return static_cast<int32_t>(popped);
+        }
+        if (q->closed.load(std::memory_order_acquire))
+            continue;
+        q->not_empty.wait(observed);
+    }
+}
+
+template <typename Queue>
+void queue_close(Queue* q) {
+    q->closed.store(true, std::memory_order_release);
+    q->not_empty.notify();
+    q->not_full.notify();
+}
+
+}  // namespace
+
 extern "C" {
 
 // チャネル作成
@@ -71,7 +477,8 @@ int32_t cm_channel_send(int64_t handle, int64_t value) {
 
     // リングバッファに書き込み
     ch->buffer[ch->tail] = value;
-    ch->tail = (ch->tail + 1) % ch->capacity;
+    if (++ch->tail == ch->capacity)
+        ch->tail = 0;
     ch->count++;
 
     // 受信待ちスレッドを起こす
@@ -104,7 +511,8 @@ int32_t cm_channel_recv(int64_t handle, int64_t* value) {
 
     // リングバッファから読み出し
     *value = ch->buffer[ch->head];
-    ch->head = (ch->head + 1) % ch->capacity;
+    if (++ch->head == ch->capacity)
+        ch->head = 0;
     ch->count--;
 
     // 送信待ちスレッドを起こす
@@ -134,7 +542,8 @@ int32_t cm_channel_try_send(int64_t handle, int64_t value) {
     }
 
     ch->buffer[ch->tail] = value;
-    ch->tail = (ch->tail + 1) % ch->capacity;
+    if (++ch->tail == ch->capacity)
+        ch->tail = 0;
     ch->count++;
 
     pthread_cond_signal(&ch->not_empty);
@@ -158,7 +567,8 @@ int32_t cm_channel_try_recv(int64_t handle, int64_t* value) {
     }
 
     *value = ch->buffer[ch->head];
-    ch->head = (ch->head + 1) % ch->capacity;
+    if (++ch->head == ch->capacity)
+        ch->head = 0;
     ch->count--;
 
     pthread_cond_signal(&ch->not_full);
@@ -167,6 +577,66 @@ int32_t cm_channel_try_recv(int64_t handle, int64_t* value) {
     return 0;
 }
 
+// バッチ送信（ブロッキング）
+// 1回のロックで空いている分をまとめて書き込み、満杯なら空くまで待機する
+// 戻り値: 送信した個数（途中でクローズされた場合はn未満）、1個も送れずクローズ済みなら-1
+int32_t cm_channel_send_n(int64_t handle, const int64_t* values, int32_t n) {
+    auto* ch = reinterpret_cast<CmChannel*>(handle);
+    if (!ch || !values)
+        return -1;
+
+    int32_t sent = 0;
+    pthread_mutex_lock(&ch->mutex);
+    while (sent < n) {
+        while (ch->count >= ch->capacity && !ch->closed) {
+            pthread_cond_wait(&ch->not_full, &ch->mutex);
+        }
+        if (ch->closed)
+            break;
+
+        while (sent < n && ch->count < ch->capacity) {
+            ch->buffer[ch->tail] = values[sent++];
+            if (++ch->tail == ch->capacity)
+                ch->tail = 0;
+            ch->count++;
+        }
+        pthread_cond_broadcast(&ch->not_empty);
+    }
+    pthread_mutex_unlock(&ch->mutex);
+
+    return (sent == 0 && n > 0) ? -1 : sent;
+}
+
+// バッチ受信（ブロッキング）
+// 1個以上届くまで待機し、その時点で取り出せる分を最大max個まとめて受信する
+// 戻り値: 受信した個数、クローズ済みかつ空なら-1
+int32_t cm_channel_recv_n(int64_t handle, int64_t* values, int32_t max) {
+    auto* ch = reinterpret_cast<CmChannel*>(handle);
+    if (!ch || !values || max <= 0)
+        return -1;
+
+    pthread_mutex_lock(&ch->mutex);
+    while (ch->count == 0 && !ch->closed) {
+        pthread_cond_wait(&ch->not_empty, &ch->mutex);
+    }
+    if (ch->count == 0) {
+        pthread_mutex_unlock(&ch->mutex);
+        return -1;
+    }
+
+    int32_t received = 0;
+    while (received < max && ch->count > 0) {
+        values[received++] = ch->buffer[ch->head];
+        if (++ch->head == ch->capacity)
+            ch->head = 0;
+        ch->count--;
+    }
+    pthread_cond_broadcast(&ch->not_full);
+    pthread_mutex_unlock(&ch->mutex);
+
+    return received;
+}
+
 // チャネルをクローズ
 void cm_channel_close(int64_t handle) {
     auto* ch = reinterpret_cast<CmChannel*>(handle);
@@ -220,4 +690,111 @@ int32_t cm_channel_is_closed(int64_t handle) {
     return closed;
 }
 
+// ============================================================
+// ロックフリーSPSCチャネル
+// 送信は1スレッド、受信は1スレッドからのみ呼び出すこと
+// 戻り値の規約は cm_channel_* と同じ
+// ============================================================
+
+int64_t cm_channel_spsc_create(int32_t capacity) {
+    return reinterpret_cast<int64_t>(new SpscRing(round_up_pow2(capacity)));
+}
+
+int32_t cm_channel_spsc_send(int64_t handle, int64_t value) {
+    auto* q = reinterpret_cast<SpscRing*>(handle);
+    return q ? queue_send(q, value) : -1;
+}
+
+int32_t cm_channel_spsc_recv(int64_t handle, int64_t* value) {
+    auto* q = reinterpret_cast<SpscRing*>(handle);
+    return (q && value) ? queue_recv(q, value) : -1;
+}
+
+int32_t cm_channel_spsc_try_send(int64_t handle, int64_t value) {
+    auto* q = reinterpret_cast<SpscRing*>(handle);
+    return q ? queue_try_send(q, value) : -1;
+}
+
+int32_t cm_channel_spsc_try_recv(int64_t handle, int64_t* value) {
+    auto* q = reinterpret_cast<SpscRing*>(handle);
+    return (q && value) ? queue_try_recv(q, value) : -1;
+}
+
+int32_t cm_channel_spsc_send_n(int64_t handle, const int64_t* values, int32_t n) {
+    auto* q = reinterpret_cast<SpscRing*>(handle);
+    return (q && values) ? queue_send_n(q, values, n) : -1;
+}
+
+int32_t cm_channel_spsc_recv_n(int64_t handle, int64_t* values, int32_t max) {
+    auto* q = reinterpret_cast<SpscRing*>(handle);
+    return (q && values) ? queue_recv_n(q, values, max) : -1;
+}
+
+void cm_channel_spsc_close(int64_t handle) {
+    if (auto* q = reinterpret_cast<SpscRing*>(handle))
+        queue_close(q);
+}
+
+void cm_channel_spsc_destroy(int64_t handle) {
+    delete reinterpret_cast<SpscRing*>(handle);
+}
+
+int32_t cm_channel_spsc_len(int64_t handle) {
+    auto* q = reinterpret_cast<SpscRing*>(handle);
+    return q ? q->size() : 0;
+}
+
+// ============================================================
+// ロックフリーMPMCチャネル
+// 送受信とも任意のスレッドから呼び出せる
+// ============================================================
+
+int64_t cm_channel_mpmc_create(int32_t capacity) {
+    return reinterpret_cast<int64_t>(new MpmcQueue(round_up_pow2(capacity)));
+}
+
+int32_t cm_channel_mpmc_send(int64_t handle, int64_t value) {
+    auto* q = reinterpret_cast<MpmcQueue*>(handle);
+    return q ? queue_send(q, value) : -1;
+}
+
+int32_t cm_channel_mpmc_recv(int64_t handle, int64_t* value) {
+    auto* q = reinterpret_cast<MpmcQueue*>(handle);
+    return (q && value) ? queue_recv(q, value) : -1;
+}
+
+int32_t cm_channel_mpmc_try_send(int64_t handle, int64_t value) {
+    auto* q = reinterpret_cast<MpmcQueue*>(handle);
+    return q ? queue_try_send(q, value) : -1;
+}
+
+int32_t cm_channel_mpmc_try_recv(int64_t handle, int64_t* value) {
+    auto* q = reinterpret_cast<MpmcQueue*>(handle);
+    return (q && value) ? queue_try_recv(q, value) : -1;
+}
+
+int32_t cm_channel_mpmc_send_n(int64_t handle, const int64_t* values, int32_t n) {
+    auto* q = reinterpret_cast<MpmcQueue*>(handle);
+    return (q && values) ? queue_send_n(q, values, n) : -1;
+}
+
+int32_t cm_channel_mpmc_recv_n(int64_t handle, int64_t* values, int32_t max) {
+    auto* q = reinterpret_cast<MpmcQueue*>(handle);
+    return (q && values) ? queue_recv_n(q, values, max) : -1;
+}
+
+void cm_channel_mpmc_close(int64_t handle) {
+    if (auto* q = reinterpret_cast<MpmcQueue*>(handle))
+        queue_close(q);
+}
+
+void cm_channel_mpmc_destroy(int64_t handle) {
+    delete reinterpret_cast<MpmcQueue*>(handle);
+}
+
+int32_t cm_channel_mpmc_len(int64_t handle) {
+    auto* q = reinterpret_cast<MpmcQueue*>(handle);
+    return q ? q->size() : 0;
+}
+
 }  // extern "C"
@@ -114,4 +114,102 @@ int atomic_compare_exchange_i64(int64_t* ptr, int64_t* expected, int64_t desired
                : 0;
 }
 
+// ============================================================
+// メモリオーダー指定版（order は __ATOMIC_RELAXED〜__ATOMIC_SEQ_CST の値）
+// LLVMバックエンドでは呼び出しがネイティブ命令に展開されるため、
+// 関数ポインタ経由など展開できない場合のフォールバック
+// ============================================================
+
+}  // extern "C"
+
+namespace {
+
+// 不正な値はSEQ_CSTに、CONSUMEはACQUIREに丸める（コード生成のtoLLVMOrderingと同じ）
+inline int normalize_order(int order) {
+    switch (order) {
+        case __ATOMIC_RELAXED:
+            return __ATOMIC_RELAXED;
+        case __ATOMIC_CONSUME:
+        case __ATOMIC_ACQUIRE:
+            return __ATOMIC_ACQUIRE;
+        case __ATOMIC_RELEASE:
+            return __ATOMIC_RELEASE;
+        case __ATOMIC_ACQ_REL:
+            return __ATOMIC_ACQ_REL;
+        default:
+            return __ATOMIC_SEQ_CST;
+    }
+}
+
+// loadにはreleaseを含められない（コード生成のadjustOrderingと同じ）
+inline int load_order(int order) {
+    order = normalize_order(order);
+    if (order == __ATOMIC_RELEASE)
+        return __ATOMIC_RELAXED;
+    if (order == __ATOMIC_ACQ_REL)
+        return __ATOMIC_ACQUIRE;
+    return order;
+}
+
+// storeにはacquireを含められない
+inline int store_order(int order) {
+    order = normalize_order(order);
+    if (order == __ATOMIC_ACQUIRE)
+        return __ATOMIC_RELAXED;
+    if (order == __ATOMIC_ACQ_REL)
+        return __ATOMIC_RELEASE;
+    return order;
+}
+
+// compare_exchange失敗時はloadのみ（コード生成のfailureOrderingと同じ）
+inline int failure_order(int order) {
+    return load_order(order);
+}
+
+}  // namespace
+
+extern "C" {
+
+#define CM_ATOMIC_EXPLICIT_OPS(BITS, T)                                                 \
+    T cm_atomic_load_explicit_i##BITS(T* ptr, int order) {                               \
+        return __atomic_load_n(ptr, load_order(order));                                  \
+    }                                                                                    \
+    void cm_atomic_store_explicit_i##BITS(T* ptr, T value, int order) {                  \
+        __atomic_store_n(ptr, value, store_order(order));                                \
+    }                                                                                    \
+    T cm_atomic_exchange_explicit_i##BITS(T* ptr, T value, int order) {                  \
+        return __atomic_exchange_n(ptr, value, normalize_order(order));                  \
+    }                                                                                    \
+    T cm_atomic_fetch_add_explicit_i##BITS(T* ptr, T value, int order) {                 \
+        return __atomic_fetch_add(ptr, value, normalize_order(order));                   \
+    }                                                                                    \
+    T cm_atomic_fetch_sub_explicit_i##BITS(T* ptr, T value, int order) {                 \
+        return __atomic_fetch_sub(ptr, value, normalize_order(order));                   \
+    }                                                                                    \
+    T cm_atomic_fetch_and_explicit_i##BITS(T* ptr, T value, int order) {                 \
+        return __atomic_fetch_and(ptr, value, normalize_order(order));                   \
+    }                                                                                    \
+    T cm_atomic_fetch_or_explicit_i##BITS(T* ptr, T value, int order) {                  \
+        return __atomic_fetch_or(ptr, value, normalize_order(order));                    \
+    }                                                                                    \
+    T cm_atomic_fetch_xor_explicit_i##BITS(T* ptr, T value, int order) {                 \
+        return __atomic_fetch_xor(ptr, value, normalize_order(order));                   \
+    }                                                                                    \
+    int cm_atomic_compare_exchange_explicit_i##BITS(T* ptr, T* expected, T desired,     \
+                                                    int order) {                         \
+        return __atomic_compare_exchange_n(ptr, expected, desired, false,                \
+                                           normalize_order(order), failure_order(order)) \
+                   ? 1                                                                   \
+                   : 0;                                                                  \
+    }
+
+CM_ATOMIC_EXPLICIT_OPS(32, int32_t)
+CM_ATOMIC_EXPLICIT_OPS(64, int64_t)
+
+#undef CM_ATOMIC_EXPLICIT_OPS
+
+void cm_atomic_fence(int order) {
+    __atomic_thread_fence(normalize_order(order));
+}
+
 }  // extern "C"
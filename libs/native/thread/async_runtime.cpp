@@ -0,0 +1,839 @@
+// async_runtime.cpp - Cm 非同期ランタイム stdバッキング実装
+// pthreadワーカー + ワークスティーリングによるマルチスレッドエグゼキュータ
+//
+// 構成:
+//   - ワーカーごとのデック（Chase-Lev）: 所有者はbottomでpush/pop、他ワーカーはtopから盗む
+//   - グローバル注入キュー: ワーカー外からのspawn・デック溢れ時の受け皿
+//   - 共有リアクタ（epoll/kqueue）: 手の空いたワーカー1つがドライバとしてI/Oとタイマーを待機
+//
+// タスクはポーリング関数 int fn(void* arg) で表現する。
+// 戻り値0は未完了（PENDING）で、タスク自身がcm_async_wait_*等で起床条件を登録してから返す。
+// 0以外は完了（READY）。
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <pthread.h>
+#include <unistd.h>
+#include <vector>
+
+#ifdef __APPLE__
+#include <sys/event.h>
+#define CM_ASYNC_KQUEUE 1
+#else
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#define CM_ASYNC_EPOLL 1
+#endif
+
+namespace {
+
+struct AsyncRuntime;
+
+// ============================================================
+// タスク
+// ============================================================
+
+enum TaskState : int {
+    TASK_IDLE = 0,       // 起床待ち
+    TASK_SCHEDULED = 1,  // キューに積まれている
+    TASK_RUNNING = 2,    // ポーリング中
+    TASK_NOTIFIED = 3,   // ポーリング中に起こされた（終了後に再スケジュール）
+    TASK_DONE = 4,       // 完了
+};
+
+struct AsyncTask {
+    int (*fn)(void*);
+    void* arg;
+    AsyncRuntime* rt;
+    std::atomic<int> state;
+    std::atomic<int> refcount;  // ハンドル + ランタイム + リアクタ登録の数
+    AsyncTask* next;            // 注入キュー用
+};
+
+void task_release(AsyncTask* task) {
+    if (task->refcount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete task;
+}
+
+// ============================================================
+// ワーカーデック（Chase-Lev、固定長）
+// 満杯時は呼び出し側が注入キューへ回す
+// ============================================================
+
+constexpr int64_t DEQUE_CAPACITY = 256;
+
+struct WorkerDeque {
+    std::atomic<int64_t> top{0};
+    std::atomic<int64_t> bottom{0};
+    std::atomic<AsyncTask*> slots[DEQUE_CAPACITY];
+
+    bool push(AsyncTask* task) {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        if (b - t >= DEQUE_CAPACITY)
+            return false;
+        slots[b & (DEQUE_CAPACITY - 1)].store(task, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    AsyncTask* pop() {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        AsyncTask* task = slots[b & (DEQUE_CAPACITY - 1)].load(std::memory_order_relaxed);
+        if (t == b) {
+            // 最後の1要素は盗む側と競合する
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                             std::memory_order_relaxed))
+                task = nullptr;
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return task;
+    }
+
+    AsyncTask* steal() {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b)
+            return nullptr;
+        AsyncTask* task = slots[t & (DEQUE_CAPACITY - 1)].load(std::memory_order_relaxed);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed))
+            return nullptr;
+        return task;
+    }
+
+    bool empty() const {
+        return top.load(std::memory_order_acquire) >= bottom.load(std::memory_order_acquire);
+    }
+};
+
+struct Worker {
+    AsyncRuntime* rt;
+    int index;
+    pthread_t thread;
+    WorkerDeque deque;
+    uint32_t rng;  // 盗む相手の選択用
+};
+
+// ============================================================
+// リアクタ（全ワーカー共有）
+// ============================================================
+
+struct IoWaiters {
+    AsyncTask* reader = nullptr;
+    AsyncTask* writer = nullptr;
+    bool registered = false;
+};
+
+struct TimerEntry {
+    uint64_t deadline;
+    AsyncTask* task;
+    bool operator<(const TimerEntry& other) const {
+        // std::push_heapは最大ヒープのため逆順で比較
+        return deadline > other.deadline;
+    }
+};
+
+// ============================================================
+// ランタイム
+// ============================================================
+
+struct AsyncRuntime {
+    std::vector<Worker*> workers;
+
+    // グローバル注入キュー
+    pthread_mutex_t inject_mutex;
+    AsyncTask* inject_head = nullptr;
+    AsyncTask* inject_tail = nullptr;
+    std::atomic<int> inject_len{0};
+
+    // アイドルワーカーの待機
+    pthread_mutex_t idle_mutex;
+    pthread_cond_t idle_cond;
+    std::atomic<int> sleepers{0};
+
+    // 未完了タスク数と完了待ち（join/wait_all）
+    std::atomic<int64_t> pending{0};
+    std::atomic<int> done_waiters{0};
+    pthread_mutex_t done_mutex;
+    pthread_cond_t done_cond;
+
+    // リアクタ
+    int poll_fd = -1;
+#ifdef CM_ASYNC_EPOLL
+    int wake_fd = -1;  // ドライバのepoll_waitを中断するeventfd
+#endif
+    pthread_mutex_t reactor_mutex;
+    std::vector<IoWaiters> io;
+    std::vector<TimerEntry> timers;
+    std::atomic<bool> driver_active{false};
+    std::atomic<bool> driver_parked{false};
+
+    std::atomic<bool> shutdown{false};
+};
+
+thread_local Worker* tls_worker = nullptr;
+thread_local AsyncTask* tls_current_task = nullptr;
+
+uint64_t now_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000 + static_cast<uint64_t>(ts.tv_nsec) / 1000000;
+}
+
+// ------------------------------------------------------------
+// 起床通知
+// ------------------------------------------------------------
+
+// リアクタでブロック中のドライバを起こす
+void interrupt_driver(AsyncRuntime* rt) {
+#ifdef CM_ASYNC_EPOLL
+    uint64_t one = 1;
+    ssize_t n = write(rt->wake_fd, &one, sizeof(one));
+    (void)n;
+#else
+    struct kevent ev;
+    EV_SET(&ev, 0, EVFILT_USER, 0, NOTE_TRIGGER, 0, nullptr);
+    kevent(rt->poll_fd, &ev, 1, nullptr, 0, nullptr);
+#endif
+}
+
+// 新しい仕事ができたことをアイドルワーカーに知らせる
+void notify_work(AsyncRuntime* rt) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (rt->sleepers.load(std::memory_order_seq_cst) > 0) {
+        pthread_mutex_lock(&rt->idle_mutex);
+        pthread_cond_signal(&rt->idle_cond);
+        pthread_mutex_unlock(&rt->idle_mutex);
+    } else if (rt->driver_parked.load(std::memory_order_seq_cst)) {
+        interrupt_driver(rt);
+    }
+}
+
+// ------------------------------------------------------------
+// キュー操作
+// ------------------------------------------------------------
+
+void inject(AsyncRuntime* rt, AsyncTask* task) {
+    task->next = nullptr;
+    pthread_mutex_lock(&rt->inject_mutex);
+    if (rt->inject_tail)
+        rt->inject_tail->next = task;
+    else
+        rt->inject_head = task;
+    rt->inject_tail = task;
+    rt->inject_len.fetch_add(1, std::memory_order_seq_cst);
+    pthread_mutex_unlock(&rt->inject_mutex);
+}
+
+AsyncTask* take_injected(AsyncRuntime* rt) {
+    if (rt->inject_len.load(std::memory_order_acquire) == 0)
+        return nullptr;
+    pthread_mutex_lock(&rt->inject_mutex);
+    AsyncTask* task = rt->inject_head;
+    if (task) {
+        rt->inject_head = task->next;
+        if (!rt->inject_head)
+            rt->inject_tail = nullptr;
+        rt->inject_len.fetch_sub(1, std::memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&rt->inject_mutex);
+    return task;
+}
+
+// スケジュール済みタスクをキューに積む（同じランタイムのワーカー上なら自分のデックへ）
+void enqueue(AsyncRuntime* rt, AsyncTask* task) {
+    Worker* self = tls_worker;
+    if (!(self && self->rt == rt && self->deque.push(task)))
+        inject(rt, task);
+    notify_work(rt);
+}
+
+// タスクを起こす（IDLE→SCHEDULED、実行中ならNOTIFIEDで再実行を予約）
+void wake_task(AsyncTask* task) {
+    int state = task->state.load(std::memory_order_acquire);
+    for (;;) {
+        if (state == TASK_IDLE) {
+            if (task->state.compare_exchange_weak(state, TASK_SCHEDULED,
+                                                  std::memory_order_acq_rel)) {
+                enqueue(task->rt, task);
+                return;
+            }
+        } else if (state == TASK_RUNNING) {
+            if (task->state.compare_exchange_weak(state, TASK_NOTIFIED,
+                                                  std::memory_order_acq_rel))
+                return;
+        } else {
+            return;
+        }
+    }
+}
+
+// 待機直前の確認（フェンスでnotify_work側と対になり、起床通知の取りこぼしを防ぐ）
+bool has_visible_work(AsyncRuntime* rt) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (rt->inject_len.load(std::memory_order_seq_cst) > 0)
+        return true;
+    for (Worker* w : rt->workers) {
+        if (!w->deque.empty())
+            return true;
+    }
+    return false;
+}
+
+AsyncTask* find_task(Worker* self) {
+    AsyncRuntime* rt = self->rt;
+    AsyncTask* task = self->deque.pop();
+    if (task)
+        return task;
+
+    task = take_injected(rt);
+    if (task)
+        return task;
+
+    // ランダムな位置から他ワーカーのデックを盗む
+    int n = static_cast<int>(rt->workers.size());
+    self->rng ^= self->rng << 13;
+    self->rng ^= self->rng >> 17;
+    self->rng ^= self->rng << 5;
+    int start = static_cast<int>(self->rng % static_cast<uint32_t>(n));
+    for (int i = 0; i < n; i++) {
+        Worker* victim = rt->workers[(start + i) % n];
+        if (victim == self)
+            continue;
+        task = victim->deque.steal();
+        if (task)
+            return task;
+    }
+    return nullptr;
+}
+
+// ------------------------------------------------------------
+// タスク実行
+// ------------------------------------------------------------
+
+void run_task(AsyncTask* task) {
+    task->state.store(TASK_RUNNING, std::memory_order_release);
+    tls_current_task = task;
+    int ready = task->fn(task->arg);
+    tls_current_task = nullptr;
+
+    if (ready != 0) {
+        AsyncRuntime* rt = task->rt;
+        task->state.store(TASK_DONE, std::memory_order_seq_cst);
+        rt->pending.fetch_sub(1, std::memory_order_seq_cst);
+        // 完了待ちがいる場合のみ起こす（タスクごとのロックを避ける）
+        if (rt->done_waiters.load(std::memory_order_seq_cst) > 0) {
+            pthread_mutex_lock(&rt->done_mutex);
+            pthread_cond_broadcast(&rt->done_cond);
+            pthread_mutex_unlock(&rt->done_mutex);
+        }
+        task_release(task);  // ランタイムの参照
+        return;
+    }
+
+    int expected = TASK_RUNNING;
+    if (!task->state.compare_exchange_strong(expected, TASK_IDLE, std::memory_order_acq_rel)) {
+        // ポーリング中に起こされた → 再スケジュール
+        task->state.store(TASK_SCHEDULED, std::memory_order_release);
+        enqueue(task->rt, task);
+    }
+}
+
+// ------------------------------------------------------------
+// リアクタ
+// ------------------------------------------------------------
+
+// 待機者の有無に合わせて監視対象を再設定（ワンショット）
+// reactor_mutexを保持して呼ぶこと
+int arm_fd(AsyncRuntime* rt, int fd) {
+    IoWaiters& w = rt->io[fd];
+#ifdef CM_ASYNC_EPOLL
+    struct epoll_event ev;
+    ev.events = EPOLLONESHOT;
+    if (w.reader)
+        ev.events |= EPOLLIN | EPOLLRDHUP;
+    if (w.writer)
+        ev.events |= EPOLLOUT;
+    ev.data.fd = fd;
+    int op = w.registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    int ret = epoll_ctl(rt->poll_fd, op, fd, &ev);
+    if (ret < 0 && op == EPOLL_CTL_MOD && errno == ENOENT)
+        ret = epoll_ctl(rt->poll_fd, EPOLL_CTL_ADD, fd, &ev);
+    if (ret == 0)
+        w.registered = true;
+    return ret;
+#else
+    struct kevent changes[2];
+    int n = 0;
+    if (w.reader)
+        EV_SET(&changes[n++], fd, EVFILT_READ, EV_ADD | EV_ONESHOT, 0, 0, nullptr);
+    if (w.writer)
+        EV_SET(&changes[n++], fd, EVFILT_WRITE, EV_ADD | EV_ONESHOT, 0, 0, nullptr);
+    w.registered = true;
+    return kevent(rt->poll_fd, changes, n, nullptr, 0, nullptr);
+#endif
+}
+
+int register_io(AsyncTask* task, int fd, bool write) {
+    AsyncRuntime* rt = task->rt;
+    if (fd < 0)
+        return -1;
+
+    pthread_mutex_lock(&rt->reactor_mutex);
+    if (static_cast<size_t>(fd) >= rt->io.size())
+        rt->io.resize(static_cast<size_t>(fd) * 2 + 1);
+
+    AsyncTask*& slot = write ? rt->io[fd].writer : rt->io[fd].reader;
+    if (slot != task) {
+        if (slot)
+            task_release(slot);
+        task->refcount.fetch_add(1, std::memory_order_relaxed);
+        slot = task;
+    }
+    int ret = arm_fd(rt, fd);
+    if (ret < 0) {
+        slot = nullptr;
+        task_release(task);
+    }
+    pthread_mutex_unlock(&rt->reactor_mutex);
+    return ret;
+}
+
+// I/Oイベントを処理してタスクを起こす
+void dispatch_io(AsyncRuntime* rt, int fd, bool readable, bool writable) {
+    AsyncTask* woken[2] = {nullptr, nullptr};
+
+    pthread_mutex_lock(&rt->reactor_mutex);
+    if (static_cast<size_t>(fd) < rt->io.size()) {
+        IoWaiters& w = rt->io[fd];
+        if (readable && w.reader) {
+            woken[0] = w.reader;
+            w.reader = nullptr;
+        }
+        if (writable && w.writer) {
+            woken[1] = w.writer;
+            w.writer = nullptr;
+        }
+        // 残った待機者のために再設定
+        if (w.reader || w.writer)
+            arm_fd(rt, fd);
+    }
+    pthread_mutex_unlock(&rt->reactor_mutex);
+
+    for (AsyncTask* task : woken) {
+        if (task) {
+            wake_task(task);
+            task_release(task);
+        }
+    }
+}
+
+// 満了したタイマーのタスクを起こし、次の満了までの待機時間を返す（なければ-1）
+int fire_timers(AsyncRuntime* rt) {
+    std::vector<AsyncTask*> expired;
+    int timeout = -1;
+
+    pthread_mutex_lock(&rt->reactor_mutex);
+    uint64_t now = now_ms();
+    while (!rt->timers.empty() && rt->timers.front().deadline <= now) {
+        std::pop_heap(rt->timers.begin(), rt->timers.end());
+        expired.push_back(rt->timers.back().task);
+        rt->timers.pop_back();
+    }
+    if (!rt->timers.empty()) {
+        uint64_t wait = rt->timers.front().deadline - now;
+        timeout = wait > 60000 ? 60000 : static_cast<int>(wait);
+    }
+    pthread_mutex_unlock(&rt->reactor_mutex);
+
+    for (AsyncTask* task : expired) {
+        wake_task(task);
+        task_release(task);
+    }
+    return timeout;
+}
+
+// ドライバとしてリアクタを1回ポーリング
+void drive_reactor(AsyncRuntime* rt, bool block) {
+    int timeout = fire_timers(rt);
+
+    rt->driver_parked.store(true, std::memory_order_seq_cst);
+    if (!block || has_visible_work(rt) || rt->shutdown.load(std::memory_order_acquire))
+        timeout = 0;
+
+#ifdef CM_ASYNC_EPOLL
+    struct epoll_event events[64];
+    int n = epoll_wait(rt->poll_fd, events, 64, timeout);
+    rt->driver_parked.store(false, std::memory_order_seq_cst);
+    for (int i = 0; i < n; i++) {
+        int fd = events[i].data.fd;
+        if (fd == rt->wake_fd) {
+            uint64_t value;
+            ssize_t r = read(rt->wake_fd, &value, sizeof(value));
+            (void)r;
+            continue;
+        }
+        uint32_t e = events[i].events;
+        bool error = (e & (EPOLLERR | EPOLLHUP)) != 0;
+        dispatch_io(rt, fd, error || (e & (EPOLLIN | EPOLLRDHUP)), error || (e & EPOLLOUT));
+    }
+#else
+    struct kevent events[64];
+    struct timespec ts;
+    struct timespec* tsp = nullptr;
+    if (timeout >= 0) {
+        ts.tv_sec = timeout / 1000;
+        ts.tv_nsec = (timeout % 1000) * 1000000L;
+        tsp = &ts;
+    }
+    int n = kevent(rt->poll_fd, nullptr, 0, events, 64, tsp);
+    rt->driver_parked.store(false, std::memory_order_seq_cst);
+    for (int i = 0; i < n; i++) {
+        if (events[i].filter == EVFILT_USER)
+            continue;
+        int fd = static_cast<int>(events[i].ident);
+        bool error = (events[i].flags & (EV_ERROR | EV_EOF)) != 0;
+        dispatch_io(rt, fd, error || events[i].filter == EVFILT_READ,
+                    error || events[i].filter == EVFILT_WRITE);
+    }
+#endif
+
+    fire_timers(rt);
+}
+
+// ------------------------------------------------------------
+// ワーカーループ
+// ------------------------------------------------------------
+
+void park(Worker* self) {
+    AsyncRuntime* rt = self->rt;
+
+    // 空いているワーカー1つがリアクタのドライバになる
+    bool expected = false;
+    if (rt->driver_active.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+        drive_reactor(rt, true);
+        rt->driver_active.store(false, std::memory_order_release);
+        // ドライバ役を空けたので、眠っているワーカーに引き継がせる
+        if (rt->sleepers.load(std::memory_order_seq_cst) > 0) {
+            pthread_mutex_lock(&rt->idle_mutex);
+            pthread_cond_signal(&rt->idle_cond);
+            pthread_mutex_unlock(&rt->idle_mutex);
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&rt->idle_mutex);
+    rt->sleepers.fetch_add(1, std::memory_order_seq_cst);
+    if (!has_visible_work(rt) && !rt->shutdown.load(std::memory_order_acquire) &&
+        rt->driver_active.load(std::memory_order_acquire)) {
+        pthread_cond_wait(&rt->idle_cond, &rt->idle_mutex);
+    }
+    rt->sleepers.fetch_sub(1, std::memory_order_seq_cst);
+    pthread_mutex_unlock(&rt->idle_mutex);
+}
+
+void* worker_main(void* arg) {
+    Worker* self = static_cast<Worker*>(arg);
+    AsyncRuntime* rt = self->rt;
+    tls_worker = self;
+
+    uint32_t tick = 0;
+    while (!rt->shutdown.load(std::memory_order_acquire)) {
+        AsyncTask* task = find_task(self);
+        if (task) {
+            run_task(task);
+            // 忙しい間もI/Oとタイマーを定期的に確認する
+            if ((++tick & 63) == 0) {
+                bool expected = false;
+                if (rt->driver_active.compare_exchange_strong(expected, true,
+                                                              std::memory_order_acq_rel)) {
+                    drive_reactor(rt, false);
+                    rt->driver_active.store(false, std::memory_order_release);
+                }
+            }
+            continue;
+        }
+        park(self);
+    }
+
+    tls_worker = nullptr;
+    return nullptr;
+}
+
+// ------------------------------------------------------------
+// グローバルランタイム
+// ------------------------------------------------------------
+
+pthread_once_t global_once = PTHREAD_ONCE_INIT;
+AsyncRuntime* global_runtime = nullptr;
+
+}  // namespace
+
+extern "C" {
+
+// ============================================================
+// ランタイム生成・破棄
+// ============================================================
+
+// ランタイムを生成
+// workers: ワーカースレッド数（0以下の場合はCPUコア数）
+// 戻り値: ランタイムハンドル（失敗時0）
+uint64_t cm_async_runtime_new(int32_t workers) {
+    if (workers <= 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = cores > 0 ? static_cast<int32_t>(cores) : 1;
+    }
+
+    auto* rt = new AsyncRuntime();
+    pthread_mutex_init(&rt->inject_mutex, nullptr);
+    pthread_mutex_init(&rt->idle_mutex, nullptr);
+    pthread_cond_init(&rt->idle_cond, nullptr);
+    pthread_mutex_init(&rt->done_mutex, nullptr);
+    pthread_cond_init(&rt->done_cond, nullptr);
+    pthread_mutex_init(&rt->reactor_mutex, nullptr);
+
+#ifdef CM_ASYNC_EPOLL
+    rt->poll_fd = epoll_create1(EPOLL_CLOEXEC);
+    rt->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (rt->poll_fd < 0 || rt->wake_fd < 0) {
+        delete rt;
+        return 0;
+    }
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = rt->wake_fd;
+    epoll_ctl(rt->poll_fd, EPOLL_CTL_ADD, rt->wake_fd, &ev);
+#else
+    rt->poll_fd = kqueue();
+    if (rt->poll_fd < 0) {
+        delete rt;
+        return 0;
+    }
+    struct kevent ev;
+    EV_SET(&ev, 0, EVFILT_USER, EV_ADD | EV_CLEAR, 0, 0, nullptr);
+    kevent(rt->poll_fd, &ev, 1, nullptr, 0, nullptr);
+#endif
+
+    for (int32_t i = 0; i < workers; i++) {
+        auto* w = new Worker();
+        w->rt = rt;
+        w->index = i;
+        w->rng = 0x9E3779B9u ^ static_cast<uint32_t>(i * 2654435761u);
+        rt->workers.push_back(w);
+    }
+    for (Worker* w : rt->workers) {
+        pthread_create(&w->thread, nullptr, worker_main, w);
+    }
+
+    return reinterpret_cast<uint64_t>(rt);
+}
+
+// 全タスクの完了を待機
+void cm_async_wait_all(uint64_t handle) {
+    auto* rt = reinterpret_cast<AsyncRuntime*>(handle);
+    if (!rt)
+        return;
+
+    pthread_mutex_lock(&rt->done_mutex);
+    rt->done_waiters.fetch_add(1, std::memory_order_seq_cst);
+    while (rt->pending.load(std::memory_order_seq_cst) > 0) {
+        pthread_cond_wait(&rt->done_cond, &rt->done_mutex);
+    }
+    rt->done_waiters.fetch_sub(1, std::memory_order_seq_cst);
+    pthread_mutex_unlock(&rt->done_mutex);
+}
+
+// ランタイムを停止して破棄（未完了タスクは破棄される）
+void cm_async_runtime_drop(uint64_t handle) {
+    auto* rt = reinterpret_cast<AsyncRuntime*>(handle);
+    if (!rt)
+        return;
+
+    rt->shutdown.store(true, std::memory_order_release);
+    pthread_mutex_lock(&rt->idle_mutex);
+    pthread_cond_broadcast(&rt->idle_cond);
+    pthread_mutex_unlock(&rt->idle_mutex);
+    interrupt_driver(rt);
+
+    for (Worker* w : rt->workers) {
+        pthread_join(w->thread, nullptr);
+    }
+
+    // 残ったタスクの参照を解放
+    for (Worker* w : rt->workers) {
+        while (AsyncTask* task = w->deque.pop())
+            task_release(task);
+        delete w;
+    }
+    while (AsyncTask* task = take_injected(rt))
+        task_release(task);
+    for (IoWaiters& w : rt->io) {
+        if (w.reader)
+            task_release(w.reader);
+        if (w.writer)
+            task_release(w.writer);
+    }
+    for (TimerEntry& t : rt->timers) {
+        task_release(t.task);
+    }
+
+    close(rt->poll_fd);
+#ifdef CM_ASYNC_EPOLL
+    close(rt->wake_fd);
+#endif
+    pthread_mutex_destroy(&rt->inject_mutex);
+    pthread_mutex_destroy(&rt->idle_mutex);
+    pthread_cond_destroy(&rt->idle_cond);
+    pthread_mutex_destroy(&rt->done_mutex);
+    pthread_cond_destroy(&rt->done_cond);
+    pthread_mutex_destroy(&rt->reactor_mutex);
+    delete rt;
+}
+
+// プロセス共通のランタイム（初回呼び出し時にCPUコア数のワーカーで起動）
+uint64_t cm_async_global() {
+    pthread_once(&global_once, [] {
+        global_runtime = reinterpret_cast<AsyncRuntime*>(cm_async_runtime_new(0));
+    });
+    return reinterpret_cast<uint64_t>(global_runtime);
+}
+
+// ワーカー数を取得
+int32_t cm_async_worker_count(uint64_t handle) {
+    auto* rt = reinterpret_cast<AsyncRuntime*>(handle);
+    return rt ? static_cast<int32_t>(rt->workers.size()) : 0;
+}
+
+// ============================================================
+// タスク
+// ============================================================
+
+// タスクをスポーン
+// fn: int (*)(void*) ポーリング関数（0=未完了, それ以外=完了）
+// 戻り値: タスクハンドル（cm_async_joinまたはcm_async_detachで解放する）
+uint64_t cm_async_spawn(uint64_t handle, void* fn, void* arg) {
+    auto* rt = reinterpret_cast<AsyncRuntime*>(handle);
+    if (!rt || !fn)
+        return 0;
+
+    auto* task = new AsyncTask();
+    task->fn = reinterpret_cast<int (*)(void*)>(fn);
+    task->arg = arg;
+    task->rt = rt;
+    task->state.store(TASK_SCHEDULED, std::memory_order_relaxed);
+    task->refcount.store(2, std::memory_order_relaxed);  // ハンドル + ランタイム
+    task->next = nullptr;
+
+    rt->pending.fetch_add(1, std::memory_order_acq_rel);
+    enqueue(rt, task);
+    return reinterpret_cast<uint64_t>(task);
+}
+
+// タスクの完了を待機してハンドルを解放
+void cm_async_join(uint64_t task_handle) {
+    auto* task = reinterpret_cast<AsyncTask*>(task_handle);
+    if (!task)
+        return;
+
+    AsyncRuntime* rt = task->rt;
+    pthread_mutex_lock(&rt->done_mutex);
+    rt->done_waiters.fetch_add(1, std::memory_order_seq_cst);
+    while (task->state.load(std::memory_order_seq_cst) != TASK_DONE) {
+        pthread_cond_wait(&rt->done_cond, &rt->done_mutex);
+    }
+    rt->done_waiters.fetch_sub(1, std::memory_order_seq_cst);
+    pthread_mutex_unlock(&rt->done_mutex);
+    task_release(task);
+}
+
+// タスクハンドルを解放（完了を待たない）
+void cm_async_detach(uint64_t task_handle) {
+    auto* task = reinterpret_cast<AsyncTask*>(task_handle);
+    if (task)
+        task_release(task);
+}
+
+// タスクが完了しているか
+bool cm_async_is_done(uint64_t task_handle) {
+    auto* task = reinterpret_cast<AsyncTask*>(task_handle);
+    return task && task->state.load(std::memory_order_acquire) == TASK_DONE;
+}
+
+// ============================================================
+// タスク内から呼ぶ起床条件の登録
+// いずれも0（PENDING）を返すので `return cm_async_wait_readable(fd);` と書ける
+// ============================================================
+
+// fdが読み込み可能になったら現在のタスクを起こす
+int32_t cm_async_wait_readable(int32_t fd) {
+    AsyncTask* task = tls_current_task;
+    if (!task)
+        return 0;
+    if (register_io(task, fd, false) < 0)
+        wake_task(task);  // 登録できない場合は再ポーリングさせてエラーを観測させる
+    return 0;
+}
+
+// fdが書き込み可能になったら現在のタスクを起こす
+int32_t cm_async_wait_writable(int32_t fd) {
+    AsyncTask* task = tls_current_task;
+    if (!task)
+        return 0;
+    if (register_io(task, fd, true) < 0)
+        wake_task(task);
+    return 0;
+}
+
+// 指定ミリ秒後に現在のタスクを起こす
+int32_t cm_async_wake_after(uint64_t ms) {
+    AsyncTask* task = tls_current_task;
+    if (!task)
+        return 0;
+
+    AsyncRuntime* rt = task->rt;
+    task->refcount.fetch_add(1, std::memory_order_relaxed);
+    pthread_mutex_lock(&rt->reactor_mutex);
+    rt->timers.push_back(TimerEntry{now_ms() + ms, task});
+    std::push_heap(rt->timers.begin(), rt->timers.end());
+    bool earliest = rt->timers.front().task == task;
+    pthread_mutex_unlock(&rt->reactor_mutex);
+
+    // ドライバが古い期限で待機中なら待ち時間を再計算させる
+    if (earliest && rt->driver_parked.load(std::memory_order_seq_cst))
+        interrupt_driver(rt);
+    return 0;
+}
+
+// 他のタスクに実行を譲り、すぐに再スケジュールされる
+int32_t cm_async_yield() {
+    AsyncTask* task = tls_current_task;
+    if (task)
+        wake_task(task);
+    return 0;
+}
+
+// 現在のワーカー番号（ワーカー外では-1）
+int32_t cm_async_worker_index() {
+    return tls_worker ? tls_worker->index : -1;
+}
+
+// 現在時刻（モノトニック、ミリ秒）
+uint64_t cm_async_now_ms() {
+    return now_ms();
+}
+
+}  // extern "C"
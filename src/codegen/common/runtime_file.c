@@ -12,6 +12,9 @@
 extern void* cm_alloc(size_t size);
 extern void cm_dealloc(void* ptr);
 
+// 標準出力のバッファ（runtime_platform.cから）
+extern void cm_flush_stdout(void);
+
 // 最大ファイルサイズ（10MB）
 #define CM_MAX_FILE_SIZE (10 * 1024 * 1024)
 
@@ -135,6 +138,8 @@ long cm_file_size(const char* path) {
 char* cm_read_line(void) {
     char buffer[4096];
 
+    // プロンプトが見えるよう、読み込み前に標準出力を書き出す
+    cm_flush_stdout();
     if (fgets(buffer, sizeof(buffer), stdin) == NULL) {
         char* empty = (char*)cm_alloc(1);
         empty[0] = '\0';
@@ -157,6 +162,7 @@ char* cm_read_line(void) {
 /// 整数読み込み（stdin）
 int cm_read_int(void) {
     int value = 0;
+    cm_flush_stdout();
     if (scanf("%d", &value) != 1) {
         return 0;
     }
@@ -169,6 +175,7 @@ int cm_read_int(void) {
 
 /// 文字読み込み（stdin）
 char cm_read_char(void) {
+    cm_flush_stdout();
     int c = getchar();
     // 残りの改行を消費
     if (c != '\n') {
@@ -39,6 +39,17 @@ char* cm_strstr(const char* haystack, const char* needle);
 void cm_write_stdout(const char* str, size_t len);
 void cm_write_stderr(const char* str, size_t len);
 
+// 標準出力のバッファリング方針
+// 既定: 端末なら行バッファ、それ以外（パイプ・ファイル）はブロックバッファ
+// 環境変数 CM_STDOUT_BUFFER=line|block|none で起動時に上書きできる
+#define CM_STDOUT_UNBUFFERED 0
+#define CM_STDOUT_LINE_BUFFERED 1
+#define CM_STDOUT_BLOCK_BUFFERED 2
+
+void cm_flush_stdout(void);
+void cm_set_stdout_buffering(int mode);
+int cm_get_stdout_buffering(void);
+
 // ============================================================
 // Memory Operations
 // ============================================================
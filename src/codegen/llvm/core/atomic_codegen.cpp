@@ -0,0 +1,278 @@
+/// @file atomic_codegen.cpp
+/// @brief アトミック操作のネイティブ命令生成
+/// sync_runtimeのcm_atomic_*呼び出しを atomicrmw / cmpxchg / load atomic / fence に展開する
+
+#include "intrinsics.hpp"
+#include "mir_to_llvm.hpp"
+
+#include <vector>
+
+namespace cm::codegen::llvm_backend {
+
+namespace {
+
+/// C11のメモリオーダー値をLLVMのAtomicOrderingに変換
+llvm::AtomicOrdering toLLVMOrdering(int64_t order) {
+    switch (order) {
+        case ATOMIC_ORDER_RELAXED:
+            return llvm::AtomicOrdering::Monotonic;
+        case ATOMIC_ORDER_CONSUME:
+        case ATOMIC_ORDER_ACQUIRE:
+            return llvm::AtomicOrdering::Acquire;
+        case ATOMIC_ORDER_RELEASE:
+            return llvm::AtomicOrdering::Release;
+        case ATOMIC_ORDER_ACQ_REL:
+            return llvm::AtomicOrdering::AcquireRelease;
+        default:
+            return llvm::AtomicOrdering::SequentiallyConsistent;
+    }
+}
+
+/// 操作ごとに不正なオーダーを有効な最も近いものへ丸める
+/// （loadにrelease、storeにacquireは指定できない）
+llvm::AtomicOrdering adjustOrdering(AtomicOp op, llvm::AtomicOrdering order) {
+    if (op == AtomicOp::Load) {
+        if (order == llvm::AtomicOrdering::Release)
+            return llvm::AtomicOrdering::Monotonic;
+        if (order == llvm::AtomicOrdering::AcquireRelease)
+            return llvm::AtomicOrdering::Acquire;
+    } else if (op == AtomicOp::Store) {
+        if (order == llvm::AtomicOrdering::Acquire)
+            return llvm::AtomicOrdering::Monotonic;
+        if (order == llvm::AtomicOrdering::AcquireRelease)
+            return llvm::AtomicOrdering::Release;
+    }
+    return order;
+}
+
+/// cmpxchg失敗時のオーダー（失敗時はloadのみなのでreleaseを含められない）
+llvm::AtomicOrdering failureOrdering(llvm::AtomicOrdering order) {
+    switch (order) {
+        case llvm::AtomicOrdering::Release:
+            return llvm::AtomicOrdering::Monotonic;
+        case llvm::AtomicOrdering::AcquireRelease:
+            return llvm::AtomicOrdering::Acquire;
+        default:
+            return order;
+    }
+}
+
+llvm::AtomicRMWInst::BinOp toRMWOp(AtomicOp op) {
+    switch (op) {
+        case AtomicOp::Exchange:
+            return llvm::AtomicRMWInst::Xchg;
+        case AtomicOp::FetchAdd:
+            return llvm::AtomicRMWInst::Add;
+        case AtomicOp::FetchSub:
+            return llvm::AtomicRMWInst::Sub;
+        case AtomicOp::FetchAnd:
+            return llvm::AtomicRMWInst::And;
+        case AtomicOp::FetchOr:
+            return llvm::AtomicRMWInst::Or;
+        default:
+            return llvm::AtomicRMWInst::Xor;
+    }
+}
+
+}  // namespace
+
+bool MIRToLLVM::generateAtomicCall(const mir::MirTerminator::CallData& callData,
+                                   const std::string& funcName) {
+    const AtomicIntrinsic* info = IntrinsicsManager::lookupAtomic(funcName);
+    if (!info) {
+        return false;
+    }
+
+    // 同名のCm関数（extern "C" 以外）はユーザー定義として通常呼び出しにする
+    auto isUserDefined = [&](const mir::MirFunction* func) {
+        return func && func->name == funcName && !func->is_extern;
+    };
+    if (currentProgram) {
+        for (const auto& func : currentProgram->functions) {
+            if (isUserDefined(func.get())) {
+                return false;
+            }
+        }
+    } else {
+        for (const auto* func : allModuleFunctions) {
+            if (isUserDefined(func)) {
+                return false;
+            }
+        }
+    }
+
+    // 引数の数: ptr [, value | expected, desired] [, order]
+    size_t expectedArgs = 0;
+    switch (info->op) {
+        case AtomicOp::Fence:
+            expectedArgs = 0;
+            break;
+        case AtomicOp::Load:
+            expectedArgs = 1;
+            break;
+        case AtomicOp::CompareExchange:
+            expectedArgs = 3;
+            break;
+        default:
+            expectedArgs = 2;
+            break;
+    }
+    if (info->explicitOrder) {
+        expectedArgs++;
+    }
+    if (callData.args.size() != expectedArgs) {
+        return false;
+    }
+
+    std::vector<llvm::Value*> args;
+    for (const auto& arg : callData.args) {
+        args.push_back(convertOperand(*arg));
+    }
+
+    llvm::Value* orderValue = nullptr;
+    if (info->explicitOrder) {
+        orderValue = args.back();
+        args.pop_back();
+    }
+
+    llvm::IntegerType* valueType = nullptr;
+    llvm::Value* ptr = nullptr;
+    if (info->op != AtomicOp::Fence) {
+        valueType = llvm::IntegerType::get(ctx.getContext(), info->bits);
+        ptr = args[0];
+#if LLVM_VERSION_MAJOR < 15
+        // LLVM 14: typed pointers require bitcast
+        ptr = builder->CreatePointerCast(ptr, llvm::PointerType::get(valueType, 0), "atomic_ptr");
+#endif
+        // 値引数は要素幅に合わせる（定数がi32で渡される場合など）
+        for (size_t i = 1; i < args.size(); ++i) {
+            if (info->op == AtomicOp::CompareExchange && i == 1) {
+                continue;  // expectedはポインタ
+            }
+            if (args[i]->getType()->isIntegerTy() && args[i]->getType() != valueType) {
+                args[i] = builder->CreateSExtOrTrunc(args[i], valueType);
+            }
+        }
+    }
+    auto align = llvm::Align(info->bits / 8 > 0 ? info->bits / 8 : 1);
+
+    // 指定オーダーで1命令を生成（戻り値なしの操作はnullptr）
+    auto emit = [&](llvm::AtomicOrdering order) -> llvm::Value* {
+        order = adjustOrdering(info->op, order);
+        switch (info->op) {
+            case AtomicOp::Fence:
+                // relaxedのfenceは何もしない
+                if (order != llvm::AtomicOrdering::Monotonic) {
+                    builder->CreateFence(order);
+                }
+                return nullptr;
+            case AtomicOp::Load: {
+                auto load = builder->CreateLoad(valueType, ptr, "atomic_load");
+                load->setAtomic(order);
+                load->setAlignment(align);
+                return load;
+            }
+            case AtomicOp::Store: {
+                auto store = builder->CreateStore(args[1], ptr);
+                store->setAtomic(order);
+                store->setAlignment(align);
+                return nullptr;
+            }
+            case AtomicOp::CompareExchange: {
+                llvm::Value* expectedPtr = args[1];
+#if LLVM_VERSION_MAJOR < 15
+                expectedPtr = builder->CreatePointerCast(
+                    expectedPtr, llvm::PointerType::get(valueType, 0), "expected_ptr");
+#endif
+                auto expected = builder->CreateLoad(valueType, expectedPtr, "expected");
+                auto cmpxchg = builder->CreateAtomicCmpXchg(ptr, expected, args[2], align, order,
+                                                            failureOrdering(order));
+                // 失敗時は現在値をexpectedへ書き戻す（成功時は同じ値なので無条件で良い）
+                auto observed = builder->CreateExtractValue(cmpxchg, 0, "observed");
+                builder->CreateStore(observed, expectedPtr);
+                return builder->CreateExtractValue(cmpxchg, 1, "cas_ok");
+            }
+            default:
+                return builder->CreateAtomicRMW(toRMWOp(info->op), ptr, args[1], align, order);
+        }
+    };
+
+    llvm::Value* result = nullptr;
+    auto constOrder = orderValue ? llvm::dyn_cast<llvm::ConstantInt>(orderValue) : nullptr;
+    if (!orderValue) {
+        result = emit(llvm::AtomicOrdering::SequentiallyConsistent);
+    } else if (constOrder) {
+        result = emit(toLLVMOrdering(constOrder->getSExtValue()));
+    } else {
+        // オーダーが実行時値の場合はswitchで分岐する
+        // （ラッパー関数がインライン化されれば定数畳み込みで1命令に戻る）
+        auto func = builder->GetInsertBlock()->getParent();
+        auto orderType = llvm::cast<llvm::IntegerType>(orderValue->getType());
+        auto contBB = llvm::BasicBlock::Create(ctx.getContext(), "atomic_cont", func);
+        auto seqCstBB = llvm::BasicBlock::Create(ctx.getContext(), "atomic_seq_cst", func);
+        auto sw = builder->CreateSwitch(orderValue, seqCstBB, 5);
+
+        const std::pair<int, llvm::AtomicOrdering> cases[] = {
+            {ATOMIC_ORDER_RELAXED, llvm::AtomicOrdering::Monotonic},
+            {ATOMIC_ORDER_CONSUME, llvm::AtomicOrdering::Acquire},
+            {ATOMIC_ORDER_ACQUIRE, llvm::AtomicOrdering::Acquire},
+            {ATOMIC_ORDER_RELEASE, llvm::AtomicOrdering::Release},
+            {ATOMIC_ORDER_ACQ_REL, llvm::AtomicOrdering::AcquireRelease},
+        };
+        std::vector<std::pair<llvm::Value*, llvm::BasicBlock*>> incoming;
+        std::vector<std::pair<llvm::AtomicOrdering, llvm::BasicBlock*>> orderBlocks;
+        for (const auto& [value, order] : cases) {
+            llvm::BasicBlock* bb = nullptr;
+            for (const auto& [o, b] : orderBlocks) {
+                if (o == order) {
+                    bb = b;
+                }
+            }
+            if (!bb) {
+                bb = llvm::BasicBlock::Create(ctx.getContext(), "atomic_order", func, seqCstBB);
+                orderBlocks.push_back({order, bb});
+                builder->SetInsertPoint(bb);
+                auto v = emit(order);
+                incoming.push_back({v, builder->GetInsertBlock()});
+                builder->CreateBr(contBB);
+            }
+            sw->addCase(llvm::ConstantInt::get(orderType, value), bb);
+        }
+        builder->SetInsertPoint(seqCstBB);
+        auto v = emit(llvm::AtomicOrdering::SequentiallyConsistent);
+        incoming.push_back({v, builder->GetInsertBlock()});
+        builder->CreateBr(contBB);
+
+        builder->SetInsertPoint(contBB);
+        if (incoming.front().first) {
+            auto phi = builder->CreatePHI(incoming.front().first->getType(), incoming.size(),
+                                          "atomic_result");
+            for (const auto& [value, bb] : incoming) {
+                phi->addIncoming(value, bb);
+            }
+            result = phi;
+        }
+    }
+
+    // 結果を格納（boolはメモリ上i8、C版の戻り値はi32なので宛先の型に合わせる）
+    if (result && callData.destination) {
+        auto destLocal = callData.destination->local;
+        if (allocatedLocals.count(destLocal) > 0 && locals[destLocal]) {
+            if (auto alloca = llvm::dyn_cast<llvm::AllocaInst>(locals[destLocal])) {
+                auto destType = alloca->getAllocatedType();
+                if (destType->isIntegerTy() && destType != result->getType()) {
+                    result = builder->CreateZExtOrTrunc(result, destType);
+                }
+            }
+            builder->CreateStore(result, locals[destLocal]);
+        } else {
+            if (result->getType()->isIntegerTy(1)) {
+                result = builder->CreateZExt(result, ctx.getI8Type());
+            }
+            locals[destLocal] = result;
+        }
+    }
+    return true;
+}
+
+}  // namespace cm::codegen::llvm_backend
@@ -5,9 +5,44 @@
 #include <llvm/Config/llvm-config.h>  // LLVM_VERSION_MAJOR を定義（最初にインクルード）
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Intrinsics.h>
+#include <string>
+#include <unordered_map>
+#include <utility>
 
 namespace cm::codegen::llvm_backend {
 
+/// アトミック操作の種類
+enum class AtomicOp {
+    Load,
+    Store,
+    Exchange,
+    FetchAdd,
+    FetchSub,
+    FetchAnd,
+    FetchOr,
+    FetchXor,
+    CompareExchange,
+    Fence,
+};
+
+/// アトミック組み込み関数の情報
+/// explicitOrder=true の場合、最後の引数がメモリオーダー（C11の__ATOMIC_*と同じ値）
+struct AtomicIntrinsic {
+    AtomicOp op;
+    unsigned bits;
+    bool explicitOrder;
+};
+
+/// メモリオーダー定数（std::sync::atomic の RELAXED 等と一致）
+enum AtomicOrderValue : int {
+    ATOMIC_ORDER_RELAXED = 0,
+    ATOMIC_ORDER_CONSUME = 1,
+    ATOMIC_ORDER_ACQUIRE = 2,
+    ATOMIC_ORDER_RELEASE = 3,
+    ATOMIC_ORDER_ACQ_REL = 4,
+    ATOMIC_ORDER_SEQ_CST = 5,
+};
+
 /// 組み込み関数管理
 class IntrinsicsManager {
    private:
@@ -33,10 +68,8 @@ class IntrinsicsManager {
         // ビット操作
         declareBitIntrinsics();
 
-        // アトミック操作
-        if (!config.noStd) {
-            declareAtomicIntrinsics();
-        }
+        // アトミック操作は関数宣言を持たず、呼び出し時にネイティブ命令へ展開する
+        // （lookupAtomic / MIRToLLVM::generateAtomicCall を参照）
 
         // プラットフォーム固有
         declarePlatformSpecific();
@@ -57,6 +90,40 @@ class IntrinsicsManager {
         return nullptr;
     }
 
+    /// sync_runtime のアトミック関数名をネイティブ命令に対応付ける
+    /// 該当しない場合はnullptr（通常の外部関数呼び出しとして扱う）
+    static const AtomicIntrinsic* lookupAtomic(const std::string& name) {
+        static const std::unordered_map<std::string, AtomicIntrinsic> table = [] {
+            std::unordered_map<std::string, AtomicIntrinsic> t;
+            const std::pair<const char*, AtomicOp> ops[] = {
+                {"load", AtomicOp::Load},
+                {"store", AtomicOp::Store},
+                {"exchange", AtomicOp::Exchange},
+                {"fetch_add", AtomicOp::FetchAdd},
+                {"fetch_sub", AtomicOp::FetchSub},
+                {"fetch_and", AtomicOp::FetchAnd},
+                {"fetch_or", AtomicOp::FetchOr},
+                {"fetch_xor", AtomicOp::FetchXor},
+                {"compare_exchange", AtomicOp::CompareExchange},
+            };
+            for (const auto& [opName, op] : ops) {
+                for (unsigned bits : {32u, 64u}) {
+                    std::string suffix = std::string(opName) + "_i" + std::to_string(bits);
+                    // 従来API（常にseq_cst）: cm_atomic_* / atomic_*
+                    t["cm_atomic_" + suffix] = {op, bits, false};
+                    t["atomic_" + suffix] = {op, bits, false};
+                    // メモリオーダー指定版: cm_atomic_*_explicit_iN
+                    t["cm_atomic_" + std::string(opName) + "_explicit_i" + std::to_string(bits)] =
+                        {op, bits, true};
+                }
+            }
+            t["cm_atomic_fence"] = {AtomicOp::Fence, 0, true};
+            return t;
+        }();
+        auto it = table.find(name);
+        return it != table.end() ? &it->second : nullptr;
+    }
+
    private:
     /// メモリ操作組み込み
     void declareMemoryIntrinsics() {
@@ -168,19 +235,6 @@ class IntrinsicsManager {
         declareBitFunc2("cttz.i64", llvm::Type::getInt64Ty(ctx));
     }
 
-    /// アトミック操作組み込み
-    void declareAtomicIntrinsics() {
-        // fence
-        auto fenceType = llvm::FunctionType::get(llvm::Type::getVoidTy(*context),
-                                                 {llvm::Type::getInt32Ty(*context)},  // ordering
-                                                 false);
-        auto fence = llvm::Function::Create(fenceType, llvm::Function::ExternalLinkage,
-                                            "__cm_atomic_fence", module);
-        intrinsics["atomic.fence"] = fence;
-
-        // TODO: atomic load/store/cmpxchg
-    }
-
     /// プラットフォーム固有組み込み
     void declarePlatformSpecific() {
         if (config.target == BuildTarget::Baremetal) {
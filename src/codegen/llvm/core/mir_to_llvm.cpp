@@ -6,7 +6,9 @@
 #include "../../../common/debug/codegen.hpp"
 #include "../monitoring/compilation_guard.hpp"
 
+#include <llvm/IR/GetElementPtrTypeIterator.h>
 #include <llvm/IR/InlineAsm.h>
+#include <llvm/IR/Operator.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/Support/raw_ostream.h>
 #include <map>
@@ -1065,6 +1067,7 @@ void MIRToLLVM::convertFunction(const mir::MirFunction& func) {
         locals.clear();
         blocks.clear();
         allocatedLocals.clear();
+        volatileLocals.clear();
         // NOTE: heapAllocatedLocalsはベアメタル対応のため削除（malloc不使用）
 
         // Bug#12修正: naked関数（ret/iret含むASM）の専用コード生成パス
@@ -1223,6 +1226,7 @@ void MIRToLLVM::convertFunction(const mir::MirFunction& func) {
                 }
             }
         }
+        volatileLocals.insert(asmOutputLocals.begin(), asmOutputLocals.end());
 
         // エントリーブロック作成
         auto entryBB = llvm::BasicBlock::Create(ctx.getContext(), "entry", currentFunction);
@@ -1393,6 +1397,7 @@ void MIRToLLVM::convertFunction(const mir::MirFunction& func) {
                         if (it != globalVariables.end()) {
                             locals[i] = it->second;
                             allocatedLocals.insert(i);
+                            volatileLocals.insert(i);
                         }
                     } else if (local.is_static) {
                         std::string staticKey = func.name + "_" + local.name;
@@ -1409,6 +1414,7 @@ void MIRToLLVM::convertFunction(const mir::MirFunction& func) {
                             locals[i] = it->second;
                         }
                         allocatedLocals.insert(i);  // グローバル変数もallocated扱い
+                        volatileLocals.insert(i);
                     } else {
                         auto alloca =
                             builder->CreateAlloca(llvmType, nullptr, "local_" + std::to_string(i));
@@ -1534,6 +1540,9 @@ void MIRToLLVM::convertFunction(const mir::MirFunction& func) {
 
             // std::cerr << "[MIR2LLVM]   Block " << i << " converted successfully\n";
         }
+
+        // 生成した全load/storeに型ベースのエイリアス情報を付与
+        attachTBAA(*currentFunction);
     } catch (const std::runtime_error& e) {
         // 無限ループエラーのハンドリング
         guard.handle_infinite_loop_error(e);
@@ -2196,9 +2205,10 @@ void MIRToLLVM::convertStatement(const mir::MirStatement& stmt) {
                                                       llvm::MaybeAlign(), payloadSize);
                             } else {
                                 // 通常のStore操作を実行
-                                // asm出力で変更される変数へのstoreはvolatileにして最適化を防止
+                                // asm出力で変更される変数・グローバル変数へのstoreは
+                                // フィールド/要素も含めてvolatileにして最適化を防止
                                 auto* storeInst = builder->CreateStore(rvalue, addr);
-                                if (isAllocated) {
+                                if (volatileLocals.count(assign.place.local) > 0) {
                                     storeInst->setVolatile(true);
                                 }
                             }
@@ -2424,6 +2434,7 @@ void MIRToLLVM::convertStatement(const mir::MirStatement& stmt) {
                                     builder->CreateAlloca(elemType, nullptr, "asm_mem_out");
                                 localPtr = alloca;
                                 allocatedLocals.insert(operand.local_id);
+                                volatileLocals.insert(operand.local_id);
                             }
                             // メモリ出力として記録（後で入力に追加）
                             memOutputPtrs.push_back(localPtr);
@@ -2452,6 +2463,7 @@ void MIRToLLVM::convertStatement(const mir::MirStatement& stmt) {
                                 // allocaからvolatile loadで値を読み取れるようにする
                                 locals[operand.local_id] = alloca;
                                 allocatedLocals.insert(operand.local_id);
+                                volatileLocals.insert(operand.local_id);
                             }
                             outputPtrs.push_back(localPtr);
                             outputTypes.push_back(elemType);  // 出力の型を記録
@@ -2809,8 +2821,9 @@ void MIRToLLVM::convertStatement(const mir::MirStatement& stmt) {
                         if (llvm::isa<llvm::PointerType>(outputPtr->getType())) {
                             auto* storeInst = builder->CreateStore(outputValue, outputPtr);
                             storeInst->setVolatile(true);
-                            // allocatedLocalsに追加してvolatile loadを強制
+                            // volatileLocalsに追加してvolatile loadを強制
                             allocatedLocals.insert(local_id);
+                            volatileLocals.insert(local_id);
                         } else {
                             // 直接SSA値として格納（fallback）
                             locals[local_id] = outputValue;
@@ -2860,6 +2873,7 @@ void MIRToLLVM::convertStatement(const mir::MirStatement& stmt) {
                         // メモリ出力のローカル変数をallocatedLocalsに追加
                         for (const auto& local_id : memOutputLocalIds) {
                             allocatedLocals.insert(local_id);
+                            volatileLocals.insert(local_id);
                         }
                     }
 
@@ -3213,13 +3227,17 @@ llvm::Value* MIRToLLVM::convertRvalue(const mir::MirRvalue& rvalue) {
                 auto srcBits = sourceType->getIntegerBitWidth();
                 auto dstBits = targetType->getIntegerBitWidth();
                 if (srcBits < dstBits) {
-                    // unsigned型（UTiny,UShort,UInt,ULong）へのキャストはゼロ拡張
-                    bool use_zext = false;
-                    if (castData.target_type) {
-                        auto kind = castData.target_type->kind;
-                        use_zext = (kind == hir::TypeKind::UTiny || kind == hir::TypeKind::UShort ||
-                                    kind == hir::TypeKind::UInt || kind == hir::TypeKind::ULong);
-                    }
+                    // unsigned型（UTiny,UShort,UInt,ULong）からの/へのキャストはゼロ拡張
+                    auto is_unsigned_kind = [](const hir::TypePtr& type) {
+                        if (!type) {
+                            return false;
+                        }
+                        auto kind = type->kind;
+                        return kind == hir::TypeKind::UTiny || kind == hir::TypeKind::UShort ||
+                               kind == hir::TypeKind::UInt || kind == hir::TypeKind::ULong;
+                    };
+                    bool use_zext = is_unsigned_kind(castData.target_type) ||
+                                    is_unsigned_kind(getOperandType(*castData.operand));
                     if (use_zext) {
                         return builder->CreateZExt(value, targetType, "zext");
                     }
@@ -3959,7 +3977,7 @@ llvm::Value* MIRToLLVM::convertOperand(const mir::MirOperand& operand) {
                 // スカラー型の場合はロード
                 // asm出力で変更される可能性がある変数はvolatile loadで最適化を防止
                 auto* loadInst = builder->CreateLoad(allocatedType, val, "load");
-                if (allocatedLocals.count(local) > 0) {
+                if (volatileLocals.count(local) > 0) {
                     // asm影響変数: volatile loadで最適化を抑制
                     if (auto* li = llvm::dyn_cast<llvm::LoadInst>(loadInst)) {
                         li->setVolatile(true);
@@ -4061,6 +4079,119 @@ llvm::Value* MIRToLLVM::convertOperand(const mir::MirOperand& operand) {
     }
 }
 
+// 関数内の全load/storeへのTBAAタグ付与
+void MIRToLLVM::attachTBAA(llvm::Function& func) {
+    if (!tbaaEnabled) {
+        return;
+    }
+    for (auto& bb : func) {
+        for (auto& inst : bb) {
+            if (auto* load = llvm::dyn_cast<llvm::LoadInst>(&inst)) {
+                attachTBAA(load, load->getPointerOperand(), load->getType());
+            } else if (auto* store = llvm::dyn_cast<llvm::StoreInst>(&inst)) {
+                attachTBAA(store, store->getPointerOperand(), store->getValueOperand()->getType());
+            }
+        }
+    }
+}
+
+// load/storeへのTBAAタグ付与
+void MIRToLLVM::attachTBAA(llvm::Instruction* inst, llvm::Value* addr, llvm::Type* accessType) {
+    if (!tbaaEnabled || !inst || !addr || !accessType) {
+        return;
+    }
+    // volatile/atomicアクセスは対象外（asm出力・同期用のアクセスを並べ替えさせない）
+    if (auto* load = llvm::dyn_cast<llvm::LoadInst>(inst)) {
+        if (load->isVolatile() || load->isAtomic()) {
+            return;
+        }
+    } else if (auto* store = llvm::dyn_cast<llvm::StoreInst>(inst)) {
+        if (store->isVolatile() || store->isAtomic()) {
+            return;
+        }
+    } else {
+        return;
+    }
+
+    if (!tbaa) {
+        tbaa = std::make_unique<TBAAManager>(ctx.getContext(), *module);
+    }
+
+    // スカラー以外（構造体・配列のまとめてのload/store）は対象外
+    llvm::MDNode* charTag = tbaa->getScalarAccessTag(accessType) ? tbaa->getCharAccessTag()
+                                                                  : nullptr;
+    if (!charTag) {
+        return;
+    }
+
+    // MIRで定義された構造体か（Tagged Union・interface fat pointer・推論構造体は
+    // 同じ領域を別の型で読み書きし得るため除外）
+    auto isMIRStruct = [this](llvm::StructType* structType) {
+        if (!structType->hasName()) {
+            return false;
+        }
+        auto name = structType->getName().str();
+        auto typeIt = structTypes.find(name);
+        return structDefs.count(name) && typeIt != structTypes.end() &&
+               typeIt->second == structType;
+    };
+
+    // 型付きのタグは、ローカル変数・グローバル変数から型どおりにたどれるアクセスだけに付ける
+    // ポインタ経由（引数・メモリから読んだポインタ・キャスト）のアクセスはvoid*経由の
+    // 型の読み替えがあり得るため、全型とエイリアスするcharタグにする
+    std::vector<llvm::GEPOperator*> geps;
+    llvm::Value* base = addr;
+    while (auto* gep = llvm::dyn_cast<llvm::GEPOperator>(base)) {
+        geps.push_back(gep);
+        base = gep->getPointerOperand();
+    }
+
+    llvm::Type* objectType = nullptr;
+    if (auto* alloca = llvm::dyn_cast<llvm::AllocaInst>(base)) {
+        objectType = alloca->getAllocatedType();
+    } else if (auto* global = llvm::dyn_cast<llvm::GlobalVariable>(base)) {
+        objectType = global->getValueType();
+    }
+
+    // 外側のGEPへ向かって型をたどる（経路上の構造体はすべてMIR定義であること）
+    for (auto it = geps.rbegin(); objectType && it != geps.rend(); ++it) {
+        auto* gep = *it;
+        if (gep->getSourceElementType() != objectType) {
+            objectType = nullptr;
+            break;
+        }
+        for (auto ti = llvm::gep_type_begin(gep), te = llvm::gep_type_end(gep); ti != te; ++ti) {
+            if (auto* structType = ti.getStructTypeOrNull()) {
+                if (!isMIRStruct(structType)) {
+                    objectType = nullptr;
+                    break;
+                }
+            }
+        }
+        if (objectType) {
+            objectType = gep->getResultElementType();
+        }
+    }
+
+    llvm::MDNode* tag = charTag;
+    if (objectType == accessType) {
+        // 直接のGEPが構造体フィールドを指す場合はstruct-path、それ以外はスカラータグ
+        llvm::MDNode* typedTag = nullptr;
+        if (!geps.empty() && geps.front()->getNumIndices() == 2) {
+            auto* gep = geps.front();
+            auto* structType = llvm::dyn_cast<llvm::StructType>(gep->getSourceElementType());
+            auto* idx = llvm::dyn_cast<llvm::ConstantInt>(gep->getOperand(2));
+            if (structType && idx) {
+                typedTag = tbaa->getFieldAccessTag(
+                    structType, static_cast<unsigned>(idx->getZExtValue()), accessType);
+            }
+        }
+        tag = typedTag ? typedTag : tbaa->getScalarAccessTag(accessType);
+    }
+
+    inst->setMetadata(llvm::LLVMContext::MD_tbaa, tag);
+}
+
 // Place変換（アドレス取得）
 llvm::Value* MIRToLLVM::convertPlaceToAddress(const mir::MirPlace& place) {
     auto addr = locals[place.local];
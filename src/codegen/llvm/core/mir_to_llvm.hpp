@@ -3,10 +3,12 @@
 #include "../../../mir/mir_splitter.hpp"
 #include "../../../mir/nodes.hpp"
 #include "context.hpp"
+#include "tbaa.hpp"
 
 #include <llvm/IR/BasicBlock.h>
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Value.h>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -29,6 +31,8 @@ class MIRToLLVM {
 
     // allocaされた変数のセット（SSA代入で上書きされないようにする）
     std::unordered_set<mir::LocalId> allocatedLocals;
+    // volatileでload/storeするローカル（asmオペランド・グローバル/static変数）
+    std::unordered_set<mir::LocalId> volatileLocals;
 
     // 基本ブロックマッピング
     std::unordered_map<mir::BlockId, llvm::BasicBlock*> blocks;
@@ -68,6 +72,10 @@ class MIRToLLVM {
     bool isWasmTarget = false;  // WASMターゲットかどうか（境界チェックで使用）
     bool isUefiTarget = false;  // UEFIターゲットかどうか（Win64 ABI適用に使用）
 
+    // TBAAメタデータ（load/storeに型ベースのエイリアス情報を付与）
+    bool tbaaEnabled = true;
+    std::unique_ptr<TBAAManager> tbaa;
+
    public:
     /// コンストラクタ
     explicit MIRToLLVM(LLVMContext& context)
@@ -80,6 +88,9 @@ class MIRToLLVM {
     /// ModuleProgramのextern関数はdeclareのみ、自モジュール関数は完全変換
     void convert(const mir::ModuleProgram& module);
 
+    /// TBAAメタデータ付与の有効/無効（--no-tbaa で無効化）
+    void setTBAAEnabled(bool enabled) { tbaaEnabled = enabled; }
+
     /// 型変換（公開：関数シグネチャ生成で使用）
     llvm::Type* convertType(const hir::TypePtr& type);
 
@@ -112,6 +123,14 @@ class MIRToLLVM {
     /// オペランド変換
     llvm::Value* convertOperand(const mir::MirOperand& operand);
 
+    /// 関数内の全load/storeにTBAAタグを付与
+    void attachTBAA(llvm::Function& func);
+
+    /// load/storeにTBAAタグを付与
+    /// ローカル変数・グローバル変数から型どおりにたどれるアクセスには型付きのタグ
+    /// （構造体フィールドはstruct-path）、ポインタ経由のアクセスにはcharタグを付与する
+    void attachTBAA(llvm::Instruction* inst, llvm::Value* addr, llvm::Type* accessType);
+
     /// Place変換（アドレス取得）
     llvm::Value* convertPlaceToAddress(const mir::MirPlace& place);
 
@@ -190,6 +209,15 @@ class MIRToLLVM {
     /// フォーマット置換を生成（replace系関数の呼び出し）
     llvm::Value* generateFormatReplace(llvm::Value* currentStr, llvm::Value* value,
                                        const hir::TypePtr& hirType);
+
+    // ============================================================
+    // Atomic Helper Methods (implemented in atomic_codegen.cpp)
+    // ============================================================
+
+    /// sync_runtimeのアトミック関数呼び出しをネイティブ命令で生成
+    /// 対象外の関数であればfalseを返し、何も生成しない
+    bool generateAtomicCall(const mir::MirTerminator::CallData& callData,
+                            const std::string& funcName);
 };
 
 }  // namespace cm::codegen::llvm_backend
\ No newline at end of file
@@ -4,16 +4,29 @@
 /// @brief TBAA（Type Based Alias Analysis）メタデータ管理
 /// ループベクトル化を有効にするためのエイリアス解析情報を提供
 
+#include <llvm/IR/DataLayout.h>
+#include <llvm/IR/DerivedTypes.h>
 #include <llvm/IR/MDBuilder.h>
 #include <llvm/IR/Metadata.h>
 #include <llvm/IR/Module.h>
 
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 namespace cm::codegen::llvm_backend {
 
 /// TBAAメタデータマネージャー
 /// LLVMの型ベースエイリアス解析（TBAA）用のメタデータを管理
 /// これにより、異なる型のポインタがエイリアスしないことをLLVMに伝え、
 /// ループベクトル化などの最適化を有効にする
+///
+/// 型ツリー:
+///   "Cm TBAA" ─ cm_char ─┬─ cm_short / cm_int / cm_long
+///                        ├─ cm_float / cm_double
+///                        └─ cm_pointer
+/// cm_char は C と同様に全スカラー型の親（omnipotent char）とし、
+/// バイト単位のアクセス（memcpy相当・バッファ操作）が他の型とエイリアスし得ることを保証する
 class TBAAManager {
    public:
     explicit TBAAManager(llvm::LLVMContext& ctx, llvm::Module& mod)
@@ -46,58 +59,146 @@ class TBAAManager {
     }
 
     /// int型へのアクセスタグを取得
-    llvm::MDNode* getIntAccessTag() {
-        if (!intAccessTag_) {
-            intAccessTag_ = mdBuilder_.createTBAAStructTagNode(intNode_, intNode_, 0);
-        }
-        return intAccessTag_;
-    }
+    llvm::MDNode* getIntAccessTag() { return getScalarTag(intNode_); }
 
     /// float型へのアクセスタグを取得
-    llvm::MDNode* getFloatAccessTag() {
-        if (!floatAccessTag_) {
-            floatAccessTag_ = mdBuilder_.createTBAAStructTagNode(floatNode_, floatNode_, 0);
-        }
-        return floatAccessTag_;
-    }
+    llvm::MDNode* getFloatAccessTag() { return getScalarTag(floatNode_); }
 
     /// double型へのアクセスタグを取得
-    llvm::MDNode* getDoubleAccessTag() {
-        if (!doubleAccessTag_) {
-            doubleAccessTag_ = mdBuilder_.createTBAAStructTagNode(doubleNode_, doubleNode_, 0);
-        }
-        return doubleAccessTag_;
-    }
+    llvm::MDNode* getDoubleAccessTag() { return getScalarTag(doubleNode_); }
 
     /// char型へのアクセスタグを取得
-    llvm::MDNode* getCharAccessTag() {
-        if (!charAccessTag_) {
-            charAccessTag_ = mdBuilder_.createTBAAStructTagNode(charNode_, charNode_, 0);
+    llvm::MDNode* getCharAccessTag() { return getScalarTag(charNode_); }
+
+    /// pointer型へのアクセスタグを取得
+    llvm::MDNode* getPointerAccessTag() { return getScalarTag(pointerNode_); }
+
+    /// LLVM型に対応するスカラー型ノードを取得
+    /// スカラーでない型（集約型・ベクトル・i128等）はnullptr
+    llvm::MDNode* getScalarTypeNode(llvm::Type* type) {
+        if (!type) {
+            return nullptr;
+        }
+        if (type->isPointerTy()) {
+            return pointerNode_;
+        }
+        if (type->isFloatTy()) {
+            return floatNode_;
         }
-        return charAccessTag_;
+        if (type->isDoubleTy()) {
+            return doubleNode_;
+        }
+        if (type->isIntegerTy()) {
+            switch (type->getIntegerBitWidth()) {
+                case 1:
+                case 8:
+                    return charNode_;
+                case 16:
+                    return shortNode_;
+                case 32:
+                    return intNode_;
+                case 64:
+                    return longNode_;
+                default:
+                    return nullptr;
+            }
+        }
+        return nullptr;
     }
 
-    /// pointer型へのアクセスタグを取得
-    llvm::MDNode* getPointerAccessTag() {
-        if (!pointerAccessTag_) {
-            pointerAccessTag_ = mdBuilder_.createTBAAStructTagNode(pointerNode_, pointerNode_, 0);
+    /// スカラーアクセス用のタグを取得（型が対象外ならnullptr）
+    llvm::MDNode* getScalarAccessTag(llvm::Type* type) {
+        auto* node = getScalarTypeNode(type);
+        return node ? getScalarTag(node) : nullptr;
+    }
+
+    /// 構造体フィールドアクセス用のstruct-pathタグを取得
+    /// フィールドの型とアクセス型が一致しない場合はnullptr（呼び出し側でフォールバック）
+    llvm::MDNode* getFieldAccessTag(llvm::StructType* structType, unsigned fieldIndex,
+                                    llvm::Type* accessType) {
+        if (!structType || structType->isOpaque() || structType->isPacked() ||
+            fieldIndex >= structType->getNumElements()) {
+            return nullptr;
+        }
+        if (structType->getElementType(fieldIndex) != accessType) {
+            return nullptr;
+        }
+        auto* accessNode = getScalarTypeNode(accessType);
+        if (!accessNode) {
+            return nullptr;
         }
-        return pointerAccessTag_;
+        auto key = std::make_pair(structType, fieldIndex);
+        auto it = fieldTags_.find(key);
+        if (it != fieldTags_.end()) {
+            return it->second;
+        }
+        auto* structNode = getStructTypeNode(structType);
+        const auto& layout = module_.getDataLayout();
+        uint64_t offset = layout.getStructLayout(structType)->getElementOffset(fieldIndex);
+        auto* tag = mdBuilder_.createTBAAStructTagNode(structNode, accessNode, offset);
+        fieldTags_[key] = tag;
+        return tag;
     }
 
    private:
+    struct FieldKeyHash {
+        size_t operator()(const std::pair<llvm::StructType*, unsigned>& key) const {
+            return std::hash<const void*>()(key.first) ^ (std::hash<unsigned>()(key.second) << 1);
+        }
+    };
+
     void initializeTBAARoots() {
         // TBAAルートノード作成
         // "Cm TBAA" はCm言語のTBAAツリーのルート
         root_ = mdBuilder_.createTBAARoot("Cm TBAA");
 
-        // 基本型ノード作成（すべてcharからDERIVEしない独立した型として定義）
-        // これにより、異なる型間のエイリアスなしが保証される
+        // charは全型とエイリアスし得る（バイト列経由のコピー・reinterpretを許容）
+        // その他のスカラー型はchar配下の兄弟として互いにエイリアスしない
         charNode_ = mdBuilder_.createTBAAScalarTypeNode("cm_char", root_);
-        intNode_ = mdBuilder_.createTBAAScalarTypeNode("cm_int", root_);
-        floatNode_ = mdBuilder_.createTBAAScalarTypeNode("cm_float", root_);
-        doubleNode_ = mdBuilder_.createTBAAScalarTypeNode("cm_double", root_);
-        pointerNode_ = mdBuilder_.createTBAAScalarTypeNode("cm_pointer", root_);
+        shortNode_ = mdBuilder_.createTBAAScalarTypeNode("cm_short", charNode_);
+        intNode_ = mdBuilder_.createTBAAScalarTypeNode("cm_int", charNode_);
+        longNode_ = mdBuilder_.createTBAAScalarTypeNode("cm_long", charNode_);
+        floatNode_ = mdBuilder_.createTBAAScalarTypeNode("cm_float", charNode_);
+        doubleNode_ = mdBuilder_.createTBAAScalarTypeNode("cm_double", charNode_);
+        pointerNode_ = mdBuilder_.createTBAAScalarTypeNode("cm_pointer", charNode_);
+    }
+
+    llvm::MDNode* getScalarTag(llvm::MDNode* node) {
+        auto it = scalarTags_.find(node);
+        if (it != scalarTags_.end()) {
+            return it->second;
+        }
+        auto* tag = mdBuilder_.createTBAAStructTagNode(node, node, 0);
+        scalarTags_[node] = tag;
+        return tag;
+    }
+
+    /// 構造体型ノードを取得（LLVM構造体レイアウトから生成）
+    /// スカラー・構造体以外のフィールド（配列等）はcharとして扱う
+    llvm::MDNode* getStructTypeNode(llvm::StructType* structType) {
+        auto it = structNodes_.find(structType);
+        if (it != structNodes_.end()) {
+            return it->second;
+        }
+        const auto& layout = module_.getDataLayout();
+        const auto* structLayout = layout.getStructLayout(structType);
+        std::vector<std::pair<llvm::MDNode*, uint64_t>> fields;
+        for (unsigned i = 0; i < structType->getNumElements(); ++i) {
+            auto* elemType = structType->getElementType(i);
+            llvm::MDNode* node = getScalarTypeNode(elemType);
+            if (!node) {
+                auto* nested = llvm::dyn_cast<llvm::StructType>(elemType);
+                node = (nested && !nested->isOpaque() && !nested->isPacked())
+                           ? getStructTypeNode(nested)
+                           : charNode_;
+            }
+            fields.emplace_back(node, structLayout->getElementOffset(i));
+        }
+        std::string name =
+            structType->hasName() ? structType->getName().str() : std::string("cm_anon_struct");
+        auto* node = mdBuilder_.createTBAAStructTypeNode(name, fields);
+        structNodes_[structType] = node;
+        return node;
     }
 
     llvm::LLVMContext& context_;
@@ -107,17 +208,18 @@ class TBAAManager {
     // TBAAノードキャッシュ
     llvm::MDNode* root_ = nullptr;
     llvm::MDNode* charNode_ = nullptr;
+    llvm::MDNode* shortNode_ = nullptr;
     llvm::MDNode* intNode_ = nullptr;
+    llvm::MDNode* longNode_ = nullptr;
     llvm::MDNode* floatNode_ = nullptr;
     llvm::MDNode* doubleNode_ = nullptr;
     llvm::MDNode* pointerNode_ = nullptr;
 
-    // アクセスタグキャッシュ
-    llvm::MDNode* charAccessTag_ = nullptr;
-    llvm::MDNode* intAccessTag_ = nullptr;
-    llvm::MDNode* floatAccessTag_ = nullptr;
-    llvm::MDNode* doubleAccessTag_ = nullptr;
-    llvm::MDNode* pointerAccessTag_ = nullptr;
+    // アクセスタグ・構造体ノードキャッシュ
+    std::unordered_map<llvm::MDNode*, llvm::MDNode*> scalarTags_;
+    std::unordered_map<llvm::StructType*, llvm::MDNode*> structNodes_;
+    std::unordered_map<std::pair<llvm::StructType*, unsigned>, llvm::MDNode*, FieldKeyHash>
+        fieldTags_;
 };
 
 }  // namespace cm::codegen::llvm_backend
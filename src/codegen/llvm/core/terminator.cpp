@@ -152,6 +152,14 @@ void MIRToLLVM::convertTerminator(const mir::MirTerminator& term) {
                 break;
             }
 
+            // ============================================================
+            // アトミック操作（cm_atomic_* をネイティブ命令へ展開）
+            // ============================================================
+            if (!isIndirectCall && generateAtomicCall(callData, funcName)) {
+                builder->CreateBr(blocks[callData.success]);
+                break;
+            }
+
             // ============================================================
             // Tagged Union Variant Constructor (v0.13.0)
             // ============================================================
@@ -160,11 +168,21 @@ void MIRToLLVM::convertTerminator(const mir::MirTerminator& term) {
             // ただし、モジュール関数（m::calculate等）は通常の関数として処理する
             if (funcName.find("::") != std::string::npos && functions.count(funcName) == 0) {
                 // まずMIR関数リストを検索（モジュール関数の可能性）
+                // モジュール分割コンパイル時はcurrentProgramがNULLなのでallModuleFunctionsを使用
                 bool isMirFunction = false;
-                for (const auto& func : currentProgram->functions) {
-                    if (func->name == funcName) {
-                        isMirFunction = true;
-                        break;
+                if (currentProgram) {
+                    for (const auto& func : currentProgram->functions) {
+                        if (func->name == funcName) {
+                            isMirFunction = true;
+                            break;
+                        }
+                    }
+                } else {
+                    for (const auto* func : allModuleFunctions) {
+                        if (func->name == funcName) {
+                            isMirFunction = true;
+                            break;
+                        }
                     }
                 }
 
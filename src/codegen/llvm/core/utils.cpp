@@ -61,6 +61,20 @@ llvm::Function* MIRToLLVM::declareExternalFunction(const std::string& name) {
         auto func = module->getOrInsertFunction(name, funcType);
         return llvm::cast<llvm::Function>(func.getCallee());
     }
+    // 標準出力のバッファ制御
+    else if (name == "cm_flush_stdout") {
+        auto funcType = llvm::FunctionType::get(ctx.getVoidType(), false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    } else if (name == "cm_set_stdout_buffering") {
+        auto funcType = llvm::FunctionType::get(ctx.getVoidType(), {ctx.getI32Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    } else if (name == "cm_get_stdout_buffering") {
+        auto funcType = llvm::FunctionType::get(ctx.getI32Type(), false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
     // 型変換関数
     else if (name == "cm_int_to_string" || name == "cm_uint_to_string") {
         auto funcType = llvm::FunctionType::get(ctx.getPtrType(), {ctx.getI32Type()}, false);
@@ -609,12 +623,115 @@ llvm::Function* MIRToLLVM::declareExternalFunction(const std::string& name) {
         auto func = module->getOrInsertFunction(name, funcType);
         return llvm::cast<llvm::Function>(func.getCallee());
     }
+    // int64_t cm_bulk_create(int32_t capacity) / int64_t cm_iov_create(int32_t max_entries)
+    else if (name == "cm_bulk_create" || name == "cm_iov_create") {
+        auto funcType = llvm::FunctionType::get(ctx.getI64Type(), {ctx.getI32Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // void cm_bulk_destroy(int64_t buf) 等のハンドルのみを受け取る関数
+    else if (name == "cm_bulk_destroy" || name == "cm_iov_clear" || name == "cm_iov_destroy") {
+        auto funcType = llvm::FunctionType::get(ctx.getVoidType(), {ctx.getI64Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // void* cm_bulk_view(int64_t buf)
+    else if (name == "cm_bulk_view") {
+        auto funcType = llvm::FunctionType::get(ctx.getPtrType(), {ctx.getI64Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // int64_t cm_bulk_data(int64_t buf)
+    else if (name == "cm_bulk_data") {
+        auto funcType = llvm::FunctionType::get(ctx.getI64Type(), {ctx.getI64Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // int32_t cm_bulk_len(int64_t buf) / cm_bulk_cap / cm_iov_count
+    else if (name == "cm_bulk_len" || name == "cm_bulk_cap" || name == "cm_iov_count") {
+        auto funcType = llvm::FunctionType::get(ctx.getI32Type(), {ctx.getI64Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // void cm_bulk_set_len(int64_t buf, int32_t len) / cm_bulk_consume
+    else if (name == "cm_bulk_set_len" || name == "cm_bulk_consume") {
+        auto funcType =
+            llvm::FunctionType::get(ctx.getVoidType(), {ctx.getI64Type(), ctx.getI32Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // int32_t cm_bulk_reserve(int64_t buf, int32_t capacity) / cm_iov_result
+    else if (name == "cm_bulk_reserve" || name == "cm_iov_result") {
+        auto funcType =
+            llvm::FunctionType::get(ctx.getI32Type(), {ctx.getI64Type(), ctx.getI32Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // int32_t cm_bulk_append(int64_t buf, const char* text)
+    else if (name == "cm_bulk_append") {
+        auto funcType =
+            llvm::FunctionType::get(ctx.getI32Type(), {ctx.getI64Type(), ctx.getPtrType()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // int32_t cm_bulk_find(int64_t buf, int32_t offset, int32_t value)
+    else if (name == "cm_bulk_find") {
+        auto funcType = llvm::FunctionType::get(
+            ctx.getI32Type(), {ctx.getI64Type(), ctx.getI32Type(), ctx.getI32Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // int32_t cm_bulk_read(int64_t fd, int64_t buf) / cm_tcp_readv / cm_tcp_writev /
+    // cm_udp_recv_batch
+    else if (name == "cm_bulk_read" || name == "cm_tcp_readv" || name == "cm_tcp_writev" ||
+             name == "cm_udp_recv_batch") {
+        auto funcType =
+            llvm::FunctionType::get(ctx.getI32Type(), {ctx.getI64Type(), ctx.getI64Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // int32_t cm_bulk_write(int64_t fd, int64_t buf, int32_t offset, int32_t size)
+    // int32_t cm_iov_add(int64_t iov, int64_t buf, int32_t offset, int32_t size)
+    else if (name == "cm_bulk_write" || name == "cm_iov_add") {
+        auto funcType = llvm::FunctionType::get(
+            ctx.getI32Type(),
+            {ctx.getI64Type(), ctx.getI64Type(), ctx.getI32Type(), ctx.getI32Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // int64_t cm_sendfile(int64_t sock_fd, int64_t file_fd, int64_t offset, int64_t count)
+    else if (name == "cm_sendfile") {
+        auto funcType = llvm::FunctionType::get(
+            ctx.getI64Type(),
+            {ctx.getI64Type(), ctx.getI64Type(), ctx.getI64Type(), ctx.getI64Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // int64_t cm_splice(int64_t in_fd, int64_t out_fd, int64_t count)
+    else if (name == "cm_splice") {
+        auto funcType = llvm::FunctionType::get(
+            ctx.getI64Type(), {ctx.getI64Type(), ctx.getI64Type(), ctx.getI64Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
     // int64_t cm_tcp_poll_create()
     else if (name == "cm_tcp_poll_create") {
         auto funcType = llvm::FunctionType::get(ctx.getI64Type(), false);
         auto func = module->getOrInsertFunction(name, funcType);
         return llvm::cast<llvm::Function>(func.getCallee());
     }
+    // int64_t cm_tcp_poll_create_backend(int32_t backend)
+    else if (name == "cm_tcp_poll_create_backend") {
+        auto funcType = llvm::FunctionType::get(ctx.getI64Type(), {ctx.getI32Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // int32_t cm_tcp_poll_backend(int64_t poll_handle)
+    else if (name == "cm_tcp_poll_backend") {
+        auto funcType = llvm::FunctionType::get(ctx.getI32Type(), {ctx.getI64Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
     // int32_t cm_tcp_poll_add(int64_t poll_handle, int64_t fd, int32_t events)
     else if (name == "cm_tcp_poll_add") {
         auto funcType = llvm::FunctionType::get(
@@ -697,6 +814,14 @@ llvm::Function* MIRToLLVM::declareExternalFunction(const std::string& name) {
         auto func = module->getOrInsertFunction(name, funcType);
         return llvm::cast<llvm::Function>(func.getCallee());
     }
+    // int32_t cm_udp_send_batch(int64_t fd, int64_t host_ptr, int32_t port, int64_t iov)
+    else if (name == "cm_udp_send_batch") {
+        auto funcType = llvm::FunctionType::get(
+            ctx.getI32Type(),
+            {ctx.getI64Type(), ctx.getI64Type(), ctx.getI32Type(), ctx.getI64Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
     // int32_t cm_udp_set_broadcast(int64_t fd)
     else if (name == "cm_udp_set_broadcast") {
         auto funcType = llvm::FunctionType::get(ctx.getI32Type(), {ctx.getI64Type()}, false);
@@ -938,7 +1063,8 @@ llvm::Function* MIRToLLVM::declareExternalFunction(const std::string& name) {
     }
     // int64_t cm_http_get(const char* host, int32_t port, const char* path)
     // int64_t cm_http_delete(const char* host, int32_t port, const char* path)
-    else if (name == "cm_http_get" || name == "cm_http_delete") {
+    // int64_t cm_http_get_async(const char* host, int32_t port, const char* path)
+    else if (name == "cm_http_get" || name == "cm_http_delete" || name == "cm_http_get_async") {
         auto funcType = llvm::FunctionType::get(
             ctx.getI64Type(), {ctx.getPtrType(), ctx.getI32Type(), ctx.getPtrType()}, false);
         auto func = module->getOrInsertFunction(name, funcType);
@@ -946,13 +1072,55 @@ llvm::Function* MIRToLLVM::declareExternalFunction(const std::string& name) {
     }
     // int64_t cm_http_post(const char* host, int32_t port, const char* path, const char* body)
     // int64_t cm_http_put(const char* host, int32_t port, const char* path, const char* body)
-    else if (name == "cm_http_post" || name == "cm_http_put") {
+    // int64_t cm_http_post_async(const char* host, int32_t port, const char* path,
+    //                            const char* body)
+    else if (name == "cm_http_post" || name == "cm_http_put" || name == "cm_http_post_async") {
         auto funcType = llvm::FunctionType::get(
             ctx.getI64Type(),
             {ctx.getPtrType(), ctx.getI32Type(), ctx.getPtrType(), ctx.getPtrType()}, false);
         auto func = module->getOrInsertFunction(name, funcType);
         return llvm::cast<llvm::Function>(func.getCallee());
     }
+    // int64_t cm_http_execute_async(int64_t req_handle)
+    // int64_t cm_http_call_finish(int64_t call)
+    else if (name == "cm_http_execute_async" || name == "cm_http_call_finish") {
+        auto funcType = llvm::FunctionType::get(ctx.getI64Type(), {ctx.getI64Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // int32_t cm_http_call_poll/fd/wants_write(int64_t call)
+    else if (name == "cm_http_call_poll" || name == "cm_http_call_fd" ||
+             name == "cm_http_call_wants_write") {
+        auto funcType = llvm::FunctionType::get(ctx.getI32Type(), {ctx.getI64Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // void cm_http_call_cancel(int64_t call)
+    else if (name == "cm_http_call_cancel") {
+        auto funcType = llvm::FunctionType::get(ctx.getVoidType(), {ctx.getI64Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // void cm_http_client_set_pool_size/idle_timeout/dns_ttl(int32_t value)
+    else if (name == "cm_http_client_set_pool_size" || name == "cm_http_client_set_idle_timeout" ||
+             name == "cm_http_client_set_dns_ttl") {
+        auto funcType = llvm::FunctionType::get(ctx.getVoidType(), {ctx.getI32Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // void cm_http_client_reset()
+    else if (name == "cm_http_client_reset") {
+        auto funcType = llvm::FunctionType::get(ctx.getVoidType(), false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // int64_t cm_http_client_connects/reuses/dns_lookups/tls_resumptions()
+    else if (name == "cm_http_client_connects" || name == "cm_http_client_reuses" ||
+             name == "cm_http_client_dns_lookups" || name == "cm_http_client_tls_resumptions") {
+        auto funcType = llvm::FunctionType::get(ctx.getI64Type(), false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
 
     // ============================================================
     // HTTP サーバー (http_runtime.cpp)
@@ -996,6 +1164,74 @@ llvm::Function* MIRToLLVM::declareExternalFunction(const std::string& name) {
         auto func = module->getOrInsertFunction(name, funcType);
         return llvm::cast<llvm::Function>(func.getCallee());
     }
+    // int64_t cm_http_evserver_create(int32_t port, int32_t workers)
+    else if (name == "cm_http_evserver_create") {
+        auto funcType =
+            llvm::FunctionType::get(ctx.getI64Type(), {ctx.getI32Type(), ctx.getI32Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // int64_t cm_http_evserver_run(int64_t handle, void* handler, int32_t max_requests)
+    else if (name == "cm_http_evserver_run") {
+        auto funcType = llvm::FunctionType::get(
+            ctx.getI64Type(), {ctx.getI64Type(), ctx.getPtrType(), ctx.getI32Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // void cm_http_evserver_stop(int64_t handle) / cm_http_evserver_destroy
+    else if (name == "cm_http_evserver_stop" || name == "cm_http_evserver_destroy") {
+        auto funcType = llvm::FunctionType::get(ctx.getVoidType(), {ctx.getI64Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // const char* cm_http_evreq_method/path/body(int64_t req)
+    else if (name == "cm_http_evreq_method" || name == "cm_http_evreq_path" ||
+             name == "cm_http_evreq_body") {
+        auto funcType = llvm::FunctionType::get(ctx.getPtrType(), {ctx.getI64Type()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // const char* cm_http_evreq_header(int64_t req, const char* key)
+    else if (name == "cm_http_evreq_header") {
+        auto funcType =
+            llvm::FunctionType::get(ctx.getPtrType(), {ctx.getI64Type(), ctx.getPtrType()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // int32_t cm_http_evreq_is(int64_t req, const char* method, const char* path)
+    else if (name == "cm_http_evreq_is") {
+        auto funcType = llvm::FunctionType::get(
+            ctx.getI32Type(), {ctx.getI64Type(), ctx.getPtrType(), ctx.getPtrType()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // void cm_http_evreq_respond(int64_t req, int32_t status, const char* body)
+    else if (name == "cm_http_evreq_respond") {
+        auto funcType = llvm::FunctionType::get(
+            ctx.getVoidType(), {ctx.getI64Type(), ctx.getI32Type(), ctx.getPtrType()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // void cm_http_evreq_respond_type(int64_t req, int32_t status, const char* content_type,
+    //                                 const char* body)
+    else if (name == "cm_http_evreq_respond_type") {
+        auto funcType = llvm::FunctionType::get(
+            ctx.getVoidType(),
+            {ctx.getI64Type(), ctx.getI32Type(), ctx.getPtrType(), ctx.getPtrType()}, false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
+    // int64_t cm_http_test_load(const char* host, int32_t port, const char* path,
+    //                           int32_t connections, int32_t requests, int32_t pipeline)
+    else if (name == "cm_http_test_load") {
+        auto funcType = llvm::FunctionType::get(ctx.getI64Type(),
+                                                {ctx.getPtrType(), ctx.getI32Type(),
+                                                 ctx.getPtrType(), ctx.getI32Type(),
+                                                 ctx.getI32Type(), ctx.getI32Type()},
+                                                false);
+        auto func = module->getOrInsertFunction(name, funcType);
+        return llvm::cast<llvm::Function>(func.getCallee());
+    }
     // const char* cm_http_error_message(int64_t handle)
     // const char* cm_http_response_content_type(int64_t handle)
     // const char* cm_http_response_location(int64_t handle)
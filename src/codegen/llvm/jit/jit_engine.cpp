@@ -5,18 +5,30 @@
 
 #include "../core/context.hpp"
 #include "../core/mir_to_llvm.hpp"
+#include "../native/runtime_bitcode.hpp"
 
 #include <llvm/Config/llvm-config.h>
+#include <llvm/ExecutionEngine/Orc/CompileUtils.h>
 #include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
 #include <llvm/ExecutionEngine/Orc/ObjectLinkingLayer.h>
 #include <llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h>
 #include <llvm/ExecutionEngine/SectionMemoryManager.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/Passes/PassBuilder.h>
+#if LLVM_VERSION_MAJOR >= 16
+#include <llvm/TargetParser/Host.h>
+#else
+#include <llvm/Support/Host.h>
+#endif
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Support/raw_ostream.h>
+#include <llvm/Support/xxhash.h>
 #include <llvm/Transforms/Utils/Cloning.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
 // LLVM 14-16: レガシーPassManager (PassManagerBuilderが存在)
 // LLVM 17+: 新PassManager のみ (PassManagerBuilder削除)
 #if LLVM_VERSION_MAJOR < 17
@@ -28,6 +40,9 @@
 #include <llvm/Transforms/Scalar/GVN.h>
 #endif
 
+// コアランタイム（cm_runtime.o、cm本体にリンク済み）の標準出力バッファ
+extern "C" void cm_flush_stdout(void);
+
 namespace cm::codegen::jit {
 
 JITEngine::JITEngine() {
@@ -59,6 +74,19 @@ llvm::Error JITEngine::initializeJIT() {
     auto jitBuilder = llvm::orc::LLJITBuilder();
     jitBuilder.setJITTargetMachineBuilder(std::move(*jtmb));
 
+    // オブジェクトキャッシュ有効時はコンパイル結果をキャッシュへ書き出すコンパイラを使う
+    if (objectCache_) {
+        jitBuilder.setCompileFunctionCreator(
+            [cache = objectCache_.get()](llvm::orc::JITTargetMachineBuilder builder)
+                -> llvm::Expected<std::unique_ptr<llvm::orc::IRCompileLayer::IRCompiler>> {
+                auto tm = builder.createTargetMachine();
+                if (!tm) {
+                    return tm.takeError();
+                }
+                return std::make_unique<llvm::orc::TMOwningSimpleCompiler>(std::move(*tm), cache);
+            });
+    }
+
     // JIT作成
     auto jitExpected = jitBuilder.create();
     if (!jitExpected) {
@@ -72,6 +100,50 @@ llvm::Error JITEngine::initializeJIT() {
     return llvm::Error::success();
 }
 
+void JITEngine::enableObjectCache(const std::filesystem::path& dir,
+                                  const std::string& fingerprint) {
+    if (fingerprint.empty()) {
+        return;
+    }
+    objectCache_ = std::make_unique<JITObjectCache>(dir);
+    fingerprint_ = fingerprint;
+}
+
+std::string JITEngine::objectCacheKey(int optLevel) const {
+    // ソースのフィンガープリントに加え、生成コードに影響する設定を含める
+    // （ホストCPUの機能・TBAA・ランタイムbitcodeの更新）
+    std::string extra = "opt:" + std::to_string(optLevel);
+    extra += ";tbaa:" + std::to_string(tbaaEnabled_ && optLevel > 0);
+    extra += ";cpu:" + llvm::sys::getHostCPUName().str();
+    llvm::StringMap<bool> features;
+    if (llvm::sys::getHostCPUFeatures(features)) {
+        std::vector<std::string> enabled;
+        for (const auto& feature : features) {
+            if (feature.getValue()) {
+                enabled.push_back(feature.getKey().str());
+            }
+        }
+        std::sort(enabled.begin(), enabled.end());
+        for (const auto& feature : enabled) {
+            extra += "," + feature;
+        }
+    }
+    if (optLevel > 0) {
+        auto bitcode = llvm_backend::findRuntimeBitcode();
+        std::error_code ec;
+        if (!bitcode.empty()) {
+            auto size = std::filesystem::file_size(bitcode, ec);
+            auto mtime = std::filesystem::last_write_time(bitcode, ec).time_since_epoch().count();
+            extra += ";rt:" + bitcode + ":" + std::to_string(size) + ":" + std::to_string(mtime);
+        }
+    }
+
+    char suffix[17];
+    std::snprintf(suffix, sizeof(suffix), "%016llx",
+                  static_cast<unsigned long long>(llvm::xxHash64(extra)));
+    return fingerprint_ + "-" + suffix;
+}
+
 llvm::orc::SymbolStringPtr JITEngine::mangle(const std::string& name) {
     return jit_->mangleAndIntern(name);
 }
@@ -175,22 +247,15 @@ void JITEngine::optimizeModule(llvm::Module& module, int optLevel) {
 #endif
 }
 
-JITResult JITEngine::execute(const mir::MirProgram& program, const std::string& entryPoint,
-                             int optLevel) {
-    JITResult result;
-
-    // JIT初期化
-    if (auto err = initializeJIT()) {
-        result.success = false;
-        result.errorMessage = llvm::toString(std::move(err));
-        return result;
-    }
-
+llvm::Error JITEngine::addProgram(const mir::MirProgram& program, int optLevel,
+                                  const std::string& cacheKey) {
     // MIR → LLVM IR 変換
     // ネイティブ設定を使用
     auto targetConfig = llvm_backend::TargetConfig::getNative();
-    llvm_backend::LLVMContext llvmCtx("jit_module", targetConfig);
+    irContext_ = std::make_unique<llvm_backend::LLVMContext>("jit_module", targetConfig);
+    auto& llvmCtx = *irContext_;
     llvm_backend::MIRToLLVM converter(llvmCtx);
+    converter.setTBAAEnabled(tbaaEnabled_ && optLevel > 0);
     converter.convert(program);
 
     // モジュール取得（所有権を移動するためにclone）
@@ -200,21 +265,65 @@ JITResult JITEngine::execute(const mir::MirProgram& program, const std::string&
     std::string verifyError;
     llvm::raw_string_ostream verifyStream(verifyError);
     if (llvm::verifyModule(llvmModule, &verifyStream)) {
-        result.success = false;
-        result.errorMessage = "LLVM module verification failed:\n" + verifyError;
-        return result;
+        return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                       "LLVM module verification failed:\n" + verifyError);
     }
 
     // モジュールをcloneしてThreadSafeModuleを作成
     auto clonedModule = llvm::CloneModule(llvmModule);
 
+    // オブジェクトキャッシュはモジュール識別子をキーに保存する
+    if (!cacheKey.empty()) {
+        clonedModule->setModuleIdentifier(cacheKey);
+    }
+
+    // ランタイムbitcodeを取り込み（未インライン分はホストプロセスのシンボルに解決）
+    if (optLevel > 0) {
+        llvm_backend::linkRuntimeBitcode(*clonedModule);
+    }
+
     // LLVM最適化パスを適用
     optimizeModule(*clonedModule, optLevel);
 
     auto tsm = llvm::orc::ThreadSafeModule(std::move(clonedModule), *tsContext_);
     if (auto err = jit_->addIRModule(std::move(tsm))) {
+        return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                       "Failed to add module to JIT: " +
+                                           llvm::toString(std::move(err)));
+    }
+    return llvm::Error::success();
+}
+
+JITResult JITEngine::execute(const mir::MirProgram& program, const std::string& entryPoint,
+                             int optLevel) {
+    JITResult result;
+
+    // JIT初期化
+    if (auto err = initializeJIT()) {
         result.success = false;
-        result.errorMessage = "Failed to add module to JIT: " + llvm::toString(std::move(err));
+        result.errorMessage = llvm::toString(std::move(err));
+        return result;
+    }
+
+    // キャッシュ済みオブジェクトがあればIR生成・最適化・コード生成を省略
+    std::string cacheKey;
+    std::unique_ptr<llvm::MemoryBuffer> cachedObject;
+    if (objectCache_) {
+        cacheKey = objectCacheKey(optLevel);
+        cachedObject = objectCache_->load(cacheKey);
+    }
+
+    if (cachedObject) {
+        if (auto err = jit_->addObjectFile(std::move(cachedObject))) {
+            result.success = false;
+            result.errorMessage =
+                "Failed to add cached object to JIT: " + llvm::toString(std::move(err));
+            return result;
+        }
+        result.objectCacheHit = true;
+    } else if (auto err = addProgram(program, optLevel, cacheKey)) {
+        result.success = false;
+        result.errorMessage = llvm::toString(std::move(err));
         return result;
     }
 
@@ -247,6 +356,8 @@ JITResult JITEngine::execute(const mir::MirProgram& program, const std::string&
         result.success = false;
         result.errorMessage = "Unknown runtime exception";
     }
+    // ランタイムは標準出力をバッファリングするため、cm本体のメッセージより先に書き出す
+    cm_flush_stdout();
 
     return result;
 }
@@ -6,21 +6,28 @@
 #pragma once
 
 #include "../../../mir/nodes.hpp"
+#include "object_cache.hpp"
 
 #include <llvm/ExecutionEngine/Orc/Core.h>
 #include <llvm/ExecutionEngine/Orc/LLJIT.h>
 #include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
 #include <llvm/IR/LLVMContext.h>
+#include <filesystem>
 #include <memory>
 #include <string>
 
+namespace cm::codegen::llvm_backend {
+class LLVMContext;
+}  // namespace cm::codegen::llvm_backend
+
 namespace cm::codegen::jit {
 
 /// JIT実行結果
 struct JITResult {
-    int exitCode = 0;          ///< 終了コード
-    std::string errorMessage;  ///< エラーメッセージ
-    bool success = true;       ///< 成功フラグ
+    int exitCode = 0;             ///< 終了コード
+    std::string errorMessage;     ///< エラーメッセージ
+    bool success = true;          ///< 成功フラグ
+    bool objectCacheHit = false;  ///< オブジェクトキャッシュから読み込んだか
 };
 
 /// LLVM ORC JITエンジン
@@ -43,9 +50,22 @@ class JITEngine {
     JITResult execute(const mir::MirProgram& program, const std::string& entryPoint = "main",
                       int optLevel = 3);
 
+    /// TBAAメタデータ付与の有効/無効（--no-tbaa）
+    void setTBAAEnabled(bool enabled) { tbaaEnabled_ = enabled; }
+
+    /// オブジェクトキャッシュを有効化
+    /// @param dir キャッシュディレクトリ（通常は .cm-cache/jit）
+    /// @param fingerprint ソースのフィンガープリント（CacheManager::compute_fingerprint）
+    void enableObjectCache(const std::filesystem::path& dir, const std::string& fingerprint);
+
    private:
+    /// IR生成用コンテキスト（ORCは遅延コンパイルするためJITより長く保持する）
+    std::unique_ptr<llvm_backend::LLVMContext> irContext_;
     std::unique_ptr<llvm::orc::LLJIT> jit_;
     std::unique_ptr<llvm::orc::ThreadSafeContext> tsContext_;
+    bool tbaaEnabled_ = true;
+    std::unique_ptr<JITObjectCache> objectCache_;
+    std::string fingerprint_;
 
     /// JITエンジン初期化
     llvm::Error initializeJIT();
@@ -59,6 +79,13 @@ class JITEngine {
     /// LLVM最適化パスを適用
     void optimizeModule(llvm::Module& module, int optLevel);
 
+    /// MIRからIRを生成・最適化してJITに追加
+    llvm::Error addProgram(const mir::MirProgram& program, int optLevel,
+                           const std::string& cacheKey);
+
+    /// オブジェクトキャッシュのキー（フィンガープリント＋コード生成に影響する設定）
+    std::string objectCacheKey(int optLevel) const;
+
     /// 関数ポインタからJITシンボルを作成
     template <typename T>
     llvm::JITEvaluatedSymbol toSymbol(T* ptr) {
@@ -0,0 +1,67 @@
+/// @file object_cache.cpp
+/// @brief JIT用オブジェクトキャッシュ実装
+
+#include "object_cache.hpp"
+
+#include <llvm/IR/Module.h>
+#include <llvm/Support/Process.h>
+
+#include <fstream>
+#include <system_error>
+
+namespace cm::codegen::jit {
+
+std::filesystem::path JITObjectCache::objectPath(const std::string& key) const {
+    return dir_ / (key + ".o");
+}
+
+void JITObjectCache::notifyObjectCompiled(const llvm::Module* module, llvm::MemoryBufferRef obj) {
+    const std::string& key = module->getModuleIdentifier();
+    if (key.empty()) {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(dir_, ec);
+    if (ec) {
+        return;
+    }
+
+    // 一時ファイルに書いてからrename（別プロセスが書き込み途中のファイルを読まないように）
+    auto path = objectPath(key);
+    auto tmp = path;
+    tmp += ".tmp" + std::to_string(llvm::sys::Process::getProcessId());
+    {
+        std::ofstream ofs(tmp, std::ios::binary);
+        if (!ofs.is_open()) {
+            return;
+        }
+        ofs.write(obj.getBufferStart(), static_cast<std::streamsize>(obj.getBufferSize()));
+        if (!ofs) {
+            ofs.close();
+            std::filesystem::remove(tmp, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+    }
+}
+
+std::unique_ptr<llvm::MemoryBuffer> JITObjectCache::getObject(const llvm::Module* module) {
+    return load(module->getModuleIdentifier());
+}
+
+std::unique_ptr<llvm::MemoryBuffer> JITObjectCache::load(const std::string& key) const {
+    if (key.empty()) {
+        return nullptr;
+    }
+    auto buffer = llvm::MemoryBuffer::getFile(objectPath(key).string());
+    if (!buffer) {
+        return nullptr;
+    }
+    return std::move(*buffer);
+}
+
+}  // namespace cm::codegen::jit
@@ -0,0 +1,42 @@
+/// @file object_cache.hpp
+/// @brief JIT用オブジェクトキャッシュ
+///
+/// ORC JITがコンパイルしたオブジェクトを .cm-cache/jit/ に保存し、
+/// 同じフィンガープリントの再実行ではIR生成・最適化・コード生成を省略する
+
+#pragma once
+
+#include <llvm/ExecutionEngine/ObjectCache.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace cm::codegen::jit {
+
+/// ファイルベースのJITオブジェクトキャッシュ
+///
+/// キーはモジュール識別子（JITEngineがフィンガープリントを設定する）。
+/// 書き込みは一時ファイル経由のrenameで行い、並行実行でも壊れたオブジェクトを読まない。
+class JITObjectCache : public llvm::ObjectCache {
+   public:
+    explicit JITObjectCache(std::filesystem::path dir) : dir_(std::move(dir)) {}
+
+    /// コンパイル済みオブジェクトを保存（ORCのコンパイラから呼ばれる）
+    void notifyObjectCompiled(const llvm::Module* module, llvm::MemoryBufferRef obj) override;
+
+    /// キャッシュ済みオブジェクトを返す（なければnullptr）
+    std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) override;
+
+    /// キーからキャッシュ済みオブジェクトを読み込む（IR生成前の検索用）
+    std::unique_ptr<llvm::MemoryBuffer> load(const std::string& key) const;
+
+    /// キャッシュファイルのパス
+    std::filesystem::path objectPath(const std::string& key) const;
+
+   private:
+    std::filesystem::path dir_;
+};
+
+}  // namespace cm::codegen::jit
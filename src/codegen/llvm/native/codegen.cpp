@@ -7,6 +7,13 @@
 #include "../optimizations/pass_limiter.hpp"
 #include "../optimizations/recursion_limiter.hpp"
 #include "pass_debugger.hpp"
+#include "runtime_bitcode.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <exception>
+#include <thread>
 
 namespace cm::codegen::llvm_backend {
 
@@ -97,6 +104,14 @@ std::vector<LLVMCodeGen::ModuleObjectFile> LLVMCodeGen::compileModules(
     // 変更モジュールのセット（高速検索用）
     std::set<std::string> changed_set(changed_modules.begin(), changed_modules.end());
 
+    // 再コンパイル待ちモジュール（results内の位置を保持し、出力順をモジュール名順に固定）
+    struct PendingModule {
+        size_t result_index;
+        const std::string* mod_name;
+        const mir::ModuleProgram* mod_program;
+    };
+    std::vector<PendingModule> pending;
+
     for (const auto& [mod_name, mod_program] : modules) {
         ModuleObjectFile result;
         result.module_name = mod_name;
@@ -115,118 +130,165 @@ std::vector<LLVMCodeGen::ModuleObjectFile> LLVMCodeGen::compileModules(
                           << cache_it->second.string() << ")\n";
             }
         } else {
-            // キャッシュミス: コンパイル
-            std::string obj_filename = mod_name + ".o";
-            std::filesystem::path obj_path = output_dir / obj_filename;
+            // キャッシュミス: ワーカーでコンパイル
+            // モジュール名（"<generated>" 等）はリンクコマンドに渡すためファイル名安全な形にする
+            std::string obj_filename = mod_name;
+            for (auto& c : obj_filename) {
+                if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_' && c != '-') {
+                    c = '_';
+                }
+            }
+            obj_filename += ".o";
+            result.object_path = output_dir / obj_filename;
+            result.from_cache = false;
 
             if (cm::debug::g_debug_mode) {
                 std::cerr << "[MODULE] " << mod_name << ": コンパイル中 ("
                           << mod_program.functions.size() << " 関数)\n";
             }
 
-            // ターゲット設定
-            TargetConfig config;
-            if (!options.customTriple.empty()) {
-                config.triple = options.customTriple;
-                config.target = BuildTarget::Native;
-            } else {
-                switch (options.target) {
-                    case BuildTarget::Baremetal:
-                        config = TargetConfig::getBaremetalARM();
-                        break;
-                    case BuildTarget::BaremetalX86:
-                        config = TargetConfig::getBaremetalX86();
-                        break;
-                    case BuildTarget::Wasm:
-                        config = TargetConfig::getWasm();
-                        break;
-                    case BuildTarget::BaremetalUEFI:
-                        config = TargetConfig::getBaremetalUEFI();
-                        break;
-                    default:
-                        config = TargetConfig::getNative();
-                }
-            }
-            config.debugInfo = options.debugInfo;
-            // Bug#13修正: UEFIターゲットではCodeGen最適化を無効化
-            // LLVM TargetMachineのISel/SelectionDAG最適化が
-            // efi_mainのcall/ret命令を削除してフォールスルークラッシュを起こす
-            if (config.target == BuildTarget::BaremetalUEFI) {
-                config.optLevel = 0;
-            } else {
-                config.optLevel = options.optimizationLevel;
-            }
+            pending.push_back({results.size(), &mod_name, &mod_program});
+        }
 
-            // 独立LLVMContextを作成
-            auto mod_context = std::make_unique<LLVMContext>(mod_name + "_module", config);
-            auto mod_target = std::make_unique<TargetManager>(config);
-            mod_target->initialize();
-            mod_target->configureModule(mod_context->getModule());
-
-            // 組み込み関数を登録
-            auto mod_intrinsics = std::make_unique<IntrinsicsManager>(
-                &mod_context->getModule(), &mod_context->getContext(), config);
-
-            // MIR→LLVM IR変換
-            MIRToLLVM mod_converter(*mod_context);
-            mod_converter.convert(mod_program);
-
-            // LLVM IR検証
-            if (options.verifyIR) {
-                std::string errStr;
-                llvm::raw_string_ostream errStream(errStr);
-                if (llvm::verifyModule(mod_context->getModule(), &errStream)) {
-                    throw std::runtime_error("モジュール " + mod_name + " のLLVM IR検証失敗:\n" +
-                                             errStr);
-                }
-            }
+        results.push_back(std::move(result));
+    }
 
-            // 最適化
-            // Bug#13修正: UEFIターゲットではLLVM最適化パスをスキップ
-            // O2のインライン展開+DCEがefi_mainの制御フローを破壊し、
-            // call/ret命令が消滅してフォールスルークラッシュを引き起こす
-            bool isUefiModule = config.target == BuildTarget::BaremetalUEFI;
-            if (options.optimizationLevel > 0 && !isUefiModule) {
-                llvm::LoopAnalysisManager LAM;
-                llvm::FunctionAnalysisManager FAM;
-                llvm::CGSCCAnalysisManager CGAM;
-                llvm::ModuleAnalysisManager MAM;
-                llvm::PassBuilder PB;
-                PB.registerModuleAnalyses(MAM);
-                PB.registerCGSCCAnalyses(CGAM);
-                PB.registerFunctionAnalyses(FAM);
-                PB.registerLoopAnalyses(LAM);
-                PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
-
-                llvm::OptimizationLevel optLevel;
-                switch (options.optimizationLevel) {
-                    case 1:
-                        optLevel = llvm::OptimizationLevel::O1;
-                        break;
-                    case 2:
-                        optLevel = llvm::OptimizationLevel::O2;
-                        break;
-                    default:
-                        optLevel = llvm::OptimizationLevel::O3;
-                        break;
-                }
-                auto MPM = PB.buildPerModuleDefaultPipeline(optLevel);
-                MPM.run(mod_context->getModule(), MAM);
-            }
+    if (pending.empty()) {
+        return results;
+    }
 
-            // オブジェクトファイル出力
-            mod_target->emitObjectFile(mod_context->getModule(), obj_path.string());
+    // ワーカー数を決定（-j N、未指定ならハードウェア並列数）
+    size_t num_workers = options.jobs > 0 ? static_cast<size_t>(options.jobs)
+                                          : std::thread::hardware_concurrency();
+    num_workers = std::clamp<size_t>(num_workers, 1, pending.size());
 
-            result.object_path = obj_path;
-            result.from_cache = false;
+    if (cm::debug::g_debug_mode) {
+        std::cerr << "[MODULE] " << pending.size() << " モジュールを " << num_workers
+                  << " ワーカーで並列コンパイル\n";
+    }
+
+    // LLVMのターゲット登録はスレッドセーフでないため、ワーカー起動前に一度だけ行う
+    {
+        TargetManager warmup(buildTargetConfig());
+        warmup.initialize();
+    }
+
+    // 各モジュールは独立したLLVMContext/TargetManager/MIRToLLVMを持つため並列実行可能
+    std::atomic<size_t> next_index{0};
+    std::vector<std::exception_ptr> errors(pending.size());
+    auto worker = [&]() {
+        for (size_t i = next_index.fetch_add(1); i < pending.size();
+             i = next_index.fetch_add(1)) {
+            const auto& job = pending[i];
+            try {
+                compileModuleObject(*job.mod_name, *job.mod_program,
+                                    results[job.result_index].object_path);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
         }
+    };
 
-        results.push_back(std::move(result));
+    std::vector<std::thread> threads;
+    threads.reserve(num_workers - 1);
+    for (size_t i = 1; i < num_workers; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();  // 呼び出しスレッドもワーカーとして参加
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // エラーはモジュール名順で最初のものを報告（実行順に依存しない）
+    for (const auto& err : errors) {
+        if (err) {
+            std::rethrow_exception(err);
+        }
     }
 
     return results;
 }
 
+// 単一モジュールのコンパイル（ワーカースレッドから呼ばれる）
+void LLVMCodeGen::compileModuleObject(const std::string& mod_name,
+                                      const mir::ModuleProgram& mod_program,
+                                      const std::filesystem::path& obj_path) const {
+    // ターゲット設定
+    TargetConfig config = buildTargetConfig();
+    // Bug#13修正: UEFIターゲットではCodeGen最適化を無効化
+    // LLVM TargetMachineのISel/SelectionDAG最適化が
+    // efi_mainのcall/ret命令を削除してフォールスルークラッシュを起こす
+    if (config.target == BuildTarget::BaremetalUEFI) {
+        config.optLevel = 0;
+    } else {
+        config.optLevel = options.optimizationLevel;
+    }
+
+    // 独立LLVMContextを作成
+    auto mod_context = std::make_unique<LLVMContext>(mod_name + "_module", config);
+    auto mod_target = std::make_unique<TargetManager>(config);
+    mod_target->initialize();
+    mod_target->configureModule(mod_context->getModule());
+
+    // 組み込み関数を登録
+    auto mod_intrinsics = std::make_unique<IntrinsicsManager>(
+        &mod_context->getModule(), &mod_context->getContext(), config);
+
+    // MIR→LLVM IR変換
+    MIRToLLVM mod_converter(*mod_context);
+    mod_converter.setTBAAEnabled(options.enableTBAA && options.optimizationLevel > 0);
+    mod_converter.convert(mod_program);
+
+    // LLVM IR検証
+    if (options.verifyIR) {
+        std::string errStr;
+        llvm::raw_string_ostream errStream(errStr);
+        if (llvm::verifyModule(mod_context->getModule(), &errStream)) {
+            throw std::runtime_error("モジュール " + mod_name + " のLLVM IR検証失敗:\n" + errStr);
+        }
+    }
+
+    // 最適化
+    // Bug#13修正: UEFIターゲットではLLVM最適化パスをスキップ
+    // O2のインライン展開+DCEがefi_mainの制御フローを破壊し、
+    // call/ret命令が消滅してフォールスルークラッシュを引き起こす
+    bool isUefiModule = config.target == BuildTarget::BaremetalUEFI;
+    if (options.optimizationLevel > 0 && !isUefiModule) {
+        if (config.target == BuildTarget::Native && !config.noStd) {
+            linkRuntimeBitcode(mod_context->getModule());
+        }
+
+        llvm::LoopAnalysisManager LAM;
+        llvm::FunctionAnalysisManager FAM;
+        llvm::CGSCCAnalysisManager CGAM;
+        llvm::ModuleAnalysisManager MAM;
+        llvm::PassBuilder PB;
+        PB.registerModuleAnalyses(MAM);
+        PB.registerCGSCCAnalyses(CGAM);
+        PB.registerFunctionAnalyses(FAM);
+        PB.registerLoopAnalyses(LAM);
+        PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+
+        llvm::OptimizationLevel optLevel;
+        switch (options.optimizationLevel) {
+            case 1:
+                optLevel = llvm::OptimizationLevel::O1;
+                break;
+            case 2:
+                optLevel = llvm::OptimizationLevel::O2;
+                break;
+            default:
+                optLevel = llvm::OptimizationLevel::O3;
+                break;
+        }
+        auto MPM = PB.buildPerModuleDefaultPipeline(optLevel);
+        MPM.run(mod_context->getModule(), MAM);
+    }
+
+    // オブジェクトファイル出力
+    mod_target->emitObjectFile(mod_context->getModule(), obj_path.string());
+}
+
 // 複数オブジェクトファイルからリンク
 void LLVMCodeGen::linkObjects(const std::vector<std::filesystem::path>& objects,
                               const std::string& output_file) {
@@ -241,7 +303,7 @@ void LLVMCodeGen::linkObjects(const std::vector<std::filesystem::path>& objects,
     bool needsSync = checkForSyncUsage();
     bool needsThread = checkForThreadUsage();
     bool needsHTTP = checkForHTTPUsage();
-    bool needsPthread = needsSync || needsThread;
+    bool needsPthread = needsSync || needsThread || needsHTTP;
     bool needsCppRuntime = needsGPU || needsNet || needsSync || needsThread || needsHTTP;
 
     // オブジェクトファイルリストを構築
@@ -344,29 +406,7 @@ void LLVMCodeGen::initialize(const std::string& moduleName) {
     cm::debug::codegen::log(cm::debug::codegen::Id::LLVMInit);
 
     // ターゲット設定
-    TargetConfig config;
-    if (!options.customTriple.empty()) {
-        config.triple = options.customTriple;
-        config.target = BuildTarget::Native;
-    } else {
-        switch (options.target) {
-            case BuildTarget::Baremetal:
-                config = TargetConfig::getBaremetalARM();
-                break;
-            case BuildTarget::BaremetalX86:
-                config = TargetConfig::getBaremetalX86();
-                break;
-            case BuildTarget::Wasm:
-                config = TargetConfig::getWasm();
-                break;
-            case BuildTarget::BaremetalUEFI:
-                config = TargetConfig::getBaremetalUEFI();
-                break;
-            default:
-                config = TargetConfig::getNative();
-        }
-    }
-    config.debugInfo = options.debugInfo;
+    TargetConfig config = buildTargetConfig();
     // Bug#13修正: UEFIターゲットではCodeGen最適化を無効化
     // LLVM最適化パスがefi_mainのcall/ret命令を削除してフォールスルークラッシュを起こす
     if (options.target == BuildTarget::BaremetalUEFI) {
@@ -389,6 +429,7 @@ void LLVMCodeGen::initialize(const std::string& moduleName) {
 
     // 変換器
     converter = std::make_unique<MIRToLLVM>(*context);
+    converter->setTBAAEnabled(options.enableTBAA && options.optimizationLevel > 0);
 
     // ベアメタルの場合、スタートアップコード生成
     if (config.target == BuildTarget::Baremetal) {
@@ -396,6 +437,34 @@ void LLVMCodeGen::initialize(const std::string& moduleName) {
     }
 }
 
+// オプションからターゲット設定を構築
+TargetConfig LLVMCodeGen::buildTargetConfig() const {
+    TargetConfig config;
+    if (!options.customTriple.empty()) {
+        config.triple = options.customTriple;
+        config.target = BuildTarget::Native;
+    } else {
+        switch (options.target) {
+            case BuildTarget::Baremetal:
+                config = TargetConfig::getBaremetalARM();
+                break;
+            case BuildTarget::BaremetalX86:
+                config = TargetConfig::getBaremetalX86();
+                break;
+            case BuildTarget::Wasm:
+                config = TargetConfig::getWasm();
+                break;
+            case BuildTarget::BaremetalUEFI:
+                config = TargetConfig::getBaremetalUEFI();
+                break;
+            default:
+                config = TargetConfig::getNative();
+        }
+    }
+    config.debugInfo = options.debugInfo;
+    return config;
+}
+
 // IR生成
 void LLVMCodeGen::generateIR(const mir::MirProgram& program) {
     cm::debug::codegen::log(cm::debug::codegen::Id::LLVMIRGen, "Generating LLVM IR from MIR");
@@ -456,6 +525,12 @@ void LLVMCodeGen::optimize() {
     cm::debug::codegen::log(cm::debug::codegen::Id::LLVMOptimize,
                             "Level " + std::to_string(options.optimizationLevel));
 
+    // ランタイムbitcodeを取り込み、スライス/文字列ヘルパーをインライン展開可能にする
+    if (context->getTargetConfig().target == BuildTarget::Native &&
+        !context->getTargetConfig().noStd) {
+        linkRuntimeBitcode(context->getModule());
+    }
+
     // カスタム最適化を使用する場合
     if (options.useCustomOptimizations) {
         using namespace cm::codegen::llvm_backend::optimizations;
@@ -654,7 +729,7 @@ void LLVMCodeGen::emitExecutable() {
     bool needsSync = checkForSyncUsage();
     bool needsThread = checkForThreadUsage();
     bool needsHTTP = checkForHTTPUsage();
-    bool needsPthread = needsSync || needsThread;
+    bool needsPthread = needsSync || needsThread || needsHTTP;
     bool needsCppRuntime = needsGPU || needsNet || needsSync || needsThread || needsHTTP;
 
     // リンカ呼び出し
@@ -1004,7 +1079,8 @@ bool LLVMCodeGen::checkForThreadUsage() const {
     for (const auto& func : context->getModule()) {
         if (func.isDeclaration()) {
             std::string name = func.getName().str();
-            if (name.find("cm_thread_") == 0) {
+            // cm_async_*（ワークスティーリング実行器）もスレッドランタイムに含まれる
+            if (name.find("cm_thread_") == 0 || name.find("cm_async_") == 0) {
                 cm::debug::codegen::log(cm::debug::codegen::Id::LLVMOptimize,
                                         "Thread function detected: " + name);
                 return true;
@@ -1080,7 +1156,7 @@ std::string LLVMCodeGen::findStdRuntimeLibrary(const std::string& name) {
     }
 #endif
 
-    std::string ext = (name == "sync") ? ".a" : ".o";
+    std::string ext = (name == "sync" || name == "thread") ? ".a" : ".o";
     std::string filename = "cm_" + name + "_runtime" + ext;
 
     // ホームディレクトリの~/.cm/lib/も検索（make install対応）
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../../common/debug/codegen.hpp"
+#include "../../../mir/mir_splitter.hpp"
 #include "../../../mir/nodes.hpp"
 #include "../core/context.hpp"
 #include "../core/intrinsics.hpp"
@@ -45,8 +46,10 @@ class LLVMCodeGen {
         bool verbose = false;
         bool verifyIR = true;
         bool useCustomOptimizations = false;
+        bool enableTBAA = true;  // load/storeへのTBAAメタデータ付与（--no-tbaa で無効化）
         std::string customTriple = "";
         std::string linkerScript = "";
+        int jobs = 0;  // モジュール並列コンパイルのワーカー数（0 = ハードウェア並列数）
     };
 
    private:
@@ -88,6 +91,7 @@ class LLVMCodeGen {
 
     /// モジュール別差分コンパイル
     /// changed_modules のみ再コンパイル、他はキャッシュから取得
+    /// 再コンパイル対象は options.jobs 個のワーカーで並列に変換・最適化・出力する
     /// output_dir: モジュール .o の出力先ディレクトリ
     std::vector<ModuleObjectFile> compileModules(
         const mir::MirProgram& program, const std::vector<std::string>& changed_modules,
@@ -105,6 +109,14 @@ class LLVMCodeGen {
     /// 初期化
     void initialize(const std::string& moduleName);
 
+    /// オプションからターゲット設定を構築
+    TargetConfig buildTargetConfig() const;
+
+    /// 単一モジュールを独立したLLVMContextで変換・最適化し、.o を出力
+    /// compileModules のワーカースレッドから並列に呼ばれるため、メンバ状態を変更しない
+    void compileModuleObject(const std::string& mod_name, const mir::ModuleProgram& mod_program,
+                             const std::filesystem::path& obj_path) const;
+
     /// IR生成
     void generateIR(const mir::MirProgram& program);
 
@@ -9,6 +9,8 @@
 // - runtime_slice.c   : Slice (dynamic array) functions
 // - runtime_file.c    : File I/O and stdin input functions
 // - runtime_io.c      : Low-level POSIX I/O wrapper functions
+// - runtime_async.c   : Future/Waker and single-threaded executor
+// - runtime_event_loop.c: epoll/kqueue/poll event loop, timers and sleep futures
 //
 // This file includes all components to create a single compilation unit
 
@@ -18,6 +20,8 @@
 #include "../../common/runtime_alloc.c"
 #include "../../common/runtime_file.c"
 #include "runtime_asm.c"
+#include "runtime_async.c"
+#include "runtime_event_loop.c"
 #include "runtime_format.c"
 #include "runtime_io.c"
 #include "runtime_platform.c"
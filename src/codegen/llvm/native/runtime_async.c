@@ -13,6 +13,69 @@
 // ============================================================
 CmExecutor* cm_global_executor = NULL;
 
+// ============================================================
+// タスクWaker - 起こされたタスクをレディキューに積む
+// Wakerはタスクに埋め込まれ、複製はタスクの参照カウントで寿命を管理する
+// ============================================================
+
+static void task_release(CmTask* task) {
+    if (task && --task->refcount == 0)
+        free(task);
+}
+
+static void task_enqueue(CmTask* task) {
+    if (!task || task->completed || task->queued || !task->executor)
+        return;
+
+    CmExecutor* executor = task->executor;
+    task->queued = true;
+    task->ready_next = NULL;
+    if (executor->ready_tail) {
+        executor->ready_tail->ready_next = task;
+    } else {
+        executor->ready_head = task;
+    }
+    executor->ready_tail = task;
+}
+
+static void task_waker_wake_by_ref(const CmWaker* waker) {
+    if (waker)
+        task_enqueue((CmTask*)waker->data);
+}
+
+static void task_waker_wake(CmWaker* waker) {
+    task_waker_wake_by_ref(waker);
+}
+
+static CmWaker* task_waker_clone(const CmWaker* waker) {
+    // 複製は同じWakerを共有し、タスクの参照カウントを増やす
+    CmTask* task = (CmTask*)waker->data;
+    task->refcount++;
+    return (CmWaker*)waker;
+}
+
+static void task_waker_drop(CmWaker* waker) {
+    task_release((CmTask*)waker->data);
+}
+
+void cm_waker_wake(const CmWaker* waker) {
+    if (waker && waker->wake_by_ref)
+        waker->wake_by_ref(waker);
+}
+
+CmWaker* cm_waker_clone(const CmWaker* waker) {
+    if (!waker)
+        return NULL;
+    if (waker->clone)
+        return waker->clone(waker);
+    return (CmWaker*)waker;
+}
+
+void cm_waker_drop(CmWaker* waker) {
+    if (waker && waker->drop)
+        waker->drop(waker);
+}
+
 // ============================================================
 // エグゼキュータの実装
 // ============================================================
@@ -25,6 +88,9 @@ CmExecutor* cm_executor_new(void) {
     executor->tasks = NULL;
     executor->current = NULL;
     executor->running = false;
+    executor->ready_head = NULL;
+    executor->ready_tail = NULL;
+    executor->pending_count = 0;
 
     return executor;
 }
@@ -33,14 +99,16 @@ void cm_executor_drop(CmExecutor* executor) {
     if (!executor)
         return;
 
-    // 全タスクを解放
+    // 全タスクを解放（Wakerの複製が残っているタスクは最後のdropで解放される）
     CmTask* task = executor->tasks;
     while (task) {
         CmTask* next = task->next;
         if (task->future && task->future->drop) {
             task->future->drop(task->future);
         }
-        free(task);
+        task->future = NULL;
+        task->executor = NULL;
+        task_release(task);
         task = next;
     }
 
@@ -121,49 +189,112 @@ void cm_spawn(CmExecutor* executor, CmFuture* future) {
     task->completed = false;
     task->next = executor->tasks;
     executor->tasks = task;
+
+    task->executor = executor;
+    task->waker.data = task;
+    task->waker.wake = task_waker_wake;
+    task->waker.wake_by_ref = task_waker_wake_by_ref;
+    task->waker.clone = task_waker_clone;
+    task->waker.drop = task_waker_drop;
+    task->queued = false;
+    task->ready_next = NULL;
+    task->refcount = 1;
+
+    executor->pending_count++;
+
+    // 新しいタスクは最初の1回を必ずポーリングする
+    task_enqueue(task);
 }
 
 // ============================================================
-// run_until_complete - 全タスクを実行
+// レディキューの実行
 // ============================================================
 
-void cm_run_until_complete(CmExecutor* executor) {
+int cm_executor_run_ready(CmExecutor* executor) {
     if (!executor)
-        return;
-
-    executor->running = true;
+        return 0;
 
-    CmWaker waker = {0};
-    CmContext context = {.waker = &waker};
+    // 今回の巡回中に起こされたタスクは次の巡回に回す（I/O待ちを飢餓させない）
+    CmTask* batch = executor->ready_head;
+    executor->ready_head = NULL;
+    executor->ready_tail = NULL;
 
-    while (executor->running) {
-        bool all_completed = true;
+    int polled = 0;
+    while (batch) {
+        CmTask* task = batch;
+        batch = task->ready_next;
+        task->ready_next = NULL;
+        task->queued = false;
 
-        CmTask* task = executor->tasks;
-        while (task) {
-            if (!task->completed && task->future) {
-                executor->current = task;
+        if (task->completed || !task->future)
+            continue;
 
-                CmPollState state = task->future->poll(task->future, &context);
+        executor->current = task;
+        CmContext context = {.waker = &task->waker};
+        CmPollState state = task->future->poll(task->future, &context);
+        polled++;
 
-                if (state == CM_POLL_READY) {
-                    task->completed = true;
-                    if (task->future->drop) {
-                        task->future->drop(task->future);
-                    }
-                } else {
-                    all_completed = false;
-                }
+        if (state == CM_POLL_READY) {
+            task->completed = true;
+            executor->pending_count--;
+            if (task->future->drop) {
+                task->future->drop(task->future);
             }
+            task->future = NULL;
+        }
+    }
+
+    executor->current = NULL;
+    return polled;
+}
+
+bool cm_executor_has_ready(const CmExecutor* executor) {
+    return executor && executor->ready_head != NULL;
+}
+
+void cm_executor_wake_all(CmExecutor* executor) {
+    if (!executor)
+        return;
+
+    for (CmTask* task = executor->tasks; task; task = task->next) {
+        task_enqueue(task);
+    }
+}
 
-            task = task->next;
+int cm_executor_wake_unparked(CmExecutor* executor) {
+    if (!executor)
+        return 0;
+
+    // refcountはエグゼキュータ分の1 + 預けられたWakerの複製数
+    int woken = 0;
+    for (CmTask* task = executor->tasks; task; task = task->next) {
+        if (!task->completed && task->refcount <= 1 && !task->queued) {
+            task_enqueue(task);
+            woken++;
         }
+    }
+    return woken;
+}
 
-        if (all_completed) {
-            executor->running = false;
+// ============================================================
+// run_until_complete - 全タスクを実行
+// ============================================================
+
+void cm_run_until_complete(CmExecutor* executor) {
+    if (!executor)
+        return;
+
+    executor->running = true;
+
+    while (executor->running && executor->pending_count > 0) {
+        if (!cm_executor_has_ready(executor)) {
+            // イベントループなしでは起こす手段がないため、未完了タスクを再ポーリングする
+            cm_executor_wake_all(executor);
         }
+        cm_executor_run_ready(executor);
     }
 
+    executor->running = false;
     executor->current = NULL;
 }
 
@@ -236,8 +367,11 @@ void* __result_unwrap(void* result) {
 // グローバルエグゼキュータの初期化/終了
 // ============================================================
 
-__attribute__((constructor)) static void cm_async_init(void) {
-    cm_global_executor = cm_executor_new();
+// コンパイラ本体にもリンクされるため、起動時ではなく初回使用時に生成する
+CmExecutor* cm_executor_global(void) {
+    if (!cm_global_executor)
+        cm_global_executor = cm_executor_new();
+    return cm_global_executor;
 }
 
 __attribute__((destructor)) static void cm_async_fini(void) {
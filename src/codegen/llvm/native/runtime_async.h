@@ -58,6 +58,13 @@ typedef struct CmTask {
     CmFuture* future;
     bool completed;
     struct CmTask* next;  // リンクドリスト用
+
+    // Wakerによる再スケジュール
+    struct CmExecutor* executor;  // 所属するエグゼキュータ
+    CmWaker waker;                // このタスクを起こすWaker（data = タスク）
+    bool queued;                  // レディキューに積まれているか
+    struct CmTask* ready_next;    // レディキュー用
+    int refcount;                 // エグゼキュータ + 複製されたWakerの数
 } CmTask;
 
 // ============================================================
@@ -68,13 +75,20 @@ typedef struct CmExecutor {
     CmTask* tasks;    // タスクキュー（リンクドリスト）
     CmTask* current;  // 現在実行中のタスク
     bool running;
+
+    // レディキュー: Wakerで起こされたタスクのみをポーリングする
+    CmTask* ready_head;
+    CmTask* ready_tail;
+    int pending_count;  // 未完了タスク数
 } CmExecutor;
 
 // ============================================================
-// グローバルエグゼキュータ
+// グローバルエグゼキュータ（初回のcm_executor_globalで生成）
 // ============================================================
 extern CmExecutor* cm_global_executor;
 
+CmExecutor* cm_executor_global(void);
+
 // ============================================================
 // Runtime API
 // ============================================================
@@ -95,6 +109,32 @@ void cm_spawn(CmExecutor* executor, CmFuture* future);
 // 全タスクを実行
 void cm_run_until_complete(CmExecutor* executor);
 
+// レディキューにあるタスクを1巡ポーリング（ポーリングしたタスク数を返す）
+int cm_executor_run_ready(CmExecutor* executor);
+
+// レディキューが空でないか
+bool cm_executor_has_ready(const CmExecutor* executor);
+
+// 未完了タスクを全てレディキューに積む（Wakerを使わないFuture向けのフォールバック）
+void cm_executor_wake_all(CmExecutor* executor);
+
+// Wakerの複製をどこにも預けていない未完了タスクをレディキューに積む（積んだ数を返す）
+// そのようなタスクは誰にも起こされないため、定期的に再ポーリングする必要がある
+int cm_executor_wake_unparked(CmExecutor* executor);
+
+// ============================================================
+// Waker API
+// ============================================================
+
+// Wakerを起こす（wake_by_refがなければ何もしない）
+void cm_waker_wake(const CmWaker* waker);
+
+// Wakerを複製（cloneがなければ同じポインタを返す）
+CmWaker* cm_waker_clone(const CmWaker* waker);
+
+// 複製したWakerを解放
+void cm_waker_drop(CmWaker* waker);
+
 // ============================================================
 // ヘルパー関数
 // ============================================================
@@ -0,0 +1,275 @@
+// Cランタイムbitcodeのリンク実装
+#include "runtime_bitcode.hpp"
+
+#include "../../../common/debug.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/Linker/Linker.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+#if LLVM_VERSION_MAJOR >= 17
+#include <llvm/TargetParser/Triple.h>
+#else
+#include <llvm/ADT/Triple.h>
+#endif
+
+namespace cm::codegen::llvm_backend {
+
+namespace {
+
+// bitcodeファイルの内容はプロセス内で一度だけ読み込む
+// （モジュール並列コンパイル時に複数スレッドから参照される）
+std::mutex g_bitcodeMutex;
+bool g_bitcodeLoaded = false;
+std::unique_ptr<llvm::MemoryBuffer> g_bitcodeBuffer;
+
+const llvm::MemoryBuffer* loadRuntimeBitcode() {
+    std::lock_guard<std::mutex> lock(g_bitcodeMutex);
+    if (!g_bitcodeLoaded) {
+        g_bitcodeLoaded = true;
+        std::string path = findRuntimeBitcode();
+        if (!path.empty()) {
+            auto bufferOrErr = llvm::MemoryBuffer::getFile(path);
+            if (bufferOrErr) {
+                g_bitcodeBuffer = std::move(*bufferOrErr);
+            } else if (cm::debug::g_debug_mode) {
+                std::cerr << "[LLVM] ランタイムbitcodeの読み込みに失敗: " << path << "\n";
+            }
+        }
+    }
+    return g_bitcodeBuffer.get();
+}
+
+// 値が参照するグローバル値を収集（定数式と内部定数テーブルの初期化子も辿る）
+void collectReferencedGlobals(const llvm::Value* value,
+                              std::unordered_set<const llvm::GlobalValue*>& out,
+                              std::unordered_set<const llvm::Constant*>& visited) {
+    if (auto* gv = llvm::dyn_cast<llvm::GlobalValue>(value)) {
+        if (!out.insert(gv).second) {
+            return;
+        }
+        // 関数ポインタテーブル経由で内部関数を呼ぶ場合に備える
+        auto* var = llvm::dyn_cast<llvm::GlobalVariable>(gv);
+        if (var && var->hasLocalLinkage() && var->hasInitializer()) {
+            collectReferencedGlobals(var->getInitializer(), out, visited);
+        }
+        return;
+    }
+    auto* constant = llvm::dyn_cast<llvm::Constant>(value);
+    if (!constant || !visited.insert(constant).second) {
+        return;
+    }
+    for (const auto& op : constant->operands()) {
+        collectReferencedGlobals(op.get(), out, visited);
+    }
+}
+
+std::unordered_set<const llvm::GlobalValue*> referencedGlobals(const llvm::Function& func) {
+    std::unordered_set<const llvm::GlobalValue*> result;
+    std::unordered_set<const llvm::Constant*> visited;
+    for (const auto& bb : func) {
+        for (const auto& inst : bb) {
+            for (const auto& op : inst.operands()) {
+                collectReferencedGlobals(op.get(), result, visited);
+            }
+        }
+    }
+    return result;
+}
+
+// ランタイム固有の可変状態（ファイル内static変数）かどうか
+bool isRuntimeLocalState(const llvm::GlobalValue* gv) {
+    auto* var = llvm::dyn_cast<llvm::GlobalVariable>(gv);
+    return var && var->hasLocalLinkage() && !var->isConstant();
+}
+
+}  // namespace
+
+// ランタイムbitcodeのパスを検索
+std::string findRuntimeBitcode() {
+#ifdef CM_RUNTIME_BC_PATH
+    if (std::filesystem::exists(CM_RUNTIME_BC_PATH)) {
+        return CM_RUNTIME_BC_PATH;
+    }
+#endif
+
+    // ホームディレクトリの~/.cm/lib/も検索（make install対応）
+    std::vector<std::string> searchPaths = {
+        "build/lib/cm_runtime.bc",
+        "./build/lib/cm_runtime.bc",
+        "../build/lib/cm_runtime.bc",
+    };
+    if (const char* home = std::getenv("HOME")) {
+        searchPaths.push_back(std::string(home) + "/.cm/lib/cm_runtime.bc");
+    }
+
+    for (const auto& path : searchPaths) {
+        if (std::filesystem::exists(path)) {
+            return path;
+        }
+    }
+    return "";
+}
+
+// ランタイムbitcodeをモジュールにリンク
+size_t linkRuntimeBitcode(llvm::Module& module) {
+    const llvm::MemoryBuffer* buffer = loadRuntimeBitcode();
+    if (!buffer) {
+        return 0;
+    }
+
+    auto runtimeOrErr = llvm::getLazyBitcodeModule(buffer->getMemBufferRef(), module.getContext());
+    if (!runtimeOrErr) {
+        // LLVMバージョン不一致等: 従来のオブジェクトリンクのみで続行
+        auto message = llvm::toString(runtimeOrErr.takeError());
+        if (cm::debug::g_debug_mode) {
+            std::cerr << "[LLVM] ランタイムbitcodeを解析できません: " << message << "\n";
+        }
+        return 0;
+    }
+    std::unique_ptr<llvm::Module> runtime = std::move(*runtimeOrErr);
+
+    // 別アーキテクチャ向けのモジュールには取り込まない
+    llvm::Triple moduleTriple(module.getTargetTriple());
+    llvm::Triple runtimeTriple(runtime->getTargetTriple());
+    if (moduleTriple.getArch() != runtimeTriple.getArch() ||
+        moduleTriple.getOS() != runtimeTriple.getOS()) {
+        return 0;
+    }
+    runtime->setTargetTriple(module.getTargetTriple());
+    runtime->setDataLayout(module.getDataLayout());
+
+    // コンストラクタ/デストラクタ登録やllvm.usedはオブジェクト側で処理済み
+    std::vector<llvm::GlobalVariable*> appending;
+    for (auto& gv : runtime->globals()) {
+        if (gv.hasAppendingLinkage()) {
+            appending.push_back(&gv);
+        }
+    }
+    for (auto* gv : appending) {
+        gv->eraseFromParent();
+    }
+
+    // リンク前に定義済みのグローバル値を記録（リンク後の差分が取り込み分）
+    std::unordered_set<std::string> definedBefore;
+    for (const auto& gv : module.global_values()) {
+        if (!gv.isDeclaration()) {
+            definedBefore.insert(gv.getName().str());
+        }
+    }
+
+    // 参照されている関数（とその依存）のみを取り込む
+    if (llvm::Linker::linkModules(module, std::move(runtime), llvm::Linker::LinkOnlyNeeded)) {
+        throw std::runtime_error("Failed to link Cm runtime bitcode into module " +
+                                 module.getModuleIdentifier());
+    }
+
+    std::vector<llvm::Function*> importedFunctions;
+    for (auto& func : module) {
+        if (!func.isDeclaration() && !definedBefore.count(func.getName().str())) {
+            importedFunctions.push_back(&func);
+        }
+    }
+
+    // ランタイム固有の状態に触れる関数を判定
+    // （内部関数経由の参照も伝播させる。外部関数は実体がオブジェクト側にあるので伝播不要）
+    std::unordered_set<const llvm::Function*> stateful;
+    std::vector<std::pair<llvm::Function*, std::unordered_set<const llvm::GlobalValue*>>> refs;
+    for (auto* func : importedFunctions) {
+        refs.emplace_back(func, referencedGlobals(*func));
+    }
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const auto& [func, globals] : refs) {
+            if (stateful.count(func)) {
+                continue;
+            }
+            for (const auto* gv : globals) {
+                auto* callee = llvm::dyn_cast<llvm::Function>(gv);
+                if (isRuntimeLocalState(gv) ||
+                    (callee && callee->hasLocalLinkage() && stateful.count(callee))) {
+                    stateful.insert(func);
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    // 外部公開関数: available_externallyにしてインライン候補とする（本体は出力されない）
+    // 状態に触れる関数は宣言に戻し、cm_runtime.o の実体を呼ぶ
+    size_t linked = 0;
+    for (auto* func : importedFunctions) {
+        if (func->hasLocalLinkage()) {
+            continue;
+        }
+        if (stateful.count(func)) {
+            func->deleteBody();
+            continue;
+        }
+        func->setLinkage(llvm::GlobalValue::AvailableExternallyLinkage);
+        func->setComdat(nullptr);
+        // ランタイムのビルド時ターゲット属性は呼び出し側と異なり得るため、
+        // 呼び出し側のTargetMachine設定に従わせる（インライン互換性チェック対策）
+        func->removeFnAttr("target-cpu");
+        func->removeFnAttr("target-features");
+        func->removeFnAttr("tune-cpu");
+        ++linked;
+    }
+
+    // 取り込まれたグローバル変数: 可変な外部変数はオブジェクト側の実体を参照する
+    for (auto& gv : module.globals()) {
+        if (gv.isDeclaration() || gv.hasLocalLinkage() || definedBefore.count(gv.getName().str())) {
+            continue;
+        }
+        if (gv.isConstant()) {
+            gv.setLinkage(llvm::GlobalValue::AvailableExternallyLinkage);
+        } else {
+            gv.setInitializer(nullptr);
+            gv.setLinkage(llvm::GlobalValue::ExternalLinkage);
+        }
+        gv.setComdat(nullptr);
+    }
+
+    // 参照されなくなった内部関数・内部変数を削除
+    bool erased = true;
+    while (erased) {
+        erased = false;
+        for (auto it = module.begin(); it != module.end();) {
+            llvm::Function& func = *it++;
+            if (func.hasLocalLinkage() && func.use_empty() &&
+                !definedBefore.count(func.getName().str())) {
+                func.eraseFromParent();
+                erased = true;
+            }
+        }
+        for (auto it = module.global_begin(); it != module.global_end();) {
+            llvm::GlobalVariable& gv = *it++;
+            if (gv.hasLocalLinkage() && gv.use_empty() &&
+                !definedBefore.count(gv.getName().str())) {
+                gv.eraseFromParent();
+                erased = true;
+            }
+        }
+    }
+
+    if (cm::debug::g_debug_mode) {
+        std::cerr << "[LLVM] ランタイムbitcodeから " << linked
+                  << " 関数をインライン候補として取り込み\n";
+    }
+    return linked;
+}
+
+}  // namespace cm::codegen::llvm_backend
@@ -0,0 +1,29 @@
+#pragma once
+
+/// @file runtime_bitcode.hpp
+/// @brief Cランタイム（runtime.c）のbitcodeリンク
+/// cm_slice_get_i32 / cm_slice_len 等のランタイム関数を最適化前にモジュールへ取り込み、
+/// 呼び出し側へのインライン展開を可能にする
+
+#include <llvm/IR/Module.h>
+
+#include <cstddef>
+#include <string>
+
+namespace cm::codegen::llvm_backend {
+
+/// ランタイムbitcode（cm_runtime.bc）のパスを検索
+/// @return 見つからない場合は空文字列
+std::string findRuntimeBitcode();
+
+/// ランタイムbitcodeをモジュールにリンク（PassBuilderパイプラインの前に呼ぶ）
+///
+/// モジュールが参照しているランタイム関数のみを取り込み、available_externally として
+/// インライン展開の候補にする。実体は従来通り cm_runtime.o（JITではホストプロセス）に残るため、
+/// インライン化されなかった呼び出しやランタイム内部の状態は共有される。
+/// ファイル内static変数などランタイム固有の状態に触れる関数は取り込まない。
+///
+/// @return 取り込んだ関数の数（bitcode未検出・ターゲット不一致・読み込み失敗時は0）
+size_t linkRuntimeBitcode(llvm::Module& module);
+
+}  // namespace cm::codegen::llvm_backend
@@ -47,6 +47,7 @@ CmEventLoop* cm_event_loop_new(void) {
         return NULL;
 
     memset(loop, 0, sizeof(CmEventLoop));
+    loop->os_event_capacity = 64;
 
 #ifdef CM_USE_KQUEUE
     loop->kq = kqueue();
@@ -54,12 +55,25 @@ CmEventLoop* cm_event_loop_new(void) {
         free(loop);
         return NULL;
     }
+    loop->os_events = (struct kevent*)malloc(sizeof(struct kevent) * loop->os_event_capacity);
+    if (!loop->os_events) {
+        close(loop->kq);
+        free(loop);
+        return NULL;
+    }
 #elif defined(CM_USE_EPOLL)
     loop->epfd = epoll_create1(0);
     if (loop->epfd < 0) {
         free(loop);
         return NULL;
     }
+    loop->os_events =
+        (struct epoll_event*)malloc(sizeof(struct epoll_event) * loop->os_event_capacity);
+    if (!loop->os_events) {
+        close(loop->epfd);
+        free(loop);
+        return NULL;
+    }
 #else
     loop->capacity = 16;
     loop->fds = (struct pollfd*)malloc(sizeof(struct pollfd) * loop->capacity);
@@ -70,7 +84,7 @@ CmEventLoop* cm_event_loop_new(void) {
     loop->nfds = 0;
 #endif
 
-    loop->pending_capacity = 16;
+    loop->pending_capacity = loop->os_event_capacity;
     loop->pending_events = (CmEvent*)malloc(sizeof(CmEvent) * loop->pending_capacity);
     loop->pending_count = 0;
     loop->running = false;
@@ -88,71 +102,206 @@ void cm_event_loop_drop(CmEventLoop* loop) {
 #ifdef CM_USE_KQUEUE
     if (loop->kq >= 0)
         close(loop->kq);
+    if (loop->os_events)
+        free(loop->os_events);
 #elif defined(CM_USE_EPOLL)
     if (loop->epfd >= 0)
         close(loop->epfd);
+    if (loop->os_events)
+        free(loop->os_events);
 #else
     if (loop->fds)
         free(loop->fds);
 #endif
 
+    for (int i = 0; i < loop->source_capacity; i++) {
+        CmIoSource* source = loop->sources[i];
+        if (source) {
+            cm_waker_drop(source->read_waker);
+            cm_waker_drop(source->write_waker);
+            free(source);
+        }
+    }
+    if (loop->sources)
+        free(loop->sources);
+
+    for (int i = 0; i < loop->timer_count; i++) {
+        cm_waker_drop(loop->timers[i].waker);
+    }
+    if (loop->timers)
+        free(loop->timers);
+
     if (loop->pending_events)
         free(loop->pending_events);
     free(loop);
 }
 
 // ============================================================
-// ファイルディスクリプタを登録
+// I/Oソース表（fdでインデックス）
 // ============================================================
-int cm_event_loop_register(CmEventLoop* loop, int fd, CmEventType type, void* user_data) {
-    if (!loop || fd < 0)
-        return -1;
+static CmIoSource* source_get(CmEventLoop* loop, int fd) {
+    if (fd < 0 || fd >= loop->source_capacity)
+        return NULL;
+    return loop->sources[fd];
+}
 
-#ifdef CM_USE_KQUEUE
-    struct kevent ev;
-    int filter = 0;
-    if (type & CM_EVENT_READ)
-        filter = EVFILT_READ;
-    else if (type & CM_EVENT_WRITE)
-        filter = EVFILT_WRITE;
+static CmIoSource* source_get_or_create(CmEventLoop* loop, int fd) {
+    if (fd >= loop->source_capacity) {
+        int new_cap = loop->source_capacity ? loop->source_capacity : 64;
+        while (new_cap <= fd)
+            new_cap *= 2;
+        CmIoSource** new_sources =
+            (CmIoSource**)realloc(loop->sources, sizeof(CmIoSource*) * new_cap);
+        if (!new_sources)
+            return NULL;
+        memset(new_sources + loop->source_capacity, 0,
+               sizeof(CmIoSource*) * (new_cap - loop->source_capacity));
+        loop->sources = new_sources;
+        loop->source_capacity = new_cap;
+    }
 
-    EV_SET(&ev, fd, filter, EV_ADD | EV_ENABLE, 0, 0, user_data);
-    return kevent(loop->kq, &ev, 1, NULL, 0, NULL);
+    CmIoSource* source = loop->sources[fd];
+    if (!source) {
+        source = (CmIoSource*)calloc(1, sizeof(CmIoSource));
+        if (!source)
+            return NULL;
+        source->fd = fd;
+        loop->sources[fd] = source;
+        loop->source_count++;
+    }
+    return source;
+}
+
+static void source_remove(CmEventLoop* loop, int fd) {
+    CmIoSource* source = source_get(loop, fd);
+    if (!source)
+        return;
+    cm_waker_drop(source->read_waker);
+    cm_waker_drop(source->write_waker);
+    free(source);
+    loop->sources[fd] = NULL;
+    loop->source_count--;
+}
+
+// OSに監視対象を反映（新規登録 or 変更）
+static int source_arm(CmEventLoop* loop, CmIoSource* source, bool is_new) {
+#ifdef CM_USE_KQUEUE
+    (void)is_new;
+    struct kevent changes[2];
+    int nchanges = 0;
+    if (source->interest & CM_EVENT_READ)
+        EV_SET(&changes[nchanges++], source->fd, EVFILT_READ, EV_ADD | EV_ENABLE, 0, 0, source);
+    if (source->interest & CM_EVENT_WRITE)
+        EV_SET(&changes[nchanges++], source->fd, EVFILT_WRITE, EV_ADD | EV_ENABLE, 0, 0, source);
+    return kevent(loop->kq, changes, nchanges, NULL, 0, NULL);
 
 #elif defined(CM_USE_EPOLL)
     struct epoll_event ev;
     ev.events = 0;
-    if (type & CM_EVENT_READ)
+    if (source->interest & CM_EVENT_READ)
         ev.events |= EPOLLIN;
-    if (type & CM_EVENT_WRITE)
+    if (source->interest & CM_EVENT_WRITE)
         ev.events |= EPOLLOUT;
-    ev.data.ptr = user_data;
-    return epoll_ctl(loop->epfd, EPOLL_CTL_ADD, fd, &ev);
+    ev.data.ptr = source;
+    return epoll_ctl(loop->epfd, is_new ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, source->fd, &ev);
 
 #else
-    // poll: 配列に追加
-    if (loop->nfds >= loop->capacity) {
-        int new_cap = loop->capacity * 2;
-        struct pollfd* new_fds =
-            (struct pollfd*)realloc(loop->fds, sizeof(struct pollfd) * new_cap);
-        if (!new_fds)
-            return -1;
-        loop->fds = new_fds;
-        loop->capacity = new_cap;
-    }
-
-    loop->fds[loop->nfds].fd = fd;
-    loop->fds[loop->nfds].events = 0;
-    if (type & CM_EVENT_READ)
-        loop->fds[loop->nfds].events |= POLLIN;
-    if (type & CM_EVENT_WRITE)
-        loop->fds[loop->nfds].events |= POLLOUT;
-    loop->fds[loop->nfds].revents = 0;
-    loop->nfds++;
+    (void)is_new;
+    int index = -1;
+    for (int i = 0; i < loop->nfds; i++) {
+        if (loop->fds[i].fd == source->fd) {
+            index = i;
+            break;
+        }
+    }
+    if (index < 0) {
+        if (loop->nfds >= loop->capacity) {
+            int new_cap = loop->capacity * 2;
+            struct pollfd* new_fds =
+                (struct pollfd*)realloc(loop->fds, sizeof(struct pollfd) * new_cap);
+            if (!new_fds)
+                return -1;
+            loop->fds = new_fds;
+            loop->capacity = new_cap;
+        }
+        index = loop->nfds++;
+        loop->fds[index].fd = source->fd;
+    }
+
+    loop->fds[index].events = 0;
+    if (source->interest & CM_EVENT_READ)
+        loop->fds[index].events |= POLLIN;
+    if (source->interest & CM_EVENT_WRITE)
+        loop->fds[index].events |= POLLOUT;
+    loop->fds[index].revents = 0;
     return 0;
 #endif
 }
 
+// 保持用にWakerを複製（起こす手段を持たないダミーWakerは保持しない）
+static CmWaker* retain_waker(const CmWaker* waker) {
+    if (!waker || !waker->wake_by_ref)
+        return NULL;
+    return cm_waker_clone(waker);
+}
+
+// ============================================================
+// ファイルディスクリプタを登録
+// ============================================================
+int cm_event_loop_register(CmEventLoop* loop, int fd, CmEventType type, void* user_data) {
+    if (!loop || fd < 0)
+        return -1;
+
+    bool is_new = source_get(loop, fd) == NULL;
+    CmIoSource* source = source_get_or_create(loop, fd);
+    if (!source)
+        return -1;
+
+    source->interest = type & (CM_EVENT_READ | CM_EVENT_WRITE);
+    source->user_data = user_data;
+    if (source_arm(loop, source, is_new) < 0) {
+        if (is_new)
+            source_remove(loop, fd);
+        return -1;
+    }
+    return 0;
+}
+
+// ============================================================
+// Wakerを登録（準備完了時にタスクを起こす）
+// ============================================================
+int cm_event_loop_register_waker(CmEventLoop* loop, int fd, CmEventType type,
+                                 const CmWaker* waker) {
+    if (!loop || fd < 0)
+        return -1;
+
+    bool is_new = source_get(loop, fd) == NULL;
+    CmIoSource* source = source_get_or_create(loop, fd);
+    if (!source)
+        return -1;
+
+    if (type & CM_EVENT_READ) {
+        cm_waker_drop(source->read_waker);
+        source->read_waker = retain_waker(waker);
+    }
+    if (type & CM_EVENT_WRITE) {
+        cm_waker_drop(source->write_waker);
+        source->write_waker = retain_waker(waker);
+    }
+
+    int interest = source->interest | (type & (CM_EVENT_READ | CM_EVENT_WRITE));
+    if (!is_new && interest == source->interest)
+        return 0;
+
+    source->interest = interest;
+    if (source_arm(loop, source, is_new) < 0) {
+        if (is_new)
+            source_remove(loop, fd);
+        return -1;
+    }
+    return 0;
+}
+
 // ============================================================
 // ファイルディスクリプタを解除
 // ============================================================
@@ -160,6 +309,8 @@ int cm_event_loop_unregister(CmEventLoop* loop, int fd) {
     if (!loop || fd < 0)
         return -1;
 
+    source_remove(loop, fd);
+
 #ifdef CM_USE_KQUEUE
     struct kevent ev;
     EV_SET(&ev, fd, EVFILT_READ, EV_DELETE, 0, 0, NULL);
@@ -183,6 +334,141 @@ int cm_event_loop_unregister(CmEventLoop* loop, int fd) {
 #endif
 }
 
+// ============================================================
+// タイマー（最小ヒープ）
+// ============================================================
+static void timer_swap(CmTimerEntry* a, CmTimerEntry* b) {
+    CmTimerEntry tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+static void timer_sift_up(CmEventLoop* loop, int i) {
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (loop->timers[parent].expires_at <= loop->timers[i].expires_at)
+            break;
+        timer_swap(&loop->timers[parent], &loop->timers[i]);
+        i = parent;
+    }
+}
+
+static void timer_sift_down(CmEventLoop* loop, int i) {
+    for (;;) {
+        int smallest = i;
+        int left = i * 2 + 1;
+        int right = left + 1;
+        if (left < loop->timer_count &&
+            loop->timers[left].expires_at < loop->timers[smallest].expires_at)
+            smallest = left;
+        if (right < loop->timer_count &&
+            loop->timers[right].expires_at < loop->timers[smallest].expires_at)
+            smallest = right;
+        if (smallest == i)
+            break;
+        timer_swap(&loop->timers[smallest], &loop->timers[i]);
+        i = smallest;
+    }
+}
+
+int cm_event_loop_add_timer(CmEventLoop* loop, uint64_t expires_at, const CmWaker* waker) {
+    if (!loop)
+        return -1;
+
+    if (loop->timer_count >= loop->timer_capacity) {
+        int new_cap = loop->timer_capacity ? loop->timer_capacity * 2 : 16;
+        CmTimerEntry* new_timers =
+            (CmTimerEntry*)realloc(loop->timers, sizeof(CmTimerEntry) * new_cap);
+        if (!new_timers)
+            return -1;
+        loop->timers = new_timers;
+        loop->timer_capacity = new_cap;
+    }
+
+    int i = loop->timer_count++;
+    loop->timers[i].expires_at = expires_at;
+    loop->timers[i].waker = retain_waker(waker);
+    timer_sift_up(loop, i);
+    return 0;
+}
+
+int cm_event_loop_next_timeout(CmEventLoop* loop) {
+    if (!loop || loop->timer_count == 0)
+        return -1;
+
+    uint64_t now = cm_now_ms();
+    uint64_t deadline = loop->timers[0].expires_at;
+    if (deadline <= now)
+        return 0;
+
+    uint64_t wait = deadline - now;
+    return wait > (uint64_t)INT32_MAX ? INT32_MAX : (int)wait;
+}
+
+// 満了したタイマーのWakerを起こす
+static void timers_fire_expired(CmEventLoop* loop) {
+    if (loop->timer_count == 0)
+        return;
+
+    uint64_t now = cm_now_ms();
+    while (loop->timer_count > 0 && loop->timers[0].expires_at <= now) {
+        CmWaker* waker = loop->timers[0].waker;
+        loop->timers[0] = loop->timers[--loop->timer_count];
+        timer_sift_down(loop, 0);
+        cm_waker_wake(waker);
+        cm_waker_drop(waker);
+    }
+}
+
+// ============================================================
+// 準備完了イベントの記録とWakerの起動
+// ============================================================
+static void dispatch_event(CmEventLoop* loop, CmIoSource* source, int fd, int type) {
+    if (loop->pending_count >= loop->pending_capacity) {
+        int new_cap = loop->pending_capacity * 2;
+        CmEvent* new_events = (CmEvent*)realloc(loop->pending_events, sizeof(CmEvent) * new_cap);
+        if (new_events) {
+            loop->pending_events = new_events;
+            loop->pending_capacity = new_cap;
+        }
+    }
+    if (loop->pending_count < loop->pending_capacity) {
+        CmEvent* ev = &loop->pending_events[loop->pending_count++];
+        ev->fd = fd;
+        ev->type = (CmEventType)type;
+        ev->user_data = source ? source->user_data : NULL;
+        ev->future = NULL;
+    }
+
+    if (!source)
+        return;
+    // エラー/切断は読み書き両方の待機者に通知する
+    if (type & (CM_EVENT_READ | CM_EVENT_ERROR))
+        cm_waker_wake(source->read_waker);
+    if (type & (CM_EVENT_WRITE | CM_EVENT_ERROR))
+        cm_waker_wake(source->write_waker);
+}
+
+#if defined(CM_USE_KQUEUE) || defined(CM_USE_EPOLL)
+// イベントバッファが満杯だった場合は次回に備えて拡張する
+static void grow_os_events(CmEventLoop* loop) {
+    int new_cap = loop->os_event_capacity * 2;
+    if (new_cap > 4096)
+        return;
+#ifdef CM_USE_KQUEUE
+    struct kevent* new_events =
+        (struct kevent*)realloc(loop->os_events, sizeof(struct kevent) * new_cap);
+#else
+    struct epoll_event* new_events =
+        (struct epoll_event*)realloc(loop->os_events, sizeof(struct epoll_event) * new_cap);
+#endif
+    if (new_events) {
+        loop->os_events = new_events;
+        loop->os_event_capacity = new_cap;
+    }
+}
+#endif
+
 // ============================================================
 // イベントを待機
 // ============================================================
@@ -190,8 +476,14 @@ int cm_event_loop_poll(CmEventLoop* loop, int timeout_ms) {
     if (!loop)
         return -1;
 
+    // タイマーの満了より長くは待たない
+    int timer_timeout = cm_event_loop_next_timeout(loop);
+    if (timer_timeout >= 0 && (timeout_ms < 0 || timer_timeout < timeout_ms))
+        timeout_ms = timer_timeout;
+
+    loop->pending_count = 0;
+
 #ifdef CM_USE_KQUEUE
-    struct kevent events[16];
     struct timespec ts;
     struct timespec* tsp = NULL;
 
@@ -201,63 +493,61 @@ int cm_event_loop_poll(CmEventLoop* loop, int timeout_ms) {
         tsp = &ts;
     }
 
-    int n = kevent(loop->kq, NULL, 0, events, 16, tsp);
-    if (n < 0)
+    int n = kevent(loop->kq, NULL, 0, loop->os_events, loop->os_event_capacity, tsp);
+    if (n < 0 && errno != EINTR)
         return -1;
 
-    loop->pending_count = 0;
-    for (int i = 0; i < n && loop->pending_count < loop->pending_capacity; i++) {
-        CmEvent* ev = &loop->pending_events[loop->pending_count++];
-        ev->fd = (int)events[i].ident;
-        ev->type = (events[i].filter == EVFILT_READ) ? CM_EVENT_READ : CM_EVENT_WRITE;
-        ev->user_data = events[i].udata;
-        if (events[i].flags & EV_ERROR)
-            ev->type |= CM_EVENT_ERROR;
+    for (int i = 0; i < n; i++) {
+        struct kevent* kev = &loop->os_events[i];
+        int type = (kev->filter == EVFILT_READ) ? CM_EVENT_READ : CM_EVENT_WRITE;
+        if (kev->flags & (EV_ERROR | EV_EOF))
+            type |= CM_EVENT_ERROR;
+        dispatch_event(loop, (CmIoSource*)kev->udata, (int)kev->ident, type);
     }
-    return loop->pending_count;
+    if (n == loop->os_event_capacity)
+        grow_os_events(loop);
 
 #elif defined(CM_USE_EPOLL)
-    struct epoll_event events[16];
-    int n = epoll_wait(loop->epfd, events, 16, timeout_ms);
-    if (n < 0)
+    int n = epoll_wait(loop->epfd, loop->os_events, loop->os_event_capacity, timeout_ms);
+    if (n < 0 && errno != EINTR)
         return -1;
 
-    loop->pending_count = 0;
-    for (int i = 0; i < n && loop->pending_count < loop->pending_capacity; i++) {
-        CmEvent* ev = &loop->pending_events[loop->pending_count++];
-        ev->fd = 0;  // epollはfdを直接返さない
-        ev->type = 0;
-        if (events[i].events & EPOLLIN)
-            ev->type |= CM_EVENT_READ;
-        if (events[i].events & EPOLLOUT)
-            ev->type |= CM_EVENT_WRITE;
-        if (events[i].events & EPOLLERR)
-            ev->type |= CM_EVENT_ERROR;
-        ev->user_data = events[i].data.ptr;
+    for (int i = 0; i < n; i++) {
+        struct epoll_event* eev = &loop->os_events[i];
+        CmIoSource* source = (CmIoSource*)eev->data.ptr;
+        int type = 0;
+        if (eev->events & EPOLLIN)
+            type |= CM_EVENT_READ;
+        if (eev->events & EPOLLOUT)
+            type |= CM_EVENT_WRITE;
+        if (eev->events & (EPOLLERR | EPOLLHUP))
+            type |= CM_EVENT_ERROR;
+        dispatch_event(loop, source, source ? source->fd : -1, type);
     }
-    return loop->pending_count;
+    if (n == loop->os_event_capacity)
+        grow_os_events(loop);
 
 #else
     int n = poll(loop->fds, loop->nfds, timeout_ms);
-    if (n < 0)
+    if (n < 0 && errno != EINTR)
         return -1;
 
-    loop->pending_count = 0;
-    for (int i = 0; i < loop->nfds && loop->pending_count < loop->pending_capacity; i++) {
+    for (int i = 0; i < loop->nfds && n > 0; i++) {
         if (loop->fds[i].revents) {
-            CmEvent* ev = &loop->pending_events[loop->pending_count++];
-            ev->fd = loop->fds[i].fd;
-            ev->type = 0;
+            int type = 0;
             if (loop->fds[i].revents & POLLIN)
-                ev->type |= CM_EVENT_READ;
+                type |= CM_EVENT_READ;
             if (loop->fds[i].revents & POLLOUT)
-                ev->type |= CM_EVENT_WRITE;
-            if (loop->fds[i].revents & POLLERR)
-                ev->type |= CM_EVENT_ERROR;
+                type |= CM_EVENT_WRITE;
+            if (loop->fds[i].revents & (POLLERR | POLLHUP))
+                type |= CM_EVENT_ERROR;
+            dispatch_event(loop, source_get(loop, loop->fds[i].fd), loop->fds[i].fd, type);
         }
     }
-    return loop->pending_count;
 #endif
+
+    timers_fire_expired(loop);
+    return loop->pending_count;
 }
 
 // ============================================================
@@ -270,35 +560,33 @@ void cm_event_loop_run(CmEventLoop* loop, CmExecutor* executor) {
     loop->running = true;
 
     while (loop->running) {
-        // まずタスクを実行
-        bool has_pending_tasks = false;
-        CmWaker waker = {0};
-        CmContext context = {.waker = &waker};
-
-        CmTask* task = executor->tasks;
-        while (task) {
-            if (!task->completed && task->future) {
-                CmPollState state = task->future->poll(task->future, &context);
-                if (state == CM_POLL_READY) {
-                    task->completed = true;
-                    if (task->future->drop) {
-                        task->future->drop(task->future);
-                    }
-                } else {
-                    has_pending_tasks = true;
-                }
-            }
-            task = task->next;
-        }
+        // 起こされたタスクのみをポーリング
+        cm_executor_run_ready(executor);
 
         // 全タスク完了時は終了
-        if (!has_pending_tasks) {
+        if (executor->pending_count == 0) {
             loop->running = false;
             break;
         }
 
-        // イベントを待機（短いタイムアウト）
-        cm_event_loop_poll(loop, 10);
+        int timeout_ms;
+        if (cm_executor_has_ready(executor)) {
+            // ポーリング中に起こされたタスクがあれば待たずにI/Oだけ確認
+            timeout_ms = 0;
+        } else if (loop->timer_count == 0 && loop->source_count == 0) {
+            // このループに起こす手段が登録されていない: 一定間隔で全タスクを再ポーリング
+            cm_executor_wake_all(executor);
+            timeout_ms = CM_EVENT_LOOP_FALLBACK_TICK_MS;
+        } else if (cm_executor_wake_unparked(executor) > 0) {
+            // Wakerを預けていないタスク（Wakerなしでfdだけ登録した場合など）は
+            // 誰にも起こされないため、一定間隔で再ポーリングする
+            timeout_ms = CM_EVENT_LOOP_FALLBACK_TICK_MS;
+        } else {
+            // 全タスクがWakerを預けている: 次のタイマー満了まで（なければI/Oが来るまで）ブロック
+            timeout_ms = -1;
+        }
+
+        cm_event_loop_poll(loop, timeout_ms);
     }
 }
 
@@ -308,10 +596,10 @@ void cm_event_loop_run(CmEventLoop* loop, CmExecutor* executor) {
 typedef struct {
     uint64_t expires_at;
     int64_t result;
+    bool timer_registered;
 } SleepFutureState;
 
 static CmPollState sleep_future_poll(CmFuture* future, void* ctx) {
-    (void)ctx;
     if (!future)
         return CM_POLL_READY;
 
@@ -326,6 +614,14 @@ static CmPollState sleep_future_poll(CmFuture* future, void* ctx) {
         return CM_POLL_READY;
     }
 
+    // 満了時に起こしてもらうようタイマーを登録（1回のみ）
+    CmContext* context = (CmContext*)ctx;
+    CmEventLoop* loop = cm_event_loop_global();
+    if (!state->timer_registered && context && context->waker && loop) {
+        if (cm_event_loop_add_timer(loop, state->expires_at, context->waker) == 0)
+            state->timer_registered = true;
+    }
+
     return CM_POLL_PENDING;
 }
 
@@ -350,6 +646,7 @@ CmFuture* cm_sleep_ms(uint64_t ms) {
 
     state->expires_at = cm_now_ms() + ms;
     state->result = 0;
+    state->timer_registered = false;
 
     future->state = state;
     future->poll = sleep_future_poll;
@@ -363,8 +660,11 @@ CmFuture* cm_sleep_ms(uint64_t ms) {
 // ============================================================
 // グローバルイベントループの初期化/終了
 // ============================================================
-__attribute__((constructor)) static void cm_event_loop_init(void) {
-    cm_global_event_loop = cm_event_loop_new();
+// コンパイラ本体にもリンクされるため、起動時ではなく初回使用時に生成する
+CmEventLoop* cm_event_loop_global(void) {
+    if (!cm_global_event_loop)
+        cm_global_event_loop = cm_event_loop_new();
+    return cm_global_event_loop;
 }
 
 __attribute__((destructor)) static void cm_event_loop_fini(void) {
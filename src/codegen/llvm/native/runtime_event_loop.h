@@ -43,30 +43,68 @@ typedef struct CmEvent {
     CmFuture* future;  // 関連するFuture
 } CmEvent;
 
+// ============================================================
+// I/Oソース（登録済みfdごとの状態）
+// 準備完了時に対応するWakerを起こす
+// ============================================================
+typedef struct CmIoSource {
+    int fd;                // ファイルディスクリプタ
+    int interest;          // 監視中のCmEventType
+    void* user_data;       // ユーザーデータ
+    CmWaker* read_waker;   // 読み込み可能時に起こすWaker
+    CmWaker* write_waker;  // 書き込み可能時に起こすWaker
+} CmIoSource;
+
+// ============================================================
+// タイマーエントリ（最小ヒープ要素）
+// ============================================================
+typedef struct CmTimerEntry {
+    uint64_t expires_at;  // 満了時刻（ミリ秒）
+    CmWaker* waker;       // 満了時に起こすWaker
+} CmTimerEntry;
+
 // ============================================================
 // イベントループ構造体
 // ============================================================
 typedef struct CmEventLoop {
 #ifdef CM_USE_KQUEUE
     int kq;  // kqueue fd
+    struct kevent* os_events;
 #elif defined(CM_USE_EPOLL)
     int epfd;  // epoll fd
+    struct epoll_event* os_events;
 #else
     struct pollfd* fds;  // poll用
     int nfds;
     int capacity;
 #endif
+    int os_event_capacity;  // 1回の待機で受け取れるイベント数（満杯なら拡張）
     bool running;
     CmEvent* pending_events;
     int pending_count;
     int pending_capacity;
+
+    // fdでインデックスされるI/Oソース表
+    CmIoSource** sources;
+    int source_capacity;
+    int source_count;
+
+    // タイマーの最小ヒープ（expires_at昇順）
+    CmTimerEntry* timers;
+    int timer_count;
+    int timer_capacity;
 } CmEventLoop;
 
 // ============================================================
-// グローバルイベントループ
+// グローバルイベントループ（初回のcm_event_loop_globalで生成）
 // ============================================================
 extern CmEventLoop* cm_global_event_loop;
 
+CmEventLoop* cm_event_loop_global(void);
+
+// Wakerを預けていないタスクを再ポーリングする間隔（ミリ秒）
+#define CM_EVENT_LOOP_FALLBACK_TICK_MS 10
+
 // ============================================================
 // Event Loop API
 // ============================================================
@@ -81,10 +119,22 @@ int cm_event_loop_register(CmEventLoop* loop, int fd, CmEventType type, void* us
 // ファイルディスクリプタを解除
 int cm_event_loop_unregister(CmEventLoop* loop, int fd);
 
+// fdの準備完了時にWakerを起こすよう登録（既存登録の監視対象に追加される）
+int cm_event_loop_register_waker(CmEventLoop* loop, int fd, CmEventType type,
+                                 const CmWaker* waker);
+
+// 満了時刻（cm_now_ms基準）にWakerを起こすタイマーを登録
+int cm_event_loop_add_timer(CmEventLoop* loop, uint64_t expires_at, const CmWaker* waker);
+
+// 次のタイマー満了までの待機時間（ミリ秒、タイマーがなければ-1）
+int cm_event_loop_next_timeout(CmEventLoop* loop);
+
 // イベントを待機（タイムアウト: ミリ秒、-1で無限待機）
+// 準備完了したfdと満了したタイマーのWakerを起こす
 int cm_event_loop_poll(CmEventLoop* loop, int timeout_ms);
 
 // イベントループを実行（タスクがなくなるまで）
+// 起こされたタスクのみをポーリングし、次のタイマー満了まで待機する
 void cm_event_loop_run(CmEventLoop* loop, CmExecutor* executor);
 
 // ============================================================
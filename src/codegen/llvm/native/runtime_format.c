@@ -2034,6 +2034,8 @@ void __cm_panic(const char* message) {
         cm_write_stderr(message, msg_len);
         cm_write_stderr("\n", 1);
     }
+    // trap前に標準出力のバッファを書き出す（メッセージなしの場合も含む）
+    cm_flush_stdout();
     // abort()の代わりに__builtin_trapを使用（より移植性が高い）
     __builtin_trap();
 #endif
@@ -148,9 +148,12 @@ void cm_io_clear_errno(void) {
 // ============================================================
 
 #ifndef CM_NO_STD
+// ランタイムの標準出力バッファ（runtime_platform.c）
+extern void cm_flush_stdout(void);
+
 /// 標準出力をフラッシュ
 void cm_io_flush_stdout(void) {
-    fflush(stdout);
+    cm_flush_stdout();
 }
 
 /// 標準エラー出力をフラッシュ
@@ -4,9 +4,13 @@
 #include "../../common/runtime_platform.h"
 
 #ifndef CM_NO_STD
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 #endif
 
 // ============================================================
@@ -39,17 +43,167 @@ char* cm_strcat(char* dst, const char* src) {
 // ============================================================
 // I/O Operations
 // ============================================================
+// 標準出力はランタイム所有のバッファに溜め、方針に応じてwrite(2)でまとめて書き出す
+// （libcのstdoutにはsetvbufしない: 使用開始後のsetvbufは未定義動作になるため）
+// 書き出しのタイミング:
+// - 行バッファ: 改行を含む書き込みごと / ブロックバッファ: バッファが満杯になった時
+// - cm_flush_stdout()・stderrへの書き込み前・stdinからの読み込み前
+// - exit時（atexit）と異常終了時（下記シグナルハンドラ）
+// 方針とハンドラは最初の書き込み時に決めるため、cm本体にリンクされても何もしない
+// FFI（printf等）との出力順:
+// - libcのstdoutに溜まった分は、空のバッファに書き始める時に先に出す
+// - FFIでstdoutに書く前にはcm_flush_stdout()（std::io::flush）を呼ぶこと
+//   （extern呼び出しごとの自動フラッシュはしない: 数学関数等の呼び出しが重くなるため）
 
 #ifndef CM_NO_STD
 
+// ブロック/行バッファのサイズ（ログの多いバッチ処理でsyscall数を抑える）
+#define CM_STDOUT_BUFFER_SIZE (64 * 1024)
+
+static char cm_stdout_buffer[CM_STDOUT_BUFFER_SIZE];
+static size_t cm_stdout_len = 0;
+static int cm_stdout_buffering = -1;  // -1: 未初期化（最初の書き込みで決める）
+static pthread_mutex_t cm_stdout_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// EINTRと部分書き込みを処理してfdに全て書き出す（async-signal-safe）
+static void cm_stdout_write_all(const char* data, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(STDOUT_FILENO, data, len);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return;
+        }
+        data += n;
+        len -= (size_t)n;
+    }
+}
+
+// 異常終了（panicのtrap・abort・不正アクセス）時に溜まった出力を書き出す
+// ロックもstdioも使わず、バッファの内容をwrite(2)するだけにする
+static void cm_stdout_crash_handler(int sig) {
+    size_t len = __atomic_exchange_n(&cm_stdout_len, 0, __ATOMIC_ACQUIRE);
+    if (len > CM_STDOUT_BUFFER_SIZE)
+        len = CM_STDOUT_BUFFER_SIZE;
+    cm_stdout_write_all(cm_stdout_buffer, len);
+    // SA_RESETHANDで既定動作に戻っているので再送出して終了する
+    raise(sig);
+}
+
+// ロック保持中に呼ぶ: 溜まった出力を書き出す
+// バッファが空になった後のlibc側の出力（FFI）の方が新しいので、cmのバッファを先に出す
+static void cm_stdout_flush_locked(void) {
+    size_t len = __atomic_exchange_n(&cm_stdout_len, 0, __ATOMIC_RELEASE);
+    cm_stdout_write_all(cm_stdout_buffer, len);
+    fflush(stdout);
+}
+
+static void cm_stdout_atexit(void) {
+    cm_flush_stdout();
+}
+
+// 既定の方針: CM_STDOUT_BUFFER=line|block|none、未指定なら端末かどうかで決める
+static int cm_stdout_default_buffering(void) {
+    const char* env = getenv("CM_STDOUT_BUFFER");
+    if (env) {
+        if (strcmp(env, "line") == 0)
+            return CM_STDOUT_LINE_BUFFERED;
+        if (strcmp(env, "block") == 0)
+            return CM_STDOUT_BLOCK_BUFFERED;
+        if (strcmp(env, "none") == 0 || strcmp(env, "unbuffered") == 0)
+            return CM_STDOUT_UNBUFFERED;
+    }
+    return isatty(STDOUT_FILENO) ? CM_STDOUT_LINE_BUFFERED : CM_STDOUT_BLOCK_BUFFERED;
+}
+
+// ロック保持中に呼ぶ: 最初の使用時に方針を決め、終了時の書き出しを登録する
+static void cm_stdout_init_locked(void) {
+    if (cm_stdout_buffering >= 0)
+        return;
+    cm_stdout_buffering = cm_stdout_default_buffering();
+    atexit(cm_stdout_atexit);
+
+    // 既にハンドラが設定されているシグナルには手を出さない
+    static const int signals[] = {SIGABRT, SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGTRAP};
+    for (size_t i = 0; i < sizeof(signals) / sizeof(signals[0]); i++) {
+        struct sigaction old;
+        if (sigaction(signals[i], NULL, &old) != 0 || old.sa_handler != SIG_DFL)
+            continue;
+        struct sigaction sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = cm_stdout_crash_handler;
+        sa.sa_flags = SA_RESETHAND | SA_NODEFER;
+        sigemptyset(&sa.sa_mask);
+        sigaction(signals[i], &sa, NULL);
+    }
+}
+
 void cm_write_stdout(const char* str, size_t len) {
-    fwrite(str, 1, len, stdout);
-    fflush(stdout);  // JIT実行時に出力が確実に表示されるようにflush
+    pthread_mutex_lock(&cm_stdout_lock);
+    cm_stdout_init_locked();
+
+    // 空のバッファに書き始める時は、それより前にFFIがlibcのstdoutに溜めた分を先に出す
+    if (cm_stdout_len == 0) {
+        fflush(stdout);
+    }
+
+    if (cm_stdout_buffering == CM_STDOUT_UNBUFFERED) {
+        cm_stdout_flush_locked();
+        cm_stdout_write_all(str, len);
+    } else if (cm_stdout_len + len > CM_STDOUT_BUFFER_SIZE) {
+        // 入り切らない場合は溜まった分を出し、大きな書き込みはバッファを経由しない
+        cm_stdout_flush_locked();
+        if (len >= CM_STDOUT_BUFFER_SIZE) {
+            cm_stdout_write_all(str, len);
+        } else {
+            memcpy(cm_stdout_buffer, str, len);
+            __atomic_store_n(&cm_stdout_len, len, __ATOMIC_RELEASE);
+        }
+    } else {
+        memcpy(cm_stdout_buffer + cm_stdout_len, str, len);
+        __atomic_store_n(&cm_stdout_len, cm_stdout_len + len, __ATOMIC_RELEASE);
+    }
+
+    if (cm_stdout_buffering == CM_STDOUT_LINE_BUFFERED && cm_stdout_len > 0 &&
+        memchr(str, '\n', len) != NULL) {
+        cm_stdout_flush_locked();
+    }
+    pthread_mutex_unlock(&cm_stdout_lock);
 }
 
 void cm_write_stderr(const char* str, size_t len) {
+    // 先に標準出力を書き出し、2>&1 でまとめた時の出力順を保つ
+    cm_flush_stdout();
     fwrite(str, 1, len, stderr);
     fflush(stderr);
 }
 
+/// 標準出力のバッファを書き出す
+void cm_flush_stdout(void) {
+    pthread_mutex_lock(&cm_stdout_lock);
+    cm_stdout_flush_locked();
+    pthread_mutex_unlock(&cm_stdout_lock);
+}
+
+/// 標準出力のバッファリング方針を変更（溜まっていた出力は先に書き出す）
+/// バッファはランタイム所有なので、出力開始後に呼んでも安全
+void cm_set_stdout_buffering(int mode) {
+    if (mode < CM_STDOUT_UNBUFFERED || mode > CM_STDOUT_BLOCK_BUFFERED)
+        return;
+    pthread_mutex_lock(&cm_stdout_lock);
+    cm_stdout_init_locked();
+    cm_stdout_flush_locked();
+    cm_stdout_buffering = mode;
+    pthread_mutex_unlock(&cm_stdout_lock);
+}
+
+/// 現在の標準出力のバッファリング方針
+int cm_get_stdout_buffering(void) {
+    pthread_mutex_lock(&cm_stdout_lock);
+    cm_stdout_init_locked();
+    int mode = cm_stdout_buffering;
+    pthread_mutex_unlock(&cm_stdout_lock);
+    return mode;
+}
+
 #endif  // !CM_NO_STD
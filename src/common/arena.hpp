@@ -0,0 +1,223 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace cm {
+
+/// IRノード用のアリーナ
+/// 層（AST / HIR / MIR）ごとにタグ型で別のアリーナを持つ。
+/// ノードは64KBのチャンクからバンプポインタで切り出し、破棄されたノードの領域は
+/// サイズクラス別のフリーリストに積んで同じ層の次のノードに再利用する。
+/// ノードのアドレスはrelease()まで移動しないので、所有者（unique_ptr）や生ポインタは
+/// そのままハンドルとして使える。
+///
+/// 割り当てはスレッドごとのキャッシュから行い、チャンクの追加時だけロックを取る。
+/// 別スレッドで割り当てたノードを破棄してもよい（領域は破棄したスレッドのキャッシュに入る）。
+///
+/// release()は層の生存ノードが0のときだけチャンクをまとめて返却する。
+/// 層の切り替わり（他スレッドがその層のノードを触っていない時点）で呼ぶこと。
+template <typename Tag>
+class NodeArena {
+   public:
+    static constexpr size_t kChunkSize = 64 * 1024;
+    static constexpr size_t kAlign = alignof(std::max_align_t);
+    static constexpr size_t kMaxNodeSize = 1024;  // これを超えるノードは通常のヒープに置く
+
+    static void* allocate(size_t size) {
+        if (size > kMaxNodeSize)
+            return ::operator new(size);
+        State& s = state();
+        if (Cache* cache = local())
+            return cache->allocate(size_class(size), s);
+        // スレッド終了処理中（キャッシュ返却後）の割り当て
+        std::lock_guard<std::mutex> lock(s.orphan_mutex);
+        return s.orphan.allocate(size_class(size), s);
+    }
+
+    static void deallocate(void* p, size_t size) noexcept {
+        if (!p)
+            return;
+        if (size > kMaxNodeSize) {
+            ::operator delete(p);
+            return;
+        }
+        State& s = state();
+        if (Cache* cache = local()) {
+            cache->deallocate(p, size_class(size), s);
+            return;
+        }
+        std::lock_guard<std::mutex> lock(s.orphan_mutex);
+        s.orphan.deallocate(p, size_class(size), s);
+    }
+
+    // 生存しているノード数
+    static size_t live() {
+        State& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        return static_cast<size_t>(live_locked(s));
+    }
+
+    // 確保済みのチャンクの総バイト数
+    static size_t reserved_bytes() {
+        State& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        return s.chunks.size() * kChunkSize;
+    }
+
+    // 生存ノードがなければ全チャンクを返却してtrue、残っていれば何もせずfalse
+    static bool release() {
+        State& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (live_locked(s) != 0)
+            return false;
+        for (char* chunk : s.chunks)
+            ::operator delete(chunk);
+        s.chunks.clear();
+        s.chunks.shrink_to_fit();
+        // 各キャッシュは次の割り当て・破棄で世代の変化に気付き、古いチャンクへの参照を捨てる
+        s.generation.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+
+   private:
+    static constexpr size_t kClasses = kMaxNodeSize / kAlign;
+
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    struct State;
+
+    struct Cache {
+        uint64_t generation = 0;
+        char* cursor = nullptr;
+        char* end = nullptr;
+        FreeNode* free_lists[kClasses + 1] = {};
+        // 持ち主のスレッドだけが書き込む（合計はrelease()がロック下で読む）
+        std::atomic<std::ptrdiff_t> live{0};
+
+        void refresh(State& s) {
+            uint64_t current = s.generation.load(std::memory_order_acquire);
+            if (current == generation)
+                return;
+            generation = current;
+            cursor = end = nullptr;
+            std::fill(std::begin(free_lists), std::end(free_lists), nullptr);
+        }
+
+        void* allocate(size_t cls, State& s) {
+            refresh(s);
+            live.store(live.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            if (FreeNode* node = free_lists[cls]) {
+                free_lists[cls] = node->next;
+                return node;
+            }
+            size_t bytes = cls * kAlign;
+            if (static_cast<size_t>(end - cursor) < bytes) {
+                cursor = s.new_chunk();
+                end = cursor + kChunkSize;
+            }
+            void* p = cursor;
+            cursor += bytes;
+            return p;
+        }
+
+        void deallocate(void* p, size_t cls, State& s) {
+            refresh(s);
+            live.store(live.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+            auto* node = static_cast<FreeNode*>(p);
+            node->next = free_lists[cls];
+            free_lists[cls] = node;
+        }
+    };
+
+    struct State {
+        std::mutex mutex;  // chunks / caches / idleを保護
+        std::vector<char*> chunks;
+        std::vector<std::unique_ptr<Cache>> caches;  // 作成した全キャッシュ（生存数の集計用）
+        std::vector<Cache*> idle;                    // 終了したスレッドから返却されたキャッシュ
+        std::atomic<uint64_t> generation{1};
+
+        std::mutex orphan_mutex;  // orphanを保護（mutexより先に取る）
+        Cache orphan;
+
+        char* new_chunk() {
+            auto* chunk = static_cast<char*>(::operator new(kChunkSize));
+            std::lock_guard<std::mutex> lock(mutex);
+            chunks.push_back(chunk);
+            return chunk;
+        }
+
+        Cache* attach() {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!idle.empty()) {
+                Cache* cache = idle.back();
+                idle.pop_back();
+                return cache;
+            }
+            caches.push_back(std::make_unique<Cache>());
+            return caches.back().get();
+        }
+
+        void detach(Cache* cache) {
+            std::lock_guard<std::mutex> lock(mutex);
+            idle.push_back(cache);
+        }
+    };
+
+    // スレッドが終了するとキャッシュを返却し、別のスレッドが引き継ぐ
+    struct Handle {
+        Cache* cache = state().attach();
+        ~Handle() {
+            state().detach(cache);
+            detached() = true;
+        }
+    };
+
+    static size_t size_class(size_t size) { return size == 0 ? 1 : (size + kAlign - 1) / kAlign; }
+
+    // 静的オブジェクトの破棄中にノードが破棄されても使えるよう、意図的に解放しない
+    static State& state() {
+        static State* s = new State();
+        return *s;
+    }
+
+    static bool& detached() {
+        static thread_local bool flag = false;
+        return flag;
+    }
+
+    static Cache* local() {
+        if (detached())
+            return nullptr;
+        static thread_local Handle handle;
+        return handle.cache;
+    }
+
+    static std::ptrdiff_t live_locked(State& s) {
+        std::ptrdiff_t total = s.orphan.live.load(std::memory_order_relaxed);
+        for (const auto& cache : s.caches)
+            total += cache->live.load(std::memory_order_relaxed);
+        return total;
+    }
+};
+
+}  // namespace cm
+
+// ノード型の定義内に置き、そのノードをタグの層のアリーナに割り当てる
+// （静的メンバ関数のみなので集成体初期化には影響しない）
+#define CM_ARENA_NODE(Tag)                                                                        \
+    static void* operator new(std::size_t size) { return ::cm::NodeArena<Tag>::allocate(size); } \
+    static void* operator new(std::size_t, void* place) noexcept { return place; }                \
+    static void operator delete(void* p, std::size_t size) noexcept {                             \
+        ::cm::NodeArena<Tag>::deallocate(p, size);                                                \
+    }                                                                                             \
+    static void operator delete(void*, void*) noexcept {}
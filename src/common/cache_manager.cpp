@@ -54,6 +54,50 @@ std::string CacheManager::compute_compiler_hash() {
     return hash.empty() ? "unknown" : hash;
 }
 
+std::string CacheManager::cached_compiler_hash() {
+    if (compiler_path_.empty() || !config_.enabled) {
+        return compute_compiler_hash();
+    }
+
+    // 1行目: mtime_ns size、2行目: SHA-256
+    auto memo_path = config_.cache_dir / "compiler_hash.txt";
+    int64_t mtime_ns = 0;
+    uintmax_t size = 0;
+    try {
+        auto ftime = std::filesystem::last_write_time(compiler_path_);
+        mtime_ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(ftime.time_since_epoch()).count();
+        size = std::filesystem::file_size(compiler_path_);
+    } catch (...) {
+        return compute_compiler_hash();
+    }
+
+    std::ifstream ifs(memo_path);
+    if (ifs.is_open()) {
+        int64_t saved_mtime = 0;
+        uintmax_t saved_size = 0;
+        std::string saved_hash;
+        if ((ifs >> saved_mtime >> saved_size >> saved_hash) && saved_mtime == mtime_ns &&
+            saved_size == size && !saved_hash.empty()) {
+            return saved_hash;
+        }
+    }
+
+    auto hash = compute_compiler_hash();
+    if (hash != "unknown") {
+        try {
+            std::filesystem::create_directories(config_.cache_dir);
+            std::ofstream ofs(memo_path);
+            if (ofs.is_open()) {
+                ofs << mtime_ns << " " << size << "\n" << hash << "\n";
+            }
+        } catch (...) {
+            // 保存失敗は無視（次回も計算するだけ）
+        }
+    }
+    return hash;
+}
+
 // ========== 合成フィンガープリント生成 ==========
 
 std::string CacheManager::compute_fingerprint(const std::vector<std::string>& source_files,
@@ -78,7 +122,7 @@ std::string CacheManager::compute_fingerprint(const std::vector<std::string>& so
     combined += "target:" + target + "\n";
     combined += "opt:" + std::to_string(optimization_level) + "\n";
     combined += "version:" + get_compiler_version() + "\n";
-    combined += "compiler:" + compute_compiler_hash() + "\n";
+    combined += "compiler:" + cached_compiler_hash() + "\n";
 
     // 結合文字列のSHA-256を最終フィンガープリントとする
     return picosha2::hash256_hex_string(combined);
@@ -65,6 +65,10 @@ class CacheManager {
     // コンパイラバイナリ自体のSHA-256ハッシュを計算
     static std::string compute_compiler_hash();
 
+    // コンパイラハッシュ（mtime+sizeが前回と同じならキャッシュ済みの値を返す）
+    // 数十MBのバイナリを毎回SHA-256にかけないようにする
+    std::string cached_compiler_hash();
+
     // 複数ファイル＋メタ情報から合成フィンガープリントを生成
     std::string compute_fingerprint(const std::vector<std::string>& source_files,
                                     const std::string& target, int optimization_level);
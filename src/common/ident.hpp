@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace cm {
+
+/// 識別子のインターンID
+/// プロセス全体で共有する表に識別子の綴りを登録し、32bitのIDで扱う。
+/// 同じ綴りは同じIDになるため、比較・ハッシュは整数演算で済む。
+/// 字句解析で識別子を登録し、ASTの識別子参照・スコープの検索・MIRの関数索引が利用する。
+/// 表は綴りのハッシュで分割し、登録・検索はその分割だけをロックする。
+/// 綴りの取得（str）はロックを取らない。
+class Ident {
+   public:
+    Ident() = default;  // 無効なID
+
+    /// 綴りを登録してIDを返す（登録済みなら既存のID）
+    static Ident intern(std::string_view text) {
+        Key key{text, std::hash<std::string_view>{}(text)};
+        auto& shard = table().shards[key.hash & kShardMask];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.ids.find(key);
+        if (it != shard.ids.end())
+            return Ident(it->second);
+        return Ident(shard.add(key, static_cast<uint32_t>(key.hash & kShardMask)));
+    }
+
+    /// 登録済みの綴りのIDを返す（未登録なら無効なID、表には追加しない）
+    static Ident find(std::string_view text) {
+        Key key{text, std::hash<std::string_view>{}(text)};
+        auto& shard = table().shards[key.hash & kShardMask];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.ids.find(key);
+        return it != shard.ids.end() ? Ident(it->second) : Ident();
+    }
+
+    bool valid() const { return id_ != kInvalid; }
+    uint32_t id() const { return id_; }
+
+    /// 綴り（表の文字列は解放されないため、参照はプロセス終了まで有効）
+    std::string_view str() const {
+        if (!valid())
+            return {};
+        const auto& shard = table().shards[id_ & kShardMask];
+        uint32_t index = id_ >> kShardBits;
+        const std::string* chunk =
+            shard.chunks[index / kChunkSize].load(std::memory_order_acquire);
+        return chunk[index % kChunkSize];
+    }
+
+    bool operator==(Ident other) const { return id_ == other.id_; }
+    bool operator!=(Ident other) const { return id_ != other.id_; }
+
+   private:
+    static constexpr uint32_t kInvalid = UINT32_MAX;
+
+    // ID = 分割内の番号 << kShardBits | 分割番号
+    static constexpr uint32_t kShardBits = 4;
+    static constexpr size_t kShardMask = (size_t{1} << kShardBits) - 1;
+    // 綴りは固定長のチャンクに置くので、登録中も既存の綴りは移動しない
+    static constexpr uint32_t kChunkSize = 1024;
+    static constexpr uint32_t kMaxChunks = 1024;
+
+    explicit Ident(uint32_t id) : id_(id) {}
+
+    // 綴りと計算済みのハッシュ（検索時に文字列を1回だけハッシュする）
+    struct Key {
+        std::string_view text;
+        size_t hash;
+        bool operator==(const Key& other) const { return text == other.text; }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const { return key.hash; }
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<Key, uint32_t, KeyHash> ids;
+        std::array<std::atomic<std::string*>, kMaxChunks> chunks{};
+        uint32_t count = 0;
+
+        // ロック中に呼ぶ。チャンクは公開後に書き換えないのでstrはロック不要
+        uint32_t add(const Key& key, uint32_t shard_index) {
+            uint32_t index = count++;
+            uint32_t chunk_index = index / kChunkSize;
+            if (chunk_index >= kMaxChunks)
+                throw std::length_error("too many identifiers");
+            std::string* chunk = chunks[chunk_index].load(std::memory_order_relaxed);
+            if (!chunk) {
+                chunk = new std::string[kChunkSize];
+                chunks[chunk_index].store(chunk, std::memory_order_release);
+            }
+            const std::string& stored = chunk[index % kChunkSize] = std::string(key.text);
+            uint32_t id = (index << kShardBits) | shard_index;
+            ids.emplace(Key{stored, key.hash}, id);
+            return id;
+        }
+    };
+
+    struct Table {
+        std::array<Shard, size_t{1} << kShardBits> shards;
+    };
+
+    // 表はプロセス終了まで解放しない（綴りへの参照を返すため）
+    static Table& table() {
+        static Table* t = new Table();
+        return *t;
+    }
+
+    uint32_t id_ = kInvalid;
+};
+
+}  // namespace cm
+
+template <>
+struct std::hash<cm::Ident> {
+    size_t operator()(cm::Ident ident) const noexcept { return std::hash<uint32_t>{}(ident.id()); }
+};
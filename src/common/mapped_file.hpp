@@ -0,0 +1,86 @@
+#pragma once
+
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cm {
+
+/// 読み取り専用でメモリマップしたソースファイル
+/// view()はこのオブジェクトが生きている間だけ有効。字句解析器はこの領域を直接走査する。
+/// mmapできない環境・ファイル（空ファイル、特殊ファイル）は通常の読み込みで代替する。
+class MappedFile {
+   public:
+    explicit MappedFile(const std::string& path) {
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return;
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE,
+                             fd, 0);
+            if (p != MAP_FAILED) {
+                // 先頭から末尾へ1回だけ走査するので先読みを促す
+                ::madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+                data_ = static_cast<const char*>(p);
+                size_ = static_cast<size_t>(st.st_size);
+                ::close(fd);
+                ok_ = true;
+                return;
+            }
+        }
+        ::close(fd);
+#endif
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return;
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        fallback_ = buffer.str();
+        ok_ = true;
+    }
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (data_)
+            ::munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool ok() const { return ok_; }
+    explicit operator bool() const { return ok_; }
+
+    std::string_view view() const {
+        return data_ ? std::string_view(data_, size_) : std::string_view(fallback_);
+    }
+
+   private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    std::string fallback_;  // mmapできなかった場合の内容
+    bool ok_ = false;
+};
+
+/// ファイル全体を文字列として読み込む（失敗時はnullopt）
+/// ストリーム経由の二重コピーを避け、マップした領域から1回だけコピーする。
+inline std::optional<std::string> read_file_contents(const std::string& path) {
+    MappedFile file(path);
+    if (!file)
+        return std::nullopt;
+    return std::string(file.view());
+}
+
+}  // namespace cm
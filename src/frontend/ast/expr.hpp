@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../common/ident.hpp"
 #include "nodes.hpp"
 
 #include <unordered_map>
@@ -19,6 +20,8 @@ using LiteralValue = std::variant<std::monostate,  // null
                                   >;
 
 struct LiteralExpr {
+    CM_ARENA_NODE(AstArenaTag)
+
     LiteralValue value;
     bool is_unsigned_literal = false;  // hex/binary/octalリテラルで32bit超の場合true
 
@@ -44,9 +47,21 @@ struct LiteralExpr {
 // 識別子
 // ============================================================
 struct IdentExpr {
+    CM_ARENA_NODE(AstArenaTag)
+
     std::string name;
+    Ident ident;  // nameのインターンID（構築時に1回だけ解決し、スコープ検索に使う）
 
-    explicit IdentExpr(std::string n) : name(std::move(n)) {}
+    explicit IdentExpr(std::string n) : name(std::move(n)), ident(Ident::intern(name)) {}
+    // 字句解析で登録済みのIDをそのまま使う（無効なIDなら登録する）
+    IdentExpr(std::string n, Ident id)
+        : name(std::move(n)), ident(id.valid() ? id : Ident::intern(name)) {}
+
+    // 名前を変える場合はIDも付け替える
+    void rename(std::string n) {
+        name = std::move(n);
+        ident = Ident::intern(name);
+    }
 };
 
 // ============================================================
@@ -154,6 +169,8 @@ inline const char* binary_op_str(BinaryOp op) {
 }
 
 struct BinaryExpr {
+    CM_ARENA_NODE(AstArenaTag)
+
     BinaryOp op;
     ExprPtr left;
     ExprPtr right;
@@ -201,6 +218,8 @@ inline const char* unary_op_str(UnaryOp op) {
 }
 
 struct UnaryExpr {
+    CM_ARENA_NODE(AstArenaTag)
+
     UnaryOp op;
     ExprPtr operand;
 
@@ -211,6 +230,8 @@ struct UnaryExpr {
 // 関数呼び出し
 // ============================================================
 struct CallExpr {
+    CM_ARENA_NODE(AstArenaTag)
+
     ExprPtr callee;
     std::vector<ExprPtr> args;
 
@@ -227,6 +248,8 @@ struct CallExpr {
 // 配列アクセス
 // ============================================================
 struct IndexExpr {
+    CM_ARENA_NODE(AstArenaTag)
+
     ExprPtr object;
     ExprPtr index;
 
@@ -237,6 +260,8 @@ struct IndexExpr {
 // スライス式（Python風: arr[start:end:step]）
 // ============================================================
 struct SliceExpr {
+    CM_ARENA_NODE(AstArenaTag)
+
     ExprPtr object;
     ExprPtr start;  // nullなら最初から
     ExprPtr end;    // nullなら最後まで
@@ -250,6 +275,8 @@ struct SliceExpr {
 // メンバアクセス
 // ============================================================
 struct MemberExpr {
+    CM_ARENA_NODE(AstArenaTag)
+
     ExprPtr object;
     std::string member;
     bool is_method_call = false;
@@ -262,6 +289,8 @@ struct MemberExpr {
 // 三項演算子
 // ============================================================
 struct TernaryExpr {
+    CM_ARENA_NODE(AstArenaTag)
+
     ExprPtr condition;
     ExprPtr then_expr;
     ExprPtr else_expr;
@@ -274,6 +303,8 @@ struct TernaryExpr {
 // new式
 // ============================================================
 struct NewExpr {
+    CM_ARENA_NODE(AstArenaTag)
+
     TypePtr type;
     std::vector<ExprPtr> args;
 
@@ -284,6 +315,8 @@ struct NewExpr {
 // sizeof式 - コンパイル時に型/式のサイズを取得
 // ============================================================
 struct SizeofExpr {
+    CM_ARENA_NODE(AstArenaTag)
+
     TypePtr target_type;  // sizeof(型) の場合
     ExprPtr target_expr;  // sizeof(式) の場合
 
@@ -295,6 +328,8 @@ struct SizeofExpr {
 // typeof式 - 式の型を取得（型コンテキストで使用）
 // ============================================================
 struct TypeofExpr {
+    CM_ARENA_NODE(AstArenaTag)
+
     ExprPtr target_expr;
 
     explicit TypeofExpr(ExprPtr e) : target_expr(std::move(e)) {}
@@ -304,6 +339,8 @@ struct TypeofExpr {
 // alignof式 - 型のアラインメントを取得
 // ============================================================
 struct AlignofExpr {
+    CM_ARENA_NODE(AstArenaTag)
+
     TypePtr target_type;
 
     explicit AlignofExpr(TypePtr t) : target_type(std::move(t)) {}
@@ -314,6 +351,8 @@ struct AlignofExpr {
 // __typename__(型) または __typename__(式) の両方に対応
 // ============================================================
 struct TypenameOfExpr {
+    CM_ARENA_NODE(AstArenaTag)
+
     TypePtr target_type;  // 型指定の場合
     ExprPtr target_expr;  // 式指定の場合
 
@@ -333,6 +372,8 @@ struct StructLiteralField {
 };
 
 struct StructLiteralExpr {
+    CM_ARENA_NODE(AstArenaTag)
+
     std::string type_name;
     std::vector<StructLiteralField> fields;
 
@@ -344,6 +385,8 @@ struct StructLiteralExpr {
 // 配列リテラル [val1, val2, val3]
 // ============================================================
 struct ArrayLiteralExpr {
+    CM_ARENA_NODE(AstArenaTag)
+
     std::vector<ExprPtr> elements;
 
     ArrayLiteralExpr(std::vector<ExprPtr> elems) : elements(std::move(elems)) {}
@@ -360,6 +403,8 @@ struct Param {
 };
 
 struct LambdaExpr {
+    CM_ARENA_NODE(AstArenaTag)
+
     std::vector<Param> params;
     TypePtr return_type;  // nullならauto
     std::variant<ExprPtr, std::vector<StmtPtr>> body;
@@ -489,6 +534,8 @@ struct MatchArm {
 // 各armはブロック本体を持ち、returnは関数スコープから戻る
 // ============================================================
 struct MatchExpr {
+    CM_ARENA_NODE(AstArenaTag)
+
     ExprPtr scrutinee;           // マッチ対象の式
     std::vector<MatchArm> arms;  // マッチアームのリスト
 
@@ -499,6 +546,8 @@ struct MatchExpr {
 // キャスト式 - expr as Type
 // ============================================================
 struct CastExpr {
+    CM_ARENA_NODE(AstArenaTag)
+
     ExprPtr operand;      // キャスト対象の式
     TypePtr target_type;  // キャスト先の型
 
@@ -509,6 +558,8 @@ struct CastExpr {
 // move式 - 所有権の移動を明示 (move expr)
 // ============================================================
 struct MoveExpr {
+    CM_ARENA_NODE(AstArenaTag)
+
     ExprPtr operand;  // 移動対象の式
 
     explicit MoveExpr(ExprPtr e) : operand(std::move(e)) {}
@@ -518,6 +569,8 @@ struct MoveExpr {
 // await式 - Future<T>を待機してTを返す
 // ============================================================
 struct AwaitExpr {
+    CM_ARENA_NODE(AstArenaTag)
+
     ExprPtr operand;  // 待機対象のFuture<T>式
 
     explicit AwaitExpr(ExprPtr e) : operand(std::move(e)) {}
@@ -555,6 +608,10 @@ inline ExprPtr make_ident(std::string name, Span s = {}) {
     return std::make_unique<Expr>(std::make_unique<IdentExpr>(std::move(name)), s);
 }
 
+inline ExprPtr make_ident(std::string name, Ident id, Span s) {
+    return std::make_unique<Expr>(std::make_unique<IdentExpr>(std::move(name), id), s);
+}
+
 inline ExprPtr make_binary(BinaryOp op, ExprPtr left, ExprPtr right, Span s = {}) {
     return std::make_unique<Expr>(
         std::make_unique<BinaryExpr>(op, std::move(left), std::move(right)), s);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../common/arena.hpp"
 #include "../../common/span.hpp"
 #include "types.hpp"
 
@@ -20,6 +21,10 @@ using ExprPtr = std::unique_ptr<Expr>;
 using StmtPtr = std::unique_ptr<Stmt>;
 using DeclPtr = std::unique_ptr<Decl>;
 
+// 式・文ノードの割り当て先（HIRへの変換後にまとめて返却する）
+struct AstArenaTag;
+using AstArena = NodeArena<AstArenaTag>;
+
 // ============================================================
 // ASTノード基底
 // ============================================================
@@ -71,6 +76,8 @@ using ExprKind =
                  std::unique_ptr<MoveExpr>, std::unique_ptr<AwaitExpr>>;
 
 struct Expr : Node {
+    CM_ARENA_NODE(AstArenaTag)
+
     ExprKind kind;
     TypePtr type;  // 推論された型（型チェック後に設定）
 
@@ -121,6 +128,8 @@ using StmtKind =
                  std::unique_ptr<MustBlockStmt>>;
 
 struct Stmt : Node {
+    CM_ARENA_NODE(AstArenaTag)
+
     StmtKind kind;
 
     template <typename T>
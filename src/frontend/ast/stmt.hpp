@@ -9,6 +9,8 @@ namespace cm::ast {
 // 変数宣言
 // ============================================================
 struct LetStmt {
+    CM_ARENA_NODE(AstArenaTag)
+
     std::string name;
     Span name_span;  // 名前の位置（Lintエラー表示用）
     TypePtr type;    // nullならauto推論
@@ -28,6 +30,8 @@ struct LetStmt {
 // 式文
 // ============================================================
 struct ExprStmt {
+    CM_ARENA_NODE(AstArenaTag)
+
     ExprPtr expr;
 
     explicit ExprStmt(ExprPtr e) : expr(std::move(e)) {}
@@ -37,6 +41,8 @@ struct ExprStmt {
 // return文
 // ============================================================
 struct ReturnStmt {
+    CM_ARENA_NODE(AstArenaTag)
+
     ExprPtr value;  // nullならreturn;
 
     ReturnStmt() = default;
@@ -47,6 +53,8 @@ struct ReturnStmt {
 // if文
 // ============================================================
 struct IfStmt {
+    CM_ARENA_NODE(AstArenaTag)
+
     ExprPtr condition;
     std::vector<StmtPtr> then_block;
     std::vector<StmtPtr> else_block;  // else ifの場合は単一のIfStmt
@@ -59,6 +67,8 @@ struct IfStmt {
 // for文
 // ============================================================
 struct ForStmt {
+    CM_ARENA_NODE(AstArenaTag)
+
     StmtPtr init;       // nullまたはLetStmt/ExprStmt
     ExprPtr condition;  // nullなら無限ループ
     ExprPtr update;     // nullなら更新なし
@@ -73,6 +83,8 @@ struct ForStmt {
 // for (T item in collection) { ... }
 // ============================================================
 struct ForInStmt {
+    CM_ARENA_NODE(AstArenaTag)
+
     std::string var_name;       // ループ変数名
     TypePtr var_type;           // ループ変数の型（nullならauto推論）
     ExprPtr iterable;           // イテレート対象（配列など）
@@ -93,6 +105,8 @@ struct ForInStmt {
 // while文
 // ============================================================
 struct WhileStmt {
+    CM_ARENA_NODE(AstArenaTag)
+
     ExprPtr condition;
     std::vector<StmtPtr> body;
 
@@ -103,6 +117,8 @@ struct WhileStmt {
 // ブロック文
 // ============================================================
 struct BlockStmt {
+    CM_ARENA_NODE(AstArenaTag)
+
     std::vector<StmtPtr> stmts;
 
     BlockStmt() = default;
@@ -164,6 +180,8 @@ struct SwitchCase {
 };
 
 struct SwitchStmt {
+    CM_ARENA_NODE(AstArenaTag)
+
     ExprPtr expr;
     std::vector<SwitchCase> cases;
 
@@ -173,13 +191,19 @@ struct SwitchStmt {
 // ============================================================
 // break / continue
 // ============================================================
-struct BreakStmt {};
-struct ContinueStmt {};
+struct BreakStmt {
+    CM_ARENA_NODE(AstArenaTag)
+};
+struct ContinueStmt {
+    CM_ARENA_NODE(AstArenaTag)
+};
 
 // ============================================================
 // defer文
 // ============================================================
 struct DeferStmt {
+    CM_ARENA_NODE(AstArenaTag)
+
     StmtPtr body;  // 遅延実行する文
 
     DeferStmt() = default;
@@ -191,6 +215,8 @@ struct DeferStmt {
 // ブロック内のコードはデッドコード削除・並び替え禁止
 // ============================================================
 struct MustBlockStmt {
+    CM_ARENA_NODE(AstArenaTag)
+
     std::vector<StmtPtr> body;
 
     MustBlockStmt() = default;
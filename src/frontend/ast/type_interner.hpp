@@ -0,0 +1,394 @@
+#pragma once
+
+#include "typedef.hpp"
+#include "types.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace cm::ast {
+
+// ============================================================
+// 型の構造的な等価判定
+// type_to_string同士の比較と違い、文字列を作らずに型の木を辿る。
+// 修飾子・配列の次元・ユニオンのバリアントまで一致する場合のみ等しい
+// （TypeInternerのIDと同じ基準）
+// ============================================================
+inline bool types_equal(const TypePtr& a, const TypePtr& b);
+
+inline bool union_payloads_equal(const Type& a, const Type& b) {
+    if (a.kind == TypeKind::Union) {
+        const auto& va = static_cast<const UnionType&>(a).variants;
+        const auto& vb = static_cast<const UnionType&>(b).variants;
+        if (va.size() != vb.size())
+            return false;
+        for (size_t i = 0; i < va.size(); ++i) {
+            if (va[i].tag != vb[i].tag || va[i].field_names != vb[i].field_names ||
+                va[i].fields.size() != vb[i].fields.size())
+                return false;
+            for (size_t f = 0; f < va[i].fields.size(); ++f) {
+                if (!types_equal(va[i].fields[f], vb[i].fields[f]))
+                    return false;
+            }
+        }
+        return true;
+    }
+    if (a.kind == TypeKind::LiteralUnion) {
+        const auto& la = static_cast<const LiteralUnionType&>(a).literals;
+        const auto& lb = static_cast<const LiteralUnionType&>(b).literals;
+        if (la.size() != lb.size())
+            return false;
+        for (size_t i = 0; i < la.size(); ++i) {
+            if (la[i].value != lb[i].value)
+                return false;
+        }
+    }
+    return true;
+}
+
+inline bool types_equal(const Type& a, const Type& b) {
+    if (&a == &b)
+        return true;
+    if (a.kind != b.kind || a.qualifiers.is_const != b.qualifiers.is_const ||
+        a.qualifiers.is_volatile != b.qualifiers.is_volatile ||
+        a.qualifiers.is_mutable != b.qualifiers.is_mutable)
+        return false;
+    if (a.array_size != b.array_size || a.name != b.name ||
+        a.size_param_name != b.size_param_name || a.dimensions != b.dimensions)
+        return false;
+    if (!types_equal(a.element_type, b.element_type) || !types_equal(a.return_type, b.return_type))
+        return false;
+    if (a.type_args.size() != b.type_args.size() || a.param_types.size() != b.param_types.size())
+        return false;
+    for (size_t i = 0; i < a.type_args.size(); ++i) {
+        if (!types_equal(a.type_args[i], b.type_args[i]))
+            return false;
+    }
+    for (size_t i = 0; i < a.param_types.size(); ++i) {
+        if (!types_equal(a.param_types[i], b.param_types[i]))
+            return false;
+    }
+    return union_payloads_equal(a, b);
+}
+
+inline bool types_equal(const TypePtr& a, const TypePtr& b) {
+    if (a == b)
+        return true;
+    if (!a || !b)
+        return false;
+    return types_equal(*a, *b);
+}
+
+// ============================================================
+// 型インターナー（ハッシュコンシング）
+// 構造的に等しい型を1つの正規インスタンスとIDにまとめる。
+// 正規インスタンスの子（要素型・型引数・ユニオンのフィールド型など）も正規インスタンスなので、
+// 照合は子のIDの比較で済み、型全体を文字列化する必要がない。
+// 正規インスタンスは共有されるため変更してはならない（変更する場合は複製する）。
+// 正規インスタンスにはIDのタグが付くので、正規インスタンスの問い合わせはロックを取らない。
+// 型文字列・サイズ情報は型ごとに1回だけ計算してキャッシュする。
+// ============================================================
+using TypeId = uint32_t;
+
+class TypeInterner {
+   public:
+    static constexpr TypeId kNoType = std::numeric_limits<TypeId>::max();
+
+    // コンパイル1回分のインターナー（定義はクラスの後）
+    class Scope;
+
+    // 現在のインターナー（Scope外ではプロセス全体で共有するもの）
+    // 最適化の並列ワーカーからも使うため、登録はロックで保護する
+    static TypeInterner& instance() {
+        if (auto* scoped = current().load(std::memory_order_acquire))
+            return *scoped;
+        static TypeInterner shared;
+        return shared;
+    }
+
+    // 型のID（構造的に等しい型は同じID、nullptrはkNoType）
+    TypeId intern(const TypePtr& type) {
+        if (!type)
+            return kNoType;
+        TypeId id = tagged_id(*type);
+        if (id != kNoType)
+            return id;
+        std::lock_guard<std::mutex> lock(mutex_);
+        return intern_locked(type);
+    }
+
+    // 正規インスタンス（nullptrはそのまま返す）
+    TypePtr canonical(const TypePtr& type) {
+        if (!type || is_canonical(*type))
+            return type;
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_[intern_locked(type)].type;
+    }
+
+    bool is_canonical(const Type& type) const { return tagged_id(type) != kNoType; }
+
+    // type_to_stringの結果（参照はインターナーの破棄まで有効）
+    const std::string& name(const TypePtr& type) {
+        static const std::string empty;
+        if (!type)
+            return empty;
+        TypeId id = intern(type);
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& entry = entries_[id];
+        if (!entry.has_name) {
+            entry.name = type_to_string(*entry.type);
+            entry.has_name = true;
+        }
+        return entry.name;
+    }
+
+    TypeInfo info(const TypePtr& type) {
+        if (!type)
+            return {0, 1};
+        TypeId id = intern(type);
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_[id].info;
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+   private:
+    struct Entry {
+        TypePtr type;  // 正規インスタンス
+        std::string name;
+        bool has_name = false;
+        TypeInfo info;
+    };
+
+    TypeInterner() = default;
+
+    static std::atomic<TypeInterner*>& current() {
+        static std::atomic<TypeInterner*> scoped{nullptr};
+        return scoped;
+    }
+
+    // インターナーごとの世代（別のScopeで付いたタグを無視するため）
+    static uint64_t next_epoch() {
+        static std::atomic<uint32_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    static void combine(size_t& seed, size_t value) {
+        seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+    }
+
+    TypeId tagged_id(const Type& type) const {
+        uint64_t tag = type.intern_tag.value.load(std::memory_order_acquire);
+        return (tag >> 32) == epoch_ ? static_cast<TypeId>(tag) : kNoType;
+    }
+
+    const Type* child(TypeId id) const {
+        return id == kNoType ? nullptr : entries_[id].type.get();
+    }
+
+    TypePtr child_ptr(TypeId id) const { return id == kNoType ? nullptr : entries_[id].type; }
+
+    TypeId add_entry(TypePtr type) {
+        auto id = static_cast<TypeId>(entries_.size());
+        Entry entry;
+        entry.info = type->info();
+        type->intern_tag.value.store((epoch_ << 32) | id, std::memory_order_release);
+        entry.type = std::move(type);
+        entries_.push_back(std::move(entry));
+        return id;
+    }
+
+    // ユニオンのバリアントのフィールド型（全バリアント分を順に並べる）
+    static void for_each_variant_field(const Type& type,
+                                       const std::function<void(const TypePtr&)>& fn) {
+        if (type.kind != TypeKind::Union)
+            return;
+        for (const auto& variant : static_cast<const UnionType&>(type).variants) {
+            for (const auto& field : variant.fields)
+                fn(field);
+        }
+    }
+
+    TypeId intern_locked(const TypePtr& ptr) {
+        if (!ptr)
+            return kNoType;
+        const Type& type = *ptr;
+        TypeId tagged = tagged_id(type);
+        if (tagged != kNoType)
+            return tagged;
+
+        // 子を先に正規化する
+        TypeId element = intern_locked(type.element_type);
+        TypeId ret = intern_locked(type.return_type);
+        std::vector<TypeId> args;
+        args.reserve(type.type_args.size() + type.param_types.size());
+        for (const auto& arg : type.type_args)
+            args.push_back(intern_locked(arg));
+        for (const auto& param : type.param_types)
+            args.push_back(intern_locked(param));
+        std::vector<TypeId> fields;
+        for_each_variant_field(type,
+                               [&](const TypePtr& field) { fields.push_back(intern_locked(field)); });
+
+        size_t hash = static_cast<size_t>(type.kind);
+        combine(hash, (type.qualifiers.is_const ? 1u : 0u) |
+                          (type.qualifiers.is_volatile ? 2u : 0u) |
+                          (type.qualifiers.is_mutable ? 4u : 0u));
+        combine(hash, std::hash<std::string>{}(type.name));
+        combine(hash, type.array_size ? *type.array_size + 1ull : 0ull);
+        combine(hash, std::hash<std::string>{}(type.size_param_name));
+        for (auto dim : type.dimensions)
+            combine(hash, dim);
+        combine(hash, element);
+        combine(hash, ret);
+        combine(hash, type.type_args.size());
+        for (auto id : args)
+            combine(hash, id);
+        combine_union_payload(hash, type, fields);
+
+        auto [begin, end] = by_hash_.equal_range(hash);
+        for (auto it = begin; it != end; ++it) {
+            if (matches(*entries_[it->second].type, type, element, ret, args, fields))
+                return it->second;
+        }
+
+        // ユニオン型は派生クラスの情報ごと複製する（フィールド型は正規インスタンスに置き換え）
+        TypePtr canon;
+        if (type.kind == TypeKind::Union) {
+            auto canon_union = std::make_shared<UnionType>();
+            size_t next_field = 0;
+            for (const auto& variant : static_cast<const UnionType&>(type).variants) {
+                UnionVariant copy(variant.tag);
+                copy.field_names = variant.field_names;
+                for (size_t f = 0; f < variant.fields.size(); ++f)
+                    copy.fields.push_back(child_ptr(fields[next_field++]));
+                canon_union->variants.push_back(std::move(copy));
+            }
+            canon = std::move(canon_union);
+        } else if (type.kind == TypeKind::LiteralUnion) {
+            auto canon_literals = std::make_shared<LiteralUnionType>();
+            canon_literals->literals = static_cast<const LiteralUnionType&>(type).literals;
+            canon = std::move(canon_literals);
+        } else {
+            canon = std::make_shared<Type>(type.kind);
+        }
+        canon->qualifiers = type.qualifiers;
+        canon->name = type.name;
+        canon->array_size = type.array_size;
+        canon->size_param_name = type.size_param_name;
+        canon->dimensions = type.dimensions;
+        canon->element_type = child_ptr(element);
+        canon->return_type = child_ptr(ret);
+        size_t arg_count = type.type_args.size();
+        for (size_t i = 0; i < args.size(); ++i) {
+            auto& dest = i < arg_count ? canon->type_args : canon->param_types;
+            dest.push_back(child_ptr(args[i]));
+        }
+
+        TypeId id = add_entry(std::move(canon));
+        by_hash_.emplace(hash, id);
+        return id;
+    }
+
+    // ユニオンのタグ・フィールド名・フィールド型、リテラルユニオンの値をハッシュに加える
+    static void combine_union_payload(size_t& hash, const Type& type,
+                                      const std::vector<TypeId>& fields) {
+        if (type.kind == TypeKind::Union) {
+            const auto& variants = static_cast<const UnionType&>(type).variants;
+            combine(hash, variants.size());
+            for (const auto& variant : variants) {
+                combine(hash, std::hash<std::string>{}(variant.tag));
+                combine(hash, variant.fields.size());
+                for (const auto& field_name : variant.field_names)
+                    combine(hash, std::hash<std::string>{}(field_name));
+            }
+            for (auto id : fields)
+                combine(hash, id);
+        } else if (type.kind == TypeKind::LiteralUnion) {
+            for (const auto& literal : static_cast<const LiteralUnionType&>(type).literals) {
+                combine(hash, literal.value.index());
+                std::visit(
+                    [&](const auto& value) {
+                        combine(hash, std::hash<std::decay_t<decltype(value)>>{}(value));
+                    },
+                    literal.value);
+            }
+        }
+    }
+
+    bool matches(const Type& canon, const Type& type, TypeId element, TypeId ret,
+                 const std::vector<TypeId>& args, const std::vector<TypeId>& fields) const {
+        if (canon.kind != type.kind || canon.qualifiers.is_const != type.qualifiers.is_const ||
+            canon.qualifiers.is_volatile != type.qualifiers.is_volatile ||
+            canon.qualifiers.is_mutable != type.qualifiers.is_mutable ||
+            canon.array_size != type.array_size || canon.name != type.name ||
+            canon.size_param_name != type.size_param_name || canon.dimensions != type.dimensions)
+            return false;
+        if (canon.element_type.get() != child(element) || canon.return_type.get() != child(ret))
+            return false;
+        if (canon.type_args.size() != type.type_args.size() ||
+            canon.param_types.size() != type.param_types.size())
+            return false;
+        size_t arg_count = canon.type_args.size();
+        for (size_t i = 0; i < args.size(); ++i) {
+            const auto& canon_child = i < arg_count ? canon.type_args[i]
+                                                    : canon.param_types[i - arg_count];
+            if (canon_child.get() != child(args[i]))
+                return false;
+        }
+        if (type.kind == TypeKind::Union) {
+            const auto& cv = static_cast<const UnionType&>(canon).variants;
+            const auto& tv = static_cast<const UnionType&>(type).variants;
+            if (cv.size() != tv.size())
+                return false;
+            size_t next_field = 0;
+            for (size_t i = 0; i < cv.size(); ++i) {
+                if (cv[i].tag != tv[i].tag || cv[i].field_names != tv[i].field_names ||
+                    cv[i].fields.size() != tv[i].fields.size())
+                    return false;
+                for (const auto& field : cv[i].fields) {
+                    if (field.get() != child(fields[next_field++]))
+                        return false;
+                }
+            }
+        } else if (type.kind == TypeKind::LiteralUnion) {
+            return union_payloads_equal(canon, type);
+        }
+        return true;
+    }
+
+    const uint64_t epoch_ = next_epoch();
+    // エントリはdequeに積むだけなので、正規インスタンス・名前への参照は移動しない
+    std::deque<Entry> entries_;
+    std::unordered_multimap<size_t, TypeId> by_hash_;
+    mutable std::mutex mutex_;
+};
+
+// 有効な間はTypeInterner::instance()がこのインターナーを返す
+// 破棄するとエントリがまとめて解放される。MIRなど型を使う側より先に作ること
+class TypeInterner::Scope {
+   public:
+    Scope() : previous_(current().exchange(&interner_, std::memory_order_acq_rel)) {}
+    ~Scope() { current().store(previous_, std::memory_order_release); }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    TypeInterner& interner() { return interner_; }
+
+   private:
+    TypeInterner interner_;
+    TypeInterner* previous_;
+};
+
+}  // namespace cm::ast
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -106,6 +107,18 @@ struct TypeQualifiers {
     bool is_mutable : 1 = false;
 };
 
+// ============================================================
+// 型インターナーのタグ（正規インスタンスのみ設定: インターナーの世代 << 32 | ID）
+// 複製した型は正規インスタンスではないので、コピー・代入ではタグを引き継がない
+// ============================================================
+struct TypeInternTag {
+    std::atomic<uint64_t> value{0};
+
+    TypeInternTag() = default;
+    TypeInternTag(const TypeInternTag&) {}
+    TypeInternTag& operator=(const TypeInternTag&) { return *this; }
+};
+
 // ============================================================
 // 型表現（前方宣言）
 // ============================================================
@@ -140,6 +153,9 @@ struct Type {
     std::vector<TypePtr> param_types;
     TypePtr return_type;
 
+    // 型インターナーが設定する（TypeInterner以外は触らない）
+    TypeInternTag intern_tag;
+
     // コンストラクタ
     explicit Type(TypeKind k) : kind(k) {}
 
@@ -3,6 +3,8 @@
 
 #include "../../common/debug/lex.hpp"
 
+#include <cstring>
+
 namespace cm {
 
 // トークン化（メインループ）
@@ -12,36 +14,36 @@ std::vector<Token> Lexer::tokenize() {
                     debug::Level::Debug);
 
     std::vector<Token> tokens;
-    while (!is_at_end()) {
-        Token tok = next_token();
-
-        // デバッグモード時のみ高コストなログ出力を実行
-        // （get_line_number/get_column_number は O(n) 線形スキャンのため、
-        //   非デバッグ時は引数評価自体をスキップする）
-        if (::cm::debug::g_debug_mode && ::cm::debug::Level::Trace >= ::cm::debug::g_debug_level) {
-            debug::lex::dump_position(get_line_number(pos_), get_column_number(pos_),
-                                      "Scanning at pos " + std::to_string(pos_));
-            std::string tok_value = "";
-            if (tok.kind == TokenKind::Ident) {
-                tok_value = std::string(tok.get_string());
-            }
-            debug::lex::dump_token(token_kind_to_string(tok.kind), tok_value,
-                                   get_line_number(tok.start), get_column_number(tok.start));
-        }
-
-        tokens.push_back(tok);
-        if (tok.kind == TokenKind::Eof)
+    while (true) {
+        tokens.push_back(next());
+        if (tokens.back().kind == TokenKind::Eof)
             break;
     }
 
-    if (tokens.empty() || tokens.back().kind != TokenKind::Eof) {
-        tokens.push_back(make_token(TokenKind::Eof));
-    }
-
     debug::lex::log(debug::lex::Id::End, std::to_string(tokens.size()) + " tokens");
     return tokens;
 }
 
+// 次のトークンを1つ取り出す
+Token Lexer::next() {
+    Token tok = next_token();
+
+    // デバッグモード時のみ高コストなログ出力を実行
+    // （get_line_number/get_column_number は O(n) 線形スキャンのため、
+    //   非デバッグ時は引数評価自体をスキップする）
+    if (::cm::debug::g_debug_mode && ::cm::debug::Level::Trace >= ::cm::debug::g_debug_level) {
+        debug::lex::dump_position(get_line_number(pos_), get_column_number(pos_),
+                                  "Scanning at pos " + std::to_string(pos_));
+        std::string tok_value = "";
+        if (tok.kind == TokenKind::Ident) {
+            tok_value = std::string(tok.get_string());
+        }
+        debug::lex::dump_token(token_kind_to_string(tok.kind), tok_value,
+                               get_line_number(tok.start), get_column_number(tok.start));
+    }
+    return tok;
+}
+
 // 次のトークンを取得
 Token Lexer::next_token() {
     skip_whitespace_and_comments();
@@ -148,24 +150,32 @@ void Lexer::init_keywords() {
 }
 
 // 空白とコメントをスキップ
+// コメント本文は終端文字をmemchrで探す（libcのベクトル化された実装で数バイトずつ進まない）
 void Lexer::skip_whitespace_and_comments() {
-    while (!is_at_end()) {
-        char c = peek();
-        if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
-            advance();
+    const char* data = source_.data();
+    const uint32_t size = static_cast<uint32_t>(source_.size());
+    while (pos_ < size) {
+        char c = data[pos_];
+        if (is_space(c)) {
+            ++pos_;
+            while (pos_ < size && is_space(data[pos_]))
+                ++pos_;
         } else if (c == '/' && peek_next() == '/') {
-            while (!is_at_end() && peek() != '\n')
-                advance();
+            const void* nl = std::memchr(data + pos_ + 2, '\n', size - pos_ - 2);
+            pos_ = nl ? static_cast<uint32_t>(static_cast<const char*>(nl) - data) : size;
         } else if (c == '/' && peek_next() == '*') {
-            advance();
-            advance();
-            while (!is_at_end()) {
-                if (peek() == '*' && peek_next() == '/') {
-                    advance();
-                    advance();
+            pos_ += 2;
+            while (true) {
+                const void* star = std::memchr(data + pos_, '*', size - pos_);
+                if (!star) {
+                    pos_ = size;  // 閉じていないコメントは末尾まで
+                    break;
+                }
+                pos_ = static_cast<uint32_t>(static_cast<const char*>(star) - data) + 1;
+                if (pos_ < size && data[pos_] == '/') {
+                    ++pos_;
                     break;
                 }
-                advance();
             }
         } else {
             break;
@@ -182,26 +192,31 @@ Token Lexer::scan_identifier(uint32_t start) {
         advance();
     }
 
-    std::string text(source_.substr(start, pos_ - start));
+    std::string_view text = source_.substr(start, pos_ - start);
     if (::cm::debug::g_debug_mode)
-        debug::lex::log(debug::lex::Id::TokenText, text, debug::Level::Trace);
+        debug::lex::log(debug::lex::Id::TokenText, std::string(text), debug::Level::Trace);
 
+    // キーワードは文字列を確保せずに判定する
     auto it = keywords_.find(text);
     if (it != keywords_.end()) {
         if (::cm::debug::g_debug_mode) {
-            debug::lex::log(debug::lex::Id::Keyword, text, debug::Level::Debug);
+            debug::lex::log(debug::lex::Id::Keyword, std::string(text), debug::Level::Debug);
             debug::lex::log(debug::lex::Id::KeywordMatch,
-                            text + " -> " + token_kind_to_string(it->second), debug::Level::Trace);
+                            std::string(text) + " -> " + token_kind_to_string(it->second),
+                            debug::Level::Trace);
         }
         return Token(it->second, start, pos_);
     }
 
     if (::cm::debug::g_debug_mode) {
-        debug::lex::log(debug::lex::Id::Ident, text, debug::Level::Debug);
-        debug::lex::log(debug::lex::Id::IdentCreate, "Variable/Function name: " + text,
+        debug::lex::log(debug::lex::Id::Ident, std::string(text), debug::Level::Debug);
+        debug::lex::log(debug::lex::Id::IdentCreate, "Variable/Function name: " + std::string(text),
                         debug::Level::Trace);
     }
-    return Token(TokenKind::Ident, start, pos_, std::move(text));
+    // 識別子は表に登録する（以降のスコープ検索などは同じIDを引く）
+    Token tok(TokenKind::Ident, start, pos_, std::string(text));
+    tok.ident = Ident::intern(text);
+    return tok;
 }
 
 // 数値リテラルスキャン
@@ -2,6 +2,8 @@
 
 #include "token.hpp"
 
+#include <array>
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -9,6 +11,43 @@
 
 namespace cm {
 
+// 文字種の表（1バイトごとの分類をビットで持ち、判定を1回の表引きにする）
+namespace lexer_detail {
+
+enum CharClass : uint8_t {
+    kAlpha = 1 << 0,  // 英字と'_'
+    kDigit = 1 << 1,
+    kHexDigit = 1 << 2,
+    kOctalDigit = 1 << 3,
+    kSpace = 1 << 4,  // 空白・タブ・改行
+};
+
+constexpr std::array<uint8_t, 256> make_char_classes() {
+    std::array<uint8_t, 256> table{};
+    for (int c = 'a'; c <= 'z'; ++c)
+        table[c] |= kAlpha;
+    for (int c = 'A'; c <= 'Z'; ++c)
+        table[c] |= kAlpha;
+    table['_'] |= kAlpha;
+    for (int c = '0'; c <= '9'; ++c)
+        table[c] |= kDigit | kHexDigit;
+    for (int c = '0'; c <= '7'; ++c)
+        table[c] |= kOctalDigit;
+    for (int c = 'a'; c <= 'f'; ++c)
+        table[c] |= kHexDigit;
+    for (int c = 'A'; c <= 'F'; ++c)
+        table[c] |= kHexDigit;
+    table[' '] |= kSpace;
+    table['\t'] |= kSpace;
+    table['\n'] |= kSpace;
+    table['\r'] |= kSpace;
+    return table;
+}
+
+inline constexpr std::array<uint8_t, 256> kCharClasses = make_char_classes();
+
+}  // namespace lexer_detail
+
 class Lexer {
    public:
     Lexer(std::string_view source) : source_(source), pos_(0) { init_keywords(); }
@@ -16,6 +55,9 @@ class Lexer {
     // トークン化（メインエントリ）
     std::vector<Token> tokenize();
 
+    // 次のトークンを1つ取り出す（TokenStreamからの逐次読み出し用、末尾以降はEofを返す）
+    Token next();
+
    private:
     // 次のトークンを取得
     Token next_token();
@@ -62,22 +104,24 @@ class Lexer {
     bool match(char expected);
 
     // 文字判定ヘルパー
-    static bool is_alpha(char c) {
-        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+    static bool has_class(char c, uint8_t cls) {
+        return (lexer_detail::kCharClasses[static_cast<unsigned char>(c)] & cls) != 0;
     }
-    static bool is_digit(char c) { return c >= '0' && c <= '9'; }
-    static bool is_hex_digit(char c) {
-        return is_digit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+    static bool is_alpha(char c) { return has_class(c, lexer_detail::kAlpha); }
+    static bool is_digit(char c) { return has_class(c, lexer_detail::kDigit); }
+    static bool is_hex_digit(char c) { return has_class(c, lexer_detail::kHexDigit); }
+    static bool is_octal_digit(char c) { return has_class(c, lexer_detail::kOctalDigit); }
+    static bool is_alnum(char c) {
+        return has_class(c, lexer_detail::kAlpha | lexer_detail::kDigit);
     }
-    static bool is_octal_digit(char c) { return c >= '0' && c <= '7'; }
-    static bool is_alnum(char c) { return is_alpha(c) || is_digit(c); }
+    static bool is_space(char c) { return has_class(c, lexer_detail::kSpace); }
 
     // raw文字列のインデント正規化
     std::string normalize_raw_indent(std::string value);
 
     std::string_view source_;
     uint32_t pos_;
-    std::unordered_map<std::string, TokenKind> keywords_;
+    std::unordered_map<std::string_view, TokenKind> keywords_;  // キーは文字列リテラル
 };
 
 }  // namespace cm
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../../common/ident.hpp"
+
 #include <cstdint>
 #include <string>
 #include <string_view>
@@ -172,6 +174,7 @@ struct Token {
     uint32_t end;    // 終了位置
     TokenValue value;
     bool is_unsigned = false;  // hex/binary/octalリテラルで32bit超の場合true
+    Ident ident;               // 識別子トークンのインターンID
 
     Token(TokenKind k, uint32_t s, uint32_t e)
         : kind(k), start(s), end(e), value(std::monostate{}) {}
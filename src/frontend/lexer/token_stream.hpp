@@ -0,0 +1,107 @@
+#pragma once
+
+#include "lexer.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <vector>
+
+namespace cm {
+
+/// パーサへ渡すトークン列
+/// 字句解析器から必要になった分だけトークンを取り出し、まだ使う範囲だけを保持する。
+/// 位置はソース全体の通し番号（先頭のトークンが0）なので、パーサは従来どおり添字で先読みできる。
+/// バックトラックで戻る位置はcheckpoint()で固定する。固定位置と直前のトークンより
+/// 前は捨てるため、保持するトークン数はソース全体ではなく先読み・巻き戻しの幅で決まる。
+/// 字句解析済みのトークン列から作ることもできる（単体テストなど）。
+class TokenStream {
+   public:
+    /// 巻き戻し位置（生きている間はその位置以降のトークンを保持する）
+    class Checkpoint {
+       public:
+        Checkpoint(const Checkpoint&) = delete;
+        Checkpoint& operator=(const Checkpoint&) = delete;
+        ~Checkpoint() { stream_->unpin(pinned()); }
+
+        size_t pos() const { return pos_; }
+
+       private:
+        friend class TokenStream;
+        // 巻き戻した直後もprevious()で直前のトークンを参照するため、その1つ前から固定する
+        Checkpoint(TokenStream* stream, size_t pos) : stream_(stream), pos_(pos) {
+            stream_->pins_.push_back(pinned());
+        }
+
+        size_t pinned() const { return pos_ > 0 ? pos_ - 1 : 0; }
+
+        TokenStream* stream_;
+        size_t pos_;
+    };
+
+    /// 字句解析器から逐次読み出す（lexerとそのソースはパース中生きていること）
+    explicit TokenStream(Lexer& lexer) : lexer_(&lexer) {}
+
+    /// 字句解析済みのトークン列を使う
+    explicit TokenStream(std::vector<Token> tokens)
+        : buffer_(std::make_move_iterator(tokens.begin()), std::make_move_iterator(tokens.end())),
+          done_(true) {
+        if (buffer_.empty() || buffer_.back().kind != TokenKind::Eof)
+            buffer_.emplace_back(TokenKind::Eof, 0, 0);
+    }
+
+    /// index番目のトークン（Eofより先はEofを返す）
+    /// 捨て済みの位置はErrorトークンを返す（チェックポイント漏れ。デバッグビルドではassert）
+    const Token& operator[](size_t index) const {
+        assert(index >= base_ && "token already discarded (missing checkpoint?)");
+        if (index < base_)
+            return discarded_;
+        if (!fill(index))
+            return buffer_.back();
+        return buffer_[index - base_];
+    }
+
+    /// index番目のトークンが存在するか（Eof自身も含む）
+    bool has(size_t index) const { return fill(index); }
+
+    /// index番目まで進んだので、それより前のトークンを捨ててよい
+    /// （固定中の巻き戻し位置より前は残す）
+    void discard_before(size_t index) {
+        for (size_t pin : pins_)
+            index = std::min(index, pin);
+        while (base_ < index && buffer_.size() > 1) {
+            buffer_.pop_front();
+            ++base_;
+        }
+    }
+
+    Checkpoint checkpoint(size_t index) { return Checkpoint(this, index); }
+
+   private:
+    // index番目まで読み込む（Eofまでに届かなければfalse）
+    bool fill(size_t index) const {
+        while (base_ + buffer_.size() <= index) {
+            if (done_)
+                return false;
+            buffer_.push_back(lexer_->next());
+            done_ = buffer_.back().kind == TokenKind::Eof;
+        }
+        return true;
+    }
+
+    void unpin(size_t pos) {
+        // チェックポイントはスコープの入れ子で使うので、通常は末尾が一致する
+        auto it = std::find(pins_.rbegin(), pins_.rend(), pos);
+        if (it != pins_.rend())
+            pins_.erase(std::next(it).base());
+    }
+
+    Lexer* lexer_ = nullptr;
+    mutable std::deque<Token> buffer_;
+    mutable size_t base_ = 0;  // buffer_先頭の通し番号
+    mutable bool done_ = false;
+    Token discarded_{TokenKind::Error, 0, 0};  // 捨て済みの位置を参照した時に返す
+    std::vector<size_t> pins_;  // 固定中の巻き戻し位置
+};
+
+}  // namespace cm
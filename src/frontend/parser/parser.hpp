@@ -2,7 +2,7 @@
 
 #include "../../common/diagnostics.hpp"
 #include "../ast/decl.hpp"
-#include "../lexer/token.hpp"
+#include "../lexer/token_stream.hpp"
 
 #include <memory>
 #include <optional>
@@ -23,6 +23,9 @@ class Parser {
    public:
     Parser(std::vector<Token> tokens) : tokens_(std::move(tokens)), pos_(0), last_error_line_(0) {}
 
+    // 字句解析器からトークンを逐次読み出してパースする（lexerはparse()の間生きていること）
+    explicit Parser(Lexer& lexer) : tokens_(lexer), pos_(0), last_error_line_(0) {}
+
     // プログラム全体を解析（parser_decl.cppで実装）
     ast::Program parse();
 
@@ -141,24 +144,25 @@ class Parser {
     bool is_at_end() const { return current().kind == TokenKind::Eof; }
 
     bool check(TokenKind kind) const { return current().kind == kind; }
-    TokenKind peek_kind(size_t offset = 1) const {
-        size_t idx = pos_ + offset;
-        if (idx >= tokens_.size()) {
-            return TokenKind::Eof;
-        }
-        return tokens_[idx].kind;
-    }
+    TokenKind peek_kind(size_t offset = 1) const { return tokens_[pos_ + offset].kind; }
     bool is_attribute_start() const {
         return check(TokenKind::At) ||
                (check(TokenKind::Hash) && peek_kind() == TokenKind::LBracket);
     }
 
     Token advance() {
-        if (!is_at_end())
+        if (!is_at_end()) {
             ++pos_;
+            // 直前のトークンより前はもう参照しない（巻き戻し位置は固定されている）
+            tokens_.discard_before(pos_ - 1);
+        }
         return previous();
     }
 
+    // バックトラック用に現在位置を固定する（戻り値が生きている間は巻き戻せる）
+    TokenStream::Checkpoint checkpoint() { return tokens_.checkpoint(pos_); }
+    void rewind(const TokenStream::Checkpoint& saved) { pos_ = saved.pos(); }
+
     bool consume_if(TokenKind kind) {
         if (check(kind)) {
             advance();
@@ -176,8 +180,8 @@ class Parser {
     // ============================================================
     // メンバ変数
     // ============================================================
-    std::vector<Token> tokens_;
-    size_t pos_;
+    TokenStream tokens_;
+    size_t pos_;  // ソース全体でのトークンの通し番号
     std::vector<Diagnostic> diagnostics_;
     uint32_t last_error_line_ = 0;  // 連続エラー抑制用
     int pending_gt_count_ = 0;  // ネストジェネリクス用: GtGtから分割された残りの'>'カウント
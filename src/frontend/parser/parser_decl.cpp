@@ -82,7 +82,7 @@ ast::DeclPtr Parser::parse_top_level() {
     // export (v4: 宣言時エクスポートと分離エクスポートの両方をサポート)
     if (check(TokenKind::KwExport)) {
         // 次のトークンを先読み
-        auto saved_pos = pos_;
+        auto saved = checkpoint();
         advance();  // consume 'export'
 
         // export struct, export interface, export enum, export typedef, export const
@@ -130,7 +130,7 @@ ast::DeclPtr Parser::parse_top_level() {
         if (!attrs.empty()) {
             error("Attributes are not supported on export lists");
         }
-        pos_ = saved_pos;
+        rewind(saved);
         return parse_export();
     }
 
@@ -182,7 +182,7 @@ ast::DeclPtr Parser::parse_top_level() {
     // #macro (新しいC++風マクロ構文)
     if (check(TokenKind::Hash)) {
         // #macroか他のディレクティブか確認
-        auto saved_pos = pos_;
+        auto saved = checkpoint();
         advance();  // consume '#'
 
         if (check(TokenKind::KwMacro)) {
@@ -204,7 +204,7 @@ ast::DeclPtr Parser::parse_top_level() {
             }
         }
 
-        pos_ = saved_pos;
+        rewind(saved);
         error("Unknown or invalid directive after '#'");
         return nullptr;
     }
@@ -233,7 +233,7 @@ bool Parser::is_global_var_start() {
     if (!is_type_start())
         return false;
 
-    auto saved_pos = pos_;
+    auto saved = checkpoint();
     advance();
 
     while (!is_at_end() && check(TokenKind::Star)) {
@@ -248,7 +248,7 @@ bool Parser::is_global_var_start() {
         }
     }
 
-    pos_ = saved_pos;
+    rewind(saved);
     return result;
 }
 
@@ -874,7 +874,7 @@ void Parser::synchronize() {
     advance();
     while (!is_at_end() && skipped < MAX_SKIP) {
         if (pos_ == last_pos) {
-            if (pos_ < tokens_.size() - 1) {
+            if (tokens_.has(pos_ + 1)) {
                 pos_++;
             } else {
                 break;
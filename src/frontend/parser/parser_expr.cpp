@@ -826,6 +826,7 @@ ast::ExprPtr Parser::parse_primary() {
     // 識別子（enum値アクセスを含む）
     if (check(TokenKind::Ident)) {
         std::string name(current().get_string());
+        Ident name_id = current().ident;
         debug::par::log(debug::par::Id::IdentifierRef, "Found identifier: " + name,
                         debug::Level::Debug);
         advance();
@@ -834,7 +835,7 @@ ast::ExprPtr Parser::parse_primary() {
         // <Type, Type...>::method の形式をチェック
         if (check(TokenKind::Lt)) {
             // 先読みで<...>::パターンかどうかを判定
-            size_t saved_pos = pos_;
+            auto saved = checkpoint();
             advance();  // < を消費
 
             // 型引数をスキップ（ネストした<>を考慮）
@@ -896,7 +897,7 @@ ast::ExprPtr Parser::parse_primary() {
             if (found_close && check(TokenKind::ColonColon)) {
                 // ジェネリック型静的メソッド呼び出しパターン: Vec<int>::method()
                 // 位置を戻して型引数を正しくパース
-                pos_ = saved_pos;
+                rewind(saved);
                 advance();  // < を消費
 
                 std::string type_args_str = "<";
@@ -933,7 +934,7 @@ ast::ExprPtr Parser::parse_primary() {
             } else if (found_close && check(TokenKind::LParen)) {
                 // ジェネリック関数呼び出しパターン: size_of<WorkerArg>()
                 // 位置を戻して型引数を正しくパース
-                pos_ = saved_pos;
+                rewind(saved);
                 advance();  // < を消費
 
                 std::string type_args_str = "<";
@@ -962,7 +963,7 @@ ast::ExprPtr Parser::parse_primary() {
                 return ast::make_ident(std::move(generic_name), Span{start_pos, previous().end});
             } else {
                 // パターンに合致しない場合は位置を戻して通常の識別子として処理
-                pos_ = saved_pos;
+                rewind(saved);
             }
         }
 
@@ -984,7 +985,7 @@ ast::ExprPtr Parser::parse_primary() {
 
         debug::par::log(debug::par::Id::VariableDetected, "Variable/Function reference: " + name,
                         debug::Level::Debug);
-        return ast::make_ident(std::move(name), Span{start_pos, previous().end});
+        return ast::make_ident(std::move(name), name_id, Span{start_pos, previous().end});
     }
 
     // 配列リテラル: [elem1, elem2, ...]
@@ -1064,7 +1065,7 @@ ast::ExprPtr Parser::parse_primary() {
         // 通常の括弧式: (expr)
 
         // 先読みのためにトークン位置を保存
-        size_t saved_pos = pos_;
+        auto saved = checkpoint();
         size_t saved_diag_count = diagnostics_.size();
         std::vector<ast::Param> potential_params;
         bool could_be_lambda = true;
@@ -1144,7 +1145,7 @@ ast::ExprPtr Parser::parse_primary() {
 
         // ラムダではないので、位置を戻して通常の括弧式として処理
         // パース中に追加されたエラーも削除
-        pos_ = saved_pos;
+        rewind(saved);
         while (diagnostics_.size() > saved_diag_count) {
             diagnostics_.pop_back();
         }
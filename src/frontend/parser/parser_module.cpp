@@ -1039,7 +1039,7 @@ std::unique_ptr<ast::FunctionDecl> Parser::parse_extern_func_decl() {
     return func;
 }
 
-// C言語スタイルの型をパース（後置ポインタ T* をサポート）
+// C言語スタイルの型をパース（後置ポインタ T* とスライス T[] をサポート）
 ast::TypePtr Parser::parse_extern_type() {
     // const修飾子をスキップ（C言語互換）
     bool is_const = consume_if(TokenKind::KwConst);
@@ -1048,13 +1048,8 @@ ast::TypePtr Parser::parse_extern_type() {
     // 基本型をパース
     ast::TypePtr base_type = parse_type();
 
-    // 後置ポインタをチェック（C言語スタイル: char*, int* など）
-    while (check(TokenKind::Star)) {
-        advance();  // consume *
-        base_type = ast::make_pointer(std::move(base_type));
-    }
-
-    return base_type;
+    // 後置ポインタ・配列をチェック（char*, int* や、ランタイムが返すスライス utiny[] など）
+    return check_array_suffix(std::move(base_type));
 }
 
 // extern関数用のパラメータパース
@@ -131,7 +131,7 @@ ast::StmtPtr Parser::parse_stmt() {
 
         // まず単純に識別子の後に'in'があるかチェック (型推論パターン)
         if (check(TokenKind::Ident)) {
-            if (lookahead + 1 < tokens_.size() && tokens_[lookahead + 1].kind == TokenKind::KwIn) {
+            if (tokens_.has(lookahead + 1) && tokens_[lookahead + 1].kind == TokenKind::KwIn) {
                 is_for_in = true;
             }
         }
@@ -157,10 +157,10 @@ ast::StmtPtr Parser::parse_stmt() {
             } else if (kind == TokenKind::Ident) {
                 lookahead++;  // カスタム型名をスキップ
                 // ジェネリック <...> をスキップ
-                if (lookahead < tokens_.size() && tokens_[lookahead].kind == TokenKind::Lt) {
+                if (tokens_.has(lookahead) && tokens_[lookahead].kind == TokenKind::Lt) {
                     int depth = 1;
                     lookahead++;
-                    while (lookahead < tokens_.size() && depth > 0) {
+                    while (tokens_.has(lookahead) && depth > 0) {
                         if (tokens_[lookahead].kind == TokenKind::Lt)
                             depth++;
                         else if (tokens_[lookahead].kind == TokenKind::Gt)
@@ -173,27 +173,27 @@ ast::StmtPtr Parser::parse_stmt() {
             }
 
             // 配列 [N] をスキップ（多次元配列対応）
-            while (lookahead < tokens_.size() && tokens_[lookahead].kind == TokenKind::LBracket) {
+            while (tokens_.has(lookahead) && tokens_[lookahead].kind == TokenKind::LBracket) {
                 lookahead++;
-                if (lookahead < tokens_.size() &&
+                if (tokens_.has(lookahead) &&
                     tokens_[lookahead].kind == TokenKind::IntLiteral) {
                     lookahead++;
                 }
-                if (lookahead < tokens_.size() && tokens_[lookahead].kind == TokenKind::RBracket) {
+                if (tokens_.has(lookahead) && tokens_[lookahead].kind == TokenKind::RBracket) {
                     lookahead++;
                 }
             }
 
             // ポインタ * をスキップ
-            while (lookahead < tokens_.size() && tokens_[lookahead].kind == TokenKind::Star) {
+            while (tokens_.has(lookahead) && tokens_[lookahead].kind == TokenKind::Star) {
                 lookahead++;
             }
 
             // 変数名
-            if (lookahead < tokens_.size() && tokens_[lookahead].kind == TokenKind::Ident) {
+            if (tokens_.has(lookahead) && tokens_[lookahead].kind == TokenKind::Ident) {
                 lookahead++;
                 // 'in' キーワード
-                if (lookahead < tokens_.size() && tokens_[lookahead].kind == TokenKind::KwIn) {
+                if (tokens_.has(lookahead) && tokens_[lookahead].kind == TokenKind::KwIn) {
                     is_for_in = true;
                 }
             }
@@ -203,7 +203,7 @@ ast::StmtPtr Parser::parse_stmt() {
             // for-in構文をパース
             ast::TypePtr var_type;
             // 識別子の後に直接'in'があれば型推論
-            bool has_explicit_type = !(check(TokenKind::Ident) && pos_ + 1 < tokens_.size() &&
+            bool has_explicit_type = !(check(TokenKind::Ident) && tokens_.has(pos_ + 1) &&
                                        tokens_[pos_ + 1].kind == TokenKind::KwIn);
             if (has_explicit_type) {
                 var_type = parse_type_with_union();
@@ -280,7 +280,7 @@ ast::StmtPtr Parser::parse_stmt() {
     if (check(TokenKind::KwStatic)) {
         // 次のトークンを見て型開始かどうか判定
         size_t next_idx = pos_ + 1;
-        if (next_idx < tokens_.size()) {
+        if (tokens_.has(next_idx)) {
             TokenKind next_kind = tokens_[next_idx].kind;
             // 型開始トークンかどうか
             is_static_var = (next_kind == TokenKind::KwInt || next_kind == TokenKind::KwFloat ||
@@ -408,7 +408,7 @@ bool Parser::is_type_start() {
             return true;
         case TokenKind::Star:
             // *type name の形式かチェック（*p = x のような式と区別）
-            if (pos_ + 1 < tokens_.size()) {
+            if (tokens_.has(pos_ + 1)) {
                 auto next_kind = tokens_[pos_ + 1].kind;
                 // *の後に型キーワードまたは識別子が来て、
                 // さらにその後に識別子が来れば型宣言
@@ -420,7 +420,7 @@ bool Parser::is_type_start() {
                     next_kind == TokenKind::KwUsize || next_kind == TokenKind::KwVoid ||
                     next_kind == TokenKind::Ident) {
                     // *int name or *Type name の形式
-                    if (pos_ + 2 < tokens_.size() && tokens_[pos_ + 2].kind == TokenKind::Ident) {
+                    if (tokens_.has(pos_ + 2) && tokens_[pos_ + 2].kind == TokenKind::Ident) {
                         return true;
                     }
                 }
@@ -435,7 +435,7 @@ bool Parser::is_type_start() {
             // 識別子の後に<が来たらジェネリック型の可能性 (Type<T> name)
             // 識別子の後に[が来たら配列型の可能性 (Type[N] name)
             // 識別子の後に*が来たらポインタ型の可能性 (Type* name)
-            if (pos_ + 1 < tokens_.size()) {
+            if (tokens_.has(pos_ + 1)) {
                 auto next_kind = tokens_[pos_ + 1].kind;
                 if (next_kind == TokenKind::Ident) {
                     return true;
@@ -445,23 +445,23 @@ bool Parser::is_type_start() {
                     // :: の後をスキップして変数名があるかチェック
                     size_t i = pos_ + 2;
                     // ns::ns2::...::Type パターンをスキップ
-                    while (i + 1 < tokens_.size() && tokens_[i].kind == TokenKind::Ident &&
+                    while (tokens_.has(i + 1) && tokens_[i].kind == TokenKind::Ident &&
                            tokens_[i + 1].kind == TokenKind::ColonColon) {
                         i += 2;  // Ident:: をスキップ
                     }
                     // 最後の型名をチェック
-                    if (i < tokens_.size() && tokens_[i].kind == TokenKind::Ident) {
+                    if (tokens_.has(i) && tokens_[i].kind == TokenKind::Ident) {
                         i++;
                         // 型名の後に変数名があるかチェック
-                        if (i < tokens_.size() && tokens_[i].kind == TokenKind::Ident) {
+                        if (tokens_.has(i) && tokens_[i].kind == TokenKind::Ident) {
                             return true;
                         }
                         // ジェネリック型: ns::Type<T> name
-                        if (i < tokens_.size() && tokens_[i].kind == TokenKind::Lt) {
+                        if (tokens_.has(i) && tokens_[i].kind == TokenKind::Lt) {
                             // <...> をスキップ
                             i++;
                             int depth = 1;
-                            while (i < tokens_.size() && depth > 0) {
+                            while (tokens_.has(i) && depth > 0) {
                                 if (tokens_[i].kind == TokenKind::Lt)
                                     depth++;
                                 else if (tokens_[i].kind == TokenKind::Gt)
@@ -470,7 +470,7 @@ bool Parser::is_type_start() {
                                     depth -= 2;  // ネストジェネリクス対応
                                 i++;
                             }
-                            if (depth <= 0 && i < tokens_.size() &&
+                            if (depth <= 0 && tokens_.has(i) &&
                                 tokens_[i].kind == TokenKind::Ident) {
                                 return true;
                             }
@@ -480,7 +480,7 @@ bool Parser::is_type_start() {
                 // ポインタ型: Type* name
                 if (next_kind == TokenKind::Star) {
                     // * の後に識別子があれば変数宣言
-                    if (pos_ + 2 < tokens_.size() && tokens_[pos_ + 2].kind == TokenKind::Ident) {
+                    if (tokens_.has(pos_ + 2) && tokens_[pos_ + 2].kind == TokenKind::Ident) {
                         return true;
                     }
                 }
@@ -489,14 +489,14 @@ bool Parser::is_type_start() {
                     // [N] の後に識別子があるかチェック
                     size_t i = pos_ + 2;
                     // 配列サイズをスキップ
-                    if (i < tokens_.size() && tokens_[i].kind == TokenKind::IntLiteral) {
+                    if (tokens_.has(i) && tokens_[i].kind == TokenKind::IntLiteral) {
                         i++;
                     }
                     // ] を期待
-                    if (i < tokens_.size() && tokens_[i].kind == TokenKind::RBracket) {
+                    if (tokens_.has(i) && tokens_[i].kind == TokenKind::RBracket) {
                         i++;
                         // ] の後に識別子があれば変数宣言
-                        if (i < tokens_.size() && tokens_[i].kind == TokenKind::Ident) {
+                        if (tokens_.has(i) && tokens_[i].kind == TokenKind::Ident) {
                             return true;
                         }
                     }
@@ -507,7 +507,7 @@ bool Parser::is_type_start() {
                     // 簡易チェック: <>のネストを追跡して、閉じた後に識別子があるか
                     size_t i = pos_ + 2;
                     int depth = 1;
-                    while (i < tokens_.size() && depth > 0) {
+                    while (tokens_.has(i) && depth > 0) {
                         if (tokens_[i].kind == TokenKind::Lt) {
                             depth++;
                         } else if (tokens_[i].kind == TokenKind::Gt) {
@@ -519,23 +519,23 @@ bool Parser::is_type_start() {
                         i++;
                     }
                     // depth == 0 なら閉じている（depth < 0 は >> で過剰消費した場合）
-                    if (depth <= 0 && i < tokens_.size()) {
+                    if (depth <= 0 && tokens_.has(i)) {
                         // ジェネリック型の後に[N]が来る可能性もチェック
                         if (tokens_[i].kind == TokenKind::LBracket) {
                             // [N]をスキップ
                             i++;
-                            if (i < tokens_.size() && tokens_[i].kind == TokenKind::IntLiteral) {
+                            if (tokens_.has(i) && tokens_[i].kind == TokenKind::IntLiteral) {
                                 i++;
                             }
-                            if (i < tokens_.size() && tokens_[i].kind == TokenKind::RBracket) {
+                            if (tokens_.has(i) && tokens_[i].kind == TokenKind::RBracket) {
                                 i++;
                             }
                         }
                         // ポインタ型をスキップ: Type<T>* name や Type<T>** name
-                        while (i < tokens_.size() && tokens_[i].kind == TokenKind::Star) {
+                        while (tokens_.has(i) && tokens_[i].kind == TokenKind::Star) {
                             i++;
                         }
-                        if (i < tokens_.size() && tokens_[i].kind == TokenKind::Ident) {
+                        if (tokens_.has(i) && tokens_[i].kind == TokenKind::Ident) {
                             return true;
                         }
                     }
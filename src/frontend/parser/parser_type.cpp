@@ -232,7 +232,7 @@ ast::TypePtr Parser::parse_type() {
 
     // 関数ポインタ型: int*(int, int) または ポインタ型: void*
     if (base_type && check(TokenKind::Star)) {
-        if (pos_ + 1 < tokens_.size() && tokens_[pos_ + 1].kind == TokenKind::LParen) {
+        if (tokens_.has(pos_ + 1) && tokens_[pos_ + 1].kind == TokenKind::LParen) {
             advance();  // consume *
             advance();  // consume (
 
@@ -291,7 +291,7 @@ ast::TypePtr Parser::parse_type() {
 
             // 関数ポインタ型/ポインタ型
             if (check(TokenKind::Star) && !in_operator_return_type_) {
-                if (pos_ + 1 < tokens_.size() && tokens_[pos_ + 1].kind == TokenKind::LParen) {
+                if (tokens_.has(pos_ + 1) && tokens_[pos_ + 1].kind == TokenKind::LParen) {
                     advance();  // consume *
                     advance();  // consume (
 
@@ -316,7 +316,7 @@ ast::TypePtr Parser::parse_type() {
         // 関数ポインタ型/ポインタ型
         if (check(TokenKind::Star) && !in_operator_return_type_) {
             auto named_type = ast::make_named(name);
-            if (pos_ + 1 < tokens_.size() && tokens_[pos_ + 1].kind == TokenKind::LParen) {
+            if (tokens_.has(pos_ + 1) && tokens_[pos_ + 1].kind == TokenKind::LParen) {
                 advance();  // consume *
                 advance();  // consume (
 
@@ -13,7 +13,6 @@
 #include "../scope.hpp"
 
 #include <functional>
-#include <regex>
 #include <set>
 
 namespace cm {
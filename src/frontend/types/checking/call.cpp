@@ -93,7 +93,7 @@ ast::TypePtr TypeChecker::infer_call(ast::CallExpr& call) {
                 call.inferred_type_args = inferred;
 
                 // 呼び出し名をベース名に変更してモノモーフィゼーションエンジンに委ねる
-                ident->name = base_name;
+                ident->rename(base_name);
                 return infer_generic_call(call, base_name, base_gen_it->second);
             }
         }
@@ -609,6 +609,13 @@ ast::TypePtr TypeChecker::infer_member(ast::MemberExpr& member) {
 
         // ジェネリック型パラメータの場合
         if (generic_context_.has_type_param(type_name)) {
+            if (auto bound_return = infer_bound_method(member, type_name)) {
+                debug::tc::log(debug::tc::Id::Resolved,
+                               "Generic type param " + type_name + "." + member.member +
+                                   "() : " + ast::type_to_string(*bound_return) + " (bound)",
+                               debug::Level::Debug);
+                return bound_return;
+            }
             debug::tc::log(debug::tc::Id::Resolved,
                            "Generic type param " + type_name + "." + member.member +
                                "() - assuming valid (constraint check deferred)",
@@ -106,6 +106,10 @@ class TypeChecker {
                                          const std::vector<ast::TypePtr>& type_args);
     bool check_constraint(const std::string& type_param, const ast::TypePtr& arg_type,
                           const ast::GenericParam& constraint);
+    std::vector<std::string> generic_param_bounds(const std::vector<ast::GenericParam>& params,
+                                                  const std::vector<ast::WhereClause>& where,
+                                                  const std::string& name);
+    ast::TypePtr infer_bound_method(ast::MemberExpr& member, const std::string& type_param);
 
     // ============================================================
     // 自動実装 (auto_impl.cpp)
@@ -247,9 +251,6 @@ class TypeChecker {
     // ============================================================
     // 変数を移動済みとしてマーク（Scope経由）
     void mark_variable_moved(const std::string& name);
-
-    // 移動後の使用をチェック（Scope経由）
-    void check_use_after_move(const std::string& name, Span span);
 };
 
 }  // namespace cm
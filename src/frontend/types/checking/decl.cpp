@@ -603,6 +603,13 @@ void TypeChecker::check_impl(ast::ImplDecl& impl) {
         }
     }
 
+    // impl<K: Hash, V> の型パラメータと境界を登録（境界インターフェースのメソッド解決用）
+    generic_context_.clear();
+    for (const auto& param : impl.generic_params) {
+        generic_context_.add_type_param(
+            param, generic_param_bounds(impl.generic_params_v2, impl.where_clauses, param));
+    }
+
     // コンストラクタ/デストラクタのチェック
     if (impl.is_ctor_impl) {
         for (auto& ctor : impl.constructors) {
@@ -658,6 +665,7 @@ void TypeChecker::check_impl(ast::ImplDecl& impl) {
     }
     current_return_type_ = nullptr;
     current_impl_target_type_.clear();
+    generic_context_.clear();
 }
 
 void TypeChecker::register_enum(ast::EnumDecl& en) {
@@ -779,7 +787,8 @@ void TypeChecker::check_function(ast::FunctionDecl& func) {
     generic_context_.clear();
     if (!func.generic_params.empty()) {
         for (const auto& param : func.generic_params) {
-            generic_context_.add_type_param(param);
+            generic_context_.add_type_param(param, generic_param_bounds(func.generic_params_v2,
+                                                                        {}, param));
             scopes_.current().define(param, ast::make_named(param));
             debug::tc::log(debug::tc::Id::Resolved, "Added generic type param: " + param,
                            debug::Level::Trace);
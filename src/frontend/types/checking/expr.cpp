@@ -230,7 +230,8 @@ ast::TypePtr TypeChecker::infer_struct_literal(ast::StructLiteralExpr& lit) {
 }
 
 ast::TypePtr TypeChecker::infer_ident(ast::IdentExpr& ident) {
-    auto sym = scopes_.current().lookup(ident.name);
+    // 構築時に解決済みのIDで引く（名前のハッシュ・シンボルのコピーをしない）
+    Symbol* sym = scopes_.current().resolve(ident.ident);
     if (!sym) {
         // 暗黙的selfは許可しない - 明示的にself.fieldを使用する必要がある
         error(current_span_, "Undefined variable '" + ident.name + "'");
@@ -238,13 +239,15 @@ ast::TypePtr TypeChecker::infer_ident(ast::IdentExpr& ident) {
     }
 
     // 変数使用をマーク（未使用変数検出用 W001）
-    scopes_.current().mark_used(ident.name);
+    sym->use_count++;
 
     // 初期化前使用のチェック
     check_uninitialized_use(ident.name, current_span_);
 
     // 移動後使用のチェック（Move Semantics）
-    check_use_after_move(ident.name, current_span_);
+    if (sym->is_moved) {
+        error(current_span_, "Variable '" + ident.name + "' used after move");
+    }
 
     debug::tc::log(debug::tc::Id::Resolved, ident.name + " : " + ast::type_to_string(*sym->type),
                    debug::Level::Trace);
@@ -264,7 +267,8 @@ ast::TypePtr TypeChecker::infer_binary(ast::BinaryExpr& binary) {
     if (is_assignment) {
         if (auto* ident = binary.left->as<ast::IdentExpr>()) {
             // move済み変数への代入は禁止
-            if (scopes_.current().is_moved(ident->name)) {
+            const Symbol* sym = scopes_.current().resolve(ident->ident);
+            if (sym && sym->is_moved) {
                 error(binary.left->span, "Cannot assign to moved variable '" + ident->name +
                                              "': variable no longer exists after move");
                 return ast::make_error();
@@ -1221,12 +1225,4 @@ void TypeChecker::mark_variable_moved(const std::string& name) {
     scopes_.current().mark_moved(name);
 }
 
-void TypeChecker::check_use_after_move(const std::string& name, Span span) {
-    // Symbolのis_movedフラグをチェック
-    auto sym = scopes_.current().lookup(name);
-    if (sym && sym->is_moved) {
-        error(span, "Variable '" + name + "' used after move");
-    }
-}
-
 }  // namespace cm
@@ -251,6 +251,56 @@ bool TypeChecker::check_constraint(const std::string& /* type_param */,
     return check_type_constraints(actual_type, constraint.constraints);
 }
 
+// 型パラメータの境界インターフェースを収集（<T: I + J> と where T: I の両方）
+std::vector<std::string> TypeChecker::generic_param_bounds(
+    const std::vector<ast::GenericParam>& params, const std::vector<ast::WhereClause>& where,
+    const std::string& name) {
+    std::vector<std::string> bounds;
+    for (const auto& param : params) {
+        if (param.name == name) {
+            bounds.insert(bounds.end(), param.constraints.begin(), param.constraints.end());
+        }
+    }
+    for (const auto& clause : where) {
+        if (clause.type_param == name) {
+            bounds.insert(bounds.end(), clause.constraint.interfaces.begin(),
+                          clause.constraint.interfaces.end());
+        }
+    }
+    return bounds;
+}
+
+// 境界インターフェース経由のメソッド呼び出し（K: Hash なら key.hash() : int）
+// 実体はモノモーフィゼーション後に具体型のメソッドへ解決される
+ast::TypePtr TypeChecker::infer_bound_method(ast::MemberExpr& member,
+                                             const std::string& type_param) {
+    auto* param = generic_context_.get_type_param(type_param);
+    if (!param) {
+        return nullptr;
+    }
+    for (const auto& bound : param->bounds) {
+        auto iface_it = interface_methods_.find(bound);
+        if (iface_it == interface_methods_.end()) {
+            continue;
+        }
+        auto method_it = iface_it->second.find(member.member);
+        if (method_it == iface_it->second.end()) {
+            continue;
+        }
+        const auto& method_info = method_it->second;
+        if (member.args.size() != method_info.param_types.size()) {
+            error(current_span_, "Method '" + member.member + "' expects " +
+                                     std::to_string(method_info.param_types.size()) +
+                                     " arguments, got " + std::to_string(member.args.size()));
+        }
+        for (auto& arg : member.args) {
+            infer_type(*arg);
+        }
+        return method_info.return_type;
+    }
+    return nullptr;
+}
+
 // type_implements_interface と check_type_constraints は private メンバ関数として
 // utils.cpp に実装
 
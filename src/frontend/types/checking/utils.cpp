@@ -6,7 +6,6 @@
 
 #include <algorithm>
 #include <cctype>
-#include <regex>
 
 namespace cm {
 
@@ -91,35 +90,45 @@ bool TypeChecker::types_compatible(ast::TypePtr a, ast::TypePtr b) {
     }
 
     // 再帰ガード：相互参照型による無限再帰を防止
-    // 型ペアを正規化してセットで管理
-    static thread_local std::set<std::pair<std::string, std::string>> visited_pairs;
-    std::string a_str = ast::type_to_string(*a);
-    std::string b_str = ast::type_to_string(*b);
+    // 比較中の型オブジェクトの組で管理する（型の文字列化・インターナーのロックを避ける）
+    // 再帰先の型はtypedef・デフォルトメンバー・子の型なので、循環すれば同じ組に戻る
+    using TypePair = std::pair<const ast::Type*, const ast::Type*>;
+    static thread_local std::set<TypePair> visited_pairs;
     // 順序を正規化（a < b）
-    auto key = a_str < b_str ? std::make_pair(a_str, b_str) : std::make_pair(b_str, a_str);
+    TypePair key = std::less<const ast::Type*>{}(b.get(), a.get()) ? TypePair{b.get(), a.get()}
+                                                                    : TypePair{a.get(), b.get()};
 
     if (visited_pairs.count(key) > 0) {
         // 既に比較中のペア → 無限再帰を回避、同じと見なす
         return true;
     }
 
-    // RAIIガード
+    // RAIIガード（比較中は型を保持し、アドレスが別の型に再利用されないようにする）
     struct RecursionGuard {
-        std::set<std::pair<std::string, std::string>>& set;
-        std::pair<std::string, std::string> k;
-        RecursionGuard(std::set<std::pair<std::string, std::string>>& s,
-                       std::pair<std::string, std::string> key)
-            : set(s), k(key) {
+        std::set<TypePair>& set;
+        TypePair k;
+        ast::TypePtr keep_a, keep_b;
+        RecursionGuard(std::set<TypePair>& s, TypePair key, ast::TypePtr ta, ast::TypePtr tb)
+            : set(s), k(key), keep_a(std::move(ta)), keep_b(std::move(tb)) {
             set.insert(k);
         }
         ~RecursionGuard() { set.erase(k); }
-    } guard(visited_pairs, key);
+    } guard(visited_pairs, key, a, b);
 
     // ジェネリック型パラメータのチェック
-    std::string a_name = ast::type_to_string(*a);
-    std::string b_name = ast::type_to_string(*b);
-    if (generic_context_.has_type_param(a_name) || generic_context_.has_type_param(b_name)) {
-        return a_name == b_name;
+    // type_to_stringが型パラメータ名と一致し得るのは型引数なしの名前付き型だけなので、
+    // 文字列を作らずに名前を直接比べる
+    auto param_name = [](const ast::Type& t) -> const std::string* {
+        if (t.kind == ast::TypeKind::Union)
+            return t.name.empty() ? nullptr : &t.name;
+        bool named = t.kind == ast::TypeKind::Struct || t.kind == ast::TypeKind::Interface;
+        return named && t.type_args.empty() ? &t.name : nullptr;
+    };
+    const std::string* a_param = param_name(*a);
+    const std::string* b_param = param_name(*b);
+    if ((a_param && generic_context_.has_type_param(*a_param)) ||
+        (b_param && generic_context_.has_type_param(*b_param))) {
+        return a_param && b_param && *a_param == *b_param;
     }
 
     // ジェネリックenum（Tagged Union）互換性: resolve_typedef前に判定
@@ -420,17 +429,31 @@ ast::TypePtr TypeChecker::common_type(ast::TypePtr a, ast::TypePtr b) {
 }
 
 std::vector<std::string> TypeChecker::extract_format_variables(const std::string& format_str) {
+    // {識別子} の形のプレースホルダーを1回の走査で集める
     std::vector<std::string> variables;
-    std::regex placeholder_regex(R"(\{([a-zA-Z_][a-zA-Z0-9_]*)\})");
-    std::smatch match;
-    std::string::const_iterator search_start(format_str.cbegin());
-
-    while (std::regex_search(search_start, format_str.cend(), match, placeholder_regex)) {
-        std::string var_name = match[1];
-        if (std::find(variables.begin(), variables.end(), var_name) == variables.end()) {
-            variables.push_back(var_name);
+    auto is_ident_start = [](char c) {
+        return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+    };
+    auto is_ident_char = [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    };
+
+    size_t pos = format_str.find('{');
+    while (pos != std::string::npos) {
+        size_t end = pos + 1;
+        if (end < format_str.size() && is_ident_start(format_str[end])) {
+            while (end < format_str.size() && is_ident_char(format_str[end]))
+                ++end;
+            if (end < format_str.size() && format_str[end] == '}') {
+                std::string var_name = format_str.substr(pos + 1, end - pos - 1);
+                if (std::find(variables.begin(), variables.end(), var_name) == variables.end()) {
+                    variables.push_back(var_name);
+                }
+                pos = format_str.find('{', end + 1);
+                continue;
+            }
         }
-        search_start = match.suffix().first;
+        pos = format_str.find('{', pos + 1);
     }
 
     return variables;
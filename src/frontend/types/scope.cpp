@@ -1,12 +1,15 @@
 // スコープ管理の実装
 #include "scope.hpp"
 
+#include <algorithm>
+
 namespace cm {
 
 // シンボル登録
 bool Scope::define(const std::string& name, ast::TypePtr type, bool is_const, bool is_static,
                    Span span, std::optional<int64_t> const_int_value) {
-    if (symbols_.count(name))
+    Ident id = Ident::intern(name);
+    if (symbols_.count(id))
         return false;  // 既存
     Symbol sym;
     sym.name = name;
@@ -16,14 +19,15 @@ bool Scope::define(const std::string& name, ast::TypePtr type, bool is_const, bo
     sym.scope_level = level_;
     sym.span = span;
     sym.const_int_value = const_int_value;
-    symbols_[name] = std::move(sym);
+    symbols_[id] = std::move(sym);
     return true;
 }
 
 // 関数登録
 bool Scope::define_function(const std::string& name, std::vector<ast::TypePtr> params,
                             ast::TypePtr ret, size_t required_params, bool is_variadic) {
-    if (symbols_.count(name))
+    Ident id = Ident::intern(name);
+    if (symbols_.count(id))
         return false;
     Symbol sym;
     sym.name = name;
@@ -35,138 +39,120 @@ bool Scope::define_function(const std::string& name, std::vector<ast::TypePtr> p
     sym.type = ast::make_function_ptr(ret, std::move(params));
     // required_paramsがSIZE_MAXの場合は全引数が必須
     sym.required_params = (required_params == SIZE_MAX) ? sym.param_types.size() : required_params;
-    symbols_[name] = std::move(sym);
+    symbols_[id] = std::move(sym);
     return true;
 }
 
+// 親スコープまで辿って検索
+Symbol* Scope::resolve(Ident id) {
+    return const_cast<Symbol*>(static_cast<const Scope*>(this)->resolve(id));
+}
+
+const Symbol* Scope::resolve(Ident id) const {
+    if (!id.valid())
+        return nullptr;
+    for (const Scope* scope = this; scope; scope = scope->parent_) {
+        auto it = scope->symbols_.find(id);
+        if (it != scope->symbols_.end())
+            return &it->second;
+    }
+    return nullptr;
+}
+
+// 名前で検索（一度も登録されていない名前は無効なIDになる）
+Symbol* Scope::find(const std::string& name) {
+    return resolve(Ident::find(name));
+}
+
+const Symbol* Scope::find(const std::string& name) const {
+    return resolve(Ident::find(name));
+}
+
 // シンボル検索（親スコープも検索）
 std::optional<Symbol> Scope::lookup(const std::string& name) const {
-    auto it = symbols_.find(name);
-    if (it != symbols_.end()) {
-        return it->second;
-    }
-    if (parent_) {
-        return parent_->lookup(name);
-    }
+    if (const Symbol* sym = find(name))
+        return *sym;
     return std::nullopt;
 }
 
 // 変数を使用済みとしてマーク（未使用検出用）
 bool Scope::mark_used(const std::string& name) {
-    auto it = symbols_.find(name);
-    if (it != symbols_.end()) {
-        it->second.use_count++;
-        return true;
-    }
-    if (parent_) {
-        return parent_->mark_used(name);
-    }
-    return false;
+    Symbol* sym = find(name);
+    if (!sym)
+        return false;
+    sym->use_count++;
+    return true;
 }
 
-// 未使用シンボル取得（現スコープのみ）
+// 未使用シンボル取得（現スコープのみ、宣言順）
 std::vector<Symbol> Scope::get_unused_symbols() const {
     std::vector<Symbol> unused;
-    for (const auto& [name, sym] : symbols_) {
+    for (const auto& [id, sym] : symbols_) {
         // 関数は除外、変数のみチェック
         // 空のspanを持つシンボル（ビルトイン）も除外
         if (!sym.is_function && sym.use_count == 0 && !sym.span.is_empty()) {
             unused.push_back(sym);
         }
     }
+    std::sort(unused.begin(), unused.end(),
+              [](const Symbol& a, const Symbol& b) { return a.span.start < b.span.start; });
     return unused;
 }
 
 // 変数を移動済みとしてマーク（Move Semantics）
 bool Scope::mark_moved(const std::string& name) {
-    auto it = symbols_.find(name);
-    if (it != symbols_.end()) {
-        it->second.is_moved = true;
-        return true;
-    }
-    // 親スコープも検索してマーク
-    if (parent_) {
-        return parent_->mark_moved(name);
-    }
-    return false;
+    Symbol* sym = find(name);
+    if (!sym)
+        return false;
+    sym->is_moved = true;
+    return true;
 }
 
 // 変数の移動状態をクリア（再代入時）
 bool Scope::unmark_moved(const std::string& name) {
-    auto it = symbols_.find(name);
-    if (it != symbols_.end()) {
-        it->second.is_moved = false;
-        return true;
-    }
-    // 親スコープも検索してクリア
-    if (parent_) {
-        return parent_->unmark_moved(name);
-    }
-    return false;
+    Symbol* sym = find(name);
+    if (!sym)
+        return false;
+    sym->is_moved = false;
+    return true;
 }
 
 // 変数を借用する（借用カウント増加）
 bool Scope::add_borrow(const std::string& name) {
-    auto it = symbols_.find(name);
-    if (it != symbols_.end()) {
-        it->second.borrow_count++;
-        return true;
-    }
-    if (parent_) {
-        return parent_->add_borrow(name);
-    }
-    return false;
+    Symbol* sym = find(name);
+    if (!sym)
+        return false;
+    sym->borrow_count++;
+    return true;
 }
 
 // 借用を解除する（借用カウント減少）
 bool Scope::remove_borrow(const std::string& name) {
-    auto it = symbols_.find(name);
-    if (it != symbols_.end()) {
-        if (it->second.borrow_count > 0) {
-            it->second.borrow_count--;
-        }
-        return true;
-    }
-    if (parent_) {
-        return parent_->remove_borrow(name);
+    Symbol* sym = find(name);
+    if (!sym)
+        return false;
+    if (sym->borrow_count > 0) {
+        sym->borrow_count--;
     }
-    return false;
+    return true;
 }
 
 // 変数が借用中かチェック
 bool Scope::is_borrowed(const std::string& name) const {
-    auto it = symbols_.find(name);
-    if (it != symbols_.end()) {
-        return it->second.borrow_count > 0;
-    }
-    if (parent_) {
-        return parent_->is_borrowed(name);
-    }
-    return false;
+    const Symbol* sym = find(name);
+    return sym && sym->borrow_count > 0;
 }
 
 // 変数がmove済みかチェック
 bool Scope::is_moved(const std::string& name) const {
-    auto it = symbols_.find(name);
-    if (it != symbols_.end()) {
-        return it->second.is_moved;
-    }
-    if (parent_) {
-        return parent_->is_moved(name);
-    }
-    return false;
+    const Symbol* sym = find(name);
+    return sym && sym->is_moved;
 }
 
 // 変数のスコープレベルを取得
 int Scope::get_scope_level(const std::string& name) const {
-    auto it = symbols_.find(name);
-    if (it != symbols_.end()) {
-        return it->second.scope_level;
-    }
-    if (parent_) {
-        return parent_->get_scope_level(name);
-    }
-    return 0;  // 見つからない場合はグローバルとみなす
+    const Symbol* sym = find(name);
+    return sym ? sym->scope_level : 0;  // 見つからない場合はグローバルとみなす
 }
 
 // スコープスタック: push
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../common/ident.hpp"
 #include "../../common/span.hpp"
 #include "../ast/types.hpp"
 
@@ -59,8 +60,15 @@ class Scope {
     // シンボル検索（親スコープも検索）
     std::optional<Symbol> lookup(const std::string& name) const;
 
+    // 識別子IDでシンボル検索（親スコープも検索、表を引かずコピーもしない）
+    Symbol* resolve(Ident id);
+    const Symbol* resolve(Ident id) const;
+
     // 現スコープのみ検索
-    bool has_local(const std::string& name) const { return symbols_.count(name) > 0; }
+    bool has_local(const std::string& name) const {
+        Ident id = Ident::find(name);
+        return id.valid() && symbols_.count(id) > 0;
+    }
 
     // 変数を使用済みとしてマーク（未使用検出用）
     bool mark_used(const std::string& name);
@@ -93,9 +101,13 @@ class Scope {
     int get_scope_level(const std::string& name) const;
 
    private:
+    // 名前をIDに変換してresolveする（未登録の名前はnullptr）
+    Symbol* find(const std::string& name);
+    const Symbol* find(const std::string& name) const;
+
     Scope* parent_;
     int level_ = 0;
-    std::unordered_map<std::string, Symbol> symbols_;
+    std::unordered_map<Ident, Symbol> symbols_;  // 識別子IDで引く（文字列のハッシュは1回だけ）
 };
 
 // ============================================================
@@ -62,6 +62,11 @@ HirDeclPtr HirLowering::lower_function(ast::FunctionDecl& func) {
     hir_func->is_export = func.visibility == ast::Visibility::Export;
     hir_func->is_extern = func.is_extern;  // externフラグを伝播
     hir_func->is_async = func.is_async;    // asyncフラグを伝播
+    for (const auto& attr : func.attributes) {
+        if (attr.name == "pure") {
+            hir_func->is_pure = true;
+        }
+    }
 
     // ジェネリックパラメータを処理
     for (const auto& param_name : func.generic_params) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../common/arena.hpp"
 #include "../common/span.hpp"
 #include "types.hpp"
 
@@ -21,17 +22,25 @@ using HirExprPtr = std::unique_ptr<HirExpr>;
 using HirStmtPtr = std::unique_ptr<HirStmt>;
 using HirDeclPtr = std::unique_ptr<HirDecl>;
 
+// 式・文ノードの割り当て先（MIRへの変換後にまとめて返却する）
+struct HirArenaTag;
+using HirArena = NodeArena<HirArenaTag>;
+
 // ============================================================
 // HIR式ノード
 // ============================================================
 
 // リテラル
 struct HirLiteral {
+    CM_ARENA_NODE(HirArenaTag)
+
     std::variant<std::monostate, bool, int64_t, double, char, std::string> value;
 };
 
 // 変数参照
 struct HirVarRef {
+    CM_ARENA_NODE(HirArenaTag)
+
     std::string name;
     bool is_function_ref = false;  // 関数名への参照（関数ポインタ用）
     bool is_closure = false;       // クロージャ（キャプチャあり）か
@@ -68,6 +77,8 @@ enum class HirBinaryOp {
 };
 
 struct HirBinary {
+    CM_ARENA_NODE(HirArenaTag)
+
     HirBinaryOp op;
     HirExprPtr lhs;
     HirExprPtr rhs;
@@ -87,12 +98,16 @@ enum class HirUnaryOp {
 };
 
 struct HirUnary {
+    CM_ARENA_NODE(HirArenaTag)
+
     HirUnaryOp op;
     HirExprPtr operand;
 };
 
 // 関数呼び出し
 struct HirCall {
+    CM_ARENA_NODE(HirArenaTag)
+
     std::string func_name;    // 完全修飾名（関数ポインタの場合は変数名）
     std::string callee_name;  // クロージャ用：実際の関数名
     std::vector<HirExprPtr> args;
@@ -104,6 +119,8 @@ struct HirCall {
 
 // 配列アクセス
 struct HirIndex {
+    CM_ARENA_NODE(HirArenaTag)
+
     HirExprPtr object;
     HirExprPtr index;                 // 単一インデックス（後方互換性）
     std::vector<HirExprPtr> indices;  // 多次元配列用の複数インデックス
@@ -112,12 +129,16 @@ struct HirIndex {
 
 // メンバアクセス
 struct HirMember {
+    CM_ARENA_NODE(HirArenaTag)
+
     HirExprPtr object;
     std::string member;
 };
 
 // 三項演算子
 struct HirTernary {
+    CM_ARENA_NODE(HirArenaTag)
+
     HirExprPtr condition;
     HirExprPtr then_expr;
     HirExprPtr else_expr;
@@ -130,12 +151,16 @@ struct HirStructLiteralField {
 };
 
 struct HirStructLiteral {
+    CM_ARENA_NODE(HirArenaTag)
+
     std::string type_name;
     std::vector<HirStructLiteralField> fields;
 };
 
 // 配列リテラル
 struct HirArrayLiteral {
+    CM_ARENA_NODE(HirArenaTag)
+
     std::vector<HirExprPtr> elements;
 };
 
@@ -147,6 +172,8 @@ struct HirLambdaParam {
 
 // ラムダ式
 struct HirLambda {
+    CM_ARENA_NODE(HirArenaTag)
+
     std::vector<HirLambdaParam> params;
     TypePtr return_type;  // nullptrなら推論
     std::vector<HirStmtPtr> body;
@@ -155,6 +182,8 @@ struct HirLambda {
 
 // キャスト式
 struct HirCast {
+    CM_ARENA_NODE(HirArenaTag)
+
     HirExprPtr operand;
     TypePtr target_type;
 };
@@ -162,6 +191,8 @@ struct HirCast {
 // enumバリアントコンストラクタ（Tagged Union用）
 // 例: Option::Some(42) → { tag: 1, payload: 42 }
 struct HirEnumConstruct {
+    CM_ARENA_NODE(HirArenaTag)
+
     std::string enum_name;     // enum型名
     std::string variant_name;  // バリアント名
     int64_t tag_value;         // タグ値
@@ -171,6 +202,8 @@ struct HirEnumConstruct {
 // enumペイロード抽出（Tagged Union用）
 // match式のバインディング変数で使用: value = extract_payload(scrutinee)
 struct HirEnumPayload {
+    CM_ARENA_NODE(HirArenaTag)
+
     HirExprPtr scrutinee;      // Tagged Union式
     std::string variant_name;  // 期待するバリアント名
     TypePtr payload_type;      // ペイロードの型
@@ -186,6 +219,8 @@ using HirExprKind =
                  std::unique_ptr<HirEnumConstruct>, std::unique_ptr<HirEnumPayload>>;
 
 struct HirExpr {
+    CM_ARENA_NODE(HirArenaTag)
+
     HirExprKind kind;
     TypePtr type;  // 型情報（必須）
     Span span;
@@ -201,6 +236,8 @@ struct HirExpr {
 
 // 変数宣言
 struct HirLet {
+    CM_ARENA_NODE(HirArenaTag)
+
     std::string name;
     TypePtr type;
     HirExprPtr init;
@@ -212,17 +249,23 @@ struct HirLet {
 
 // 代入
 struct HirAssign {
+    CM_ARENA_NODE(HirArenaTag)
+
     HirExprPtr target;  // 左辺値（変数参照、メンバーアクセス、配列アクセス等）
     HirExprPtr value;  // 右辺値
 };
 
 // return
 struct HirReturn {
+    CM_ARENA_NODE(HirArenaTag)
+
     HirExprPtr value;
 };
 
 // if
 struct HirIf {
+    CM_ARENA_NODE(HirArenaTag)
+
     HirExprPtr cond;
     std::vector<HirStmtPtr> then_block;
     std::vector<HirStmtPtr> else_block;
@@ -230,17 +273,23 @@ struct HirIf {
 
 // loop (無限ループ)
 struct HirLoop {
+    CM_ARENA_NODE(HirArenaTag)
+
     std::vector<HirStmtPtr> body;
 };
 
 // while文
 struct HirWhile {
+    CM_ARENA_NODE(HirArenaTag)
+
     HirExprPtr cond;
     std::vector<HirStmtPtr> body;
 };
 
 // for文
 struct HirFor {
+    CM_ARENA_NODE(HirArenaTag)
+
     HirStmtPtr init;    // 初期化（nullptrの場合あり）
     HirExprPtr cond;    // 条件（nullptrの場合は無限ループ）
     HirExprPtr update;  // 更新式（nullptrの場合あり）
@@ -248,23 +297,33 @@ struct HirFor {
 };
 
 // break
-struct HirBreak {};
+struct HirBreak {
+    CM_ARENA_NODE(HirArenaTag)
+};
 
 // continue
-struct HirContinue {};
+struct HirContinue {
+    CM_ARENA_NODE(HirArenaTag)
+};
 
 // defer
 struct HirDefer {
+    CM_ARENA_NODE(HirArenaTag)
+
     HirStmtPtr body;
 };
 
 // 式文
 struct HirExprStmt {
+    CM_ARENA_NODE(HirArenaTag)
+
     HirExprPtr expr;
 };
 
 // ブロック文
 struct HirBlock {
+    CM_ARENA_NODE(HirArenaTag)
+
     std::vector<HirStmtPtr> stmts;
 };
 
@@ -293,6 +352,8 @@ struct HirSwitchCase {
 
 // switch文
 struct HirSwitch {
+    CM_ARENA_NODE(HirArenaTag)
+
     HirExprPtr expr;
     std::vector<HirSwitchCase> cases;
 };
@@ -318,6 +379,8 @@ struct AsmOperand {
 
 // インラインアセンブリ
 struct HirAsm {
+    CM_ARENA_NODE(HirArenaTag)
+
     std::string code;                   // アセンブリコード（%0, %1... に変換済み）
     bool is_must;                       // must修飾（最適化抑制）
     std::vector<std::string> clobbers;  // 破壊レジスタ
@@ -326,6 +389,8 @@ struct HirAsm {
 
 // must {} ブロック（最適化禁止）
 struct HirMustBlock {
+    CM_ARENA_NODE(HirArenaTag)
+
     std::vector<HirStmtPtr> body;  // ブロック内の文
 };
 
@@ -338,6 +403,8 @@ using HirStmtKind =
                  std::unique_ptr<HirMustBlock>>;
 
 struct HirStmt {
+    CM_ARENA_NODE(HirArenaTag)
+
     HirStmtKind kind;
     Span span;
 
@@ -381,6 +448,7 @@ struct HirFunction {
     bool is_destructor = false;
     bool is_static = false;    // staticメソッド（selfパラメータなし）
     bool is_async = false;     // async関数（JSバックエンド用）
+    bool is_pure = false;      // #[pure]: 副作用がなく結果が引数だけで決まる
     bool is_overload = false;  // overloadキーワードの有無
     HirMethodAccess access = HirMethodAccess::Public;  // メソッドの場合のアクセス修飾子
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../frontend/ast/type_interner.hpp"
 #include "../frontend/ast/types.hpp"
 
 #include <memory>
@@ -40,5 +41,8 @@ using ast::make_ushort;
 using ast::make_utiny;
 using ast::make_void;
 using ast::type_to_string;
+using ast::TypeId;
+using ast::TypeInterner;
+using ast::types_equal;
 
 }  // namespace cm::hir
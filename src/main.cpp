@@ -16,9 +16,11 @@
 // MIR validation
 #include "common/cache_manager.hpp"
 #include "common/debug_messages.hpp"
+#include "common/mapped_file.hpp"
 #include "common/source_location.hpp"
 #include "fmt/formatter.hpp"
 #include "frontend/ast/target_filtering_visitor.hpp"
+#include "frontend/ast/type_interner.hpp"
 #include "frontend/lexer/lexer.hpp"
 #include "frontend/parser/parser.hpp"
 #include "frontend/types/type_checker.hpp"
@@ -35,15 +37,20 @@
 #include "preprocessor/conditional.hpp"
 #include "preprocessor/import.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
 #include <chrono>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 #if !defined(_WIN32)
 #include <fcntl.h>
 #include <sys/wait.h>
@@ -64,6 +71,18 @@ std::string get_version() {
 #endif
 }
 
+// 層のノードを全て破棄した後に、その層のアリーナのチャンクをまとめて返却する
+// ノードが残っていると返却されない（チャンクはプロセス終了まで保持される）ので報告する
+template <typename Arena>
+bool release_arena(debug::Stage stage, const char* layer) {
+    if (Arena::release())
+        return true;
+    debug::log(stage, debug::Level::Warn,
+               std::string(layer) + " arena not released: " + std::to_string(Arena::live()) +
+                   " nodes still alive");
+    return false;
+}
+
 // コマンドラインオプション
 enum class Command { None, Run, Compile, Check, Lint, Fmt, Help, Cache };
 
@@ -94,6 +113,9 @@ struct Options {
     bool incremental = false;             // デフォルトで無効（--incrementalで有効化）
     std::string cache_dir = ".cm-cache";  // キャッシュディレクトリ
     std::string cache_subcommand;         // cache サブコマンド（clear/stats）
+    bool split_modules = false;           // モジュール別分割コンパイル（--split-modules）
+    int jobs = 0;                         // 並列ジョブ数（-j N、0 = ハードウェア並列数）
+    bool no_tbaa = false;                 // TBAAメタデータ付与を無効化（--no-tbaa）
 };
 
 // ヘルプメッセージを表示
@@ -135,10 +157,14 @@ void print_help(const char* program_name) {
     std::cout << "  --hir                 HIR（高レベル中間表現）を表示\n";
     std::cout << "  --mir                 MIR（中レベル中間表現）を表示\n";
     std::cout << "  --mir-opt             最適化後のMIRを表示\n";
-    std::cout << "  --lir-opt             最適化後のLLVM IRを表示（codegen直前）\n\n";
+    std::cout << "  --lir-opt             最適化後のLLVM IRを表示（codegen直前）\n";
+    std::cout << "  --no-tbaa             TBAA（型ベースエイリアス解析）メタデータを付与しない\n\n";
     std::cout << "インクリメンタルビルド:\n";
     std::cout << "  --no-cache            キャッシュを無効化（デフォルト: 有効）\n";
     std::cout << "  --cache-dir=<dir>     キャッシュディレクトリ（デフォルト: .cm-cache）\n";
+    std::cout << "  --split-modules       モジュール別に分割コンパイル（変更モジュールのみ再生成）\n";
+    std::cout << "  -j <n>, --jobs=<n>    並列ジョブ数（MIR最適化 / --split-modules / check / lint、"
+                 "デフォルト: CPUコア数）\n";
     std::cout << "  cache clear           キャッシュを全削除\n";
     std::cout << "  cache stats           キャッシュ統計を表示\n\n";
     std::cout << "その他のオプション:\n";
@@ -152,6 +178,7 @@ void print_help(const char* program_name) {
     std::cout << "  " << program_name
               << " compile --backend=llvm --target=bm -o firmware.o main.cm\n";
     std::cout << "  " << program_name << " check --verbose src/lib.cm\n";
+    std::cout << "  " << program_name << " check -r -j 8 src/\n";
 }
 
 // コマンドラインオプションをパース
@@ -274,6 +301,31 @@ Options parse_options(int argc, char* argv[]) {
         } else if (arg.substr(0, 12) == "--cache-dir=") {
             opts.cache_dir = arg.substr(12);
             opts.incremental = true;  // --cache-dir指定時は暗黙的に有効化
+        } else if (arg == "--split-modules") {
+            opts.split_modules = true;
+        } else if (arg == "--no-tbaa") {
+            opts.no_tbaa = true;
+        } else if (arg.compare(0, 2, "-j") == 0 || arg.compare(0, 7, "--jobs=") == 0) {
+            // -j N / -jN / --jobs=N: 並列ジョブ数（10進数の整数のみ受け付ける）
+            std::string value;
+            if (arg == "-j") {
+                if (i + 1 < argc) {
+                    value = argv[++i];
+                } else {
+                    std::cerr << "-j オプションにはジョブ数が必要です\n";
+                    std::exit(1);
+                }
+            } else {
+                value = arg[1] == 'j' ? arg.substr(2) : arg.substr(7);
+            }
+            bool digits = !value.empty() && value.size() <= 4 &&
+                          std::all_of(value.begin(), value.end(),
+                                      [](unsigned char c) { return std::isdigit(c) != 0; });
+            opts.jobs = digits ? std::stoi(value) : -1;
+            if (opts.jobs < 1 || opts.jobs > 1024) {
+                std::cerr << "無効なジョブ数: " << arg << (arg == "-j" ? " " + value : "") << "\n";
+                std::exit(1);
+            }
         } else if (arg.substr(0, 10) == "--exclude=") {
             // --exclude=PATTERN: 除外パターン
             opts.exclude_patterns.push_back(arg.substr(10));
@@ -303,15 +355,12 @@ Options parse_options(int argc, char* argv[]) {
 
 // ファイルを読み込む
 std::string read_file(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
+    auto contents = read_file_contents(filename);
+    if (!contents) {
         std::cerr << "エラー: ファイルを開けません: " << filename << "\n";
         std::exit(1);
     }
-
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    return buffer.str();
+    return std::move(*contents);
 }
 
 // ソースコード先頭から //! platform: ディレクティブを解析
@@ -454,6 +503,181 @@ std::vector<std::string> collect_cm_files(const std::vector<std::string>& paths,
     return result;
 }
 
+// check/lint 1ファイル分の結果（診断出力はバッファに溜めて入力順に表示する）
+struct FileCheckResult {
+    std::string output;
+    int errors = 0;
+    int warnings = 0;
+    bool checked = false;
+};
+
+// 1ファイルを前処理・パース・型チェック・lintする（ワーカースレッドから呼ばれる）
+// configはファイルごとの行単位無効化を書き換えるため値で受け取る
+FileCheckResult check_single_file(const std::string& file, bool is_lint, bool debug,
+                                  lint::ConfigLoader config) {
+    FileCheckResult result;
+    std::ostringstream out;
+    try {
+        std::string code = read_file(file);
+
+        // //! platform: ディレクティブ検出
+        std::string platform_directive = parse_platform_directive(code);
+        bool is_baremetal_file = is_baremetal_platform(platform_directive);
+
+        // Import処理
+        preprocessor::ImportPreprocessor import_preprocessor(debug);
+        auto preprocess_result = import_preprocessor.process(code, file);
+
+        if (!preprocess_result.success) {
+            out << file << ": プリプロセッサエラー: " << preprocess_result.error_message
+                << "\n";
+            result.errors++;
+            result.output = out.str();
+            return result;
+        }
+
+        code = preprocess_result.processed_source;
+
+        // 条件付きコンパイル
+        preprocessor::ConditionalPreprocessor conditional;
+        code = conditional.process(code);
+
+        // パース（トークンはパーサが必要な分だけ字句解析器から取り出す）
+        Lexer lexer(code);
+        Parser parser(lexer);
+        auto program = parser.parse();
+
+        if (parser.has_errors()) {
+            SourceLocationManager loc_mgr(code, file);
+            for (const auto& diag : parser.diagnostics()) {
+                std::string error_type = (diag.severity == DiagKind::Error ? "error" : "warning");
+                out << loc_mgr.format_error_location(diag.span,
+                                                     error_type + ": " + diag.message);
+            }
+            result.errors += static_cast<int>(parser.diagnostics().size());
+            result.output = out.str();
+            return result;
+        }
+
+        // 型チェック
+        TypeChecker checker;
+        bool type_check_ok = checker.check(program);
+        (void)type_check_ok;  // 警告抑制：将来のエラー処理で使用予定
+
+        // 診断情報を表示
+        SourceLocationManager loc_mgr(code, file);
+
+        // インラインコメントによる無効化を解析
+        config.clear_line_disables();
+        config.parse_disable_comments(code);
+
+        for (const auto& diag : checker.diagnostics()) {
+            // ルールIDを抽出 (メッセージ末尾の [W001] や [L100] など)
+            std::string rule_id;
+            auto bracket_pos = diag.message.rfind('[');
+            auto close_pos = diag.message.rfind(']');
+            if (bracket_pos != std::string::npos && close_pos != std::string::npos &&
+                close_pos > bracket_pos) {
+                rule_id = diag.message.substr(bracket_pos + 1, close_pos - bracket_pos - 1);
+            }
+
+            // 設定で無効化されているルールはスキップ
+            if (!rule_id.empty() && config.is_disabled(rule_id)) {
+                continue;
+            }
+
+            // インラインコメントで無効化されている行はスキップ
+            if (!rule_id.empty()) {
+                auto line_col = loc_mgr.get_line_column(diag.span.start);
+                if (config.is_line_disabled(line_col.line, rule_id)) {
+                    continue;
+                }
+            }
+
+            // 設定されたレベルに基づいて表示を決定
+            std::string prefix;
+            bool count_as_error = false;
+
+            if (!rule_id.empty()) {
+                // 設定ファイルでレベルが指定されている場合
+                auto level = config.get_level(rule_id);
+                switch (level) {
+                    case lint::RuleLevel::Error:
+                        prefix = "error";
+                        count_as_error = true;
+                        break;
+                    case lint::RuleLevel::Warning:
+                        prefix = "warning";
+                        break;
+                    case lint::RuleLevel::Hint:
+                        prefix = "hint";
+                        break;
+                    default:
+                        prefix = "warning";
+                        break;
+                }
+            } else {
+                // ルールIDがない場合は元の診断レベルを使用
+                prefix = (diag.severity == DiagKind::Error) ? "error" : "warning";
+                count_as_error = (diag.severity == DiagKind::Error);
+            }
+
+            out << loc_mgr.format_error_location(diag.span, prefix + ": " + diag.message);
+            if (count_as_error) {
+                result.errors++;
+            } else {
+                result.warnings++;
+            }
+        }
+
+        // ベアメタルファイルの場合、ソースコード上で禁止関数呼び出しを検出
+        if (is_baremetal_file && is_lint) {
+            static const std::vector<std::string> forbidden = {
+                "println", "print",  "printf",         "puts",         "putchar",
+                "malloc",  "free",   "calloc",         "realloc",      "exit",
+                "fopen",   "fclose", "fread",          "fwrite",       "socket",
+                "connect", "bind",   "pthread_create", "pthread_join",
+            };
+            // ソースコードの各行をスキャン
+            std::istringstream scan(code);
+            std::string scan_line;
+            int line_num = 0;
+            while (std::getline(scan, scan_line)) {
+                line_num++;
+                // コメント行はスキップ
+                auto trimmed = scan_line;
+                trimmed.erase(0, trimmed.find_first_not_of(" \t"));
+                if (trimmed.find("//") == 0)
+                    continue;
+
+                for (const auto& func : forbidden) {
+                    // "func_name(" パターンを検出
+                    std::string pattern = func + "(";
+                    auto fpos = scan_line.find(pattern);
+                    if (fpos != std::string::npos) {
+                        // 直前が英数字やアンダースコアならスキップ（部分一致防止）
+                        if (fpos > 0) {
+                            char prev = scan_line[fpos - 1];
+                            if (std::isalnum(prev) || prev == '_')
+                                continue;
+                        }
+                        out << file << ":" << line_num << ": warning: ベアメタル環境では '"
+                            << func << "' は使用できません [B001]\n";
+                        result.warnings++;
+                    }
+                }
+            }
+        }
+
+        result.checked = true;
+    } catch (const std::exception& e) {
+        out << file << ": 例外: " << e.what() << "\n";
+        result.errors++;
+    }
+    result.output = out.str();
+    return result;
+}
+
 // ASTを表示
 void print_ast(const ast::Program& program) {
     std::cout << "=== AST (Abstract Syntax Tree) ===\n";
@@ -547,176 +771,59 @@ int main(int argc, char* argv[]) {
             }
         }
 
-        // 各ファイルをチェック
-        int total_errors = 0;
-        int total_warnings = 0;
-        int files_checked = 0;
-
-        for (const auto& file : cm_files) {
-            try {
-                std::string code = read_file(file);
-
-                // //! platform: ディレクティブ検出
-                std::string platform_directive = parse_platform_directive(code);
-                bool is_baremetal_file = is_baremetal_platform(platform_directive);
-
-                // モジュールリゾルバ初期化
-                module::initialize_module_resolver();
-
-                // Import処理
-                preprocessor::ImportPreprocessor import_preprocessor(opts.debug);
-                auto preprocess_result = import_preprocessor.process(code, file);
-
-                if (!preprocess_result.success) {
-                    std::cerr << file
-                              << ": プリプロセッサエラー: " << preprocess_result.error_message
-                              << "\n";
-                    total_errors++;
-                    continue;
-                }
-
-                code = preprocess_result.processed_source;
-
-                // 条件付きコンパイル
-                preprocessor::ConditionalPreprocessor conditional;
-                code = conditional.process(code);
-
-                // パース
-                Lexer lexer(code);
-                auto tokens = lexer.tokenize();
-                Parser parser(std::move(tokens));
-                auto program = parser.parse();
-
-                if (parser.has_errors()) {
-                    SourceLocationManager loc_mgr(code, file);
-                    for (const auto& diag : parser.diagnostics()) {
-                        std::string error_type =
-                            (diag.severity == DiagKind::Error ? "error" : "warning");
-                        std::cerr << loc_mgr.format_error_location(
-                            diag.span, error_type + ": " + diag.message);
-                    }
-                    total_errors += parser.diagnostics().size();
-                    continue;
-                }
-
-                // 型チェック
-                TypeChecker checker;
-                bool type_check_ok = checker.check(program);
-                (void)type_check_ok;  // 警告抑制：将来のエラー処理で使用予定
-
-                // 診断情報を表示
-                SourceLocationManager loc_mgr(code, file);
-
-                // インラインコメントによる無効化を解析
-                config.clear_line_disables();
-                config.parse_disable_comments(code);
-
-                for (const auto& diag : checker.diagnostics()) {
-                    // ルールIDを抽出 (メッセージ末尾の [W001] や [L100] など)
-                    std::string rule_id;
-                    auto bracket_pos = diag.message.rfind('[');
-                    auto close_pos = diag.message.rfind(']');
-                    if (bracket_pos != std::string::npos && close_pos != std::string::npos &&
-                        close_pos > bracket_pos) {
-                        rule_id = diag.message.substr(bracket_pos + 1, close_pos - bracket_pos - 1);
-                    }
-
-                    // 設定で無効化されているルールはスキップ
-                    if (!rule_id.empty() && config.is_disabled(rule_id)) {
-                        continue;
-                    }
+        // モジュールリゾルバはグローバルなのでワーカー起動前に初期化
+        module::initialize_module_resolver();
 
-                    // インラインコメントで無効化されている行はスキップ
-                    if (!rule_id.empty()) {
-                        auto line_col = loc_mgr.get_line_column(diag.span.start);
-                        if (config.is_line_disabled(line_col.line, rule_id)) {
-                            continue;
-                        }
-                    }
+        // ワーカー数を決定（-j N、未指定ならハードウェア並列数）
+        // デバッグ出力は行が混ざらないよう直列で実行する
+        size_t num_workers = opts.jobs > 0 ? static_cast<size_t>(opts.jobs)
+                                           : std::thread::hardware_concurrency();
+        if (opts.debug) {
+            num_workers = 1;
+        }
+        num_workers = std::clamp<size_t>(num_workers, 1, cm_files.size());
 
-                    // 設定されたレベルに基づいて表示を決定
-                    std::string prefix;
-                    bool count_as_error = false;
-
-                    if (!rule_id.empty()) {
-                        // 設定ファイルでレベルが指定されている場合
-                        auto level = config.get_level(rule_id);
-                        switch (level) {
-                            case lint::RuleLevel::Error:
-                                prefix = "error";
-                                count_as_error = true;
-                                break;
-                            case lint::RuleLevel::Warning:
-                                prefix = "warning";
-                                break;
-                            case lint::RuleLevel::Hint:
-                                prefix = "hint";
-                                break;
-                            default:
-                                prefix = "warning";
-                                break;
-                        }
-                    } else {
-                        // ルールIDがない場合は元の診断レベルを使用
-                        prefix = (diag.severity == DiagKind::Error) ? "error" : "warning";
-                        count_as_error = (diag.severity == DiagKind::Error);
-                    }
+        // 各ファイルを並列にチェックし、診断は完了順ではなく入力順に出力する
+        bool is_lint = opts.command == Command::Lint;
+        std::vector<FileCheckResult> results(cm_files.size());
+        std::vector<char> done(cm_files.size(), 0);
+        size_t next_to_print = 0;
+        std::mutex print_mutex;
+        std::atomic<size_t> next_index{0};
 
-                    std::cerr << loc_mgr.format_error_location(diag.span,
-                                                               prefix + ": " + diag.message);
-                    if (count_as_error) {
-                        total_errors++;
-                    } else {
-                        total_warnings++;
-                    }
-                }
-
-                // ベアメタルファイルの場合、ソースコード上で禁止関数呼び出しを検出
-                if (is_baremetal_file && opts.command == Command::Lint) {
-                    static const std::vector<std::string> forbidden = {
-                        "println", "print",  "printf",         "puts",         "putchar",
-                        "malloc",  "free",   "calloc",         "realloc",      "exit",
-                        "fopen",   "fclose", "fread",          "fwrite",       "socket",
-                        "connect", "bind",   "pthread_create", "pthread_join",
-                    };
-                    // ソースコードの各行をスキャン
-                    std::istringstream scan(code);
-                    std::string scan_line;
-                    int line_num = 0;
-                    while (std::getline(scan, scan_line)) {
-                        line_num++;
-                        // コメント行はスキップ
-                        auto trimmed = scan_line;
-                        trimmed.erase(0, trimmed.find_first_not_of(" \t"));
-                        if (trimmed.find("//") == 0)
-                            continue;
+        int total_errors = 0;
+        int total_warnings = 0;
+        int files_checked = 0;
 
-                        for (const auto& func : forbidden) {
-                            // "func_name(" パターンを検出
-                            std::string pattern = func + "(";
-                            auto fpos = scan_line.find(pattern);
-                            if (fpos != std::string::npos) {
-                                // 直前が英数字やアンダースコアならスキップ（部分一致防止）
-                                if (fpos > 0) {
-                                    char prev = scan_line[fpos - 1];
-                                    if (std::isalnum(prev) || prev == '_')
-                                        continue;
-                                }
-                                std::cerr << file << ":" << line_num
-                                          << ": warning: ベアメタル環境では '" << func
-                                          << "' は使用できません [B001]\n";
-                                total_warnings++;
-                            }
-                        }
-                    }
+        auto worker = [&]() {
+            for (size_t i = next_index.fetch_add(1); i < cm_files.size();
+                 i = next_index.fetch_add(1)) {
+                FileCheckResult r = check_single_file(cm_files[i], is_lint, opts.debug, config);
+
+                std::lock_guard<std::mutex> lock(print_mutex);
+                results[i] = std::move(r);
+                done[i] = 1;
+                // 先頭から連続して完了した分を出力
+                while (next_to_print < cm_files.size() && done[next_to_print]) {
+                    auto& ready = results[next_to_print];
+                    std::cerr << ready.output;
+                    total_errors += ready.errors;
+                    total_warnings += ready.warnings;
+                    files_checked += ready.checked ? 1 : 0;
+                    ready.output.clear();
+                    next_to_print++;
                 }
-
-                files_checked++;
-
-            } catch (const std::exception& e) {
-                std::cerr << file << ": 例外: " << e.what() << "\n";
-                total_errors++;
             }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(num_workers - 1);
+        for (size_t i = 1; i < num_workers; ++i) {
+            threads.emplace_back(worker);
+        }
+        worker();  // 呼び出しスレッドもワーカーとして参加
+        for (auto& t : threads) {
+            t.join();
         }
 
         // サマリー表示
@@ -887,6 +994,10 @@ int main(int argc, char* argv[]) {
     }
 
     try {
+        // 型インターナーはこのコンパイル専用（終了時にまとめて解放する）
+        // MIRより先に作り、MIRの破棄後に解放されるようにする
+        ast::TypeInterner::Scope type_interner_scope;
+
         // ========== Initialize Module Resolver ==========
         if (opts.debug)
             std::cout << "=== Module Resolver Init ===\n";
@@ -939,6 +1050,14 @@ int main(int argc, char* argv[]) {
             std::cout << "=== Import Preprocessor ===\n";
         auto phase_preprocess_start = std::chrono::steady_clock::now();
         preprocessor::ImportPreprocessor import_preprocessor(opts.debug);
+        if (opts.incremental) {
+            // インポートされたモジュールの展開結果を .cmi として再利用
+            cache::CacheConfig cmi_config;
+            cmi_config.cache_dir = opts.cache_dir;
+            cache::CacheManager cmi_mgr(cmi_config);
+            import_preprocessor.enable_interface_cache(cmi_mgr.cache_dir() / "cmi",
+                                                       cmi_mgr.cached_compiler_hash());
+        }
         auto preprocess_result = import_preprocessor.process(code, opts.input_file);
         auto phase_preprocess_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
                                        std::chrono::steady_clock::now() - phase_preprocess_start)
@@ -1100,15 +1219,13 @@ int main(int argc, char* argv[]) {
         if (opts.debug)
             std::cout << "=== Lexer ===\n";
         auto phase_parse_start = std::chrono::steady_clock::now();
+        // トークン列は作らず、パーサが必要な分だけ字句解析器から取り出す
         Lexer lexer(code);
-        auto tokens = lexer.tokenize();
-        if (opts.debug)
-            std::cout << "トークン数: " << tokens.size() << "\n\n";
 
         // ========== Parser ==========
         if (opts.debug)
             std::cout << "=== Parser ===\n";
-        Parser parser(std::move(tokens));
+        Parser parser(lexer);
         auto program = parser.parse();
 
         if (parser.has_errors()) {
@@ -1305,6 +1422,10 @@ int main(int argc, char* argv[]) {
             print_hir(hir);
         }
 
+        // ASTはHIRへ変換済みなので破棄し、ASTノードのアリーナをまとめて返却する
+        program.declarations.clear();
+        release_arena<ast::AstArena>(debug::Stage::Ast, "AST");
+
         // ========== MIR Lowering ==========
         if (opts.debug)
             std::cout << "=== MIR Lowering ===\n";
@@ -1321,6 +1442,10 @@ int main(int argc, char* argv[]) {
                                 std::chrono::steady_clock::now() - phase_mir_start)
                                 .count();
 
+        // MIRへ変換済みのHIRも破棄し、HIRノードのアリーナを返却する
+        hir.declarations.clear();
+        release_arena<hir::HirArena>(debug::Stage::Hir, "HIR");
+
         if (opts.debug)
             std::cout << "MIR関数数: " << mir.functions.size() << "\n\n" << std::flush;
 
@@ -1343,7 +1468,7 @@ int main(int argc, char* argv[]) {
 
             // MIR最適化パスマネージャーv2を使用（収束管理と無限ループ防止機能付き）
             mir::opt::run_optimization_passes(mir, opts.optimization_level,
-                                              opts.debug || opts.verbose);
+                                              opts.debug || opts.verbose, opts.jobs);
             if (cm::debug::g_debug_mode)
                 std::cerr << "[OPT] Optimization complete" << std::endl;
 
@@ -1467,22 +1592,37 @@ int main(int argc, char* argv[]) {
             // JITキャッシュ用: バックグラウンドでネイティブバイナリも生成
             // MIRからLLVMコンパイルしてJIT実行
             cm::codegen::jit::JITEngine jit;
+            jit.setTBAAEnabled(!opts.no_tbaa);
+
+            // JITオブジェクトキャッシュ: 同じフィンガープリントなら最適化・コード生成を省略
+            if (opts.incremental && !cache_fingerprint.empty()) {
+                jit.enableObjectCache(std::filesystem::path(opts.cache_dir) / "jit",
+                                      cache_fingerprint);
+            }
 
-            // JIT実行時はstdoutをアンバッファにして即時出力されるようにする
-            std::setvbuf(stdout, nullptr, _IONBF, 0);
+            // stdoutはランタイムの方針（端末は行、パイプ・ファイルはブロック）でバッファする
+            // stderrへの書き込み前・panic/異常終了時・main終了後に書き出すため出力順は保たれる
 
             auto result = jit.execute(mir, "main", opts.optimization_level);
 
+            // 実行済みなのでMIRを破棄し、MIRノードのアリーナを返却する
+            mir = mir::MirProgram{};
+            release_arena<mir::MirArena>(debug::Stage::Mir, "MIR");
+
             if (!result.success) {
                 std::cerr << "JIT実行エラー: " << result.errorMessage << std::endl;
                 return 1;
             }
 
-            // 注意: JIT実行後のキャッシュ保存（codegen.compile）は、
+            // 注意: JIT実行後の実行ファイル保存（codegen.compile）は、
             // LLVM globalの再初期化問題とstdout汚染のため実装しない。
-            // JITキャッシュは「cm compile」で生成されたキャッシュの再利用のみサポート。
+            // 実行ファイルキャッシュは「cm compile」で生成されたもののみ再利用し、
+            // JIT自体はオブジェクトキャッシュ（.cm-cache/jit/）で再コンパイルを省略する。
 
             if (opts.verbose) {
+                if (result.objectCacheHit) {
+                    std::cout << "✓ JITオブジェクトキャッシュヒット" << std::endl;
+                }
                 std::cout << "プログラム終了コード: " << result.exitCode << std::endl;
                 std::cout << "✓ JIT実行完了" << std::endl;
             }
@@ -1641,6 +1781,8 @@ int main(int argc, char* argv[]) {
                 llvm_opts.debugInfo = opts.debug;
                 llvm_opts.verbose = opts.verbose || opts.debug;
                 llvm_opts.verifyIR = true;
+                llvm_opts.jobs = opts.jobs;
+                llvm_opts.enableTBAA = !opts.no_tbaa;
 
                 // LLVM コード生成
                 try {
@@ -1671,9 +1813,9 @@ int main(int argc, char* argv[]) {
                     }
 
                     // モジュール分割情報を事前計算
-                    // 注意: 現在モジュール分割コンパイルは無効化されている
+                    // 注意: モジュール分割コンパイルはデフォルトで無効
                     // （フロントエンドが毎回全実行されるため、効果が限定的）
-                    // 将来 --split-modules オプションで有効化可能
+                    // --split-modules オプションで有効化可能
                     cm::codegen::llvm_backend::LLVMCodeGen::ModuleCompileInfo module_info_pre;
 
                     if (cm::debug::g_debug_mode)
@@ -1681,22 +1823,20 @@ int main(int argc, char* argv[]) {
                     auto phase_llvm_start = std::chrono::steady_clock::now();
 
                     // モジュール別差分コンパイルの判定
-                    // 現在は常に全体コンパイルを使用
-                    // モジュール分割はフロントエンドの差分化が実装されるまで無効
-                    bool use_module_compile = false;
+                    // --split-modules 指定時のみ、ネイティブ実行ファイル出力で使用
+                    // （IR表示やLLVM IR出力は単一モジュールが前提のため全体コンパイル）
+                    bool use_module_compile =
+                        opts.split_modules && !opts.show_lir_opt &&
+                        llvm_opts.target == cm::codegen::llvm_backend::BuildTarget::Native &&
+                        llvm_opts.format ==
+                            cm::codegen::llvm_backend::LLVMCodeGen::OutputFormat::Executable;
 
                     // モジュール情報（事前計算）
                     cm::codegen::llvm_backend::LLVMCodeGen::ModuleCompileInfo module_info;
 
                     if (use_module_compile) {
                         // === モジュール別差分コンパイル ===
-                        // 現在無効化中 - フロントエンド差分化後に再有効化予定
-                        if (opts.verbose) {
-                            std::cout << "⚡ モジュール別差分コンパイル: " << changed_modules.size()
-                                      << "/" << module_info_pre.module_names.size()
-                                      << " モジュール再コンパイル\n";
-                        }
-
+                        // 変更モジュールは -j N のワーカーで並列にコンパイルされる
                         // キャッシュ済みオブジェクトのマップ
                         std::map<std::string, std::filesystem::path> cached_objects;
                         if (opts.incremental) {
@@ -1727,6 +1867,9 @@ int main(int argc, char* argv[]) {
                         // モジュール情報を構築
                         module_info = module_info_pre;
                         module_info.changed_modules = changed_modules;
+                        for (const auto& mo : module_objects) {
+                            module_info.module_names.push_back(mo.module_name);
+                        }
 
                         // 新しいモジュール .o をキャッシュに保存
                         if (opts.incremental) {
@@ -1748,6 +1891,9 @@ int main(int argc, char* argv[]) {
                                 if (mo.from_cache)
                                     cached_count++;
                             }
+                            std::cout << "⚡ モジュール別差分コンパイル: "
+                                      << module_objects.size() - cached_count << "/"
+                                      << module_objects.size() << " モジュール再コンパイル\n";
                             std::cout << "  キャッシュヒット: " << cached_count << "/"
                                       << module_objects.size() << " モジュール\n";
                         }
@@ -1756,6 +1902,10 @@ int main(int argc, char* argv[]) {
                         module_info = codegen.compileWithModuleInfo(mir, changed_modules);
                     }
 
+                    // LLVM IRへ変換済みなのでMIRを破棄し、MIRノードのアリーナを返却する
+                    mir = mir::MirProgram{};
+                    release_arena<mir::MirArena>(debug::Stage::Mir, "MIR");
+
                     auto phase_llvm_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
                                              std::chrono::steady_clock::now() - phase_llvm_start)
                                              .count();
@@ -0,0 +1,85 @@
+#include "analysis_manager.hpp"
+
+namespace cm::mir {
+
+FunctionAnalysisManager::Entry& FunctionAnalysisManager::entry(const MirFunction& func) {
+    Entry* e = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(entries_mutex);
+        auto& slot = entries[&func];
+        if (!slot) {
+            slot = std::make_unique<Entry>();
+            slot->num_blocks = func.basic_blocks.size();
+        }
+        e = slot.get();
+    }
+
+    // ブロック数が変わっていればCFGが変わっている（invalidate漏れ）ので全て作り直す
+    if (e->num_blocks != func.basic_blocks.size()) {
+        *e = Entry{};
+        e->num_blocks = func.basic_blocks.size();
+    }
+    return *e;
+}
+
+const DominatorTree& FunctionAnalysisManager::dominators(const MirFunction& func) {
+    auto& e = entry(func);
+    return get(e.dominators, [&] { return std::make_unique<DominatorTree>(func); });
+}
+
+const PostDominatorTree& FunctionAnalysisManager::post_dominators(const MirFunction& func) {
+    auto& e = entry(func);
+    return get(e.post_dominators, [&] { return std::make_unique<PostDominatorTree>(func); });
+}
+
+const LoopAnalysis& FunctionAnalysisManager::loops(const MirFunction& func) {
+    const auto& dom_tree = dominators(func);
+    auto& e = entry(func);
+    return get(e.loops, [&] { return std::make_unique<LoopAnalysis>(func, dom_tree); });
+}
+
+const DefUseChains& FunctionAnalysisManager::def_use(const MirFunction& func) {
+    auto& e = entry(func);
+    return get(e.def_use, [&] { return std::make_unique<DefUseChains>(func); });
+}
+
+const LivenessAnalysis& FunctionAnalysisManager::liveness(const MirFunction& func) {
+    auto& e = entry(func);
+    return get(e.liveness, [&] { return std::make_unique<LivenessAnalysis>(func); });
+}
+
+void FunctionAnalysisManager::invalidate(const MirFunction& func,
+                                         const PreservedAnalyses& preserved) {
+    Entry* e = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(entries_mutex);
+        auto it = entries.find(&func);
+        if (it == entries.end())
+            return;
+        e = it->second.get();
+    }
+
+    // ループ解析は支配木を参照しているので、支配木と一緒に破棄する
+    if (!preserved.is_preserved(AnalysisKind::Dominators) ||
+        !preserved.is_preserved(AnalysisKind::Loops)) {
+        e->loops.reset();
+    }
+    if (!preserved.is_preserved(AnalysisKind::Dominators))
+        e->dominators.reset();
+    if (!preserved.is_preserved(AnalysisKind::PostDominators))
+        e->post_dominators.reset();
+    if (!preserved.is_preserved(AnalysisKind::DefUse))
+        e->def_use.reset();
+    if (!preserved.is_preserved(AnalysisKind::Liveness))
+        e->liveness.reset();
+
+    if (!e->dominators && !e->post_dominators && !e->def_use && !e->liveness)
+        e->num_blocks = func.basic_blocks.size();
+}
+
+void FunctionAnalysisManager::clear() {
+    std::lock_guard<std::mutex> lock(entries_mutex);
+    entries.clear();
+}
+
+}  // namespace cm::mir
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "mir/analysis/def_use.hpp"
+#include "mir/analysis/dominators.hpp"
+#include "mir/analysis/liveness.hpp"
+#include "mir/analysis/loop_analysis.hpp"
+#include "mir/nodes.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace cm::mir {
+
+// 解析の種類
+enum class AnalysisKind : uint8_t {
+    Dominators,
+    PostDominators,
+    Loops,
+    DefUse,
+    Liveness,
+};
+
+// パスが変更後も有効なまま残す解析の集合
+class PreservedAnalyses {
+   public:
+    static PreservedAnalyses all() { return PreservedAnalyses(~0u); }
+    static PreservedAnalyses none() { return PreservedAnalyses(0); }
+
+    // CFGの形（ブロックと遷移先）だけに依存する解析: 支配木・後支配木・ループ
+    static PreservedAnalyses cfg() {
+        return none()
+            .preserve(AnalysisKind::Dominators)
+            .preserve(AnalysisKind::PostDominators)
+            .preserve(AnalysisKind::Loops);
+    }
+
+    PreservedAnalyses& preserve(AnalysisKind kind) {
+        mask |= bit(kind);
+        return *this;
+    }
+
+    bool is_preserved(AnalysisKind kind) const { return (mask & bit(kind)) != 0; }
+
+   private:
+    explicit PreservedAnalyses(uint32_t m) : mask(m) {}
+    static uint32_t bit(AnalysisKind kind) { return 1u << static_cast<uint32_t>(kind); }
+
+    uint32_t mask;
+};
+
+// 関数単位の解析結果キャッシュ（LLVMのFunctionAnalysisManager相当）
+// パスは解析を要求し、変更後はパイプラインがinvalidate()で保持されない解析を破棄する。
+// 異なる関数に対しては並行に呼び出せる（同じ関数は同時に1スレッドのみ）。
+class FunctionAnalysisManager {
+   public:
+    const DominatorTree& dominators(const MirFunction& func);
+    const PostDominatorTree& post_dominators(const MirFunction& func);
+    const LoopAnalysis& loops(const MirFunction& func);
+    const DefUseChains& def_use(const MirFunction& func);
+    const LivenessAnalysis& liveness(const MirFunction& func);
+
+    // 関数の変更後に、保持されない解析を破棄
+    void invalidate(const MirFunction& func, const PreservedAnalyses& preserved);
+
+    // 全関数の解析を破棄（関数間パスの後など）
+    void clear();
+
+    // 統計（計算回数とキャッシュヒット数）
+    size_t computed_count() const { return computed; }
+    size_t cached_count() const { return cached; }
+
+   private:
+    struct Entry {
+        size_t num_blocks = 0;  // 計算時のブロック数（invalidate漏れの検出用）
+        std::unique_ptr<DominatorTree> dominators;
+        std::unique_ptr<PostDominatorTree> post_dominators;
+        std::unique_ptr<LoopAnalysis> loops;
+        std::unique_ptr<DefUseChains> def_use;
+        std::unique_ptr<LivenessAnalysis> liveness;
+    };
+
+    Entry& entry(const MirFunction& func);
+
+    template <typename T, typename Compute>
+    const T& get(std::unique_ptr<T>& slot, Compute&& compute) {
+        if (slot) {
+            ++cached;
+            return *slot;
+        }
+        ++computed;
+        slot = compute();
+        return *slot;
+    }
+
+    std::mutex entries_mutex;
+    std::unordered_map<const MirFunction*, std::unique_ptr<Entry>> entries;
+    std::atomic<size_t> computed{0};
+    std::atomic<size_t> cached{0};
+};
+
+}  // namespace cm::mir
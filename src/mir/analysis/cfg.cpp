@@ -0,0 +1,89 @@
+#include "cfg.hpp"
+
+#include <algorithm>
+
+namespace cm::mir {
+
+void collect_successors(const BasicBlock& bb, std::vector<BlockId>& succs) {
+    if (!bb.terminator)
+        return;
+
+    switch (bb.terminator->kind) {
+        case MirTerminator::Goto:
+            succs.push_back(std::get<MirTerminator::GotoData>(bb.terminator->data).target);
+            break;
+        case MirTerminator::SwitchInt: {
+            auto& data = std::get<MirTerminator::SwitchIntData>(bb.terminator->data);
+            succs.push_back(data.otherwise);
+            for (auto& pair : data.targets)
+                succs.push_back(pair.second);
+            break;
+        }
+        case MirTerminator::Call: {
+            auto& data = std::get<MirTerminator::CallData>(bb.terminator->data);
+            if (data.success != INVALID_BLOCK)
+                succs.push_back(data.success);
+            if (data.unwind && *data.unwind != INVALID_BLOCK)
+                succs.push_back(*data.unwind);
+            break;
+        }
+        case MirTerminator::Return:
+        case MirTerminator::Unreachable:
+            break;
+    }
+}
+
+ControlFlowGraph::ControlFlowGraph(const MirFunction& f) {
+    const size_t n = f.basic_blocks.size();
+    succs.resize(n);
+    preds.resize(n);
+    rpo_index.assign(n, UNVISITED);
+
+    for (size_t i = 0; i < n; ++i) {
+        if (!f.basic_blocks[i])
+            continue;
+        auto& out = succs[i];
+        collect_successors(*f.basic_blocks[i], out);
+
+        // 範囲外・削除済みブロックへの辺は無視し、重複辺（同じ遷移先への複数case）をまとめる
+        out.erase(std::remove_if(out.begin(), out.end(),
+                                 [&](BlockId s) { return s >= n || !f.basic_blocks[s]; }),
+                  out.end());
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+
+        for (BlockId s : out) {
+            preds[s].push_back(static_cast<BlockId>(i));
+        }
+    }
+
+    if (n == 0 || !f.basic_blocks[0])
+        return;
+
+    // 反復DFSで後順を求める
+    std::vector<BlockId> post_order;
+    std::vector<char> visited(n, 0);
+    std::vector<std::pair<BlockId, size_t>> stack;
+    stack.push_back({0, 0});
+    visited[0] = 1;
+    while (!stack.empty()) {
+        auto& [b, next] = stack.back();
+        if (next < succs[b].size()) {
+            BlockId s = succs[b][next++];
+            if (!visited[s]) {
+                visited[s] = 1;
+                stack.push_back({s, 0});
+            }
+        } else {
+            post_order.push_back(b);
+            stack.pop_back();
+        }
+    }
+
+    rpo.assign(post_order.rbegin(), post_order.rend());
+    for (size_t i = 0; i < rpo.size(); ++i) {
+        rpo_index[rpo[i]] = static_cast<uint32_t>(i);
+    }
+}
+
+}  // namespace cm::mir
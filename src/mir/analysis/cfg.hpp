@@ -0,0 +1,44 @@
+#pragma once
+
+#include "mir/nodes.hpp"
+
+#include <limits>
+#include <vector>
+
+namespace cm::mir {
+
+// 終端命令の遷移先を列挙（Goto / SwitchInt / Call の success・unwind）
+void collect_successors(const BasicBlock& bb, std::vector<BlockId>& succs);
+
+// 関数のCFGを密なベクタで保持する（ブロックIDで直接引ける）
+// BasicBlock::successors/predecessors はパスが更新しない場合があるため、終端命令から再構築する
+class ControlFlowGraph {
+   public:
+    explicit ControlFlowGraph(const MirFunction& f);
+
+    size_t size() const { return succs.size(); }
+
+    const std::vector<BlockId>& successors(BlockId b) const { return succs[b]; }
+    const std::vector<BlockId>& predecessors(BlockId b) const { return preds[b]; }
+
+    const std::vector<std::vector<BlockId>>& successor_lists() const { return succs; }
+    const std::vector<std::vector<BlockId>>& predecessor_lists() const { return preds; }
+
+    // entryから到達可能か
+    bool is_reachable(BlockId b) const { return b < rpo_index.size() && rpo_index[b] != UNVISITED; }
+
+    // 到達可能ブロックの逆後順（entryが先頭）
+    const std::vector<BlockId>& reverse_post_order() const { return rpo; }
+
+    // 逆後順での位置（到達不能ブロックはUNVISITED）
+    static constexpr uint32_t UNVISITED = std::numeric_limits<uint32_t>::max();
+    uint32_t rpo_number(BlockId b) const { return rpo_index[b]; }
+
+   private:
+    std::vector<std::vector<BlockId>> succs;
+    std::vector<std::vector<BlockId>> preds;
+    std::vector<BlockId> rpo;
+    std::vector<uint32_t> rpo_index;
+};
+
+}  // namespace cm::mir
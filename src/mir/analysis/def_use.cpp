@@ -0,0 +1,208 @@
+#include "def_use.hpp"
+
+namespace cm::mir {
+
+namespace {
+
+void collect_projection_uses(const MirPlace& place, std::vector<LocalId>& uses) {
+    for (const auto& proj : place.projections) {
+        if (proj.kind == ProjectionKind::Index) {
+            uses.push_back(proj.index_local);
+        }
+    }
+}
+
+void collect_place_read(const MirPlace& place, std::vector<LocalId>& uses) {
+    uses.push_back(place.local);
+    collect_projection_uses(place, uses);
+}
+
+// 代入先: 射影なしなら定義のみ、射影ありなら基底も読む（部分更新・ポインタ経由の書き込み）
+void collect_place_write_uses(const MirPlace& place, std::vector<LocalId>& uses) {
+    if (!place.projections.empty()) {
+        collect_place_read(place, uses);
+    }
+}
+
+void collect_operand_uses(const MirOperand& op, std::vector<LocalId>& uses) {
+    if (op.kind == MirOperand::Move || op.kind == MirOperand::Copy) {
+        collect_place_read(std::get<MirPlace>(op.data), uses);
+    }
+}
+
+void collect_rvalue_uses(const MirRvalue& rvalue, std::vector<LocalId>& uses) {
+    switch (rvalue.kind) {
+        case MirRvalue::Use: {
+            auto& data = std::get<MirRvalue::UseData>(rvalue.data);
+            if (data.operand)
+                collect_operand_uses(*data.operand, uses);
+            break;
+        }
+        case MirRvalue::BinaryOp: {
+            auto& data = std::get<MirRvalue::BinaryOpData>(rvalue.data);
+            if (data.lhs)
+                collect_operand_uses(*data.lhs, uses);
+            if (data.rhs)
+                collect_operand_uses(*data.rhs, uses);
+            break;
+        }
+        case MirRvalue::UnaryOp: {
+            auto& data = std::get<MirRvalue::UnaryOpData>(rvalue.data);
+            if (data.operand)
+                collect_operand_uses(*data.operand, uses);
+            break;
+        }
+        case MirRvalue::Ref: {
+            // アドレスを取られたローカルは使用として扱う
+            collect_place_read(std::get<MirRvalue::RefData>(rvalue.data).place, uses);
+            break;
+        }
+        case MirRvalue::Aggregate: {
+            for (const auto& op : std::get<MirRvalue::AggregateData>(rvalue.data).operands) {
+                if (op)
+                    collect_operand_uses(*op, uses);
+            }
+            break;
+        }
+        case MirRvalue::Cast: {
+            auto& data = std::get<MirRvalue::CastData>(rvalue.data);
+            if (data.operand)
+                collect_operand_uses(*data.operand, uses);
+            break;
+        }
+        case MirRvalue::FormatConvert: {
+            auto& data = std::get<MirRvalue::FormatConvertData>(rvalue.data);
+            if (data.operand)
+                collect_operand_uses(*data.operand, uses);
+            break;
+        }
+    }
+}
+
+}  // namespace
+
+void collect_uses(const MirStatement& stmt, std::vector<LocalId>& uses) {
+    switch (stmt.kind) {
+        case MirStatement::Assign: {
+            auto& data = std::get<MirStatement::AssignData>(stmt.data);
+            if (data.rvalue)
+                collect_rvalue_uses(*data.rvalue, uses);
+            collect_place_write_uses(data.place, uses);
+            break;
+        }
+        case MirStatement::Asm: {
+            // 出力専用（=）以外のオペランドは読まれる
+            for (const auto& operand : std::get<MirStatement::AsmData>(stmt.data).operands) {
+                if (!operand.is_constant &&
+                    (operand.constraint.empty() || operand.constraint[0] != '=')) {
+                    uses.push_back(operand.local_id);
+                }
+            }
+            break;
+        }
+        case MirStatement::StorageLive:
+        case MirStatement::StorageDead:
+        case MirStatement::Nop:
+            break;
+    }
+}
+
+void collect_uses(const MirTerminator& term, std::vector<LocalId>& uses) {
+    switch (term.kind) {
+        case MirTerminator::SwitchInt: {
+            auto& data = std::get<MirTerminator::SwitchIntData>(term.data);
+            if (data.discriminant)
+                collect_operand_uses(*data.discriminant, uses);
+            break;
+        }
+        case MirTerminator::Call: {
+            auto& data = std::get<MirTerminator::CallData>(term.data);
+            if (data.func)
+                collect_operand_uses(*data.func, uses);
+            for (const auto& arg : data.args) {
+                if (arg)
+                    collect_operand_uses(*arg, uses);
+            }
+            if (data.destination)
+                collect_place_write_uses(*data.destination, uses);
+            break;
+        }
+        case MirTerminator::Goto:
+        case MirTerminator::Return:
+        case MirTerminator::Unreachable:
+            break;
+    }
+}
+
+void collect_defs(const MirStatement& stmt, std::vector<LocalId>& defs) {
+    if (stmt.kind == MirStatement::Assign) {
+        auto& data = std::get<MirStatement::AssignData>(stmt.data);
+        if (data.place.projections.empty())
+            defs.push_back(data.place.local);
+    } else if (stmt.kind == MirStatement::Asm) {
+        for (const auto& operand : std::get<MirStatement::AsmData>(stmt.data).operands) {
+            if (!operand.is_constant && !operand.constraint.empty() &&
+                (operand.constraint[0] == '=' || operand.constraint[0] == '+')) {
+                defs.push_back(operand.local_id);
+            }
+        }
+    }
+}
+
+void collect_defs(const MirTerminator& term, std::vector<LocalId>& defs) {
+    if (term.kind == MirTerminator::Call) {
+        auto& data = std::get<MirTerminator::CallData>(term.data);
+        if (data.destination && data.destination->projections.empty())
+            defs.push_back(data.destination->local);
+    }
+}
+
+DefUseChains::DefUseChains(const MirFunction& f) {
+    def_sites.resize(f.locals.size());
+    use_sites.resize(f.locals.size());
+
+    std::vector<LocalId> scratch;
+    auto record = [&](std::vector<std::vector<InstructionSite>>& sites, InstructionSite site) {
+        for (LocalId local : scratch) {
+            if (local >= sites.size())
+                sites.resize(local + 1);
+            sites[local].push_back(site);
+        }
+        scratch.clear();
+    };
+
+    for (BlockId b = 0; b < f.basic_blocks.size(); ++b) {
+        if (!f.basic_blocks[b])
+            continue;
+        const auto& bb = *f.basic_blocks[b];
+        for (uint32_t i = 0; i < bb.statements.size(); ++i) {
+            if (!bb.statements[i])
+                continue;
+            collect_uses(*bb.statements[i], scratch);
+            record(use_sites, {b, i});
+            collect_defs(*bb.statements[i], scratch);
+            record(def_sites, {b, i});
+        }
+        if (bb.terminator) {
+            collect_uses(*bb.terminator, scratch);
+            // Returnは戻り値ローカルを読む
+            if (bb.terminator->kind == MirTerminator::Return)
+                scratch.push_back(f.return_local);
+            record(use_sites, {b, InstructionSite::TERMINATOR});
+            collect_defs(*bb.terminator, scratch);
+            record(def_sites, {b, InstructionSite::TERMINATOR});
+        }
+    }
+}
+
+const std::vector<InstructionSite>& DefUseChains::defs(LocalId local) const {
+    static const std::vector<InstructionSite> empty;
+    return local < def_sites.size() ? def_sites[local] : empty;
+}
+
+const std::vector<InstructionSite>& DefUseChains::uses(LocalId local) const {
+    static const std::vector<InstructionSite> empty;
+    return local < use_sites.size() ? use_sites[local] : empty;
+}
+
+}  // namespace cm::mir
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "mir/nodes.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace cm::mir {
+
+// 文・終端命令が読むローカル変数を収集
+// 射影付きの代入先（フィールド・インデックス・デリファレンス）は基底ローカルの使用として扱う
+void collect_uses(const MirStatement& stmt, std::vector<LocalId>& uses);
+void collect_uses(const MirTerminator& term, std::vector<LocalId>& uses);
+
+// 文・終端命令が値全体を上書きするローカル変数を収集
+// （射影なしの代入先、asmの出力オペランド、Callの戻り値格納先）
+void collect_defs(const MirStatement& stmt, std::vector<LocalId>& defs);
+void collect_defs(const MirTerminator& term, std::vector<LocalId>& defs);
+
+// 定義・使用の位置（index == TERMINATOR なら終端命令）
+struct InstructionSite {
+    static constexpr uint32_t TERMINATOR = std::numeric_limits<uint32_t>::max();
+
+    BlockId block;
+    uint32_t index;
+
+    bool is_terminator() const { return index == TERMINATOR; }
+};
+
+// ローカル変数ごとの定義・使用位置（def-use / use-def チェーン）
+class DefUseChains {
+   public:
+    explicit DefUseChains(const MirFunction& f);
+
+    const std::vector<InstructionSite>& defs(LocalId local) const;
+    const std::vector<InstructionSite>& uses(LocalId local) const;
+
+    // 定義が1箇所だけか（SSA的に扱えるローカル）
+    bool has_single_def(LocalId local) const { return defs(local).size() == 1; }
+
+   private:
+    std::vector<std::vector<InstructionSite>> def_sites;
+    std::vector<std::vector<InstructionSite>> use_sites;
+};
+
+}  // namespace cm::mir
@@ -1,191 +1,149 @@
 #include "dominators.hpp"
 
 #include <algorithm>
-#include <queue>
 
 namespace cm::mir {
 
-DominatorTree::DominatorTree(const MirFunction& f) : func(f) {
-    compute();
-}
-
-bool DominatorTree::dominates(BlockId a, BlockId b) const {
+bool DominatorTreeBase::dominates(BlockId a, BlockId b) const {
     if (a == b)
         return true;
 
-    // entryは全てを支配する
-    if (a == 0 && reachable.count(b))
-        return true;
-
     // 到達不能ブロックは考慮しない
-    if (!reachable.count(a) || !reachable.count(b))
+    if (!in_tree(a) || !in_tree(b))
         return false;
 
-    auto it = dom_sets.find(b);
-    if (it != dom_sets.end()) {
-        return it->second.count(a) > 0;
-    }
-    return false;
+    return pre_order[a] <= pre_order[b] && post_order[b] <= post_order[a];
 }
 
-std::optional<BlockId> DominatorTree::get_idom(BlockId b) const {
-    auto it = idoms.find(b);
-    if (it != idoms.end()) {
-        return it->second;
+std::optional<BlockId> DominatorTreeBase::get_idom(BlockId b) const {
+    if (b >= idoms.size() || idoms[b] == INVALID_BLOCK || idoms[b] >= num_real_blocks) {
+        return std::nullopt;
     }
-    return std::nullopt;
+    return idoms[b];
 }
 
-void DominatorTree::compute() {
-    if (func.basic_blocks.empty())
+void DominatorTreeBase::build(const std::vector<std::vector<BlockId>>& succs,
+                              const std::vector<std::vector<BlockId>>& preds, BlockId root,
+                              size_t num_blocks) {
+    const size_t n = succs.size();
+    num_real_blocks = num_blocks;
+    idoms.assign(n, INVALID_BLOCK);
+    tree_children.assign(n, {});
+    pre_order.assign(n, UNNUMBERED);
+    post_order.assign(n, UNNUMBERED);
+    if (root >= n)
         return;
 
-    // 到達可能ブロックを特定（CFGトラバーサル）
-    std::queue<BlockId> q;
-    q.push(0);  // entry
-    reachable.insert(0);
-
-    while (!q.empty()) {
-        BlockId curr = q.front();
-        q.pop();
-
-        if (curr >= func.basic_blocks.size() || !func.basic_blocks[curr])
-            continue;
-
-        const auto& bb = *func.basic_blocks[curr];
-        if (bb.terminator) {
-            std::vector<BlockId> succs;
-            switch (bb.terminator->kind) {
-                case MirTerminator::Goto:
-                    succs.push_back(std::get<MirTerminator::GotoData>(bb.terminator->data).target);
-                    break;
-                case MirTerminator::SwitchInt: {
-                    auto& data = std::get<MirTerminator::SwitchIntData>(bb.terminator->data);
-                    succs.push_back(data.otherwise);
-                    for (auto& pair : data.targets)
-                        succs.push_back(pair.second);
-                    break;
-                }
-                case MirTerminator::Call: {
-                    auto& data = std::get<MirTerminator::CallData>(bb.terminator->data);
-                    if (data.success != INVALID_BLOCK)
-                        succs.push_back(data.success);
-                    break;
-                }
-                case MirTerminator::Return:
-                case MirTerminator::Unreachable:
-                    break;
-            }
-
-            for (BlockId s : succs) {
-                if (reachable.find(s) == reachable.end()) {
-                    reachable.insert(s);
-                    q.push(s);
+    // 1. 逆後順の番号付け（反復DFS）
+    std::vector<uint32_t> rpo_number(n, UNNUMBERED);
+    std::vector<BlockId> order;
+    {
+        std::vector<char> visited(n, 0);
+        std::vector<std::pair<BlockId, size_t>> stack;
+        stack.push_back({root, 0});
+        visited[root] = 1;
+        while (!stack.empty()) {
+            auto& [b, next] = stack.back();
+            if (next < succs[b].size()) {
+                BlockId s = succs[b][next++];
+                if (!visited[s]) {
+                    visited[s] = 1;
+                    stack.push_back({s, 0});
                 }
+            } else {
+                order.push_back(b);
+                stack.pop_back();
             }
         }
     }
+    std::reverse(order.begin(), order.end());
+    for (size_t i = 0; i < order.size(); ++i) {
+        rpo_number[order[i]] = static_cast<uint32_t>(i);
+    }
 
-    // 全ブロックの集合（到達可能のみ）
-    std::set<BlockId> all_blocks = reachable;
-
-    // 初期化: Dom(n0) = {n0}, Dom(n) = All for n != n0
-    dom_sets[0] = {0};
-    for (BlockId b : all_blocks) {
-        if (b != 0) {
-            dom_sets[b] = all_blocks;
+    // 2. 即時支配ノードを逆後順番号で反復計算
+    //    intersect は番号の大きい方を idom へ辿って合流点を求める
+    std::vector<uint32_t> idom(order.size(), UNNUMBERED);
+    idom[0] = 0;
+    auto intersect = [&](uint32_t a, uint32_t b) {
+        while (a != b) {
+            while (a > b)
+                a = idom[a];
+            while (b > a)
+                b = idom[b];
         }
-    }
+        return a;
+    };
 
-    // 反復計算
     bool changed = true;
     while (changed) {
         changed = false;
-        for (BlockId b : all_blocks) {
-            if (b == 0)
-                continue;
-
-            // bへのPredecessorを探す
-            std::vector<BlockId> preds;
-            for (BlockId p : all_blocks) {
-                if (p >= func.basic_blocks.size() || !func.basic_blocks[p])
+        for (uint32_t i = 1; i < order.size(); ++i) {
+            uint32_t new_idom = UNNUMBERED;
+            for (BlockId p : preds[order[i]]) {
+                uint32_t pn = rpo_number[p];
+                if (pn == UNNUMBERED || idom[pn] == UNNUMBERED)
                     continue;
-                const auto& p_bb = *func.basic_blocks[p];
-                if (!p_bb.terminator)
-                    continue;
-
-                bool is_pred = false;
-                switch (p_bb.terminator->kind) {
-                    case MirTerminator::Goto:
-                        if (std::get<MirTerminator::GotoData>(p_bb.terminator->data).target == b)
-                            is_pred = true;
-                        break;
-                    case MirTerminator::SwitchInt: {
-                        auto& data = std::get<MirTerminator::SwitchIntData>(p_bb.terminator->data);
-                        if (data.otherwise == b)
-                            is_pred = true;
-                        for (auto& pair : data.targets)
-                            if (pair.second == b)
-                                is_pred = true;
-                        break;
-                    }
-                    case MirTerminator::Call: {
-                        auto& data = std::get<MirTerminator::CallData>(p_bb.terminator->data);
-                        if (data.success == b)
-                            is_pred = true;
-                        break;
-                    }
-                    default:
-                        break;
-                }
-                if (is_pred)
-                    preds.push_back(p);
-            }
-
-            if (preds.empty())
-                continue;
-
-            // Intersection計算
-            std::set<BlockId> new_dom = dom_sets[preds[0]];
-            for (size_t i = 1; i < preds.size(); ++i) {
-                std::set<BlockId> intersection;
-                const auto& p_dom = dom_sets[preds[i]];
-                std::set_intersection(new_dom.begin(), new_dom.end(), p_dom.begin(), p_dom.end(),
-                                      std::inserter(intersection, intersection.begin()));
-                new_dom = intersection;
+                new_idom = new_idom == UNNUMBERED ? pn : intersect(pn, new_idom);
             }
-
-            new_dom.insert(b);
-
-            if (dom_sets[b] != new_dom) {
-                dom_sets[b] = new_dom;
+            if (new_idom != UNNUMBERED && idom[i] != new_idom) {
+                idom[i] = new_idom;
                 changed = true;
             }
         }
     }
 
-    // Immediate Dominator (idom) の計算
-    for (BlockId b : all_blocks) {
-        if (b == 0)
+    for (uint32_t i = 1; i < order.size(); ++i) {
+        if (idom[i] == UNNUMBERED)
             continue;
+        BlockId parent = order[idom[i]];
+        idoms[order[i]] = parent;
+        tree_children[parent].push_back(order[i]);
+    }
 
-        std::set<BlockId> strict_doms = dom_sets[b];
-        strict_doms.erase(b);
+    // 3. 支配木の前順・後順番号（dominates を区間包含で判定するため）
+    uint32_t counter = 0;
+    std::vector<std::pair<BlockId, size_t>> stack;
+    stack.push_back({root, 0});
+    pre_order[root] = counter++;
+    while (!stack.empty()) {
+        auto& [b, next] = stack.back();
+        if (next < tree_children[b].size()) {
+            BlockId c = tree_children[b][next++];
+            pre_order[c] = counter++;
+            stack.push_back({c, 0});
+        } else {
+            post_order[b] = counter++;
+            stack.pop_back();
+        }
+    }
+}
 
-        if (strict_doms.empty())
-            continue;
+DominatorTree::DominatorTree(const MirFunction& f) : graph(f) {
+    if (graph.size() == 0 || !f.basic_blocks[0])
+        return;
+    build(graph.successor_lists(), graph.predecessor_lists(), 0, graph.size());
+}
 
-        BlockId candidate = *strict_doms.begin();
-        size_t max_size = 0;
+PostDominatorTree::PostDominatorTree(const MirFunction& f) {
+    ControlFlowGraph graph(f);
+    const size_t n = graph.size();
+    if (n == 0)
+        return;
 
-        for (BlockId d : strict_doms) {
-            if (dom_sets[d].size() > max_size) {
-                max_size = dom_sets[d].size();
-                candidate = d;
-            }
+    // 逆CFG: ノード n を仮想出口とし、遷移先のない既存ブロックから出口へ辺を張る
+    const BlockId exit = static_cast<BlockId>(n);
+    std::vector<std::vector<BlockId>> succs(n + 1);
+    std::vector<std::vector<BlockId>> preds(n + 1);
+    for (BlockId b = 0; b < n; ++b) {
+        succs[b] = graph.predecessors(b);
+        preds[b] = graph.successors(b);
+        if (f.basic_blocks[b] && graph.successors(b).empty()) {
+            succs[exit].push_back(b);
+            preds[b].push_back(exit);
         }
-        idoms[b] = candidate;
     }
+    build(succs, preds, exit, n);
 }
 
 }  // namespace cm::mir
@@ -1,31 +1,61 @@
 #pragma once
 
+#include "mir/analysis/cfg.hpp"
 #include "mir/nodes.hpp"
 
-#include <map>
 #include <optional>
-#include <set>
 #include <vector>
 
 namespace cm::mir {
 
-class DominatorTree {
+// 支配木の共通表現（ブロックIDで引ける密なベクタ）
+// dominates() は支配木上の前順・後順番号の区間包含で O(1) 判定する
+class DominatorTreeBase {
    public:
-    explicit DominatorTree(const MirFunction& f);
-
-    // ブロック A が ブロック B を支配しているか
+    // ブロック A が ブロック B を支配しているか（到達不能ブロックは考慮しない）
     bool dominates(BlockId a, BlockId b) const;
 
-    // 即時支配ブロックを取得
+    // 即時支配ブロックを取得（根・到達不能ブロックはnullopt）
     std::optional<BlockId> get_idom(BlockId b) const;
 
+    // 支配木上の子
+    const std::vector<BlockId>& children(BlockId b) const { return tree_children[b]; }
+
+   protected:
+    // succs/predsは解析方向のグラフ（後支配木では逆辺）、rootから到達できるノードのみ木に入る
+    void build(const std::vector<std::vector<BlockId>>& succs,
+               const std::vector<std::vector<BlockId>>& preds, BlockId root, size_t num_blocks);
+
+    bool in_tree(BlockId b) const { return b < pre_order.size() && pre_order[b] != UNNUMBERED; }
+
+   private:
+    static constexpr uint32_t UNNUMBERED = std::numeric_limits<uint32_t>::max();
+
+    std::vector<BlockId> idoms;
+    std::vector<std::vector<BlockId>> tree_children;
+    std::vector<uint32_t> pre_order;
+    std::vector<uint32_t> post_order;
+    size_t num_real_blocks = 0;
+};
+
+// 支配木（Cooper-Harvey-Kennedy の反復アルゴリズム）
+class DominatorTree : public DominatorTreeBase {
+   public:
+    explicit DominatorTree(const MirFunction& f);
+
+    const ControlFlowGraph& cfg() const { return graph; }
+
+    bool is_reachable(BlockId b) const { return graph.is_reachable(b); }
+
    private:
-    const MirFunction& func;
-    std::set<BlockId> reachable;
-    std::map<BlockId, std::set<BlockId>> dom_sets;
-    std::map<BlockId, BlockId> idoms;
+    ControlFlowGraph graph;
+};
 
-    void compute();
+// 後支配木（Return/Unreachable ブロックを仮想出口に繋いだ逆CFG上の支配木）
+// 出口に到達できないブロック（無限ループ内など）は木に含まれない
+class PostDominatorTree : public DominatorTreeBase {
+   public:
+    explicit PostDominatorTree(const MirFunction& f);
 };
 
 }  // namespace cm::mir
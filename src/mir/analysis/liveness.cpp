@@ -0,0 +1,121 @@
+#include "liveness.hpp"
+
+#include "def_use.hpp"
+
+#include <bit>
+
+namespace cm::mir {
+
+LivenessAnalysis::LivenessAnalysis(const MirFunction& f) {
+    ControlFlowGraph cfg(f);
+    const size_t n = cfg.size();
+
+    // 使用されるローカルIDの最大値からビット幅を決める（locals外のIDにも耐える）
+    size_t num_locals = f.locals.size();
+    // 1. ブロックごとの gen（定義前の使用）と kill（定義）を求める
+    std::vector<LocalId> uses;
+    std::vector<LocalId> defs;
+    std::vector<std::pair<std::vector<LocalId>, std::vector<LocalId>>> per_block(n);
+    for (BlockId b = 0; b < n; ++b) {
+        if (!f.basic_blocks[b])
+            continue;
+        const auto& bb = *f.basic_blocks[b];
+        auto& [block_gen, block_kill] = per_block[b];
+        std::vector<char> killed;
+        auto visit = [&]() {
+            for (LocalId local : uses) {
+                if (local >= num_locals)
+                    num_locals = local + 1;
+                if (local >= killed.size() || !killed[local])
+                    block_gen.push_back(local);
+            }
+            for (LocalId local : defs) {
+                if (local >= num_locals)
+                    num_locals = local + 1;
+                if (local >= killed.size())
+                    killed.resize(local + 1, 0);
+                if (!killed[local]) {
+                    killed[local] = 1;
+                    block_kill.push_back(local);
+                }
+            }
+            uses.clear();
+            defs.clear();
+        };
+        for (const auto& stmt : bb.statements) {
+            if (!stmt)
+                continue;
+            collect_uses(*stmt, uses);
+            collect_defs(*stmt, defs);
+            visit();
+        }
+        if (bb.terminator) {
+            collect_uses(*bb.terminator, uses);
+            if (bb.terminator->kind == MirTerminator::Return)
+                uses.push_back(f.return_local);
+            collect_defs(*bb.terminator, defs);
+            visit();
+        }
+    }
+
+    num_words = (num_locals + 63) / 64;
+    std::vector<BitSet> gen(n);
+    std::vector<BitSet> kill(n);
+    auto set_bit = [](BitSet& set, LocalId local) { set[local >> 6] |= uint64_t{1} << (local & 63); };
+    for (BlockId b = 0; b < n; ++b) {
+        gen[b].assign(num_words, 0);
+        kill[b].assign(num_words, 0);
+        for (LocalId local : per_block[b].first)
+            set_bit(gen[b], local);
+        for (LocalId local : per_block[b].second)
+            set_bit(kill[b], local);
+    }
+
+    // 2. live_out(b) = ∪ live_in(succ)、live_in(b) = gen(b) ∪ (live_out(b) − kill(b))
+    //    後ろ向き解析なので逆後順の逆（後順）で反復する。到達不能ブロックも最後に処理する
+    live_in.assign(n, BitSet(num_words, 0));
+    live_out.assign(n, BitSet(num_words, 0));
+
+    std::vector<BlockId> order(cfg.reverse_post_order().rbegin(), cfg.reverse_post_order().rend());
+    for (BlockId b = 0; b < n; ++b) {
+        if (f.basic_blocks[b] && !cfg.is_reachable(b))
+            order.push_back(b);
+    }
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (BlockId b : order) {
+            BitSet& out = live_out[b];
+            for (BlockId s : cfg.successors(b)) {
+                for (size_t w = 0; w < num_words; ++w)
+                    out[w] |= live_in[s][w];
+            }
+            BitSet& in = live_in[b];
+            for (size_t w = 0; w < num_words; ++w) {
+                uint64_t next = gen[b][w] | (out[w] & ~kill[b][w]);
+                if (next != in[w]) {
+                    in[w] = next;
+                    changed = true;
+                }
+            }
+        }
+    }
+}
+
+std::vector<LocalId> LivenessAnalysis::live_out_locals(BlockId b) const {
+    std::vector<LocalId> result;
+    if (b >= live_out.size())
+        return result;
+    for (size_t w = 0; w < num_words; ++w) {
+        uint64_t bits = live_out[b][w];
+        while (bits) {
+            int bit = std::countr_zero(bits);
+            result.push_back(static_cast<LocalId>(w * 64 + bit));
+            bits &= bits - 1;
+        }
+    }
+    return result;
+}
+
+}  // namespace cm::mir
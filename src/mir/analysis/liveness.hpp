@@ -0,0 +1,38 @@
+#pragma once
+
+#include "mir/analysis/cfg.hpp"
+#include "mir/nodes.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace cm::mir {
+
+// ブロック境界での生存ローカル変数（後ろ向きデータフロー解析）
+// 集合はローカル数ビットの密なビットベクタで保持する
+class LivenessAnalysis {
+   public:
+    explicit LivenessAnalysis(const MirFunction& f);
+
+    // ブロック入口・出口で生存しているか
+    bool is_live_in(BlockId b, LocalId local) const { return test(live_in, b, local); }
+    bool is_live_out(BlockId b, LocalId local) const { return test(live_out, b, local); }
+
+    // ブロック出口で生存しているローカルの一覧
+    std::vector<LocalId> live_out_locals(BlockId b) const;
+
+   private:
+    using BitSet = std::vector<uint64_t>;
+
+    size_t num_words = 0;
+    std::vector<BitSet> live_in;
+    std::vector<BitSet> live_out;
+
+    static bool test(const std::vector<BitSet>& sets, BlockId b, LocalId local) {
+        if (b >= sets.size() || (local >> 6) >= sets[b].size())
+            return false;
+        return (sets[b][local >> 6] >> (local & 63)) & 1;
+    }
+};
+
+}  // namespace cm::mir
@@ -9,64 +9,30 @@ LoopAnalysis::LoopAnalysis(const MirFunction& f, const DominatorTree& d) : func(
 }
 
 Loop* LoopAnalysis::get_inner_most_loop(BlockId b) const {
-    auto it = block_to_loop.find(b);
-    if (it != block_to_loop.end()) {
-        return it->second;
-    }
-    return nullptr;
+    return b < block_to_loop.size() ? block_to_loop[b] : nullptr;
 }
 
 void LoopAnalysis::compute() {
     if (func.basic_blocks.empty())
         return;
 
+    const auto& cfg = dom_tree.cfg();
+    std::vector<Loop*> header_to_loop(cfg.size(), nullptr);
+
     // バックエッジを検出してループを特定
-    for (size_t i = 0; i < func.basic_blocks.size(); ++i) {
-        if (!func.basic_blocks[i])
+    for (BlockId i = 0; i < cfg.size(); ++i) {
+        if (!cfg.is_reachable(i))
             continue;
-        const auto& bb = *func.basic_blocks[i];
-
-        // Successorsを取得
-        std::vector<BlockId> succs;
-        if (bb.terminator) {
-            switch (bb.terminator->kind) {
-                case MirTerminator::Goto:
-                    succs.push_back(std::get<MirTerminator::GotoData>(bb.terminator->data).target);
-                    break;
-                case MirTerminator::SwitchInt: {
-                    auto& data = std::get<MirTerminator::SwitchIntData>(bb.terminator->data);
-                    succs.push_back(data.otherwise);
-                    for (auto& pair : data.targets)
-                        succs.push_back(pair.second);
-                    break;
-                }
-                case MirTerminator::Call: {
-                    auto& data = std::get<MirTerminator::CallData>(bb.terminator->data);
-                    if (data.success != INVALID_BLOCK)
-                        succs.push_back(data.success);
-                    break;
-                }
-                default:
-                    break;
-            }
-        }
-
-        for (BlockId h : succs) {
+        for (BlockId h : cfg.successors(i)) {
             if (dom_tree.dominates(h, i)) {
                 // Back-edge detected: i -> h
-                Loop* loop = nullptr;
-                for (auto& l : loops) {
-                    if (l->header == h) {
-                        loop = l.get();
-                        break;
-                    }
-                }
-
+                Loop* loop = header_to_loop[h];
                 if (!loop) {
                     loops.push_back(std::make_unique<Loop>());
                     loop = loops.back().get();
                     loop->header = h;
                     loop->blocks.insert(h);
+                    header_to_loop[h] = loop;
                 }
 
                 loop->back_edges.push_back(i);
@@ -85,6 +51,7 @@ void LoopAnalysis::populate_loop_body(Loop* loop, BlockId back_edge_node) {
 
     loop->blocks.insert(back_edge_node);
 
+    const auto& cfg = dom_tree.cfg();
     std::queue<BlockId> q;
     q.push(back_edge_node);
 
@@ -92,43 +59,8 @@ void LoopAnalysis::populate_loop_body(Loop* loop, BlockId back_edge_node) {
         BlockId m = q.front();
         q.pop();
 
-        for (size_t p = 0; p < func.basic_blocks.size(); ++p) {
-            if (!func.basic_blocks[p])
-                continue;
-            const auto& p_bb = *func.basic_blocks[p];
-            if (!p_bb.terminator)
-                continue;
-
-            if (loop->blocks.count(p))
-                continue;
-
-            bool is_pred = false;
-            switch (p_bb.terminator->kind) {
-                case MirTerminator::Goto:
-                    if (std::get<MirTerminator::GotoData>(p_bb.terminator->data).target == m)
-                        is_pred = true;
-                    break;
-                case MirTerminator::SwitchInt: {
-                    auto& data = std::get<MirTerminator::SwitchIntData>(p_bb.terminator->data);
-                    if (data.otherwise == m)
-                        is_pred = true;
-                    for (auto& pair : data.targets)
-                        if (pair.second == m)
-                            is_pred = true;
-                    break;
-                }
-                case MirTerminator::Call: {
-                    auto& data = std::get<MirTerminator::CallData>(p_bb.terminator->data);
-                    if (data.success == m)
-                        is_pred = true;
-                    break;
-                }
-                default:
-                    break;
-            }
-
-            if (is_pred) {
-                loop->blocks.insert(p);
+        for (BlockId p : cfg.predecessors(m)) {
+            if (loop->blocks.insert(p).second) {
                 q.push(p);
             }
         }
@@ -159,6 +91,7 @@ void LoopAnalysis::build_nesting_tree() {
     }
 
     // 各ブロックの最内ループを設定
+    block_to_loop.assign(func.basic_blocks.size(), nullptr);
     for (auto& loop : loops) {
         for (BlockId b : loop->blocks) {
             Loop* current = block_to_loop[b];
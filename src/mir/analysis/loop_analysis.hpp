@@ -3,7 +3,6 @@
 #include "mir/analysis/dominators.hpp"
 #include "mir/nodes.hpp"
 
-#include <map>
 #include <memory>
 #include <set>
 #include <vector>
@@ -40,7 +39,7 @@ class LoopAnalysis {
     const DominatorTree& dom_tree;
     std::vector<std::unique_ptr<Loop>> loops;
     std::vector<Loop*> top_level_loops;
-    std::map<BlockId, Loop*> block_to_loop;
+    std::vector<Loop*> block_to_loop;  // ブロック → 最内ループ
 
     void compute();
     void populate_loop_body(Loop* loop, BlockId back_edge_node);
@@ -35,10 +35,8 @@ void AutoImplGenerator::generate_builtin_clone_method(const hir::HirStruct& st)
 void AutoImplGenerator::generate_builtin_clone_method_for_monomorphized(const MirStruct& st) {
     std::string func_name = st.name + "__clone";
 
-    for (const auto& func : ctx_.program.functions) {
-        if (func && func->name == func_name)
-            return;
-    }
+    if (ctx_.program.find_function(func_name))
+        return;
 
     auto mir_func = std::make_unique<MirFunction>();
     mir_func->name = func_name;
@@ -62,145 +60,265 @@ void AutoImplGenerator::generate_builtin_clone_method_for_monomorphized(const Mi
 }
 
 // ============================================================
-// 組み込みHashメソッドの自動実装
+// 導出Hashの関数本体（非ジェネリック・モノモーフィゼーション版で共有）
 // ============================================================
-void AutoImplGenerator::generate_builtin_hash_method(const hir::HirStruct& st) {
-    std::string func_name = st.name + "__hash";
-
+std::unique_ptr<MirFunction> build_derived_hash_function(
+    const std::string& struct_name, const std::vector<hir::TypePtr>& field_types) {
     auto mir_func = std::make_unique<MirFunction>();
-    mir_func->name = func_name;
-
-    auto struct_type = hir::make_named(st.name);
+    mir_func->name = struct_name + "__hash";
     mir_func->return_local = mir_func->add_local("_0", hir::make_int(), true, false);
 
-    LocalId self_local = mir_func->add_local("self", struct_type, false, true);
+    LocalId self_local = mir_func->add_local("self", hir::make_named(struct_name), false, true);
     mir_func->arg_locals.push_back(self_local);
 
-    BlockId entry_block = mir_func->add_block();
-    auto* block = mir_func->get_block(entry_block);
-
-    if (st.fields.empty()) {
-        auto const_zero = std::make_unique<MirOperand>();
-        const_zero->kind = MirOperand::Constant;
-        MirConstant c;
-        c.value = int64_t(0);
-        c.type = hir::make_int();
-        const_zero->data = c;
-
-        block->statements.push_back(MirStatement::assign(MirPlace(mir_func->return_local),
-                                                         MirRvalue::use(std::move(const_zero))));
-    } else {
-        LocalId acc = mir_func->add_local("_hash_acc", hir::make_int(), true, false);
+    BlockId current_block = mir_func->add_block();
 
-        auto const_zero = std::make_unique<MirOperand>();
-        const_zero->kind = MirOperand::Constant;
+    auto constant = [](int64_t value, hir::TypePtr type) {
         MirConstant c;
-        c.value = int64_t(0);
-        c.type = hir::make_int();
-        const_zero->data = c;
-
-        block->statements.push_back(
-            MirStatement::assign(MirPlace(acc), MirRvalue::use(std::move(const_zero))));
-
-        for (size_t i = 0; i < st.fields.size(); ++i) {
-            const auto& field = st.fields[i];
-
-            LocalId field_val =
-                mir_func->add_local("_f" + std::to_string(i), field.type, true, false);
-            auto field_place = MirPlace(self_local, {PlaceProjection::field(i)});
-            block->statements.push_back(MirStatement::assign(
-                MirPlace(field_val), MirRvalue::use(MirOperand::copy(field_place))));
-
-            LocalId new_acc =
-                mir_func->add_local("_acc" + std::to_string(i), hir::make_int(), true, false);
-            block->statements.push_back(MirStatement::assign(
-                MirPlace(new_acc),
-                MirRvalue::binary(MirBinaryOp::Add, MirOperand::copy(MirPlace(acc)),
-                                  MirOperand::copy(MirPlace(field_val)))));
-            acc = new_acc;
+        c.value = value;
+        c.type = type;
+        return MirOperand::constant(c);
+    };
+    auto int_constant = [&](int64_t value) { return constant(value, hir::make_int()); };
+
+    auto emit = [&](LocalId dest, MirRvaluePtr rvalue) {
+        mir_func->get_block(current_block)
+            ->statements.push_back(MirStatement::assign(MirPlace(dest), std::move(rvalue)));
+    };
+    auto temp = [&](const std::string& name, hir::TypePtr type) {
+        return mir_func->add_local(name, type, true, false);
+    };
+    // current_blockを呼び出しで終え、続きのブロックへ移る
+    auto emit_call = [&](const std::string& callee, std::vector<MirOperandPtr> args,
+                         LocalId dest) {
+        BlockId next = mir_func->add_block();
+        auto term = std::make_unique<MirTerminator>();
+        term->kind = MirTerminator::Call;
+        term->data = MirTerminator::CallData{MirOperand::function_ref(callee),
+                                             std::move(args),
+                                             MirPlace(dest),
+                                             next,
+                                             std::nullopt,
+                                             "",
+                                             "",
+                                             false};
+        mir_func->get_block(current_block)->terminator = std::move(term);
+        current_block = next;
+    };
+
+    // 64bit値の上位・下位を畳み込んでintにする（long.hash() と同じ）
+    auto fold_64 = [&](LocalId value, hir::TypePtr type, const std::string& suffix) {
+        LocalId high = temp("_hi" + suffix, type);
+        emit(high, MirRvalue::binary(MirBinaryOp::Shr, MirOperand::copy(MirPlace(value)),
+                                     constant(32, type)));
+        LocalId folded = temp("_fold" + suffix, type);
+        emit(folded, MirRvalue::binary(MirBinaryOp::BitXor, MirOperand::copy(MirPlace(value)),
+                                       MirOperand::copy(MirPlace(high))));
+        LocalId result = temp("_h" + suffix, hir::make_int());
+        emit(result, MirRvalue::cast(MirOperand::copy(MirPlace(folded)), hir::make_int()));
+        return result;
+    };
+
+    // 文字列のFNV-1a（32bit、string.hash() と同じ）
+    auto hash_string = [&](LocalId str, const std::string& suffix) {
+        auto uint_type = hir::make_uint();
+        LocalId h = temp("_fnv" + suffix, uint_type);
+        emit(h, MirRvalue::use(constant(2166136261LL, uint_type)));
+        LocalId len = temp("_len" + suffix, uint_type);
+        std::vector<MirOperandPtr> len_args;
+        len_args.push_back(MirOperand::copy(MirPlace(str)));
+        emit_call("__builtin_string_len", std::move(len_args), len);
+        LocalId i = temp("_i" + suffix, hir::make_int());
+        emit(i, MirRvalue::use(int_constant(0)));
+
+        BlockId header = mir_func->add_block();
+        BlockId body = mir_func->add_block();
+        BlockId exit = mir_func->add_block();
+        mir_func->get_block(current_block)->terminator = MirTerminator::goto_block(header);
+
+        current_block = header;
+        LocalId i_uint = temp("_iu" + suffix, uint_type);
+        emit(i_uint, MirRvalue::cast(MirOperand::copy(MirPlace(i)), uint_type));
+        LocalId in_range = temp("_lt" + suffix, hir::make_bool());
+        emit(in_range, MirRvalue::binary(MirBinaryOp::Lt, MirOperand::copy(MirPlace(i_uint)),
+                                         MirOperand::copy(MirPlace(len))));
+        mir_func->get_block(current_block)->terminator =
+            MirTerminator::switch_int(MirOperand::copy(MirPlace(in_range)), {{1, body}}, exit);
+
+        current_block = body;
+        LocalId ch = temp("_ch" + suffix, hir::make_char());
+        std::vector<MirOperandPtr> char_args;
+        char_args.push_back(MirOperand::copy(MirPlace(str)));
+        char_args.push_back(MirOperand::copy(MirPlace(i)));
+        emit_call("__builtin_string_charAt", std::move(char_args), ch);
+        LocalId ch_int = temp("_chi" + suffix, hir::make_int());
+        emit(ch_int, MirRvalue::cast(MirOperand::copy(MirPlace(ch)), hir::make_int()));
+        LocalId byte = temp("_byte" + suffix, hir::make_int());
+        emit(byte, MirRvalue::binary(MirBinaryOp::BitAnd, MirOperand::copy(MirPlace(ch_int)),
+                                     int_constant(255)));
+        LocalId byte_uint = temp("_bu" + suffix, uint_type);
+        emit(byte_uint, MirRvalue::cast(MirOperand::copy(MirPlace(byte)), uint_type));
+        LocalId mixed = temp("_x" + suffix, uint_type);
+        emit(mixed, MirRvalue::binary(MirBinaryOp::BitXor, MirOperand::copy(MirPlace(h)),
+                                      MirOperand::copy(MirPlace(byte_uint))));
+        emit(h, MirRvalue::binary(MirBinaryOp::Mul, MirOperand::copy(MirPlace(mixed)),
+                                  constant(16777619, uint_type)));
+        emit(i, MirRvalue::binary(MirBinaryOp::Add, MirOperand::copy(MirPlace(i)),
+                                  int_constant(1)));
+        mir_func->get_block(current_block)->terminator = MirTerminator::goto_block(header);
+
+        current_block = exit;
+        LocalId result = temp("_h" + suffix, hir::make_int());
+        emit(result, MirRvalue::cast(MirOperand::copy(MirPlace(h)), hir::make_int()));
+        return result;
+    };
+
+    // 浮動小数点はビット列をハッシュする（-0.0は+0.0に正規化して == と一致させる）
+    auto hash_float = [&](LocalId value, const hir::TypePtr& type, const std::string& suffix) {
+        auto double_type = hir::make_double();
+        LocalId widened = temp("_d" + suffix, double_type);
+        if (type->kind == hir::TypeKind::Double || type->kind == hir::TypeKind::UDouble) {
+            emit(widened, MirRvalue::use(MirOperand::copy(MirPlace(value))));
+        } else {
+            emit(widened, MirRvalue::cast(MirOperand::copy(MirPlace(value)), double_type));
+        }
+        MirConstant zero;
+        zero.value = 0.0;
+        zero.type = double_type;
+        LocalId normalized = temp("_dn" + suffix, double_type);
+        emit(normalized, MirRvalue::binary(MirBinaryOp::Add, MirOperand::copy(MirPlace(widened)),
+                                           MirOperand::constant(zero)));
+
+        auto long_type = hir::make_long();
+        auto long_ptr = hir::make_pointer(long_type);
+        LocalId addr = temp("_dp" + suffix, hir::make_pointer(double_type));
+        emit(addr, MirRvalue::ref(MirPlace(normalized), false));
+        LocalId bits_addr = temp("_bp" + suffix, long_ptr);
+        emit(bits_addr, MirRvalue::cast(MirOperand::copy(MirPlace(addr)), long_ptr));
+        LocalId bits = temp("_bits" + suffix, long_type);
+        emit(bits, MirRvalue::use(MirOperand::copy(
+                       MirPlace(bits_addr, {PlaceProjection::deref(long_type, long_type)}))));
+        return fold_64(bits, long_type, suffix);
+    };
+
+    // フィールドがない場合は0
+    LocalId acc = mir_func->return_local;
+    if (!field_types.empty()) {
+        acc = temp("_hash_acc", hir::make_int());
+    }
+    emit(acc, MirRvalue::use(int_constant(0)));
+
+    for (size_t i = 0; i < field_types.size(); ++i) {
+        std::string suffix = std::to_string(i);
+        const auto& type = field_types[i];
+
+        LocalId field_val = temp("_f" + suffix, type);
+        auto field_place = MirPlace(self_local, {PlaceProjection::field(i)});
+        emit(field_val, MirRvalue::use(MirOperand::copy(field_place)));
+
+        // フィールド型ごとのハッシュ値（int）
+        std::optional<LocalId> field_hash;
+        switch (type ? type->kind : hir::TypeKind::Error) {
+            case hir::TypeKind::Bool:
+            case hir::TypeKind::Tiny:
+            case hir::TypeKind::Short:
+            case hir::TypeKind::Int:
+            case hir::TypeKind::UTiny:
+            case hir::TypeKind::UShort:
+            case hir::TypeKind::UInt:
+            case hir::TypeKind::Char: {
+                LocalId as_int = temp("_h" + suffix, hir::make_int());
+                emit(as_int, MirRvalue::cast(MirOperand::copy(MirPlace(field_val)),
+                                             hir::make_int()));
+                field_hash = as_int;
+                break;
+            }
+            case hir::TypeKind::Long:
+            case hir::TypeKind::ULong:
+            case hir::TypeKind::ISize:
+            case hir::TypeKind::USize:
+                field_hash = fold_64(field_val, type, suffix);
+                break;
+            case hir::TypeKind::Pointer: {
+                // ポインタはアドレスで比較されるため、アドレス値をハッシュする
+                LocalId addr = temp("_addr" + suffix, hir::make_ulong());
+                emit(addr, MirRvalue::cast(MirOperand::copy(MirPlace(field_val)),
+                                           hir::make_ulong()));
+                field_hash = fold_64(addr, hir::make_ulong(), suffix);
+                break;
+            }
+            case hir::TypeKind::Float:
+            case hir::TypeKind::Double:
+            case hir::TypeKind::UFloat:
+            case hir::TypeKind::UDouble:
+                field_hash = hash_float(field_val, type, suffix);
+                break;
+            case hir::TypeKind::String:
+                field_hash = hash_string(field_val, suffix);
+                break;
+            case hir::TypeKind::Struct: {
+                // ネストした構造体はその型の導出Hashを呼ぶ
+                LocalId nested = temp("_h" + suffix, hir::make_int());
+                std::vector<MirOperandPtr> args;
+                args.push_back(MirOperand::copy(MirPlace(field_val)));
+                emit_call(type->name + "__hash", std::move(args), nested);
+                field_hash = nested;
+                break;
+            }
+            default:
+                // 配列・ユニオン等は値としてハッシュできないため寄与させない（Eqとの整合は保つ）
+                break;
+        }
+        if (!field_hash) {
+            continue;
         }
 
-        block->statements.push_back(MirStatement::assign(
-            MirPlace(mir_func->return_local), MirRvalue::use(MirOperand::copy(MirPlace(acc)))));
+        // acc * 31 + field_hash
+        LocalId scaled = temp("_scaled" + suffix, hir::make_int());
+        emit(scaled, MirRvalue::binary(MirBinaryOp::Mul, MirOperand::copy(MirPlace(acc)),
+                                       int_constant(31)));
+        LocalId new_acc = temp("_acc" + suffix, hir::make_int());
+        emit(new_acc, MirRvalue::binary(MirBinaryOp::Add, MirOperand::copy(MirPlace(scaled)),
+                                        MirOperand::copy(MirPlace(*field_hash))));
+        acc = new_acc;
     }
 
-    block->terminator = MirTerminator::return_value();
+    if (acc != mir_func->return_local) {
+        emit(mir_func->return_local, MirRvalue::use(MirOperand::copy(MirPlace(acc))));
+    }
 
-    ctx_.impl_info[st.name]["Hash"] = func_name;
-    ctx_.program.functions.push_back(std::move(mir_func));
+    mir_func->get_block(current_block)->terminator = MirTerminator::return_value();
+    return mir_func;
 }
 
 // ============================================================
-// モノモーフィゼーション版Hash
+// 組み込みHashメソッドの自動実装
 // ============================================================
-void AutoImplGenerator::generate_builtin_hash_method_for_monomorphized(const MirStruct& st) {
-    std::string func_name = st.name + "__hash";
-
-    for (const auto& func : ctx_.program.functions) {
-        if (func && func->name == func_name)
-            return;
+void AutoImplGenerator::generate_builtin_hash_method(const hir::HirStruct& st) {
+    std::vector<hir::TypePtr> field_types;
+    for (const auto& field : st.fields) {
+        field_types.push_back(field.type);
     }
 
-    auto mir_func = std::make_unique<MirFunction>();
-    mir_func->name = func_name;
-
-    auto struct_type = hir::make_named(st.name);
-    mir_func->return_local = mir_func->add_local("_0", hir::make_int(), true, false);
-
-    LocalId self_local = mir_func->add_local("self", struct_type, false, true);
-    mir_func->arg_locals.push_back(self_local);
-
-    BlockId entry_block = mir_func->add_block();
-    auto* block = mir_func->get_block(entry_block);
-
-    if (st.fields.empty()) {
-        auto const_zero = std::make_unique<MirOperand>();
-        const_zero->kind = MirOperand::Constant;
-        MirConstant c;
-        c.value = int64_t(0);
-        c.type = hir::make_int();
-        const_zero->data = c;
-
-        block->statements.push_back(MirStatement::assign(MirPlace(mir_func->return_local),
-                                                         MirRvalue::use(std::move(const_zero))));
-    } else {
-        LocalId acc = mir_func->add_local("_hash_acc", hir::make_int(), true, false);
+    auto mir_func = build_derived_hash_function(st.name, field_types);
+    ctx_.impl_info[st.name]["Hash"] = mir_func->name;
+    ctx_.program.functions.push_back(std::move(mir_func));
+}
 
-        auto const_zero = std::make_unique<MirOperand>();
-        const_zero->kind = MirOperand::Constant;
-        MirConstant c;
-        c.value = int64_t(0);
-        c.type = hir::make_int();
-        const_zero->data = c;
-
-        block->statements.push_back(
-            MirStatement::assign(MirPlace(acc), MirRvalue::use(std::move(const_zero))));
-
-        for (size_t i = 0; i < st.fields.size(); ++i) {
-            const auto& field = st.fields[i];
-
-            LocalId field_val =
-                mir_func->add_local("_f" + std::to_string(i), field.type, true, false);
-            auto field_place = MirPlace(self_local, {PlaceProjection::field(i)});
-            block->statements.push_back(MirStatement::assign(
-                MirPlace(field_val), MirRvalue::use(MirOperand::copy(field_place))));
-
-            LocalId new_acc =
-                mir_func->add_local("_acc" + std::to_string(i), hir::make_int(), true, false);
-            block->statements.push_back(MirStatement::assign(
-                MirPlace(new_acc),
-                MirRvalue::binary(MirBinaryOp::Add, MirOperand::copy(MirPlace(acc)),
-                                  MirOperand::copy(MirPlace(field_val)))));
-            acc = new_acc;
-        }
+// ============================================================
+// モノモーフィゼーション版Hash
+// ============================================================
+void AutoImplGenerator::generate_builtin_hash_method_for_monomorphized(const MirStruct& st) {
+    if (ctx_.program.find_function(st.name + "__hash"))
+        return;
 
-        block->statements.push_back(MirStatement::assign(
-            MirPlace(mir_func->return_local), MirRvalue::use(MirOperand::copy(MirPlace(acc)))));
+    std::vector<hir::TypePtr> field_types;
+    for (const auto& field : st.fields) {
+        field_types.push_back(field.type);
     }
 
-    block->terminator = MirTerminator::return_value();
-
-    ctx_.impl_info[st.name]["Hash"] = func_name;
+    auto mir_func = build_derived_hash_function(st.name, field_types);
+    ctx_.impl_info[st.name]["Hash"] = mir_func->name;
     ctx_.program.functions.push_back(std::move(mir_func));
 }
 
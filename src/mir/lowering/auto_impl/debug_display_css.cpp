@@ -576,10 +576,8 @@ void AutoImplGenerator::generate_builtin_is_css_method(const hir::HirStruct& st)
 void AutoImplGenerator::generate_builtin_debug_method_for_monomorphized(const MirStruct& st) {
     std::string func_name = st.name + "__debug";
 
-    for (const auto& func : ctx_.program.functions) {
-        if (func && func->name == func_name)
-            return;
-    }
+    if (ctx_.program.find_function(func_name))
+        return;
 
     // 簡略化: モノモーフィ版はフィールドなし扱い
     auto mir_func = std::make_unique<MirFunction>();
@@ -615,10 +613,8 @@ void AutoImplGenerator::generate_builtin_debug_method_for_monomorphized(const Mi
 void AutoImplGenerator::generate_builtin_display_method_for_monomorphized(const MirStruct& st) {
     std::string func_name = st.name + "__toString";
 
-    for (const auto& func : ctx_.program.functions) {
-        if (func && func->name == func_name)
-            return;
-    }
+    if (ctx_.program.find_function(func_name))
+        return;
 
     auto mir_func = std::make_unique<MirFunction>();
     mir_func->name = func_name;
@@ -653,10 +649,8 @@ void AutoImplGenerator::generate_builtin_display_method_for_monomorphized(const
 void AutoImplGenerator::generate_builtin_css_method_for_monomorphized(const MirStruct& st) {
     std::string func_name = st.name + "__css";
 
-    for (const auto& func : ctx_.program.functions) {
-        if (func && func->name == func_name)
-            return;
-    }
+    if (ctx_.program.find_function(func_name))
+        return;
 
     auto mir_func = std::make_unique<MirFunction>();
     mir_func->name = func_name;
@@ -692,10 +686,8 @@ void AutoImplGenerator::generate_builtin_to_css_method_for_monomorphized(const M
     std::string func_name = st.name + "__to_css";
     std::string css_func_name = st.name + "__css";
 
-    for (const auto& func : ctx_.program.functions) {
-        if (func && func->name == func_name)
-            return;
-    }
+    if (ctx_.program.find_function(func_name))
+        return;
 
     auto mir_func = std::make_unique<MirFunction>();
     mir_func->name = func_name;
@@ -738,10 +730,8 @@ void AutoImplGenerator::generate_builtin_to_css_method_for_monomorphized(const M
 void AutoImplGenerator::generate_builtin_is_css_method_for_monomorphized(const MirStruct& st) {
     std::string func_name = st.name + "__isCss";
 
-    for (const auto& func : ctx_.program.functions) {
-        if (func && func->name == func_name)
-            return;
-    }
+    if (ctx_.program.find_function(func_name))
+        return;
 
     auto mir_func = std::make_unique<MirFunction>();
     mir_func->name = func_name;
@@ -93,10 +93,8 @@ void AutoImplGenerator::generate_builtin_eq_operator_for_monomorphized(const Mir
     std::string func_name = st.name + "__op_eq";
 
     // 既に生成されている場合はスキップ
-    for (const auto& func : ctx_.program.functions) {
-        if (func && func->name == func_name)
-            return;
-    }
+    if (ctx_.program.find_function(func_name))
+        return;
 
     auto mir_func = std::make_unique<MirFunction>();
     mir_func->name = func_name;
@@ -10,6 +10,13 @@
 
 namespace cm::mir {
 
+// 導出Hashの関数本体 `<struct_name>__hash(self) -> int` を生成する
+// 各フィールドをその型のハッシュ（文字列はFNV-1a、構造体は `<T>__hash`、64bit整数は
+// 上位・下位の畳み込み、浮動小数点はビット列）にし、acc = acc * 31 + hash で畳み込む
+// AutoImplGenerator と MirLowering の両方から使う
+std::unique_ptr<MirFunction> build_derived_hash_function(
+    const std::string& struct_name, const std::vector<hir::TypePtr>& field_types);
+
 // ============================================================
 // 自動実装生成器
 // with キーワードによる組み込みトレイト（Eq, Ord, Clone, Hash, Debug, Display, Css）
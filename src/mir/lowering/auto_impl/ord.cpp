@@ -117,10 +117,8 @@ void AutoImplGenerator::generate_builtin_lt_operator(const hir::HirStruct& st) {
 void AutoImplGenerator::generate_builtin_lt_operator_for_monomorphized(const MirStruct& st) {
     std::string func_name = st.name + "__op_lt";
 
-    for (const auto& func : ctx_.program.functions) {
-        if (func && func->name == func_name)
-            return;
-    }
+    if (ctx_.program.find_function(func_name))
+        return;
 
     auto mir_func = std::make_unique<MirFunction>();
     mir_func->name = func_name;
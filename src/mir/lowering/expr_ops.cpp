@@ -378,15 +378,15 @@ LocalId ExprLowering::lower_binary(const hir::HirBinary& bin, LoweringContext& c
                     LocalId result = ctx.new_temp(hir::make_bool());
                     BlockId success_block = ctx.new_block();
 
-                    // < と > では引数の順序を変える
+                    // > と <= では引数の順序を変える
                     // <= と >= では結果を反転する
                     std::vector<MirOperandPtr> args;
-                    if (bin.op == hir::HirBinaryOp::Lt || bin.op == hir::HirBinaryOp::Le) {
-                        // a < b または a <= b: __op_lt(a, b)
+                    if (bin.op == hir::HirBinaryOp::Lt || bin.op == hir::HirBinaryOp::Ge) {
+                        // a < b: __op_lt(a, b)、a >= b: !__op_lt(a, b)
                         args.push_back(MirOperand::copy(MirPlace{lhs}));
                         args.push_back(MirOperand::copy(MirPlace{rhs}));
                     } else {
-                        // a > b または a >= b: __op_lt(b, a)
+                        // a > b: __op_lt(b, a)、a <= b: !__op_lt(b, a)
                         args.push_back(MirOperand::copy(MirPlace{rhs}));
                         args.push_back(MirOperand::copy(MirPlace{lhs}));
                     }
@@ -145,6 +145,7 @@ std::unique_ptr<MirFunction> MirLowering::lower_function(const hir::HirFunction&
     mir_func->is_extern = func.is_extern;         // externフラグを設定
     mir_func->is_variadic = func.is_variadic;     // 可変長引数フラグを設定
     mir_func->is_async = func.is_async;           // asyncフラグを設定
+    mir_func->is_pure = func.is_pure;             // #[pure]フラグを設定
 
     // 戻り値用のローカル変数（typedefを解決）
     mir_func->return_local = 0;
@@ -4,9 +4,12 @@
 #include "lowering.hpp"
 
 #include "../../common/debug.hpp"
+#include "auto_impl/generator.hpp"
 
 #include <algorithm>
 #include <numeric>
+#include <type_traits>
+#include <unordered_set>
 
 namespace cm::mir {
 
@@ -61,6 +64,16 @@ MirProgram MirLowering::lower(const hir::HirProgram& hir_program) {
     // Pass 8: 高階関数呼び出しをクロージャ版に書き換え
     rewrite_hof_calls_for_closures();
 
+    if (cm::debug::g_debug_mode)
+        std::cerr << "[MIR] Pass 9: mark_pure_calls" << std::endl;
+    // Pass 9: #[pure] 関数の呼び出しに印を付ける（GVNの呼び出しCSE用）
+    mark_pure_calls();
+
+    if (cm::debug::g_debug_mode)
+        std::cerr << "[MIR] Pass 10: intern_types" << std::endl;
+    // Pass 10: 型を正規インスタンスに置き換える（以降、MIRの型は変更しない）
+    intern_types();
+
     if (cm::debug::g_debug_mode)
         std::cerr << "[MIR] All passes complete" << std::endl;
     // typedef定義をMirProgramにコピー（LLVM backendでTypeAlias解決に使用）
@@ -138,6 +151,142 @@ void MirLowering::rewrite_hof_calls_for_closures() {
     }
 }
 
+// #[pure] 関数の呼び出しに純粋フラグを付ける
+void MirLowering::mark_pure_calls() {
+    std::unordered_set<std::string> pure_functions;
+    for (const auto& func : mir_program.functions) {
+        if (func && func->is_pure) {
+            pure_functions.insert(func->name);
+        }
+    }
+    if (pure_functions.empty())
+        return;
+
+    for (auto& func : mir_program.functions) {
+        if (!func)
+            continue;
+
+        for (auto& block : func->basic_blocks) {
+            if (!block || !block->terminator || block->terminator->kind != MirTerminator::Call)
+                continue;
+
+            auto& call_data = std::get<MirTerminator::CallData>(block->terminator->data);
+            if (!call_data.func || call_data.is_virtual)
+                continue;
+
+            // 関数名はFunctionRefか文字列定数で保持される
+            const std::string* callee = nullptr;
+            if (call_data.func->kind == MirOperand::FunctionRef) {
+                callee = &std::get<std::string>(call_data.func->data);
+            } else if (call_data.func->kind == MirOperand::Constant) {
+                const auto& constant = std::get<MirConstant>(call_data.func->data);
+                callee = std::get_if<std::string>(&constant.value);
+            }
+            if (callee && pure_functions.count(*callee)) {
+                call_data.is_pure = true;
+            }
+        }
+    }
+}
+
+// MIR中の型を型インターナーの正規インスタンスに置き換える
+// 構造的に等しい型は1つのオブジェクトを共有する（型オブジェクトの重複を解消）
+void MirLowering::intern_types() {
+    auto& interner = hir::TypeInterner::instance();
+    auto intern = [&](hir::TypePtr& type) {
+        if (type)
+            type = interner.canonical(type);
+    };
+    auto intern_place = [&](MirPlace& place) {
+        intern(place.type);
+        intern(place.pointee_type);
+        for (auto& proj : place.projections) {
+            intern(proj.result_type);
+            intern(proj.pointee_type);
+        }
+    };
+    auto intern_operand = [&](MirOperand* op) {
+        if (!op)
+            return;
+        intern(op->type);
+        if (auto* place = std::get_if<MirPlace>(&op->data)) {
+            intern_place(*place);
+        } else if (auto* constant = std::get_if<MirConstant>(&op->data)) {
+            intern(constant->type);
+        }
+    };
+
+    for (auto& func : mir_program.functions) {
+        if (!func)
+            continue;
+        for (auto& local : func->locals) {
+            intern(local.type);
+        }
+
+        for (auto& block : func->basic_blocks) {
+            if (!block)
+                continue;
+            for (auto& stmt : block->statements) {
+                if (!stmt || stmt->kind != MirStatement::Assign)
+                    continue;
+                auto& data = std::get<MirStatement::AssignData>(stmt->data);
+                intern_place(data.place);
+                if (!data.rvalue)
+                    continue;
+                std::visit(
+                    [&](auto& rv) {
+                        using T = std::decay_t<decltype(rv)>;
+                        if constexpr (std::is_same_v<T, MirRvalue::UseData> ||
+                                      std::is_same_v<T, MirRvalue::UnaryOpData> ||
+                                      std::is_same_v<T, MirRvalue::FormatConvertData>) {
+                            intern_operand(rv.operand.get());
+                        } else if constexpr (std::is_same_v<T, MirRvalue::BinaryOpData>) {
+                            intern_operand(rv.lhs.get());
+                            intern_operand(rv.rhs.get());
+                            intern(rv.result_type);
+                        } else if constexpr (std::is_same_v<T, MirRvalue::RefData>) {
+                            intern_place(rv.place);
+                        } else if constexpr (std::is_same_v<T, MirRvalue::AggregateData>) {
+                            intern(rv.kind.ty);
+                            for (auto& op : rv.operands)
+                                intern_operand(op.get());
+                        } else if constexpr (std::is_same_v<T, MirRvalue::CastData>) {
+                            intern_operand(rv.operand.get());
+                            intern(rv.target_type);
+                        }
+                    },
+                    data.rvalue->data);
+            }
+
+            if (!block->terminator)
+                continue;
+            if (block->terminator->kind == MirTerminator::SwitchInt) {
+                auto& data = std::get<MirTerminator::SwitchIntData>(block->terminator->data);
+                intern_operand(data.discriminant.get());
+            } else if (block->terminator->kind == MirTerminator::Call) {
+                auto& data = std::get<MirTerminator::CallData>(block->terminator->data);
+                intern_operand(data.func.get());
+                for (auto& arg : data.args)
+                    intern_operand(arg.get());
+                if (data.destination)
+                    intern_place(*data.destination);
+            }
+        }
+    }
+
+    for (auto& st : mir_program.structs) {
+        if (!st)
+            continue;
+        for (auto& field : st->fields) {
+            intern(field.type);
+        }
+    }
+    for (auto& global : mir_program.global_vars) {
+        if (global)
+            intern(global->type);
+    }
+}
+
 // クロージャ情報を代入先変数に伝播（固定点まで繰り返し）
 void MirLowering::propagate_closure_info() {
     bool changed = true;
@@ -516,22 +665,14 @@ void MirLowering::generate_builtin_eq_operator_for_monomorphized(const MirStruct
     std::string func_name = st.name + "__op_eq";
 
     // 既に生成されている場合はスキップ
-    for (const auto& func : mir_program.functions) {
-        if (func && func->name == func_name)
-            return;
-    }
+    if (mir_program.find_function(func_name))
+        return;
 
     // ネストしたstruct型フィールドの比較関数を先に生成（再帰的自動実装）
     for (const auto& field : st.fields) {
         if (field.type && field.type->kind == hir::TypeKind::Struct) {
             std::string nested_func_name = field.type->name + "__op_eq";
-            bool exists = false;
-            for (const auto& func : mir_program.functions) {
-                if (func && func->name == nested_func_name) {
-                    exists = true;
-                    break;
-                }
-            }
+            bool exists = mir_program.find_function(nested_func_name) != nullptr;
             if (!exists) {
                 for (const auto& mir_st : mir_program.structs) {
                     if (mir_st && mir_st->name == field.type->name) {
@@ -655,23 +796,15 @@ void MirLowering::generate_builtin_eq_operator_for_monomorphized(const MirStruct
 void MirLowering::generate_builtin_lt_operator_for_monomorphized(const MirStruct& st) {
     std::string func_name = st.name + "__op_lt";
 
-    for (const auto& func : mir_program.functions) {
-        if (func && func->name == func_name)
-            return;
-    }
+    if (mir_program.find_function(func_name))
+        return;
 
     // ネストしたstruct型フィールドの比較関数を先に生成（再帰的自動実装）
     for (const auto& field : st.fields) {
         if (field.type && field.type->kind == hir::TypeKind::Struct) {
             // そのstruct用の比較関数が既に存在するかチェック
             std::string nested_func_name = field.type->name + "__op_lt";
-            bool exists = false;
-            for (const auto& func : mir_program.functions) {
-                if (func && func->name == nested_func_name) {
-                    exists = true;
-                    break;
-                }
-            }
+            bool exists = mir_program.find_function(nested_func_name) != nullptr;
             if (!exists) {
                 // ネスト構造体のMirStructを取得して再帰生成
                 for (const auto& mir_st : mir_program.structs) {
@@ -845,10 +978,8 @@ void MirLowering::generate_builtin_lt_operator_for_monomorphized(const MirStruct
 void MirLowering::generate_builtin_clone_method_for_monomorphized(const MirStruct& st) {
     std::string func_name = st.name + "__clone";
 
-    for (const auto& func : mir_program.functions) {
-        if (func && func->name == func_name)
-            return;
-    }
+    if (mir_program.find_function(func_name))
+        return;
 
     auto mir_func = std::make_unique<MirFunction>();
     mir_func->name = func_name;
@@ -873,80 +1004,16 @@ void MirLowering::generate_builtin_clone_method_for_monomorphized(const MirStruc
 
 // モノモーフィゼーションされた構造体用のHashメソッドを生成
 void MirLowering::generate_builtin_hash_method_for_monomorphized(const MirStruct& st) {
-    std::string func_name = st.name + "__hash";
-
-    for (const auto& func : mir_program.functions) {
-        if (func && func->name == func_name)
-            return;
-    }
-
-    auto mir_func = std::make_unique<MirFunction>();
-    mir_func->name = func_name;
-
-    auto struct_type = hir::make_named(st.name);
-    mir_func->return_local = mir_func->add_local("_0", hir::make_int(), true, false);
-
-    LocalId self_local = mir_func->add_local("self", struct_type, false, true);
-    mir_func->arg_locals.push_back(self_local);
-
-    BlockId entry_block = mir_func->add_block();
-    auto* block = mir_func->get_block(entry_block);
-
-    if (st.fields.empty()) {
-        auto const_zero = std::make_unique<MirOperand>();
-        const_zero->kind = MirOperand::Constant;
-        MirConstant c;
-        c.value = int64_t(0);
-        c.type = hir::make_int();
-        const_zero->data = c;
-
-        block->statements.push_back(MirStatement::assign(MirPlace(mir_func->return_local),
-                                                         MirRvalue::use(std::move(const_zero))));
-    } else {
-        LocalId acc = mir_func->add_local("_hash_acc", hir::make_int(), true, false);
-
-        auto const_zero = std::make_unique<MirOperand>();
-        const_zero->kind = MirOperand::Constant;
-        MirConstant c_zero;
-        c_zero.value = int64_t(0);
-        c_zero.type = hir::make_int();
-        const_zero->data = c_zero;
-
-        block->statements.push_back(
-            MirStatement::assign(MirPlace(acc), MirRvalue::use(std::move(const_zero))));
-
-        for (size_t i = 0; i < st.fields.size(); ++i) {
-            const auto& field = st.fields[i];
-
-            // フィールド値を取得
-            LocalId field_val =
-                mir_func->add_local("_field" + std::to_string(i), field.type, true, false);
-            auto self_place = MirPlace(self_local, {PlaceProjection::field(i)});
-            block->statements.push_back(MirStatement::assign(
-                MirPlace(field_val), MirRvalue::use(MirOperand::copy(self_place))));
-
-            // フィールド値をint型の一時変数にコピー（プリミティブ型を想定、暗黙変換）
-            LocalId field_as_int =
-                mir_func->add_local("_f_int" + std::to_string(i), hir::make_int(), true, false);
-            block->statements.push_back(MirStatement::assign(
-                MirPlace(field_as_int), MirRvalue::use(MirOperand::copy(MirPlace(field_val)))));
-
-            LocalId new_acc =
-                mir_func->add_local("_new_acc" + std::to_string(i), hir::make_int(), true, false);
-            block->statements.push_back(MirStatement::assign(
-                MirPlace(new_acc),
-                MirRvalue::binary(MirBinaryOp::Add, MirOperand::copy(MirPlace(acc)),
-                                  MirOperand::copy(MirPlace(field_as_int)))));
-            acc = new_acc;
-        }
+    if (mir_program.find_function(st.name + "__hash"))
+        return;
 
-        block->statements.push_back(MirStatement::assign(
-            MirPlace(mir_func->return_local), MirRvalue::use(MirOperand::copy(MirPlace(acc)))));
+    std::vector<hir::TypePtr> field_types;
+    for (const auto& field : st.fields) {
+        field_types.push_back(field.type);
     }
 
-    block->terminator = MirTerminator::return_value();
-
-    impl_info[st.name]["Hash"] = func_name;
+    auto mir_func = build_derived_hash_function(st.name, field_types);
+    impl_info[st.name]["Hash"] = mir_func->name;
     mir_program.functions.push_back(std::move(mir_func));
 }
 
@@ -1090,8 +1157,11 @@ void MirLowering::rewrite_struct_comparison_operators() {
                 rhs_op->kind = bin_data.rhs->kind;
                 rhs_op->data = bin_data.rhs->data;
 
-                // > と >= は引数を入れ替え
-                if (bin_data.op == MirBinaryOp::Gt || bin_data.op == MirBinaryOp::Ge) {
+                // 文を切り詰めるとbin_dataも破棄されるので、演算子を先に取り出しておく
+                MirBinaryOp op = bin_data.op;
+
+                // a > b は b < a、a <= b は !(b < a) なので引数を入れ替える
+                if (op == MirBinaryOp::Gt || op == MirBinaryOp::Le) {
                     args.push_back(std::move(rhs_op));
                     args.push_back(std::move(lhs_op));
                 } else {
@@ -1116,7 +1186,7 @@ void MirLowering::rewrite_struct_comparison_operators() {
                 // 単純化のため、< と == を両方呼び出す必要がある
                 // 今回は < のみ使用して、<= は !( > ) として実装
 
-                if (bin_data.op == MirBinaryOp::Le || bin_data.op == MirBinaryOp::Ge) {
+                if (op == MirBinaryOp::Le || op == MirBinaryOp::Ge) {
                     // <= は !(a > b) = !(b < a)
                     // >= は !(a < b)
                     // 一時変数を作成して結果を反転
@@ -1375,13 +1445,7 @@ void MirLowering::generate_builtin_lt_operator(const hir::HirStruct& st) {
 
                 // ネスト構造体用の比較関数を先に生成（必要であれば）
                 std::string nested_func_name = field_op_lt;
-                bool exists = false;
-                for (const auto& func : mir_program.functions) {
-                    if (func && func->name == nested_func_name) {
-                        exists = true;
-                        break;
-                    }
-                }
+                bool exists = mir_program.find_function(nested_func_name) != nullptr;
                 if (!exists) {
                     // ネスト構造体のHirStructを取得して再帰生成
                     for (const auto& mir_st : mir_program.structs) {
@@ -1532,87 +1596,15 @@ void MirLowering::generate_builtin_clone_method(const hir::HirStruct& st) {
     mir_program.functions.push_back(std::move(mir_func));
 }
 
-// 組み込みHashメソッドの自動実装を生成
+// 組み込みHashメソッドの自動実装を生成（関数名: TypeName__hash）
 void MirLowering::generate_builtin_hash_method(const hir::HirStruct& st) {
-    // 関数名: TypeName__hash
-    std::string func_name = st.name + "__hash";
-
-    auto mir_func = std::make_unique<MirFunction>();
-    mir_func->name = func_name;
-
-    auto struct_type = hir::make_named(st.name);
-
-    // 戻り値: int (_0)
-    mir_func->return_local = mir_func->add_local("_0", hir::make_int(), true, false);
-
-    // 引数: self (値)
-    LocalId self_local = mir_func->add_local("self", struct_type, false, true);
-    mir_func->arg_locals.push_back(self_local);
-
-    // エントリブロックを作成
-    BlockId entry_block = mir_func->add_block();
-    auto* block = mir_func->get_block(entry_block);
-
-    // 簡略化実装: 各フィールドの値を足し合わせてハッシュとする
-    // TODO: より良いハッシュ関数の実装（FNV-1a等）
-
-    if (st.fields.empty()) {
-        // フィールドがない場合は0
-        auto const_zero = std::make_unique<MirOperand>();
-        const_zero->kind = MirOperand::Constant;
-        MirConstant c;
-        c.value = int64_t(0);
-        c.type = hir::make_int();
-        const_zero->data = c;
-
-        block->statements.push_back(MirStatement::assign(MirPlace(mir_func->return_local),
-                                                         MirRvalue::use(std::move(const_zero))));
-    } else {
-        // 各フィールドの値を加算
-        LocalId acc = mir_func->add_local("_hash_acc", hir::make_int(), true, false);
-
-        // 初期値 = 0
-        auto const_zero = std::make_unique<MirOperand>();
-        const_zero->kind = MirOperand::Constant;
-        MirConstant c;
-        c.value = int64_t(0);
-        c.type = hir::make_int();
-        const_zero->data = c;
-
-        block->statements.push_back(
-            MirStatement::assign(MirPlace(acc), MirRvalue::use(std::move(const_zero))));
-
-        for (size_t i = 0; i < st.fields.size(); ++i) {
-            const auto& field = st.fields[i];
-
-            // フィールド値を読み込み
-            LocalId field_val =
-                mir_func->add_local("_f" + std::to_string(i), field.type, true, false);
-            auto field_place = MirPlace(self_local, {PlaceProjection::field(i)});
-            block->statements.push_back(MirStatement::assign(
-                MirPlace(field_val), MirRvalue::use(MirOperand::copy(field_place))));
-
-            // acc += field_val (簡略化: intにキャスト)
-            // TODO: 型に応じたハッシュ計算
-            LocalId new_acc =
-                mir_func->add_local("_acc" + std::to_string(i), hir::make_int(), true, false);
-            block->statements.push_back(MirStatement::assign(
-                MirPlace(new_acc),
-                MirRvalue::binary(MirBinaryOp::Add, MirOperand::copy(MirPlace(acc)),
-                                  MirOperand::copy(MirPlace(field_val)))));
-            acc = new_acc;
-        }
-
-        block->statements.push_back(MirStatement::assign(
-            MirPlace(mir_func->return_local), MirRvalue::use(MirOperand::copy(MirPlace(acc)))));
+    std::vector<hir::TypePtr> field_types;
+    for (const auto& field : st.fields) {
+        field_types.push_back(field.type);
     }
 
-    block->terminator = MirTerminator::return_value();
-
-    // impl_info に登録
-    impl_info[st.name]["Hash"] = func_name;
-
-    // MIRプログラムに追加
+    auto mir_func = build_derived_hash_function(st.name, field_types);
+    impl_info[st.name]["Hash"] = mir_func->name;
     mir_program.functions.push_back(std::move(mir_func));
 }
 
@@ -1856,10 +1848,8 @@ void MirLowering::generate_builtin_is_css_method(const hir::HirStruct& st) {
 void MirLowering::generate_builtin_css_method_for_monomorphized(const MirStruct& st) {
     std::string func_name = st.name + "__css";
 
-    for (const auto& func : mir_program.functions) {
-        if (func && func->name == func_name)
-            return;
-    }
+    if (mir_program.find_function(func_name))
+        return;
 
     auto mir_func = std::make_unique<MirFunction>();
     mir_func->name = func_name;
@@ -2020,10 +2010,8 @@ void MirLowering::generate_builtin_to_css_method_for_monomorphized(const MirStru
     std::string func_name = st.name + "__to_css";
     std::string css_func_name = st.name + "__css";
 
-    for (const auto& func : mir_program.functions) {
-        if (func && func->name == func_name)
-            return;
-    }
+    if (mir_program.find_function(func_name))
+        return;
 
     auto mir_func = std::make_unique<MirFunction>();
     mir_func->name = func_name;
@@ -2062,10 +2050,8 @@ void MirLowering::generate_builtin_to_css_method_for_monomorphized(const MirStru
 void MirLowering::generate_builtin_is_css_method_for_monomorphized(const MirStruct& st) {
     std::string func_name = st.name + "__isCss";
 
-    for (const auto& func : mir_program.functions) {
-        if (func && func->name == func_name)
-            return;
-    }
+    if (mir_program.find_function(func_name))
+        return;
 
     auto mir_func = std::make_unique<MirFunction>();
     mir_func->name = func_name;
@@ -2430,10 +2416,8 @@ void MirLowering::generate_builtin_debug_method_for_monomorphized(const MirStruc
     std::string func_name = st.name + "__debug";
 
     // 既に生成されている場合はスキップ
-    for (const auto& func : mir_program.functions) {
-        if (func && func->name == func_name)
-            return;
-    }
+    if (mir_program.find_function(func_name))
+        return;
 
     auto mir_func = std::make_unique<MirFunction>();
     mir_func->name = func_name;
@@ -2597,10 +2581,8 @@ void MirLowering::generate_builtin_debug_method_for_monomorphized(const MirStruc
 void MirLowering::generate_builtin_display_method_for_monomorphized(const MirStruct& st) {
     std::string func_name = st.name + "__toString";
 
-    for (const auto& func : mir_program.functions) {
-        if (func && func->name == func_name)
-            return;
-    }
+    if (mir_program.find_function(func_name))
+        return;
 
     auto mir_func = std::make_unique<MirFunction>();
     mir_func->name = func_name;
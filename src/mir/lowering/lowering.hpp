@@ -45,6 +45,12 @@ class MirLowering : public MirLoweringBase {
     // クロージャ情報を代入先変数に伝播（固定点まで繰り返し）
     void propagate_closure_info();
 
+    // #[pure] 関数の呼び出しに純粋フラグを付ける
+    void mark_pure_calls();
+
+    // MIRの型を型インターナーの正規インスタンスに置き換える
+    void intern_types();
+
    private:
     // 宣言の登録
     void register_declarations(const hir::HirProgram& hir_program);
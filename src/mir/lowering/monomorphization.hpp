@@ -115,6 +115,7 @@ class Monomorphization : public MirLoweringBase {
 
     // 特殊化された型のサイズを計算
     int64_t calculate_specialized_type_size(const hir::TypePtr& type) const;
+    int64_t specialized_type_align(const hir::TypePtr& type) const;
 };
 
 }  // namespace cm::mir
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include "monomorphization.hpp"
 #include "monomorphization_utils.hpp"
 
+#include <algorithm>
+
 namespace cm::mir {
 
 // デバッグ出力用
@@ -808,13 +810,7 @@ void Monomorphization::generate_generic_specializations(
         debug_msg("MONO", "Generating specialization: " + specialized_name);
 
         // 元のMIR関数を検索
-        MirFunction* original_mir = nullptr;
-        for (auto& func : program.functions) {
-            if (func && func->name == func_name) {
-                original_mir = func.get();
-                break;
-            }
-        }
+        MirFunction* original_mir = program.find_function(func_name);
 
         if (!original_mir)
             continue;
@@ -1226,13 +1222,7 @@ void Monomorphization::generate_generic_specializations(
             std::string element_dtor_name = element_type + "__dtor";
 
             // 要素型にデストラクタが存在するかチェック
-            bool has_element_dtor = false;
-            for (const auto& func : program.functions) {
-                if (func && func->name == element_dtor_name) {
-                    has_element_dtor = true;
-                    break;
-                }
-            }
+            bool has_element_dtor = program.find_function(element_dtor_name) != nullptr;
 
             // デストラクタがある場合のみループを挿入
             if (has_element_dtor) {
@@ -1444,6 +1434,7 @@ void Monomorphization::cleanup_generic_functions(
         if (should_remove) {
             debug_msg("MONO", "Removing generic function: " + (*it)->name);
             it = program.functions.erase(it);
+            program.invalidate_function_index();
         } else {
             ++it;
         }
@@ -1862,7 +1853,7 @@ void Monomorphization::update_type_references(MirProgram& program) {
                 pos += 6;
             }
             debug_msg("MONO", "Normalized function name: " + func->name + " -> " + normalized);
-            func->name = normalized;
+            program.rename_function(*func, normalized);
         }
 
         // 関数内の呼び出しも正規化
@@ -2236,13 +2227,8 @@ void Monomorphization::rewrite_generic_calls(
                                         std::string specialized_dtor = actual_type + "__dtor";
 
                                         // MIRに特殊化デストラクタが存在するか確認
-                                        bool found = false;
-                                        for (const auto& mir_func : program.functions) {
-                                            if (mir_func && mir_func->name == specialized_dtor) {
-                                                found = true;
-                                                break;
-                                            }
-                                        }
+                                        bool found =
+                                            program.find_function(specialized_dtor) != nullptr;
 
                                         if (found && specialized_dtor != func_name) {
                                             debug_msg("MONO",
@@ -2313,13 +2299,7 @@ void Monomorphization::rewrite_generic_calls(
                     std::string direct_name = base_name + args_str + method_suffix;
 
                     // MIRに特殊化関数が存在するか確認
-                    bool found = false;
-                    for (const auto& mir_func : program.functions) {
-                        if (mir_func && mir_func->name == direct_name) {
-                            found = true;
-                            break;
-                        }
-                    }
+                    bool found = program.find_function(direct_name) != nullptr;
                     if (found) {
                         func_name = direct_name;
                         debug_msg("MONO", "Rewrote call (fallback) in " + func->name + ": " +
@@ -2734,8 +2714,18 @@ int64_t Monomorphization::calculate_specialized_type_size(const hir::TypePtr& ty
             return 8;
         case hir::TypeKind::Struct: {
             if (hir_struct_defs && hir_struct_defs->count(type->name)) {
+                // フィールドを順に配置し、アラインメントで詰め物を入れる
+                // ネストした構造体もその実サイズで数える（HashMapのエントリ確保に使われる）
                 const auto* st = hir_struct_defs->at(type->name);
-                int64_t size = static_cast<int64_t>(st->fields.size()) * 8;
+                int64_t size = 0;
+                int64_t align = 1;
+                for (const auto& field : st->fields) {
+                    int64_t field_size = calculate_specialized_type_size(field.type);
+                    int64_t field_align = specialized_type_align(field.type);
+                    size = (size + field_align - 1) / field_align * field_align + field_size;
+                    align = std::max(align, field_align);
+                }
+                size = (size + align - 1) / align * align;
                 return size > 0 ? size : 8;
             }
             if (type->name.find("__") != std::string::npos) {
@@ -2759,4 +2749,22 @@ int64_t Monomorphization::calculate_specialized_type_size(const hir::TypePtr& ty
     }
 }
 
+// 型のアラインメント（構造体はフィールドの最大値）
+int64_t Monomorphization::specialized_type_align(const hir::TypePtr& type) const {
+    if (!type)
+        return 8;
+    if (type->kind == hir::TypeKind::Struct && hir_struct_defs &&
+        hir_struct_defs->count(type->name)) {
+        int64_t align = 1;
+        for (const auto& field : hir_struct_defs->at(type->name)->fields) {
+            align = std::max(align, specialized_type_align(field.type));
+        }
+        return align;
+    }
+    if (type->kind == hir::TypeKind::Array && type->element_type) {
+        return specialized_type_align(type->element_type);
+    }
+    return std::min<int64_t>(std::max<int64_t>(calculate_specialized_type_size(type), 1), 8);
+}
+
 }  // namespace cm::mir
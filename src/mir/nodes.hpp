@@ -1,13 +1,17 @@
 #pragma once
 
+#include "../common/arena.hpp"
+#include "../common/ident.hpp"
 #include "../common/span.hpp"
 #include "../hir/types.hpp"
 
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <unordered_map>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -32,6 +36,10 @@ using MirTerminatorPtr = std::unique_ptr<MirTerminator>;
 using BasicBlockPtr = std::unique_ptr<BasicBlock>;
 using MirFunctionPtr = std::unique_ptr<MirFunction>;
 
+// MIRノード（Place・オペランド・右辺値・文・終端命令・基本ブロック）の割り当て先
+struct MirArenaTag;
+using MirArena = NodeArena<MirArenaTag>;
+
 // ============================================================
 // 基本型定義
 // ============================================================
@@ -111,6 +119,8 @@ struct PlaceProjection {
 };
 
 struct MirPlace {
+    CM_ARENA_NODE(MirArenaTag)
+
     LocalId local;
     std::vector<PlaceProjection> projections;
     hir::TypePtr type;          // このPlaceが示す値の型
@@ -148,6 +158,8 @@ struct MirConstant {
 };
 
 struct MirOperand {
+    CM_ARENA_NODE(MirArenaTag)
+
     enum Kind {
         Move,        // 所有権を移動
         Copy,        // 値をコピー
@@ -261,6 +273,8 @@ struct AggregateKind {
 };
 
 struct MirRvalue {
+    CM_ARENA_NODE(MirArenaTag)
+
     enum Kind {
         Use,            // オペランドの使用
         BinaryOp,       // 二項演算
@@ -365,6 +379,8 @@ struct MirRvalue {
 // Statement（文）
 // ============================================================
 struct MirStatement {
+    CM_ARENA_NODE(MirArenaTag)
+
     enum Kind {
         Assign,       // 代入: place = rvalue
         StorageLive,  // 変数の有効範囲開始
@@ -459,6 +475,8 @@ struct MirStatement {
 // Terminator（終端命令）
 // ============================================================
 struct MirTerminator {
+    CM_ARENA_NODE(MirArenaTag)
+
     enum Kind {
         Goto,         // 無条件ジャンプ
         SwitchInt,    // 整数値による分岐
@@ -500,6 +518,9 @@ struct MirTerminator {
 
         // async関数をawaitで呼び出しているか（同期実行する）
         bool is_awaited = false;
+
+        // #[pure] 関数の呼び出しか（GVNで同じ引数の呼び出しを再利用できる）
+        bool is_pure = false;
     };
 
     std::variant<std::monostate,  // Return, Unreachable
@@ -543,6 +564,8 @@ struct MirTerminator {
 // 基本ブロック
 // ============================================================
 struct BasicBlock {
+    CM_ARENA_NODE(MirArenaTag)
+
     BlockId id;
     std::vector<MirStatementPtr> statements;
     MirTerminatorPtr terminator;
@@ -633,6 +656,7 @@ struct MirFunction {
     bool is_extern = false;         // extern "C" 関数か
     bool is_variadic = false;       // 可変長引数（FFI用）
     bool is_async = false;          // async関数（JSバックエンド用）
+    bool is_pure = false;           // #[pure] 関数（呼び出しをCSE可能）
     std::vector<LocalDecl> locals;  // ローカル変数（引数も含む）
     std::vector<LocalId> arg_locals;  // 引数に対応するローカルID
     LocalId return_local;             // 戻り値用のローカル（_0）
@@ -898,16 +922,53 @@ struct MirProgram {
     // LLVM backendでTypeAlias/Struct名の透過的解決に使用
     std::unordered_map<std::string, hir::TypePtr> typedef_defs;
 
-    // 関数を名前で検索
+    // 関数を名前で検索（識別子IDの索引を引く）
+    // 並列パスの各スレッドから呼ばれるため、索引の構築・参照はロックの中で行う
     const MirFunction* find_function(const std::string& name) const {
-        for (const auto& func : functions) {
-            if (func && func->name == name) {
-                return func.get();
-            }
+        std::lock_guard<std::mutex> lock(function_index_mutex_.mutex);
+
+        // 追加された関数だけ索引に加える（同名は先頭を優先、線形探索と同じ）
+        if (indexed_functions_ > functions.size())
+            reset_function_index();
+        for (size_t i = indexed_functions_; i < functions.size(); ++i) {
+            if (functions[i])
+                function_index_.try_emplace(Ident::intern(functions[i]->name), i);
+        }
+        indexed_functions_ = functions.size();
+
+        Ident id = Ident::find(name);
+        auto it = id.valid() ? function_index_.find(id) : function_index_.end();
+        if (it == function_index_.end())
+            return nullptr;
+        const auto& func = functions[it->second];
+        if (func && func->name == name)
+            return func.get();
+
+        // 無効化されずに削除・改名された場合は作り直して線形探索
+        reset_function_index();
+        for (const auto& f : functions) {
+            if (f && f->name == name)
+                return f.get();
         }
         return nullptr;
     }
 
+    MirFunction* find_function(const std::string& name) {
+        return const_cast<MirFunction*>(std::as_const(*this).find_function(name));
+    }
+
+    // functionsの要素を削除・改名したら呼ぶ（末尾への追加は自動で索引に加わる）
+    void invalidate_function_index() const {
+        std::lock_guard<std::mutex> lock(function_index_mutex_.mutex);
+        reset_function_index();
+    }
+
+    // 関数を改名する（改名後の名前で引けるよう索引を無効化する）
+    void rename_function(MirFunction& func, std::string new_name) {
+        func.name = std::move(new_name);
+        invalidate_function_index();
+    }
+
     // モジュール修飾名で関数を検索（例: "math::add"）
     const MirFunction* find_function_qualified(const std::string& qualified_name) const {
         // モジュール修飾名を分割
@@ -948,6 +1009,26 @@ struct MirProgram {
         }
         return nullptr;
     }
+
+   private:
+    // ロックを保持して呼ぶ
+    void reset_function_index() const {
+        function_index_.clear();
+        indexed_functions_ = 0;
+    }
+
+    // ムーブ可能なmutex（MirProgramはムーブで受け渡すため。ムーブ先は新しいmutexを持つ）
+    struct IndexMutex {
+        std::mutex mutex;
+        IndexMutex() = default;
+        IndexMutex(IndexMutex&&) noexcept {}
+        IndexMutex& operator=(IndexMutex&&) noexcept { return *this; }
+    };
+
+    // find_function用の索引（関数名の識別子ID → functionsの添字）
+    mutable std::unordered_map<Ident, size_t> function_index_;
+    mutable size_t indexed_functions_ = 0;
+    mutable IndexMutex function_index_mutex_;
 };
 
 }  // namespace cm::mir
@@ -17,6 +17,9 @@ class DeadStoreElimination : public OptimizationPass {
 
     bool run(MirFunction& func) override;
 
+    // 文の書き換えのみでCFGは変えない
+    PreservedAnalyses preserved_analyses() const override { return PreservedAnalyses::cfg(); }
+
    private:
     // ブロック処理
     bool process_block(BasicBlock& block, const MirFunction& func);
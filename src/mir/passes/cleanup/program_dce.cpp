@@ -188,6 +188,7 @@ bool ProgramDeadCodeElimination::remove_unused_functions(MirProgram& program,
     while (it != program.functions.end()) {
         if (*it && used.find((*it)->name) == used.end()) {
             it = program.functions.erase(it);
+            program.invalidate_function_index();
             changed = true;
         } else {
             ++it;
@@ -1,31 +1,26 @@
 #include "base.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 namespace cm::mir::opt {
 
-int OptimizationPipeline::count_instructions(const MirProgram& program) const {
-    int count = 0;
-    for (const auto& func : program.functions) {
-        if (!func)
+OptimizationPipeline::FunctionShape OptimizationPipeline::shape_of(const MirFunction& func) {
+    FunctionShape shape;
+    for (const auto& block : func.basic_blocks) {
+        if (!block)
             continue;
-        for (const auto& block : func->basic_blocks) {
-            if (!block)
-                continue;
-            count += block->statements.size();
-        }
+        shape.instructions += block->statements.size();
+        shape.blocks++;
     }
-    return count;
-}
-
-int OptimizationPipeline::count_blocks(const MirProgram& program) const {
-    int count = 0;
-    for (const auto& func : program.functions) {
-        if (!func)
-            continue;
-        count += func->basic_blocks.size();
-    }
-    return count;
+    return shape;
 }
 
 void OptimizationPipeline::run(MirProgram& program) {
@@ -52,95 +47,390 @@ void OptimizationPipeline::run(MirProgram& program) {
     }
 }
 
+namespace {
+
+// この関数数未満なら関数内パスを逐次実行する（ワーカーへの受け渡しコストの方が大きい）
+constexpr size_t MIN_PARALLEL_FUNCTIONS = 8;
+
+// 関数内パス区間の並列実行用ワーカープール
+// run_until_fixpoint 1回につき1つ作り、全反復・全区間で同じスレッドを使い回す。
+// スレッドは最初に並列実行が必要になった時点で起動する（小さなプログラムでは起動しない）
+class WorkerPool {
+   public:
+    WorkerPool() = default;
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        start_cv_.notify_all();
+        for (auto& t : threads_) {
+            t.join();
+        }
+    }
+
+    // job(0..num_workers-1) を並列に実行し、全て終わるまで待つ（job(0)は呼び出しスレッドで実行）
+    // job は例外を外に投げないこと
+    void run(size_t num_workers, const std::function<void(size_t)>& job) {
+        if (num_workers <= 1) {
+            job(0);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            while (threads_.size() + 1 < num_workers) {
+                // 起動時点の世代を渡し、この直後の依頼から拾わせる
+                size_t id = threads_.size() + 1;
+                uint64_t seen = generation_;
+                threads_.emplace_back([this, id, seen] { worker_loop(id, seen); });
+            }
+            job_ = &job;
+            active_workers_ = num_workers;
+            pending_ = num_workers - 1;
+            ++generation_;
+        }
+        start_cv_.notify_all();
+        job(0);
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_cv_.wait(lock, [this] { return pending_ == 0; });
+        job_ = nullptr;
+    }
+
+   private:
+    void worker_loop(size_t id, uint64_t seen) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            start_cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) {
+                return;
+            }
+            seen = generation_;
+            if (id >= active_workers_) {
+                continue;
+            }
+            const auto* job = job_;
+            lock.unlock();
+            (*job)(id);
+            lock.lock();
+            if (--pending_ == 0) {
+                done_cv_.notify_one();
+            }
+        }
+    }
+
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    const std::function<void(size_t)>* job_ = nullptr;
+    size_t active_workers_ = 0;
+    size_t pending_ = 0;
+    uint64_t generation_ = 0;
+    bool stop_ = false;
+};
+
+// 関数が直接呼び出す関数名を列挙
+template <typename F>
+void for_each_callee(const MirFunction& func, F&& callback) {
+    for (const auto& block : func.basic_blocks) {
+        if (!block || !block->terminator || block->terminator->kind != MirTerminator::Call)
+            continue;
+        const auto& call_data = std::get<MirTerminator::CallData>(block->terminator->data);
+        if (!call_data.func)
+            continue;
+        if (call_data.func->kind == MirOperand::FunctionRef) {
+            callback(std::get<std::string>(call_data.func->data));
+        } else if (call_data.func->kind == MirOperand::Constant) {
+            const auto& callee = std::get<MirConstant>(call_data.func->data);
+            if (const auto* name = std::get_if<std::string>(&callee.value)) {
+                callback(*name);
+            }
+        }
+    }
+}
+
+}  // namespace
+
 void OptimizationPipeline::run_until_fixpoint(MirProgram& program, int max_iterations) {
     using namespace cm::mir::optimizations;
 
     ConvergenceManager convergence_mgr;
 
-    // 個々の最適化パスの実行回数を追跡
-    std::unordered_map<std::string, int> pass_run_counts;
+    // 個々の最適化パスの実行回数を追跡（変更があった反復の数）
+    std::vector<int> pass_run_counts(passes.size(), 0);
+    const int max_pass_runs_total = 30;
+
+    // パスを「関数内パスの連続区間」と「関数間パス（同期点）」に分割
+    // 例: [SCCP..SimplifyCFG] | Inlining | [TCE..DCE]
+    struct Segment {
+        size_t begin;
+        size_t end;
+        bool interprocedural;
+    };
+    std::vector<Segment> segments;
+    for (size_t p = 0; p < passes.size(); ++p) {
+        bool inter = passes[p]->is_interprocedural();
+        if (inter || segments.empty() || segments.back().interprocedural) {
+            segments.push_back({p, p + 1, inter});
+        } else {
+            segments.back().end = p + 1;
+        }
+    }
 
-    // 各パスが前回の反復で変更を生じたかを追跡
-    // 変更なし + その後に他のパスも変更なし → スキップ可能
-    std::vector<bool> pass_changed_last(passes.size(), true);  // 初回は全パス実行
+    auto& functions = program.functions;
+    const size_t num_functions = functions.size();
 
-    for (int i = 0; i < max_iterations; ++i) {
-        ConvergenceManager::ChangeMetrics metrics;
+    // 呼び出し元グラフ（関数名 → 呼び出し元のインデックス）
+    // インライン化で辺が増えるため、変更された関数の辺は反復ごとに追加する（削除はしない）
+    std::unordered_map<std::string, std::set<size_t>> callers;
+    for (size_t f = 0; f < num_functions; ++f) {
+        if (!functions[f])
+            continue;
+        for_each_callee(*functions[f], [&](const std::string& callee) { callers[callee].insert(f); });
+    }
 
-        if (debug_output) {
-            std::cout << "[OPT] 反復 " << (i + 1) << "/" << max_iterations << "\n";
+    size_t hw_threads = std::thread::hardware_concurrency();
+    size_t max_workers = num_threads > 0 ? static_cast<size_t>(num_threads)
+                                         : std::max<size_t>(1, hw_threads);
+    WorkerPool pool;
+
+    // ワークリスト: 初回は全関数
+    std::vector<char> dirty(num_functions, 1);
+    std::vector<FunctionShape> shapes(num_functions);
+    for (size_t f = 0; f < num_functions; ++f) {
+        if (functions[f]) {
+            shapes[f] = shape_of(*functions[f]);
         }
+    }
 
-        // 実行前の状態を記録
-        int prev_inst_count = count_instructions(program);
-        int prev_block_count = count_blocks(program);
-
-        // 一時的に変更検出用の仕組みを用意
-        int before_count = count_instructions(program);
+    auto total_shape = [&](const MirProgram& prog) {
+        FunctionShape total;
+        for (const auto& func : prog.functions) {
+            if (func) {
+                FunctionShape shape = shape_of(*func);
+                total.instructions += shape.instructions;
+                total.blocks += shape.blocks;
+            }
+        }
+        return total;
+    };
 
-        // 個々のパスごとの実行回数制限
-        const int max_pass_runs_total = 30;
+    // 関数ごとの解析キャッシュ（パスの変更時に保持されない解析を破棄）
+    FunctionAnalysisManager analyses;
 
-        // この反復で何かしら変更があったか
-        bool any_pass_changed_this_iteration = false;
+    // 関数間パスの前回反復での変更（変更なし + 他も変更なし → スキップ）
+    std::vector<bool> inter_changed_last(passes.size(), true);
 
-        // 各パスの変更状態を記録（次の反復用）
-        std::vector<bool> pass_changed_current(passes.size(), false);
+    for (int i = 0; i < max_iterations; ++i) {
+        ConvergenceManager::ChangeMetrics metrics;
 
-        // 各パスを実行（回数制限付き）
-        for (size_t p = 0; p < passes.size(); ++p) {
-            auto& pass = passes[p];
-            std::string pass_name = pass->name();
+        if (debug_output) {
+            size_t dirty_count = std::count(dirty.begin(), dirty.end(), 1);
+            std::cout << "[OPT] 反復 " << (i + 1) << "/" << max_iterations << " (対象関数: "
+                      << dirty_count << "/" << num_functions << ")\n";
+        }
 
-            if (pass_run_counts[pass_name] >= max_pass_runs_total) {
-                if (debug_output) {
-                    std::cout << "[OPT]   " << pass_name
-                              << " スキップ（実行回数上限: " << max_pass_runs_total << "回）\n";
+        // 実行前の規模を記録（収束判定は従来通りプログラム全体の増減で行う）
+        FunctionShape prev_total = total_shape(program);
+
+        // この反復で変更された関数
+        std::vector<char> changed(num_functions, 0);
+        bool any_changed_this_iteration = false;
+        std::vector<bool> inter_changed_current(passes.size(), false);
+
+        for (const auto& segment : segments) {
+            if (segment.interprocedural) {
+                // 同期点: プログラム全体に対して逐次実行
+                for (size_t p = segment.begin; p < segment.end; ++p) {
+                    auto& pass = passes[p];
+                    if (pass_run_counts[p] >= max_pass_runs_total) {
+                        if (debug_output) {
+                            std::cout << "[OPT]   " << pass->name() << " スキップ（実行回数上限: "
+                                      << max_pass_runs_total << "回）\n";
+                        }
+                        continue;
+                    }
+                    if (i > 0 && !inter_changed_last[p] && !any_changed_this_iteration) {
+                        if (debug_output) {
+                            std::cout << "[OPT]   " << pass->name() << " スキップ（前回変更なし）\n";
+                        }
+                        continue;
+                    }
+
+                    auto pass_start = std::chrono::steady_clock::now();
+                    bool pass_changed = pass->run_on_program(program);
+                    auto pass_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                       std::chrono::steady_clock::now() - pass_start)
+                                       .count();
+                    inter_changed_current[p] = pass_changed;
+
+                    if (pass_changed) {
+                        pass_run_counts[p]++;
+                        any_changed_this_iteration = true;
+                        analyses.clear();
+                        // どの関数が変わったかは規模の差分で判定
+                        for (size_t f = 0; f < num_functions; ++f) {
+                            if (!functions[f]) {
+                                continue;
+                            }
+                            FunctionShape now = shape_of(*functions[f]);
+                            if (now.instructions != shapes[f].instructions ||
+                                now.blocks != shapes[f].blocks) {
+                                changed[f] = 1;
+                            }
+                            shapes[f] = now;
+                        }
+                        if (debug_output) {
+                            std::cout << "[OPT]   " << pass->name()
+                                      << " 変更実行 (回数: " << pass_run_counts[p] << "/"
+                                      << max_pass_runs_total << ", " << pass_ms << "ms)\n";
+                        }
+                    } else if (debug_output && pass_ms > 0) {
+                        std::cout << "[OPT]   " << pass->name() << " 変更なし (" << pass_ms
+                                  << "ms)\n";
+                    }
                 }
                 continue;
             }
 
-            // スキップ判定: 前回変更なし + その後に他のパスも変更なし → スキップ
-            if (i > 0 && !pass_changed_last[p] && !any_pass_changed_this_iteration) {
-                if (debug_output) {
-                    std::cout << "[OPT]   " << pass_name << " スキップ（前回変更なし）\n";
+            // 関数内パス: ワークリスト上の関数（＋この反復で変更された関数）に区間内の全パスを適用
+            std::vector<size_t> targets;
+            for (size_t f = 0; f < num_functions; ++f) {
+                if (functions[f] && (dirty[f] || changed[f])) {
+                    targets.push_back(f);
                 }
+            }
+            if (targets.empty()) {
                 continue;
             }
 
-            auto pass_start = std::chrono::steady_clock::now();
-            bool pass_changed = pass->run_on_program(program);
-            auto pass_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                               std::chrono::steady_clock::now() - pass_start)
-                               .count();
+            std::vector<bool> pass_enabled(passes.size(), false);
+            for (size_t p = segment.begin; p < segment.end; ++p) {
+                pass_enabled[p] = pass_run_counts[p] < max_pass_runs_total;
+                if (!pass_enabled[p] && debug_output) {
+                    std::cout << "[OPT]   " << passes[p]->name() << " スキップ（実行回数上限: "
+                              << max_pass_runs_total << "回）\n";
+                }
+            }
 
-            pass_changed_current[p] = pass_changed;
+            // ワーカーごとの集計（パスごとの変更有無と所要時間）
+            struct WorkerStats {
+                std::vector<char> pass_changed;
+                std::vector<size_t> changed_functions;
+                std::vector<std::chrono::steady_clock::duration> pass_time;
+            };
+            size_t num_workers =
+                targets.size() < MIN_PARALLEL_FUNCTIONS ? 1 : std::min(max_workers, targets.size());
+            std::vector<WorkerStats> stats(num_workers);
+            for (auto& st : stats) {
+                st.pass_changed.assign(passes.size(), 0);
+                st.pass_time.assign(passes.size(), {});
+            }
 
-            if (pass_changed) {
-                pass_run_counts[pass_name]++;
-                any_pass_changed_this_iteration = true;
-                if (debug_output) {
-                    std::cout << "[OPT]   " << pass_name
-                              << " 変更実行 (回数: " << pass_run_counts[pass_name] << "/"
-                              << max_pass_runs_total << ", " << pass_ms << "ms)\n";
+            std::atomic<size_t> next_index{0};
+            std::exception_ptr worker_error;
+            std::mutex error_mutex;
+
+            auto worker = [&](size_t worker_id) {
+                auto& st = stats[worker_id];
+                try {
+                    while (true) {
+                        size_t t = next_index.fetch_add(1);
+                        if (t >= targets.size()) {
+                            break;
+                        }
+                        auto& func = *functions[targets[t]];
+                        bool func_changed = false;
+                        for (size_t p = segment.begin; p < segment.end; ++p) {
+                            if (!pass_enabled[p]) {
+                                continue;
+                            }
+                            auto pass_start = std::chrono::steady_clock::now();
+                            if (passes[p]->run_with_analyses(func, analyses)) {
+                                analyses.invalidate(func, passes[p]->preserved_analyses());
+                                st.pass_changed[p] = 1;
+                                func_changed = true;
+                            }
+                            st.pass_time[p] += std::chrono::steady_clock::now() - pass_start;
+                        }
+                        if (func_changed) {
+                            st.changed_functions.push_back(targets[t]);
+                        }
+                    }
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!worker_error) {
+                        worker_error = std::current_exception();
+                    }
+                    next_index = targets.size();
                 }
-            } else if (debug_output && pass_ms > 0) {
-                std::cout << "[OPT]   " << pass_name << " 変更なし (" << pass_ms << "ms)\n";
+            };
+
+            pool.run(num_workers, worker);
+            if (worker_error) {
+                std::rethrow_exception(worker_error);
             }
-        }
 
-        // 次の反復用に変更状態を更新
-        pass_changed_last = pass_changed_current;
+            for (const auto& st : stats) {
+                for (size_t f : st.changed_functions) {
+                    changed[f] = 1;
+                    any_changed_this_iteration = true;
+                }
+            }
+            for (size_t f : targets) {
+                shapes[f] = shape_of(*functions[f]);
+            }
 
-        int after_count = count_instructions(program);
-        bool any_changed = (before_count != after_count);
+            for (size_t p = segment.begin; p < segment.end; ++p) {
+                bool pass_changed = false;
+                std::chrono::steady_clock::duration pass_time{};
+                for (const auto& st : stats) {
+                    pass_changed = pass_changed || st.pass_changed[p];
+                    pass_time += st.pass_time[p];
+                }
+                auto pass_ms =
+                    std::chrono::duration_cast<std::chrono::milliseconds>(pass_time).count();
+                if (pass_changed) {
+                    pass_run_counts[p]++;
+                    if (debug_output) {
+                        std::cout << "[OPT]   " << passes[p]->name()
+                                  << " 変更実行 (回数: " << pass_run_counts[p] << "/"
+                                  << max_pass_runs_total << ", " << pass_ms << "ms)\n";
+                    }
+                } else if (debug_output && pass_ms > 0) {
+                    std::cout << "[OPT]   " << passes[p]->name() << " 変更なし (" << pass_ms
+                              << "ms)\n";
+                }
+            }
+        }
 
-        if (any_changed) {
-            int curr_inst_count = count_instructions(program);
-            int curr_block_count = count_blocks(program);
+        inter_changed_last = inter_changed_current;
+
+        // 次の反復のワークリスト: 変更された関数とその呼び出し元
+        std::fill(dirty.begin(), dirty.end(), 0);
+        for (size_t f = 0; f < num_functions; ++f) {
+            if (!changed[f]) {
+                continue;
+            }
+            dirty[f] = 1;
+            for_each_callee(*functions[f],
+                            [&](const std::string& callee) { callers[callee].insert(f); });
+            auto it = callers.find(functions[f]->name);
+            if (it != callers.end()) {
+                for (size_t caller : it->second) {
+                    dirty[caller] = 1;
+                }
+            }
+        }
 
-            metrics.instructions_changed = std::abs(curr_inst_count - prev_inst_count);
-            metrics.blocks_changed = std::abs(curr_block_count - prev_block_count);
+        FunctionShape curr_total = total_shape(program);
+        if (curr_total.instructions != prev_total.instructions) {
+            metrics.instructions_changed =
+                std::abs(curr_total.instructions - prev_total.instructions);
+            metrics.blocks_changed = std::abs(curr_total.blocks - prev_total.blocks);
 
             if (metrics.blocks_changed > 0) {
                 metrics.cfg_changed = true;
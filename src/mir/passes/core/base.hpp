@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../analysis/analysis_manager.hpp"
 #include "../../nodes.hpp"
 #include "../../printer.hpp"
 #include "../convergence/manager.hpp"
@@ -28,6 +29,19 @@ class OptimizationPass {
     // 最適化を実行（変更があった場合trueを返す）
     virtual bool run(MirFunction& func) = 0;
 
+    // 解析マネージャ付きで実行（支配木・ループ等を使うパスはこちらをオーバーライド）
+    virtual bool run_with_analyses(MirFunction& func, FunctionAnalysisManager& analyses) {
+        (void)analyses;
+        return run(func);
+    }
+
+    // 変更後も有効なまま残る解析（デフォルトは全て破棄）
+    virtual PreservedAnalyses preserved_analyses() const { return PreservedAnalyses::none(); }
+
+    // 関数間パスか（trueなら並列実行せず、パイプラインの同期点でrun_on_programを呼ぶ）
+    // 関数内パスは状態を持たず、異なる関数に対して並行にrunを呼べること
+    virtual bool is_interprocedural() const { return false; }
+
     // プログラム全体に対する最適化（デフォルトは各関数に対して実行）
     virtual bool run_on_program(MirProgram& program) {
         bool changed = false;
@@ -61,17 +75,22 @@ class OptimizationPipeline {
    protected:
     std::vector<std::unique_ptr<OptimizationPass>> passes;
     bool debug_output = false;
+    int num_threads = 0;  // 関数内パスの並列数（0 = ハードウェア並列数）
 
-    // インストラクション数をカウント
-    int count_instructions(const MirProgram& program) const;
-
-    // 基本ブロック数をカウント
-    int count_blocks(const MirProgram& program) const;
+    // 関数の規模（変更検出用: 命令数と基本ブロック数）
+    struct FunctionShape {
+        int instructions = 0;
+        int blocks = 0;
+    };
+    static FunctionShape shape_of(const MirFunction& func);
 
    public:
     // デバッグ出力を有効化
     void enable_debug_output(bool enable = true) { debug_output = enable; }
 
+    // 関数内パスの並列数を設定（0 = ハードウェア並列数、1 = 逐次）
+    void set_num_threads(int threads) { num_threads = threads; }
+
     // パスを追加
     void add_pass(std::unique_ptr<OptimizationPass> pass) { passes.push_back(std::move(pass)); }
 
@@ -82,6 +101,7 @@ class OptimizationPipeline {
     void run(MirProgram& program);
 
     // 収束するまで繰り返し実行（収束管理付き）
+    // 関数単位のワークリストで、変更された関数とその呼び出し元のみを再最適化する
     void run_until_fixpoint(MirProgram& program, int max_iterations = 10);
 };
 
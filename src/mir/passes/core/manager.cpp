@@ -56,10 +56,11 @@ std::vector<std::unique_ptr<OptimizationPass>> create_standard_passes(int optimi
     return passes;
 }
 
-void run_optimization_passes(MirProgram& program, int optimization_level, bool debug) {
+void run_optimization_passes(MirProgram& program, int optimization_level, bool debug, int jobs) {
     // パイプラインを使用（収束管理付き）
     OptimizationPipeline pass_mgr;
     pass_mgr.enable_debug_output(debug);
+    pass_mgr.set_num_threads(jobs);
 
     auto passes = create_standard_passes(optimization_level);
     for (auto& pass : passes) {
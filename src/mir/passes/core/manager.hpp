@@ -12,6 +12,8 @@ namespace cm::mir::opt {
 std::vector<std::unique_ptr<OptimizationPass>> create_standard_passes(int optimization_level);
 
 // 最適化レベルに応じた収束戦略で最適化を実行
-void run_optimization_passes(MirProgram& program, int optimization_level, bool debug = false);
+// jobs: 関数内パスの並列数（0 = ハードウェア並列数）
+void run_optimization_passes(MirProgram& program, int optimization_level, bool debug = false,
+                             int jobs = 0);
 
 }  // namespace cm::mir::opt
\ No newline at end of file
@@ -1,107 +1,301 @@
 #include "inlining.hpp"
 
+#include "../../analysis/loop_analysis.hpp"
+
 namespace cm::mir::opt {
 
+namespace {
+
+size_t statement_cost(const MirStatement& stmt) {
+    switch (stmt.kind) {
+        case MirStatement::Assign: {
+            const auto& data = std::get<MirStatement::AssignData>(stmt.data);
+            if (!data.rvalue)
+                return 1;
+            switch (data.rvalue->kind) {
+                case MirRvalue::Aggregate:
+                    return 1 + std::get<MirRvalue::AggregateData>(data.rvalue->data).operands.size();
+                case MirRvalue::FormatConvert:
+                    return 3;
+                default:
+                    return 1;
+            }
+        }
+        case MirStatement::Asm:
+            return 10;
+        default:
+            return 0;  // StorageLive/StorageDead/Nop
+    }
+}
+
+size_t terminator_cost(const MirTerminator& term) {
+    switch (term.kind) {
+        case MirTerminator::SwitchInt:
+            return 1 + std::get<MirTerminator::SwitchIntData>(term.data).targets.size();
+        case MirTerminator::Call:
+            return 3 + std::get<MirTerminator::CallData>(term.data).args.size();
+        default:
+            return 0;  // Goto/Return/Unreachable
+    }
+}
+
+size_t loop_depth_of(const LoopAnalysis& loops, BlockId block) {
+    size_t depth = 0;
+    for (const Loop* loop = loops.get_inner_most_loop(block); loop; loop = loop->parent_loop) {
+        ++depth;
+    }
+    return depth;
+}
+
+}  // namespace
+
 bool FunctionInlining::run_on_program(MirProgram& program) {
     bool changed = false;
 
-    std::unordered_map<std::string, const MirFunction*> function_map;
+    FunctionMap function_map;
     for (const auto& func : program.functions) {
         if (func) {
             function_map[func->name] = func.get();
         }
     }
 
-    // インライン化回数の追跡（無限ループ防止）
-    inline_counts.clear();
-    max_inlines_reached = false;
+    count_uses(program);
+    costs.clear();
 
-    for (auto& func : program.functions) {
-        if (func) {
-            changed |= process_function(*func, function_map);
+    // 葉側のSCCから処理する（呼び出し先は展開済みのコストで評価される）
+    for (const auto& scc : bottom_up_sccs(program, function_map)) {
+        std::unordered_set<const MirFunction*> members(scc.begin(), scc.end());
+        for (MirFunction* func : scc) {
+            changed |= process_function(*func, function_map, members);
         }
     }
 
-    if (max_inlines_reached) {
-        std::cerr << "[INLINE] 警告: 一部の関数でインライン化上限に達しました\n";
-    }
-
     return changed;
 }
 
-bool FunctionInlining::process_function(
-    MirFunction& caller, const std::unordered_map<std::string, const MirFunction*>& func_map) {
-    bool changed = false;
-    size_t initial_block_count = caller.basic_blocks.size();
+const std::string* FunctionInlining::callee_name(const MirTerminator::CallData& call) {
+    if (!call.func || call.is_virtual || !call.interface_name.empty())
+        return nullptr;
+    if (call.func->kind == MirOperand::FunctionRef)
+        return &std::get<std::string>(call.func->data);
+    if (call.func->kind == MirOperand::Constant)
+        return std::get_if<std::string>(&std::get<MirConstant>(call.func->data).value);
+    return nullptr;
+}
+
+// 呼び出し・関数参照の箇所数（関数ポインタとして使われる関数も1箇所と数える）
+void FunctionInlining::count_uses(const MirProgram& program) {
+    use_counts.clear();
+
+    auto count_operand = [&](const MirOperand* op) {
+        if (op && op->kind == MirOperand::FunctionRef)
+            ++use_counts[std::get<std::string>(op->data)];
+    };
 
-    for (size_t i = 0; i < initial_block_count; ++i) {
-        if (process_block(caller, i, func_map)) {
-            changed = true;
+    for (const auto& func : program.functions) {
+        if (!func)
+            continue;
+        for (const auto& block : func->basic_blocks) {
+            if (!block)
+                continue;
+            for (const auto& stmt : block->statements) {
+                if (stmt->kind != MirStatement::Assign)
+                    continue;
+                const auto& data = std::get<MirStatement::AssignData>(stmt->data);
+                if (!data.rvalue)
+                    continue;
+                if (const auto* use = std::get_if<MirRvalue::UseData>(&data.rvalue->data)) {
+                    count_operand(use->operand.get());
+                } else if (const auto* agg =
+                               std::get_if<MirRvalue::AggregateData>(&data.rvalue->data)) {
+                    for (const auto& op : agg->operands)
+                        count_operand(op.get());
+                } else if (const auto* cast =
+                               std::get_if<MirRvalue::CastData>(&data.rvalue->data)) {
+                    count_operand(cast->operand.get());
+                }
+            }
+            if (block->terminator && block->terminator->kind == MirTerminator::Call) {
+                const auto& call = std::get<MirTerminator::CallData>(block->terminator->data);
+                if (const auto* name = callee_name(call)) {
+                    ++use_counts[*name];
+                } else {
+                    count_operand(call.func.get());
+                }
+                for (const auto& arg : call.args)
+                    count_operand(arg.get());
+            }
         }
     }
-
-    return changed;
 }
 
-bool FunctionInlining::process_block(
-    MirFunction& caller, BlockId block_id,
-    const std::unordered_map<std::string, const MirFunction*>& func_map) {
-    if (block_id >= caller.basic_blocks.size() || !caller.basic_blocks[block_id])
-        return false;
-
-    auto& block = caller.basic_blocks[block_id];
-    if (!block->terminator || block->terminator->kind != MirTerminator::Call) {
-        return false;
+// Tarjanの強連結成分分解（出力順は呼び出し先が先のトポロジカル順）
+std::vector<std::vector<MirFunction*>> FunctionInlining::bottom_up_sccs(
+    const MirProgram& program, const FunctionMap& func_map) {
+    std::unordered_map<const MirFunction*, std::vector<MirFunction*>> callees;
+    for (const auto& func : program.functions) {
+        if (!func)
+            continue;
+        auto& edges = callees[func.get()];
+        for (const auto& block : func->basic_blocks) {
+            if (!block || !block->terminator || block->terminator->kind != MirTerminator::Call)
+                continue;
+            const auto& call = std::get<MirTerminator::CallData>(block->terminator->data);
+            if (const auto* name = callee_name(call)) {
+                auto it = func_map.find(*name);
+                if (it != func_map.end())
+                    edges.push_back(it->second);
+            }
+        }
     }
 
-    auto& call_data = std::get<MirTerminator::CallData>(block->terminator->data);
+    struct NodeState {
+        size_t index;
+        size_t low_link;
+        bool on_stack;
+    };
+    std::unordered_map<const MirFunction*, NodeState> states;
+    std::vector<MirFunction*> stack;
+    std::vector<std::vector<MirFunction*>> sccs;
+    size_t next_index = 0;
+
+    // 深い呼び出し連鎖でもスタックを使い切らないよう明示的なスタックで辿る
+    struct Frame {
+        MirFunction* func;
+        size_t next_edge;
+    };
+    for (const auto& root : program.functions) {
+        if (!root || states.count(root.get()))
+            continue;
 
-    if (call_data.func->kind != MirOperand::Constant)
-        return false;
-    const auto& callee_const = std::get<MirConstant>(call_data.func->data);
+        std::vector<Frame> frames;
+        auto visit = [&](MirFunction* func) {
+            states[func] = {next_index, next_index, true};
+            ++next_index;
+            stack.push_back(func);
+            frames.push_back({func, 0});
+        };
+        visit(root.get());
+
+        while (!frames.empty()) {
+            Frame& frame = frames.back();
+            const auto& edges = callees[frame.func];
+            if (frame.next_edge < edges.size()) {
+                MirFunction* callee = edges[frame.next_edge++];
+                auto it = states.find(callee);
+                if (it == states.end()) {
+                    visit(callee);
+                } else if (it->second.on_stack) {
+                    auto& state = states[frame.func];
+                    state.low_link = std::min(state.low_link, it->second.index);
+                }
+                continue;
+            }
 
-    std::string callee_name;
-    if (const auto* s = std::get_if<std::string>(&callee_const.value)) {
-        callee_name = *s;
+            MirFunction* func = frame.func;
+            frames.pop_back();
+            auto& state = states[func];
+            if (!frames.empty()) {
+                auto& parent = states[frames.back().func];
+                parent.low_link = std::min(parent.low_link, state.low_link);
+            }
+            if (state.low_link == state.index) {
+                std::vector<MirFunction*> scc;
+                MirFunction* member = nullptr;
+                do {
+                    member = stack.back();
+                    stack.pop_back();
+                    states[member].on_stack = false;
+                    scc.push_back(member);
+                } while (member != func);
+                sccs.push_back(std::move(scc));
+            }
+        }
     }
 
-    if (callee_name.empty())
-        return false;
-    if (callee_name == caller.name)
-        return false;  // 自己再帰を防ぐ
+    return sccs;
+}
 
-    // プログラム全体のインライン化回数制限チェック
-    size_t total_inlines = 0;
-    for (const auto& [key, count] : inline_counts) {
-        total_inlines += count;
-    }
-    if (total_inlines >= MAX_TOTAL_INLINES) {
-        max_inlines_reached = true;
-        return false;
+size_t FunctionInlining::function_cost(const MirFunction& func) {
+    size_t cost = 0;
+    for (const auto& block : func.basic_blocks) {
+        if (!block)
+            continue;
+        for (const auto& stmt : block->statements) {
+            cost += statement_cost(*stmt);
+        }
+        if (block->terminator)
+            cost += terminator_cost(*block->terminator);
     }
+    return cost;
+}
 
-    // インライン化回数制限チェック
-    auto inline_key = caller.name + "->" + callee_name;
-    if (inline_counts[inline_key] >= MAX_INLINE_PER_FUNCTION) {
-        max_inlines_reached = true;
-        return false;
+bool FunctionInlining::process_function(MirFunction& caller, const FunctionMap& func_map,
+                                        const std::unordered_set<const MirFunction*>& scc) {
+    // 呼び出し箇所をループの深い順に並べる（ホットな呼び出しから予算を使う）
+    std::vector<CallSite> sites;
+    {
+        DominatorTree dom_tree(caller);
+        LoopAnalysis loops(caller, dom_tree);
+        for (BlockId id = 0; id < caller.basic_blocks.size(); ++id) {
+            const auto& block = caller.basic_blocks[id];
+            if (block && block->terminator && block->terminator->kind == MirTerminator::Call &&
+                dom_tree.is_reachable(id)) {
+                sites.push_back({id, loop_depth_of(loops, id)});
+            }
+        }
     }
-
-    auto it = func_map.find(callee_name);
-    if (it == func_map.end())
+    if (sites.empty())
         return false;
-    const MirFunction* callee = it->second;
+    std::stable_sort(sites.begin(), sites.end(), [](const CallSite& a, const CallSite& b) {
+        return a.loop_depth > b.loop_depth;
+    });
 
-    if (!should_inline(*callee))
-        return false;
+    size_t caller_cost = function_cost(caller);
+    bool changed = false;
 
-    inline_counts[inline_key]++;
+    for (const auto& site : sites) {
+        // 展開は呼び出しブロックの終端命令を置き換えるだけなので、他の箇所はそのまま有効
+        auto& term = caller.basic_blocks[site.block]->terminator;
+        const auto& call_data = std::get<MirTerminator::CallData>(term->data);
+        const auto* name = callee_name(call_data);
+        if (!name || *name == caller.name || call_data.unwind)
+            continue;
 
-    perform_inlining(caller, block_id, *callee, call_data);
-    return true;
+        auto it = func_map.find(*name);
+        if (it == func_map.end())
+            continue;
+        const MirFunction* callee = it->second;
+        if (scc.count(callee) || !is_inlinable(*callee) ||
+            call_data.args.size() != callee->arg_locals.size() ||
+            !arguments_match(caller, *callee, call_data))
+            continue;
+
+        auto cost_it = costs.find(callee);
+        size_t cost =
+            cost_it != costs.end() ? cost_it->second : (costs[callee] = function_cost(*callee));
+
+        bool profitable = cost <= ALWAYS_INLINE_COST ||
+                          (cost <= threshold_for(*callee, call_data, site.loop_depth) &&
+                           caller_cost + cost <= MAX_CALLER_COST);
+        if (!profitable)
+            continue;
+
+        perform_inlining(caller, site.block, *callee, call_data);
+        caller_cost += cost;
+        changed = true;
+    }
+
+    if (changed)
+        costs[&caller] = caller_cost;
+    return changed;
 }
 
-bool FunctionInlining::should_inline(const MirFunction& callee) {
+bool FunctionInlining::is_inlinable(const MirFunction& callee) const {
+    if (callee.basic_blocks.empty() || callee.is_extern || callee.is_variadic ||
+        callee.is_async || callee.name == "main")
+        return false;
+
     // ラムダ関数やクロージャ関数はインライン化しない
     if (callee.name.find("__lambda_") != std::string::npos ||
         callee.name.find("$_") != std::string::npos ||
@@ -109,8 +303,16 @@ bool FunctionInlining::should_inline(const MirFunction& callee) {
         return false;
     }
 
+    // static変数は展開先ごとに複製されてしまう、キャプチャ情報はローカルIDを持つ
+    for (const auto& local : callee.locals) {
+        if (local.is_static || local.is_closure || !local.captured_locals.empty())
+            return false;
+    }
+
     // ASM文を含む関数はインライン化しない
     // （レジスタ割当前提の崩壊、ret命令の帰先消失を防止）
+    // 引数への参照（&self等）もしない: コード生成では引数ローカルの参照が
+    // 引数の値そのもの（借用self）になり、通常のローカルとは意味が異なる
     for (const auto& b : callee.basic_blocks) {
         if (!b)
             continue;
@@ -118,15 +320,66 @@ bool FunctionInlining::should_inline(const MirFunction& callee) {
             if (stmt->kind == MirStatement::Asm) {
                 return false;
             }
+            if (stmt->kind != MirStatement::Assign)
+                continue;
+            const auto& data = std::get<MirStatement::AssignData>(stmt->data);
+            if (data.rvalue && data.rvalue->kind == MirRvalue::Ref) {
+                LocalId base = std::get<MirRvalue::RefData>(data.rvalue->data).place.local;
+                if (std::find(callee.arg_locals.begin(), callee.arg_locals.end(), base) !=
+                    callee.arg_locals.end())
+                    return false;
+            }
         }
     }
+    return true;
+}
 
-    size_t stmt_count = 0;
-    for (const auto& b : callee.basic_blocks) {
-        if (b)
-            stmt_count += b->statements.size();
+// 実引数の型が仮引数と一致するか
+// （プリミティブ型implのselfはポインタで渡されるなど、呼び出し規約で変換される引数は展開しない）
+bool FunctionInlining::arguments_match(const MirFunction& caller, const MirFunction& callee,
+                                       const MirTerminator::CallData& call) const {
+    for (size_t i = 0; i < call.args.size(); ++i) {
+        const auto& arg = *call.args[i];
+        hir::TypePtr arg_type = arg.type;
+        if (arg.kind == MirOperand::Move || arg.kind == MirOperand::Copy) {
+            const auto& place = std::get<MirPlace>(arg.data);
+            if (place.projections.empty() && place.local < caller.locals.size())
+                arg_type = caller.locals[place.local].type;
+            else if (place.type)
+                arg_type = place.type;
+        } else if (arg.kind == MirOperand::Constant) {
+            const auto& constant = std::get<MirConstant>(arg.data);
+            if (constant.type)
+                arg_type = constant.type;
+        }
+
+        LocalId param = callee.arg_locals[i];
+        const auto& param_type = param < callee.locals.size() ? callee.locals[param].type : nullptr;
+        if (!arg_type || !param_type || !hir::types_equal(arg_type, param_type))
+            return false;
     }
-    return stmt_count <= INLINE_THRESHOLD;
+    return true;
+}
+
+size_t FunctionInlining::threshold_for(const MirFunction& callee,
+                                       const MirTerminator::CallData& call,
+                                       size_t loop_depth) const {
+    size_t threshold = BASE_THRESHOLD;
+
+    // 定数引数は展開後の定数畳み込み・分岐削除で縮む見込みがある
+    for (const auto& arg : call.args) {
+        if (arg->kind == MirOperand::Constant)
+            threshold += CONSTANT_ARG_BONUS;
+    }
+
+    threshold += std::min(loop_depth, MAX_BONUS_LOOP_DEPTH) * LOOP_DEPTH_BONUS;
+
+    // 唯一の呼び出し箇所なら展開後に元の関数ごと削除できる
+    auto it = use_counts.find(callee.name);
+    if (it != use_counts.end() && it->second == 1 && !callee.is_export)
+        threshold += SINGLE_CALL_SITE_BONUS;
+
+    return threshold;
 }
 
 void FunctionInlining::perform_inlining(MirFunction& caller, BlockId call_block_id,
@@ -140,75 +393,43 @@ void FunctionInlining::perform_inlining(MirFunction& caller, BlockId call_block_
         caller.locals.push_back(new_local);
     }
 
+    // 呼び出し先のブロックIDをそのままオフセットするため、欠番（nullptr）も詰めずに残す
     BlockId block_offset = caller.basic_blocks.size();
-    std::vector<BlockId> block_map(callee.basic_blocks.size());
-
-    std::vector<BasicBlockPtr> new_blocks;
-    new_blocks.reserve(callee.basic_blocks.size());
+    std::vector<BlockId> block_map(callee.basic_blocks.size(), INVALID_BLOCK);
+    for (size_t i = 0; i < callee.basic_blocks.size(); ++i) {
+        if (callee.basic_blocks[i])
+            block_map[i] = block_offset + i;
+    }
 
-    // Pass 1: Clone blocks and map IDs
     for (size_t i = 0; i < callee.basic_blocks.size(); ++i) {
-        if (!callee.basic_blocks[i]) {
-            block_map[i] = INVALID_BLOCK;
+        const auto& src = callee.basic_blocks[i];
+        if (!src) {
+            caller.basic_blocks.push_back(nullptr);
             continue;
         }
 
         auto new_block = std::make_unique<BasicBlock>(block_offset + i);
-        new_block->id = block_offset + i;
-        block_map[i] = new_block->id;
-
-        for (const auto& stmt : callee.basic_blocks[i]->statements) {
+        for (const auto& stmt : src->statements) {
             new_block->statements.push_back(clone_statement(*stmt));
         }
-
-        if (callee.basic_blocks[i]->terminator) {
-            new_block->terminator = clone_terminator(*callee.basic_blocks[i]->terminator);
-        }
-
-        new_blocks.push_back(std::move(new_block));
-    }
-
-    // Pass 2: Remap
-    for (auto& nb : new_blocks) {
-        remap_block(*nb, local_offset, block_map, call_data);
-    }
-
-    // Append modified blocks to caller
-    for (auto& nb : new_blocks) {
-        caller.basic_blocks.push_back(std::move(nb));
-    }
-
-    // Ensure IDs match indices
-    for (size_t i = block_offset; i < caller.basic_blocks.size(); ++i) {
-        if (caller.basic_blocks[i])
-            caller.basic_blocks[i]->id = i;
-    }
-
-    // Arguments assignment
-    if (callee.entry_block < block_map.size()) {
-        BlockId entry_id = block_map[callee.entry_block];
-        if (entry_id != INVALID_BLOCK) {
-            auto& entry_block = caller.basic_blocks[entry_id];
-
-            for (size_t i = 0; i < call_data.args.size(); ++i) {
-                if (i >= callee.arg_locals.size())
-                    break;
-
-                LocalId target_local = callee.arg_locals[i] + local_offset;
-                MirPlace place{target_local};
-                MirOperandPtr op = clone_operand(*call_data.args[i]);
-                MirRvaluePtr rv = MirRvalue::use(std::move(op));
-
-                auto stmt = MirStatement::assign(std::move(place), std::move(rv));
-                entry_block->statements.insert(entry_block->statements.begin() + i,
-                                               std::move(stmt));
-            }
+        if (src->terminator) {
+            new_block->terminator = clone_terminator(*src->terminator);
         }
+        remap_block(*new_block, local_offset, block_map, callee.return_local, call_data);
+        caller.basic_blocks.push_back(std::move(new_block));
     }
 
+    // 引数の受け渡しは呼び出しブロックの末尾で行う
+    // （呼び出し先の入口がループヘッダでも1回だけ実行される）
     auto& call_block = caller.basic_blocks[call_block_id];
+    for (size_t i = 0; i < call_data.args.size() && i < callee.arg_locals.size(); ++i) {
+        MirPlace place{callee.arg_locals[i] + local_offset};
+        call_block->statements.push_back(
+            MirStatement::assign(std::move(place), MirRvalue::use(clone_operand(*call_data.args[i]))));
+    }
 
-    BlockId entry_id = block_map[callee.entry_block];
+    BlockId entry_id =
+        callee.entry_block < block_map.size() ? block_map[callee.entry_block] : INVALID_BLOCK;
     if (entry_id != INVALID_BLOCK) {
         call_block->terminator = MirTerminator::goto_block(entry_id);
     } else {
@@ -270,6 +491,9 @@ MirTerminatorPtr FunctionInlining::clone_terminator(const MirTerminator& src) {
         nd.interface_name = d.interface_name;
         nd.method_name = d.method_name;
         nd.is_virtual = d.is_virtual;
+        nd.is_tail_call = d.is_tail_call;
+        nd.is_awaited = d.is_awaited;
+        nd.is_pure = d.is_pure;
         term->data = std::move(nd);
     }
     return term;
@@ -278,6 +502,7 @@ MirTerminatorPtr FunctionInlining::clone_terminator(const MirTerminator& src) {
 MirOperandPtr FunctionInlining::clone_operand(const MirOperand& src) {
     auto op = std::make_unique<MirOperand>();
     op->kind = src.kind;
+    op->type = src.type;
     if (std::holds_alternative<MirPlace>(src.data)) {
         op->data = clone_place(std::get<MirPlace>(src.data));
     } else if (std::holds_alternative<MirConstant>(src.data)) {
@@ -326,7 +551,7 @@ MirRvaluePtr FunctionInlining::clone_rvalue(const MirRvalue& src) {
 }
 
 void FunctionInlining::remap_block(BasicBlock& block, LocalId local_offset,
-                                   const std::vector<BlockId>& block_map,
+                                   const std::vector<BlockId>& block_map, LocalId return_local,
                                    const MirTerminator::CallData& call_data) {
     for (auto& stmt : block.statements) {
         remap_statement(*stmt, local_offset);
@@ -335,9 +560,8 @@ void FunctionInlining::remap_block(BasicBlock& block, LocalId local_offset,
     if (block.terminator) {
         if (block.terminator->kind == MirTerminator::Return) {
             if (call_data.destination) {
-                LocalId callee_ret_id = 0;
                 MirPlace dest = *call_data.destination;
-                MirPlace src{callee_ret_id + local_offset};
+                MirPlace src{return_local + local_offset};
                 MirRvaluePtr rv = MirRvalue::use(MirOperand::move(src));
                 auto stmt = MirStatement::assign(std::move(dest), std::move(rv));
                 block.statements.push_back(std::move(stmt));
@@ -9,6 +9,7 @@
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <variant>
 #include <vector>
 
@@ -16,6 +17,10 @@ namespace cm::mir::opt {
 
 // ============================================================
 // 関数インライン化
+// 呼び出しグラフの強連結成分を葉側から処理するボトムアップ方式。
+// 呼び出し先のコスト（文の重み付き合計）を呼び出し箇所ごとの閾値と比較する。
+// 閾値は定数引数・ループの深さ・唯一の呼び出し箇所でボーナスを受け、
+// 深いループ内の呼び出しから順に呼び出し元の肥大化上限まで展開する。
 // ============================================================
 class FunctionInlining : public OptimizationPass {
    public:
@@ -23,24 +28,50 @@ class FunctionInlining : public OptimizationPass {
 
     bool run(MirFunction& /*func*/) override { return false; }
 
+    bool is_interprocedural() const override { return true; }
+
     bool run_on_program(MirProgram& program) override;
 
+    // 関数のコスト（文・終端命令の重みの合計）
+    static size_t function_cost(const MirFunction& func);
+
    private:
-    const size_t INLINE_THRESHOLD = 10;        // より小さい関数のみインライン化
-    const size_t MAX_INLINE_PER_FUNCTION = 2;  // 同じ関数の最大インライン化回数を削減
-    const size_t MAX_TOTAL_INLINES = 20;  // プログラム全体でのインライン化回数制限
-    std::unordered_map<std::string, size_t> inline_counts;
-    bool max_inlines_reached = false;
-
-    bool process_function(MirFunction& caller,
-                          const std::unordered_map<std::string, const MirFunction*>& func_map);
-    bool process_block(MirFunction& caller, BlockId block_id,
-                       const std::unordered_map<std::string, const MirFunction*>& func_map);
-    bool should_inline(const MirFunction& callee);
+    static constexpr size_t BASE_THRESHOLD = 25;        // 基本の閾値
+    static constexpr size_t ALWAYS_INLINE_COST = 5;     // アクセサ程度の関数は常に展開
+    static constexpr size_t CONSTANT_ARG_BONUS = 5;     // 定数引数1つあたり
+    static constexpr size_t LOOP_DEPTH_BONUS = 20;      // ループの深さ1段あたり
+    static constexpr size_t MAX_BONUS_LOOP_DEPTH = 3;   // ボーナスを数える深さの上限
+    static constexpr size_t SINGLE_CALL_SITE_BONUS = 60;  // 呼び出し箇所が1つだけの関数
+    static constexpr size_t MAX_CALLER_COST = 4000;     // 呼び出し元の肥大化上限
+
+    using FunctionMap = std::unordered_map<std::string, MirFunction*>;
+
+    struct CallSite {
+        BlockId block;
+        size_t loop_depth;
+    };
+
+    // 呼び出しグラフ
+    static const std::string* callee_name(const MirTerminator::CallData& call);
+    std::vector<std::vector<MirFunction*>> bottom_up_sccs(const MirProgram& program,
+                                                          const FunctionMap& func_map);
+    void count_uses(const MirProgram& program);
+
+    bool process_function(MirFunction& caller, const FunctionMap& func_map,
+                          const std::unordered_set<const MirFunction*>& scc);
+    bool is_inlinable(const MirFunction& callee) const;
+    bool arguments_match(const MirFunction& caller, const MirFunction& callee,
+                         const MirTerminator::CallData& call) const;
+    size_t threshold_for(const MirFunction& callee, const MirTerminator::CallData& call,
+                         size_t loop_depth) const;
 
     void perform_inlining(MirFunction& caller, BlockId call_block_id, const MirFunction& callee,
                           const MirTerminator::CallData& call_data);
 
+    // 実行ごとの状態
+    std::unordered_map<std::string, size_t> use_counts;  // 呼び出し・参照の箇所数
+    std::unordered_map<const MirFunction*, size_t> costs;
+
     // クローン関数
     MirStatementPtr clone_statement(const MirStatement& src);
     MirTerminatorPtr clone_terminator(const MirTerminator& src);
@@ -50,7 +81,7 @@ class FunctionInlining : public OptimizationPass {
 
     // リマップ関数
     void remap_block(BasicBlock& block, LocalId local_offset, const std::vector<BlockId>& block_map,
-                     const MirTerminator::CallData& call_data);
+                     LocalId return_local, const MirTerminator::CallData& call_data);
     void remap_statement(MirStatement& stmt, LocalId offset);
     void remap_terminator(MirTerminator& term, LocalId lo, const std::vector<BlockId>& bm);
     void remap_place(MirPlace& p, LocalId offset);
@@ -3,11 +3,18 @@
 namespace cm::mir::opt {
 
 bool LoopInvariantCodeMotion::run(MirFunction& func) {
+    FunctionAnalysisManager analyses;
+    return run_with_analyses(func, analyses);
+}
+
+bool LoopInvariantCodeMotion::run_with_analyses(MirFunction& func,
+                                                FunctionAnalysisManager& analyses) {
     bool changed = false;
+    size_t num_blocks = func.basic_blocks.size();
 
-    // 1. Dominator Tree & Loop Analysis構築
-    cm::mir::DominatorTree dom_tree(func);
-    cm::mir::LoopAnalysis loop_analysis(func, dom_tree);
+    // 1. Loop Analysis（支配木とともに解析マネージャのキャッシュから取得）
+    //    Pre-header作成でCFGが変わるが、この実行中は最初の解析結果を使い続ける
+    const auto& loop_analysis = analyses.loops(func);
 
     // 2. ループごとに処理（内側から外側へ）
     for (auto* loop : loop_analysis.get_top_level_loops()) {
@@ -16,6 +23,11 @@ bool LoopInvariantCodeMotion::run(MirFunction& func) {
         }
     }
 
+    // 命令を移動しなくてもPre-headerを作った場合はCFGが変わっている
+    if (!changed && func.basic_blocks.size() != num_blocks) {
+        analyses.invalidate(func, PreservedAnalyses::none());
+    }
+
     return changed;
 }
 
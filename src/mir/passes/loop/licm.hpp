@@ -1,7 +1,5 @@
 #pragma once
 
-#include "../../analysis/dominators.hpp"
-#include "../../analysis/loop_analysis.hpp"
 #include "../../nodes.hpp"
 #include "../core/base.hpp"
 
@@ -21,6 +19,7 @@ class LoopInvariantCodeMotion : public OptimizationPass {
     std::string name() const override { return "LoopInvariantCodeMotion"; }
 
     bool run(MirFunction& func) override;
+    bool run_with_analyses(MirFunction& func, FunctionAnalysisManager& analyses) override;
 
    private:
     bool process_loop(MirFunction& func, cm::mir::Loop* loop);
@@ -1,213 +1,775 @@
 #include "gvn.hpp"
 
+#include <cstring>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 namespace cm::mir::opt {
 
-bool GVN::run(MirFunction& func) {
-    bool changed = false;
+namespace {
 
-    for (auto& block : func.basic_blocks) {
-        if (!block)
-            continue;
-        changed |= process_block(*block);
+// 値番号表のキー（演算の種類 + 最大3つの値番号/属性）
+// 引数の多い呼び出しや射影の連鎖は、ArgList/Field等の中間キーを畳み込んで表す
+struct ExprKey {
+    uint32_t tag;
+    uint32_t a;
+    uint32_t b;
+    uint32_t c;
+
+    bool operator==(const ExprKey& other) const = default;
+};
+
+struct ExprKeyHash {
+    size_t operator()(const ExprKey& k) const {
+        uint64_t h = ((static_cast<uint64_t>(k.tag) << 32) | k.a) * 0x9E3779B97F4A7C15ull;
+        uint64_t l = (static_cast<uint64_t>(k.b) << 32) | k.c;
+        h ^= l + 0x7F4A7C159E3779B9ull + (h << 6) + (h >> 2);
+        return static_cast<size_t>(h);
     }
+};
 
-    return changed;
+enum class ExprTag : uint32_t {
+    Constant,
+    Binary,
+    Unary,
+    Cast,
+    Function,
+    Field,
+    Index,
+    Deref,
+    Load,
+    ArgList,
+    PureCall,
+};
+
+uint32_t make_tag(ExprTag tag, uint32_t sub = 0) {
+    return (static_cast<uint32_t>(tag) << 8) | sub;
 }
 
-bool GVN::process_block(BasicBlock& block) {
-    bool changed = false;
+bool is_commutative(MirBinaryOp op) {
+    switch (op) {
+        case MirBinaryOp::Add:
+        case MirBinaryOp::Mul:
+        case MirBinaryOp::BitAnd:
+        case MirBinaryOp::BitOr:
+        case MirBinaryOp::BitXor:
+        case MirBinaryOp::Eq:
+        case MirBinaryOp::Ne:
+        case MirBinaryOp::And:
+        case MirBinaryOp::Or:
+            return true;
+        default:
+            return false;
+    }
+}
 
-    // 式の文字列表現 -> 結果を保持するLocalId
-    std::unordered_map<std::string, LocalId> available_exprs;
+// 値を1つのレジスタに保持できる型（コピーで複製できるスカラー）
+bool is_scalar_type(const hir::TypePtr& type) {
+    if (!type) {
+        return false;
+    }
+    if (type->kind == hir::TypeKind::Void || type->kind == hir::TypeKind::String) {
+        return false;
+    }
+    return type->is_primitive() || type->kind == hir::TypeKind::Pointer ||
+           type->kind == hir::TypeKind::Reference;
+}
 
-    // 変数 -> その変数を使用している式の集合（無効化用）
-    std::unordered_map<LocalId, std::unordered_set<std::string>> var_to_exprs;
+// volatile修飾された型か
+bool is_volatile_type(const hir::TypePtr& type) {
+    return type && type->qualifiers.is_volatile;
+}
 
-    for (auto& stmt : block.statements) {
-        if (stmt->kind == MirStatement::Nop)
-            continue;
+// 支配木上の1関数分の値番号付け
+//
+// ローカル変数は次の3種類に分けて値番号を持つ:
+// - SSA的ローカル: 定義が1箇所でその定義が全使用を支配する → 関数全体で1つの値番号
+// - その他のレジスタ的ローカル: 拡大基本ブロック（唯一の先行ブロックが即時支配ブロック）
+//   の中でだけ値番号を引き継ぎ、合流点では新しい値番号になる
+// - メモリ上のローカル（アドレスを取られた変数・集約型）: 読み出しは
+//   「基底の版 + メモリの版」をキーとするロードとして扱う
+// - volatileな場所（グローバル・static・volatile修飾型）: 読み出しごとに新しい値番号
+// メモリの版はポインタ経由/射影付きの書き込み・純粋でない呼び出し・asmで更新する。
+class ValueNumbering {
+   public:
+    ValueNumbering(MirFunction& f, const DominatorTree& dom, const DefUseChains& def_use)
+        : func(f), dom_tree(dom), cfg(dom.cfg()) {
+        classify_locals(def_use);
+    }
+
+    bool run();
+
+   private:
+    struct LocalValue {
+        uint32_t vn = 0;
+        uint32_t generation = 0;
+    };
+
+    struct LeaderUndo {
+        uint32_t vn;
+        LocalId previous;
+        bool existed;
+    };
+
+    struct Frame {
+        BlockId block;
+        size_t next_child;
+        size_t value_mark;
+        size_t leader_mark;
+        uint32_t generation;
+        uint32_t memory;
+    };
+
+    void classify_locals(const DefUseChains& def_use);
+    bool is_strict_def(const InstructionSite& def, const std::vector<InstructionSite>& uses) const;
+
+    bool process_block(BlockId block_id, bool inherit);
+    bool process_assign(MirStatement& stmt);
+    bool process_call(BasicBlock& block);
+
+    uint32_t fresh() { return next_vn++; }
+
+    uint32_t intern(ExprKey key) {
+        auto [it, inserted] = table.try_emplace(key, next_vn);
+        if (inserted) {
+            ++next_vn;
+        }
+        return it->second;
+    }
+
+    uint32_t type_id(const hir::TypePtr& type);
+    uint32_t function_id(const std::string& name);
+
+    uint32_t current_value(LocalId local);
+    void set_value(LocalId local, uint32_t vn);
+    uint32_t local_vn(LocalId local);
+    uint32_t place_vn(const MirPlace& place);
+    bool is_volatile_place(const MirPlace& place) const;
+    uint32_t constant_vn(const MirConstant& constant, const hir::TypePtr& operand_type);
+    uint32_t operand_vn(const MirOperand& op);
+
+    // 右辺値の値番号（second: 既存の値で置き換えられる式か）
+    std::pair<uint32_t, bool> rvalue_vn(const MirRvalue& rvalue);
+
+    void define(LocalId local, uint32_t vn);
+    void write_place(const MirPlace& place);
+
+    bool holds(LocalId local, uint32_t vn) const;
+    std::optional<LocalId> find_leader(uint32_t vn, LocalId exclude) const;
+    void set_leader(uint32_t vn, LocalId local);
+
+    MirOperandPtr copy_of(LocalId local) const {
+        const auto& type = func.locals[local].type;
+        return MirOperand::copy(MirPlace{local, type}, type);
+    }
+
+    MirFunction& func;
+    const DominatorTree& dom_tree;
+    const ControlFlowGraph& cfg;
+
+    std::vector<bool> is_register;
+    std::vector<bool> is_volatile;  // 読むたびにメモリから読み直すローカル（グローバル・static）
+    std::vector<bool> is_ssa;
+    std::vector<uint32_t> ssa_values;
+    std::vector<LocalValue> values;
+
+    uint32_t next_vn = 1;
+    uint32_t generation = 0;
+    uint32_t next_generation = 1;
+    uint32_t memory = 0;
+
+    std::unordered_map<ExprKey, uint32_t, ExprKeyHash> table;
+    std::unordered_map<uint32_t, LocalId> leaders;
+
+    // 支配木の部分木を抜けるときに巻き戻す変更履歴
+    std::vector<std::pair<LocalId, LocalValue>> value_log;
+    std::vector<LeaderUndo> leader_log;
+
+    // 0: 型なし、1..: プリミティブ型、FIRST_DERIVED_TYPE_ID..: 派生型
+    static constexpr uint32_t FIRST_DERIVED_TYPE_ID = 64;
+    std::unordered_map<const hir::Type*, uint32_t> type_ids;
+    std::unordered_map<std::string, uint32_t> function_ids;
+};
+
+void ValueNumbering::classify_locals(const DefUseChains& def_use) {
+    size_t n = func.locals.size();
+    std::vector<bool> address_taken(n, false);
+    std::vector<bool> partially_written(n, false);
+    std::vector<bool> has_storage(n, false);
+
+    auto note_write = [&](const MirPlace& place) {
+        if (!place.projections.empty() && place.projections.front().kind != ProjectionKind::Deref &&
+            place.local < n) {
+            partially_written[place.local] = true;
+        }
+    };
 
-        // ASMステートメント: 出力オペランドの変数は変更されるため式を無効化
-        if (stmt->kind == MirStatement::Asm) {
-            const auto& asm_data = std::get<MirStatement::AsmData>(stmt->data);
-            for (const auto& operand : asm_data.operands) {
-                if (!operand.constraint.empty() &&
-                    (operand.constraint[0] == '+' || operand.constraint[0] == '=')) {
-                    invalidate_exprs_using(operand.local_id, available_exprs, var_to_exprs);
+    for (const auto& block : func.basic_blocks) {
+        if (!block)
+            continue;
+        for (const auto& stmt : block->statements) {
+            if (stmt->kind == MirStatement::Assign) {
+                const auto& data = std::get<MirStatement::AssignData>(stmt->data);
+                note_write(data.place);
+                if (data.rvalue && data.rvalue->kind == MirRvalue::Ref) {
+                    const auto& ref = std::get<MirRvalue::RefData>(data.rvalue->data);
+                    if (ref.place.local < n)
+                        address_taken[ref.place.local] = true;
                 }
+            } else if (stmt->kind == MirStatement::Asm) {
+                const auto& data = std::get<MirStatement::AsmData>(stmt->data);
+                for (const auto& operand : data.operands) {
+                    if (!operand.is_constant && operand.local_id < n)
+                        address_taken[operand.local_id] = true;
+                }
+            } else if (stmt->kind == MirStatement::StorageLive ||
+                       stmt->kind == MirStatement::StorageDead) {
+                const auto& data = std::get<MirStatement::StorageData>(stmt->data);
+                if (data.local < n)
+                    has_storage[data.local] = true;
+            }
+        }
+        if (block->terminator && block->terminator->kind == MirTerminator::Call) {
+            const auto& call = std::get<MirTerminator::CallData>(block->terminator->data);
+            if (call.destination)
+                note_write(*call.destination);
+        }
+    }
+
+    // クロージャがキャプチャした変数は呼び出し先から書き換えられうる
+    for (const auto& local : func.locals) {
+        for (LocalId captured : local.captured_locals) {
+            if (captured < n)
+                address_taken[captured] = true;
+        }
+    }
+
+    is_register.assign(n, false);
+    is_volatile.assign(n, false);
+    is_ssa.assign(n, false);
+    ssa_values.assign(n, 0);
+    values.assign(n, LocalValue{});
+
+    std::vector<bool> is_arg(n, false);
+    for (LocalId arg : func.arg_locals) {
+        if (arg < n)
+            is_arg[arg] = true;
+    }
+
+    for (LocalId id = 0; id < n; ++id) {
+        const auto& decl = func.locals[id];
+        is_register[id] = is_scalar_type(decl.type) && !address_taken[id] && !decl.is_global &&
+                          !decl.is_static;
+        // グローバル・staticはコード生成でvolatileアクセスになる（他スレッド・割り込みから見える）
+        is_volatile[id] = decl.is_global || decl.is_static || is_volatile_type(decl.type);
+        if (!is_register[id] || partially_written[id] || has_storage[id])
+            continue;
+
+        const auto& defs = def_use.defs(id);
+        if (defs.empty()) {
+            // 代入されない引数は関数全体で入口の値を保つ
+            if (is_arg[id]) {
+                is_ssa[id] = true;
+                ssa_values[id] = fresh();
             }
+        } else if (defs.size() == 1 && is_strict_def(defs.front(), def_use.uses(id))) {
+            is_ssa[id] = true;
+        }
+    }
+}
+
+// 唯一の定義がすべての（到達可能な）使用を支配するか
+bool ValueNumbering::is_strict_def(const InstructionSite& def,
+                                   const std::vector<InstructionSite>& uses) const {
+    if (!cfg.is_reachable(def.block))
+        return false;
+
+    BlockId def_block = def.block;
+    bool before_block = false;  // 定義がdef_blockの先頭より前にあるか
+    if (def.is_terminator()) {
+        // Callの戻り値は成功側の遷移先の先頭で定義されたとみなす
+        const auto& term = func.basic_blocks[def.block]->terminator;
+        if (!term || term->kind != MirTerminator::Call)
+            return false;
+        const auto& call = std::get<MirTerminator::CallData>(term->data);
+        if (call.unwind || call.success >= cfg.size() || cfg.predecessors(call.success).size() != 1)
+            return false;
+        def_block = call.success;
+        before_block = true;
+    }
+
+    for (const auto& use : uses) {
+        if (!cfg.is_reachable(use.block))
             continue;
+        if (use.block == def_block) {
+            if (!before_block && use.index <= def.index)
+                return false;
+        } else if (!dom_tree.dominates(def_block, use.block)) {
+            return false;
         }
+    }
+    return true;
+}
+
+uint32_t ValueNumbering::type_id(const hir::TypePtr& type) {
+    if (!type)
+        return 0;
+    if (type->is_primitive())
+        return static_cast<uint32_t>(type->kind) + 1;
+
+    auto it = type_ids.find(type.get());
+    if (it != type_ids.end())
+        return it->second;
+
+    // 派生型は型インターナーのIDで同一視する（型オブジェクトごとに1回だけ問い合わせ）
+    uint32_t id = hir::TypeInterner::instance().intern(type) + FIRST_DERIVED_TYPE_ID;
+    type_ids.emplace(type.get(), id);
+    return id;
+}
+
+uint32_t ValueNumbering::function_id(const std::string& name) {
+    auto it = function_ids.find(name);
+    if (it != function_ids.end())
+        return it->second;
+    uint32_t id = static_cast<uint32_t>(function_ids.size()) + 1;
+    function_ids.emplace(name, id);
+    return id;
+}
+
+// SSA的でないローカルの現在の値番号（別の世代で付けた値は無効）
+uint32_t ValueNumbering::current_value(LocalId local) {
+    if (values[local].generation != generation) {
+        set_value(local, fresh());
+    }
+    return values[local].vn;
+}
+
+void ValueNumbering::set_value(LocalId local, uint32_t vn) {
+    value_log.emplace_back(local, values[local]);
+    values[local] = LocalValue{vn, generation};
+}
 
-        // 1. この文が変数を変更する場合、その変数に依存する式を無効化
-        if (stmt->kind == MirStatement::Assign) {
-            auto& assign_data = std::get<MirStatement::AssignData>(stmt->data);
+uint32_t ValueNumbering::local_vn(LocalId local) {
+    if (local >= values.size())
+        return fresh();
+    if (is_ssa[local]) {
+        // 定義より前の読み出しは起こらないが、念のため一時的な値にする
+        return ssa_values[local] ? ssa_values[local] : fresh();
+    }
+    uint32_t base = current_value(local);
+    if (is_register[local])
+        return base;
+    if (is_volatile[local])
+        return fresh();
+    return intern({make_tag(ExprTag::Load), base, memory, 0});
+}
 
-            LocalId target_base = assign_data.place.local;
-            invalidate_exprs_using(target_base, available_exprs, var_to_exprs);
+uint32_t ValueNumbering::place_vn(const MirPlace& place) {
+    if (place.local >= values.size())
+        return fresh();
+    if (place.projections.empty())
+        return local_vn(place.local);
+
+    // volatileな読み出しは毎回別の値（同じ場所の読み出しを1つにまとめない）
+    if (is_volatile_place(place))
+        return fresh();
+
+    uint32_t cur = is_register[place.local] ? local_vn(place.local) : current_value(place.local);
+    for (const auto& proj : place.projections) {
+        switch (proj.kind) {
+            case ProjectionKind::Field:
+                cur = intern({make_tag(ExprTag::Field), cur, proj.field_id, 0});
+                break;
+            case ProjectionKind::Index:
+                cur = intern({make_tag(ExprTag::Index), cur, local_vn(proj.index_local), 0});
+                break;
+            case ProjectionKind::Deref:
+                cur = intern({make_tag(ExprTag::Deref), cur, 0, 0});
+                break;
+        }
+    }
+    return intern({make_tag(ExprTag::Load), cur, memory, 0});
+}
 
-            // Deref代入の場合、全式を無効化（保守的）
-            for (const auto& proj : assign_data.place.projections) {
-                if (proj.kind == ProjectionKind::Deref) {
-                    available_exprs.clear();
-                    var_to_exprs.clear();
+bool ValueNumbering::is_volatile_place(const MirPlace& place) const {
+    if (is_volatile[place.local] || is_volatile_type(place.type))
+        return true;
+    for (const auto& proj : place.projections) {
+        if (is_volatile_type(proj.result_type) || is_volatile_type(proj.pointee_type))
+            return true;
+    }
+    return false;
+}
+
+uint32_t ValueNumbering::constant_vn(const MirConstant& constant,
+                                     const hir::TypePtr& operand_type) {
+    uint32_t ty = type_id(constant.type ? constant.type : operand_type);
+    uint64_t bits = 0;
+    if (const auto* b = std::get_if<bool>(&constant.value)) {
+        bits = *b ? 1 : 0;
+    } else if (const auto* i = std::get_if<int64_t>(&constant.value)) {
+        bits = static_cast<uint64_t>(*i);
+    } else if (const auto* d = std::get_if<double>(&constant.value)) {
+        std::memcpy(&bits, d, sizeof(bits));
+    } else if (const auto* c = std::get_if<char>(&constant.value)) {
+        bits = static_cast<unsigned char>(*c);
+    } else if (std::holds_alternative<std::string>(constant.value)) {
+        // 文字列定数は内容を比較しない
+        return fresh();
+    }
+    uint32_t sub = static_cast<uint32_t>(constant.value.index());
+    return intern({make_tag(ExprTag::Constant, sub), static_cast<uint32_t>(bits),
+                   static_cast<uint32_t>(bits >> 32), ty});
+}
+
+uint32_t ValueNumbering::operand_vn(const MirOperand& op) {
+    switch (op.kind) {
+        case MirOperand::Move:
+        case MirOperand::Copy:
+            return place_vn(std::get<MirPlace>(op.data));
+        case MirOperand::Constant:
+            return constant_vn(std::get<MirConstant>(op.data), op.type);
+        case MirOperand::FunctionRef:
+            return intern({make_tag(ExprTag::Function),
+                           function_id(std::get<std::string>(op.data)), 0, 0});
+    }
+    return fresh();
+}
+
+std::pair<uint32_t, bool> ValueNumbering::rvalue_vn(const MirRvalue& rvalue) {
+    switch (rvalue.kind) {
+        case MirRvalue::Use: {
+            const auto& data = std::get<MirRvalue::UseData>(rvalue.data);
+            if (!data.operand)
+                break;
+            const auto& op = *data.operand;
+            if (op.kind == MirOperand::Move || op.kind == MirOperand::Copy) {
+                const auto& place = std::get<MirPlace>(op.data);
+                // レジスタ的ローカルのコピーは値番号を引き継ぐだけ、それ以外はロード
+                bool is_load = !place.projections.empty() ||
+                               (place.local < values.size() && !is_register[place.local]);
+                return {place_vn(place), is_load};
+            }
+            return {operand_vn(op), false};
+        }
+        case MirRvalue::BinaryOp: {
+            const auto& data = std::get<MirRvalue::BinaryOpData>(rvalue.data);
+            if (!data.lhs || !data.rhs)
+                break;
+            uint32_t lhs = operand_vn(*data.lhs);
+            uint32_t rhs = operand_vn(*data.rhs);
+            MirBinaryOp op = data.op;
+            // a > b は b < a、可換演算はオペランドを値番号順に正規化
+            if (op == MirBinaryOp::Gt || op == MirBinaryOp::Ge) {
+                op = op == MirBinaryOp::Gt ? MirBinaryOp::Lt : MirBinaryOp::Le;
+                std::swap(lhs, rhs);
+            } else if (is_commutative(op) && lhs > rhs) {
+                std::swap(lhs, rhs);
+            }
+            return {intern({make_tag(ExprTag::Binary, static_cast<uint32_t>(op)), lhs, rhs,
+                            type_id(data.result_type)}),
+                    true};
+        }
+        case MirRvalue::UnaryOp: {
+            const auto& data = std::get<MirRvalue::UnaryOpData>(rvalue.data);
+            if (!data.operand)
+                break;
+            return {intern({make_tag(ExprTag::Unary, static_cast<uint32_t>(data.op)),
+                            operand_vn(*data.operand), 0, 0}),
+                    true};
+        }
+        case MirRvalue::Cast: {
+            const auto& data = std::get<MirRvalue::CastData>(rvalue.data);
+            if (!data.operand)
+                break;
+            return {intern({make_tag(ExprTag::Cast), operand_vn(*data.operand),
+                            type_id(data.target_type), 0}),
+                    true};
+        }
+        default:
+            break;
+    }
+    return {fresh(), false};
+}
+
+// 射影なしの代入先への定義
+void ValueNumbering::define(LocalId local, uint32_t vn) {
+    if (local >= values.size())
+        return;
+    if (is_ssa[local]) {
+        ssa_values[local] = vn;
+    } else if (is_register[local]) {
+        set_value(local, vn);
+    } else {
+        // メモリ上のローカルはポインタ経由の読み出しと別名になりうる
+        set_value(local, fresh());
+        memory = fresh();
+    }
+}
+
+// 射影付きの代入先（部分更新・ポインタ経由の書き込み）
+void ValueNumbering::write_place(const MirPlace& place) {
+    memory = fresh();
+    if (place.projections.front().kind != ProjectionKind::Deref && place.local < values.size() &&
+        !is_ssa[place.local]) {
+        set_value(place.local, fresh());
+    }
+}
+
+bool ValueNumbering::holds(LocalId local, uint32_t vn) const {
+    if (is_ssa[local])
+        return ssa_values[local] == vn;
+    return values[local].generation == generation && values[local].vn == vn;
+}
+
+std::optional<LocalId> ValueNumbering::find_leader(uint32_t vn, LocalId exclude) const {
+    auto it = leaders.find(vn);
+    if (it == leaders.end() || it->second == exclude || !holds(it->second, vn))
+        return std::nullopt;
+    return it->second;
+}
+
+void ValueNumbering::set_leader(uint32_t vn, LocalId local) {
+    auto it = leaders.find(vn);
+    if (it != leaders.end()) {
+        leader_log.push_back({vn, it->second, true});
+        it->second = local;
+    } else {
+        leader_log.push_back({vn, 0, false});
+        leaders.emplace(vn, local);
+    }
+}
+
+bool ValueNumbering::process_assign(MirStatement& stmt) {
+    auto& data = std::get<MirStatement::AssignData>(stmt.data);
+    const auto& place = data.place;
+
+    if (stmt.no_opt || !data.rvalue) {
+        if (place.projections.empty())
+            define(place.local, fresh());
+        else
+            write_place(place);
+        return false;
+    }
+
+    auto [vn, reusable] = rvalue_vn(*data.rvalue);
+    if (!place.projections.empty()) {
+        write_place(place);
+        return false;
+    }
+
+    LocalId target = place.local;
+    if (!reusable || target >= values.size() || !is_register[target]) {
+        define(target, vn);
+        return false;
+    }
+
+    bool changed = false;
+    auto leader = find_leader(vn, target);
+    if (leader) {
+        // 同じ値を保持しているローカルからのコピーに置き換え
+        data.rvalue = MirRvalue::use(copy_of(*leader));
+        changed = true;
+    }
+    define(target, vn);
+    if (!leader && holds(target, vn))
+        set_leader(vn, target);
+    return changed;
+}
+
+bool ValueNumbering::process_call(BasicBlock& block) {
+    auto& call = std::get<MirTerminator::CallData>(block.terminator->data);
+
+    auto define_destination = [&](uint32_t vn) {
+        if (!call.destination)
+            return;
+        if (call.destination->projections.empty())
+            define(call.destination->local, vn);
+        else
+            write_place(*call.destination);
+    };
+
+    // 再利用できる純粋呼び出し: 例外経路がなく、戻り値をレジスタ的ローカルに受けるもの
+    bool reusable = call.is_pure && !call.is_virtual && call.interface_name.empty() &&
+                    !call.unwind && call.func && call.destination &&
+                    call.destination->projections.empty() &&
+                    call.destination->local < values.size() &&
+                    is_register[call.destination->local];
+
+    const std::string* callee = nullptr;
+    if (reusable) {
+        if (call.func->kind == MirOperand::FunctionRef) {
+            callee = &std::get<std::string>(call.func->data);
+        } else if (call.func->kind == MirOperand::Constant) {
+            callee = std::get_if<std::string>(&std::get<MirConstant>(call.func->data).value);
+        }
+    }
+    if (reusable && callee) {
+        // ムーブされる非スカラー引数がある呼び出しは消すと所有権が変わるため残す
+        for (const auto& arg : call.args) {
+            if (arg->kind == MirOperand::Move) {
+                LocalId local = std::get<MirPlace>(arg->data).local;
+                if (local >= values.size() || !is_register[local]) {
+                    callee = nullptr;
                     break;
                 }
             }
-        } else if (stmt->kind == MirStatement::StorageLive ||
-                   stmt->kind == MirStatement::StorageDead) {
-            auto& storage_data = std::get<MirStatement::StorageData>(stmt->data);
-            invalidate_exprs_using(storage_data.local, available_exprs, var_to_exprs);
-        }
-
-        // 2. 代入文の場合、CSEのチャンスを探す
-        if (stmt->kind == MirStatement::Assign) {
-            auto& assign_data = std::get<MirStatement::AssignData>(stmt->data);
-
-            if (assign_data.place.projections.empty()) {
-                LocalId target = assign_data.place.local;
-
-                if (assign_data.rvalue) {
-                    std::string expr_key = stringify_rvalue(*assign_data.rvalue);
-
-                    if (!expr_key.empty()) {
-                        auto it = available_exprs.find(expr_key);
-                        if (it != available_exprs.end()) {
-                            // 共通部分式を発見
-                            LocalId source = it->second;
-
-                            if (target != source) {
-                                auto new_operand = MirOperand::copy(MirPlace{source});
-                                assign_data.rvalue = MirRvalue::use(std::move(new_operand));
-                                changed = true;
-                            }
-                        } else {
-                            available_exprs[expr_key] = target;
-
-                            std::unordered_set<LocalId> dependencies;
-                            collect_dependencies(*assign_data.rvalue, dependencies);
-                            for (LocalId dep : dependencies) {
-                                var_to_exprs[dep].insert(expr_key);
-                            }
-                        }
+        }
+    }
+
+    if (!callee) {
+        if (!call.is_pure)
+            memory = fresh();
+        define_destination(fresh());
+        return false;
+    }
+
+    uint32_t args = 0;
+    for (const auto& arg : call.args) {
+        args = intern({make_tag(ExprTag::ArgList), args, operand_vn(*arg), 0});
+    }
+    uint32_t vn = intern({make_tag(ExprTag::PureCall), function_id(*callee), args, memory});
+
+    LocalId dest = call.destination->local;
+    auto leader = find_leader(vn, dest);
+    if (leader) {
+        // 呼び出しを「戻り値 = copy leader; goto success」に置き換え（CFGの形は変えない）
+        Span span = block.terminator->span;
+        MirPlace place = *call.destination;
+        BlockId success = call.success;
+        block.statements.push_back(
+            MirStatement::assign(std::move(place), MirRvalue::use(copy_of(*leader)), span));
+        block.terminator = MirTerminator::goto_block(success, span);
+        define(dest, vn);
+        return true;
+    }
+
+    define_destination(vn);
+    if (holds(dest, vn))
+        set_leader(vn, dest);
+    return false;
+}
+
+bool ValueNumbering::process_block(BlockId block_id, bool inherit) {
+    if (!inherit) {
+        // 合流点（または例外経路）: SSA的でない値とメモリの状態は引き継がない
+        generation = next_generation++;
+        memory = fresh();
+    }
+
+    auto& block = *func.basic_blocks[block_id];
+    bool changed = false;
+
+    for (auto& stmt : block.statements) {
+        switch (stmt->kind) {
+            case MirStatement::Assign:
+                changed |= process_assign(*stmt);
+                break;
+            case MirStatement::Asm: {
+                const auto& data = std::get<MirStatement::AsmData>(stmt->data);
+                for (const auto& operand : data.operands) {
+                    if (!operand.is_constant && !operand.constraint.empty() &&
+                        (operand.constraint[0] == '+' || operand.constraint[0] == '=')) {
+                        define(operand.local_id, fresh());
                     }
                 }
+                memory = fresh();
+                break;
             }
+            case MirStatement::StorageLive:
+            case MirStatement::StorageDead:
+                define(std::get<MirStatement::StorageData>(stmt->data).local, fresh());
+                break;
+            case MirStatement::Nop:
+                break;
         }
     }
 
+    if (block.terminator && block.terminator->kind == MirTerminator::Call) {
+        changed |= process_call(block);
+    }
     return changed;
 }
 
-void GVN::invalidate_exprs_using(
-    LocalId local, std::unordered_map<std::string, LocalId>& available_exprs,
-    std::unordered_map<LocalId, std::unordered_set<std::string>>& var_to_exprs) {
-    // この変数を使用しているすべての式を削除
-    auto it = var_to_exprs.find(local);
-    if (it != var_to_exprs.end()) {
-        for (const auto& expr_key : it->second) {
-            available_exprs.erase(expr_key);
-        }
-        var_to_exprs.erase(it);
-    }
-
-    // この変数が「結果」となっている式も削除
-    for (auto it2 = available_exprs.begin(); it2 != available_exprs.end();) {
-        if (it2->second == local) {
-            it2 = available_exprs.erase(it2);
-        } else {
-            ++it2;
-        }
-    }
-}
-
-void GVN::collect_dependencies(const MirRvalue& rvalue, std::unordered_set<LocalId>& deps) {
-    if (const auto* bin = std::get_if<MirRvalue::BinaryOpData>(&rvalue.data)) {
-        if (bin->lhs)
-            collect_operand_deps(*bin->lhs, deps);
-        if (bin->rhs)
-            collect_operand_deps(*bin->rhs, deps);
-    } else if (const auto* un = std::get_if<MirRvalue::UnaryOpData>(&rvalue.data)) {
-        if (un->operand)
-            collect_operand_deps(*un->operand, deps);
-    } else if (const auto* cast = std::get_if<MirRvalue::CastData>(&rvalue.data)) {
-        if (cast->operand)
-            collect_operand_deps(*cast->operand, deps);
-    }
-}
-
-void GVN::collect_operand_deps(const MirOperand& op, std::unordered_set<LocalId>& deps) {
-    if (const auto* place = std::get_if<MirPlace>(&op.data)) {
-        deps.insert(place->local);
-        for (const auto& p : place->projections) {
-            if (p.kind == ProjectionKind::Index)
-                deps.insert(p.index_local);
-        }
-    }
-}
-
-std::string GVN::stringify_rvalue(const MirRvalue& rvalue) {
-    std::stringstream ss;
-
-    if (const auto* bin = std::get_if<MirRvalue::BinaryOpData>(&rvalue.data)) {
-        ss << "BinOp(" << (int)bin->op << ",";
-        if (bin->lhs)
-            ss << stringify_operand(*bin->lhs);
-        ss << ",";
-        if (bin->rhs)
-            ss << stringify_operand(*bin->rhs);
-        ss << ")";
-        return ss.str();
-    } else if (const auto* un = std::get_if<MirRvalue::UnaryOpData>(&rvalue.data)) {
-        ss << "UnOp(" << (int)un->op << ",";
-        if (un->operand)
-            ss << stringify_operand(*un->operand);
-        ss << ")";
-        return ss.str();
-    } else if (const auto* cast = std::get_if<MirRvalue::CastData>(&rvalue.data)) {
-        ss << "Cast(";
-        if (cast->operand)
-            ss << stringify_operand(*cast->operand);
-        ss << ",";
-        if (cast->target_type)
-            ss << cm::hir::type_to_string(*cast->target_type);
-        ss << ")";
-        return ss.str();
-    }
-
-    return "";
-}
-
-std::string GVN::stringify_operand(const MirOperand& op) {
-    std::stringstream ss;
-    if (op.kind == MirOperand::Constant) {
-        if (const auto* c = std::get_if<MirConstant>(&op.data)) {
-            if (auto* i = std::get_if<int64_t>(&c->value))
-                ss << "C(int," << *i << ")";
-            else if (auto* d = std::get_if<double>(&c->value))
-                ss << "C(dbl," << *d << ")";
-            else if (auto* b = std::get_if<bool>(&c->value))
-                ss << "C(bool," << *b << ")";
-            else if (auto* s = std::get_if<std::string>(&c->value))
-                ss << "C(str," << *s << ")";
-            else
-                ss << "C(other)";
-        }
-    } else if (op.kind == MirOperand::Copy || op.kind == MirOperand::Move) {
-        if (const auto* p = std::get_if<MirPlace>(&op.data)) {
-            ss << "L(" << p->local;
-            for (const auto& proj : p->projections) {
-                if (proj.kind == ProjectionKind::Field)
-                    ss << ".f" << proj.field_id;
-                else if (proj.kind == ProjectionKind::Index)
-                    ss << "[" << proj.index_local << "]";
-                else if (proj.kind == ProjectionKind::Deref)
-                    ss << "*";
+bool ValueNumbering::run() {
+    BlockId entry = func.entry_block;
+    if (entry >= func.basic_blocks.size() || !func.basic_blocks[entry] ||
+        !cfg.is_reachable(entry)) {
+        return false;
+    }
+
+    bool changed = false;
+
+    // 子ブロックに状態を引き継げるか（唯一の先行ブロックが親で、例外経路でない）
+    auto inherits = [&](BlockId child, BlockId parent) {
+        if (cfg.predecessors(child).size() != 1)
+            return false;
+        const auto& term = func.basic_blocks[parent]->terminator;
+        if (term && term->kind == MirTerminator::Call) {
+            const auto& call = std::get<MirTerminator::CallData>(term->data);
+            if (call.unwind && *call.unwind == child)
+                return false;
+        }
+        return true;
+    };
+
+    // 支配木の前順走査（深い木でもスタックを使い切らないよう明示的なスタックで辿る）
+    std::vector<Frame> stack;
+    auto enter = [&](BlockId block, bool inherit) {
+        stack.push_back({block, 0, value_log.size(), leader_log.size(), generation, memory});
+        changed |= process_block(block, inherit);
+    };
+
+    enter(entry, false);
+    while (!stack.empty()) {
+        Frame& frame = stack.back();
+        const auto& children = dom_tree.children(frame.block);
+        if (frame.next_child < children.size()) {
+            BlockId child = children[frame.next_child++];
+            BlockId parent = frame.block;
+            if (child < func.basic_blocks.size() && func.basic_blocks[child]) {
+                enter(child, inherits(child, parent));
             }
-            ss << ")";
+            continue;
         }
+
+        // 部分木を抜ける: このブロック以降の変更を巻き戻す
+        while (value_log.size() > frame.value_mark) {
+            auto [local, value] = value_log.back();
+            value_log.pop_back();
+            values[local] = value;
+        }
+        while (leader_log.size() > frame.leader_mark) {
+            const auto& undo = leader_log.back();
+            if (undo.existed)
+                leaders[undo.vn] = undo.previous;
+            else
+                leaders.erase(undo.vn);
+            leader_log.pop_back();
+        }
+        generation = frame.generation;
+        memory = frame.memory;
+        stack.pop_back();
     }
-    return ss.str();
+
+    return changed;
+}
+
+}  // namespace
+
+bool GVN::run(MirFunction& func) {
+    FunctionAnalysisManager analyses;
+    return run_with_analyses(func, analyses);
+}
+
+bool GVN::run_with_analyses(MirFunction& func, FunctionAnalysisManager& analyses) {
+    if (func.basic_blocks.empty())
+        return false;
+
+    ValueNumbering numbering(func, analyses.dominators(func), analyses.def_use(func));
+    return numbering.run();
 }
 
 }  // namespace cm::mir::opt
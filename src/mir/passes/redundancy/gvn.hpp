@@ -2,36 +2,25 @@
 
 #include "../core/base.hpp"
 
-#include <sstream>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
-#include <variant>
-#include <vector>
 
 namespace cm::mir::opt {
 
 // ============================================================
-// 共通部分式削除 (CSE) / Global Value Numbering (GVN)
-// 現在はLocal CSEのみ実装
+// 大域値番号付け (Global Value Numbering) / 共通部分式削除
+// 支配木を前順に辿り、支配ブロックで計算済みの式を再利用する。
+// 式はオペランドの値番号・演算子・型のハッシュで照合する（可換演算は正規化）。
+// 対象: 二項/単項演算、キャスト、射影経由のロード、#[pure] 関数の呼び出し
 // ============================================================
 class GVN : public OptimizationPass {
    public:
     std::string name() const override { return "GVN/CSE"; }
 
     bool run(MirFunction& func) override;
+    bool run_with_analyses(MirFunction& func, FunctionAnalysisManager& analyses) override;
 
-   private:
-    bool process_block(BasicBlock& block);
-
-    void invalidate_exprs_using(
-        LocalId local, std::unordered_map<std::string, LocalId>& available_exprs,
-        std::unordered_map<LocalId, std::unordered_set<std::string>>& var_to_exprs);
-
-    void collect_dependencies(const MirRvalue& rvalue, std::unordered_set<LocalId>& deps);
-    void collect_operand_deps(const MirOperand& op, std::unordered_set<LocalId>& deps);
-    std::string stringify_rvalue(const MirRvalue& rvalue);
-    std::string stringify_operand(const MirOperand& op);
+    // 文の書き換えのみでCFGは変えない（純粋呼び出しの削除もGotoで同じ遷移先に置き換える）
+    PreservedAnalyses preserved_analyses() const override { return PreservedAnalyses::cfg(); }
 };
 
 }  // namespace cm::mir::opt
@@ -17,6 +17,9 @@ class CopyPropagation : public OptimizationPass {
 
     bool run(MirFunction& func) override;
 
+    // 文の書き換えのみでCFGは変えない
+    PreservedAnalyses preserved_analyses() const override { return PreservedAnalyses::cfg(); }
+
    private:
     // 複数回代入される変数を検出
     std::unordered_set<LocalId> detect_multi_assigned(const MirFunction& func);
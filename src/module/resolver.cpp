@@ -1,5 +1,6 @@
 #include "resolver.hpp"
 
+#include "../common/mapped_file.hpp"
 #include "../frontend/lexer/lexer.hpp"
 #include "../frontend/parser/parser.hpp"
 #include "../hir/lowering/lowering.hpp"
@@ -235,21 +236,15 @@ const mir::MirStruct* ModuleResolver::find_exported_struct(const std::string& mo
 
 std::unique_ptr<hir::HirProgram> ModuleResolver::parse_module_file(
     const std::filesystem::path& path) {
-    // ファイルを読み込む
-    std::ifstream file(path);
-    if (!file) {
+    // ファイルをメモリマップし、字句解析器はマップした領域を直接走査する
+    MappedFile source(path.string());
+    if (!source) {
         return nullptr;
     }
 
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    std::string source = buffer.str();
-
-    // レキサーとパーサーで処理
-    Lexer lex(source);
-    auto tokens = lex.tokenize();
-
-    Parser parser(tokens);
+    // トークンはパーサが必要な分だけ取り出す
+    Lexer lex(source.view());
+    Parser parser(lex);
     auto ast = parser.parse();
 
     // HIRに変換
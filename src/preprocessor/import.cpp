@@ -1,10 +1,13 @@
 #include "import.hpp"
 
+#include "../common/mapped_file.hpp"
+#include "../frontend/lexer/lexer.hpp"
+
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <map>
-#include <regex>
 #include <set>
 #include <sstream>
 
@@ -61,6 +64,110 @@ static bool line_starts_with(const std::string& line, const char* keyword) {
     return starts_with_keyword(line, pos, keyword);
 }
 
+// ========== トークン単位の行スキャナ（std::regex 置換用） ==========
+
+// 1行をLexerでトークン化し、宣言の形をトークンの並びで判定する
+// 空白の量やコメントに左右されず、文字列リテラル内の語も拾わない
+// （呼び出し側は上の高速チェックで候補行を絞ってから使う）
+class LineScanner {
+   public:
+    explicit LineScanner(std::string_view line) : line_(line) {
+        try {
+            Lexer lexer(line);
+            tokens_ = lexer.tokenize();
+        } catch (const std::exception&) {
+            // 範囲外の数値リテラルなど: どのパターンにも一致しない行として扱う
+            tokens_.clear();
+            tokens_.emplace_back(TokenKind::Eof, 0, 0);
+        }
+    }
+
+    // Eofを除いたトークン数
+    size_t size() const { return tokens_.size() - 1; }
+
+    bool is(size_t i, TokenKind kind) const { return at(i).kind == kind; }
+
+    // 英数字と'_'だけからなる語（識別子・予約語・数字列）
+    bool is_word(size_t i) const {
+        std::string_view t = text(i);
+        return !t.empty() && std::all_of(t.begin(), t.end(), [](char c) {
+                   return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+               });
+    }
+
+    std::string_view text(size_t i) const {
+        const Token& t = at(i);
+        return line_.substr(t.start, t.end - t.start);
+    }
+    size_t begin(size_t i) const { return at(i).start; }
+    size_t end(size_t i) const { return at(i).end; }
+
+    // i番目のトークンの直後が空白か（キーワードの後に空白が必要な構文用）
+    bool space_after(size_t i) const {
+        size_t e = end(i);
+        return e < line_.size() && std::isspace(static_cast<unsigned char>(line_[e]));
+    }
+
+    // start以降で最初のkindの位置（なければsize()）
+    size_t find(TokenKind kind, size_t start = 0) const {
+        for (size_t i = start; i < size(); ++i) {
+            if (is(i, kind))
+                return i;
+        }
+        return size();
+    }
+
+   private:
+    const Token& at(size_t i) const { return tokens_[std::min(i, tokens_.size() - 1)]; }
+
+    std::string_view line_;
+    std::vector<Token> tokens_;
+};
+
+// start位置から「module 名前;」が続くなら名前のトークン数、違えば0
+// 名前は語を :: / : / . でつないだもの
+static size_t module_decl_name_length(const LineScanner& s, size_t start = 0) {
+    if (!s.is(start, TokenKind::KwModule) || !s.is_word(start + 1))
+        return 0;
+    size_t i = start + 2;
+    while (s.is(i, TokenKind::ColonColon) || s.is(i, TokenKind::Colon) ||
+           s.is(i, TokenKind::Dot) || s.is_word(i))
+        ++i;
+    return s.is(i, TokenKind::Semicolon) ? i - start - 1 : 0;
+}
+
+// 行が「namespace 名前 {」で始まれば名前、そうでなければ空文字列
+static std::string namespace_opening(const std::string& line) {
+    if (!line_starts_with(line, "namespace"))
+        return "";
+    LineScanner s(line);
+    if (s.is(0, TokenKind::KwNamespace) && s.is_word(1) && s.is(2, TokenKind::LBrace))
+        return std::string(s.text(1));
+    return "";
+}
+
+// 行中のexportキーワード（後ろに空白が続くもの）を後続の空白ごと取り除く
+static std::string strip_export_keyword(const std::string& line) {
+    if (line.find("export") == std::string::npos)
+        return line;
+    LineScanner s(line);
+    std::string out;
+    size_t copied = 0;
+    for (size_t i = 0; i < s.size(); ++i) {
+        if (!s.is(i, TokenKind::KwExport) || !s.space_after(i))
+            continue;
+        size_t e = s.end(i);
+        while (e < line.size() && std::isspace(static_cast<unsigned char>(line[e])))
+            ++e;
+        out.append(line, copied, s.begin(i) - copied);
+        copied = e;
+    }
+    if (copied == 0)
+        return line;
+    out.append(line, copied, std::string::npos);
+    return out;
+}
+
 // 実行ファイルのディレクトリを取得するヘルパー関数
 static std::filesystem::path get_executable_directory() {
 #ifdef __APPLE__
@@ -370,6 +477,11 @@ std::string ImportPreprocessor::process_imports(const std::string& source,
 
             // 再帰的ワイルドカードインポートの処理
             if (import_info.is_recursive_wildcard) {
+                // ディレクトリ内容に依存するため、展開中のモジュールは.cmiに保存しない
+                for (auto* recorder : interface_recorders) {
+                    recorder->cacheable = false;
+                }
+
                 // ディレクトリパスを解決
                 std::filesystem::path base_dir;
                 if (import_info.module_name.substr(0, 2) == "./" ||
@@ -549,6 +661,7 @@ std::string ImportPreprocessor::process_imports(const std::string& source,
 
             // 正規化されたパスを取得
             std::string canonical_path = std::filesystem::canonical(module_path).string();
+            record_touched(canonical_path);
 
             // 循環依存チェック（再インポート防止より先に行う）
             if (std::find(import_stack.begin(), import_stack.end(), canonical_path) !=
@@ -630,10 +743,6 @@ std::string ImportPreprocessor::process_imports(const std::string& source,
                 std::filesystem::relative(module_path, std::filesystem::current_path()).string();
             std::string module_chain = import_chain + " -> " + module_file_str;
 
-            // 再帰呼び出し用のダミーソースマップ（実際のマッピングは出力時に行う）
-            SourceMap dummy_source_map;
-            std::vector<ModuleRange> dummy_module_ranges;
-
             // export抽出用にオリジナルファイル（再帰import展開前）を保存
             std::string raw_module_source;
 
@@ -641,16 +750,15 @@ std::string ImportPreprocessor::process_imports(const std::string& source,
                 module_source = module_cache[canonical_path];
                 // キャッシュからraw sourceも取得
                 raw_module_source = raw_module_cache[canonical_path];
+                // 参照記録を展開中のモジュールへ伝播
+                auto touched_it = module_touched.find(canonical_path);
+                if (touched_it != module_touched.end()) {
+                    record_touched(touched_it->second);
+                }
             } else {
-                // モジュールファイルを読み込む
-                module_source = load_module_file(module_path);
-                // 再帰import展開前のソースを保存（export抽出用）
-                raw_module_source = module_source;
-
-                // モジュール内のインポートを再帰的に処理（ダミーソースマップを使用）
-                module_source =
-                    process_imports(module_source, module_path, imported_files, dummy_source_map,
-                                    dummy_module_ranges, module_chain, line_number);
+                // モジュールを読み込んで再帰的に展開（.cmiがあれば再利用）
+                module_source = expand_module(module_path, canonical_path, imported_files,
+                                              module_chain, line_number, raw_module_source);
 
                 // キャッシュに保存
                 module_cache[canonical_path] = module_source;
@@ -663,10 +771,12 @@ std::string ImportPreprocessor::process_imports(const std::string& source,
             // エクスポートフィルタリング（選択的インポートの場合）
             if (!import_info.items.empty() && !import_info.is_wildcard) {
                 // 新しいシンボルのみをフィルタリング
+                // 索引はモジュールごとに1回だけ作り、インポートのたびに再走査しない
+                const auto& index = module_export_index(canonical_path, module_source);
                 if (!new_items.empty()) {
-                    module_source = filter_exports(module_source, new_items);
+                    module_source = filter_exports(index, new_items);
                 } else {
-                    module_source = filter_exports(module_source, import_info.items);
+                    module_source = filter_exports(index, import_info.items);
                 }
             }
 
@@ -920,25 +1030,238 @@ std::filesystem::path ImportPreprocessor::find_module_file(
 }
 
 std::string ImportPreprocessor::load_module_file(const std::filesystem::path& module_path) {
-    std::ifstream file(module_path);
-    if (!file) {
+    auto contents = read_file_contents(module_path.string());
+    if (!contents) {
         throw std::runtime_error("Failed to open module file: " + module_path.string());
     }
+    return std::move(*contents);
+}
+
+// ========== モジュールインターフェース（.cmi） ==========
+
+void ImportPreprocessor::enable_interface_cache(const std::filesystem::path& dir,
+                                                const std::string& compiler_id) {
+    interface_cache_dir = dir;
+    interface_compiler_id = compiler_id;
+}
+
+std::string ImportPreprocessor::interface_env_key() const {
+    std::string key = "compiler:" + interface_compiler_id + "\n";
+    key += "cwd:" + std::filesystem::current_path().string() + "\n";
+    key += "root:" + project_root.string() + "\n";
+    for (const auto& path : search_paths) {
+        key += "search:" + path.string() + "\n";
+    }
+    return key;
+}
 
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    return buffer.str();
+std::filesystem::path ImportPreprocessor::interface_path(const std::string& canonical_path) const {
+    // ファイル名はモジュール名+パスのハッシュ（衝突は.cmi内のmodule_pathで検出）
+    std::ostringstream name;
+    name << std::filesystem::path(canonical_path).stem().string() << "-" << std::hex
+         << std::hash<std::string>{}(canonical_path) << ".cmi";
+    return interface_cache_dir / name.str();
 }
 
-std::string ImportPreprocessor::filter_exports(const std::string& module_source,
-                                               const std::vector<std::string>& import_items) {
-    // 選択的インポート：指定されたアイテムのみを抽出
-    std::stringstream result;
+void ImportPreprocessor::record_touched(const std::string& canonical_path) {
+    for (auto* recorder : interface_recorders) {
+        recorder->touched.insert(canonical_path);
+    }
+}
+
+void ImportPreprocessor::record_touched(const InterfaceRecorder& nested) {
+    for (auto* recorder : interface_recorders) {
+        recorder->touched.insert(nested.touched.begin(), nested.touched.end());
+        recorder->cacheable = recorder->cacheable && nested.cacheable;
+    }
+}
+
+bool ImportPreprocessor::load_interface(const std::string& canonical_path,
+                                        std::unordered_set<std::string>& imported_files,
+                                        std::string& module_source,
+                                        std::string& raw_module_source) {
+    auto iface = read_module_interface(interface_path(canonical_path));
+    if (!iface || iface->module_path != canonical_path || iface->env_key != interface_env_key()) {
+        return false;
+    }
+
+    // 参照ファイルがすべて変更されていないこと
+    InterfaceRecorder recorder;
+    for (const auto& file : iface->files) {
+        if (!is_stamp_current(file)) {
+            return false;
+        }
+        recorder.touched.insert(file.path);
+    }
+
+    // 展開開始時の状態が一致すること
+    // （インポート済みのモジュール・シンボルは展開結果から省かれるため）
+    std::set<std::string> pre_modules(iface->pre_imported_modules.begin(),
+                                      iface->pre_imported_modules.end());
+    for (const auto& path : recorder.touched) {
+        if (path == canonical_path) {
+            continue;
+        }
+        if ((imported_modules.count(path) > 0) != (pre_modules.count(path) > 0)) {
+            return false;
+        }
+        std::set<std::string> current;
+        auto current_it = imported_symbols.find(path);
+        if (current_it != imported_symbols.end()) {
+            current = current_it->second;
+        }
+        std::set<std::string> saved;
+        auto saved_it = iface->pre_imported_symbols.find(path);
+        if (saved_it != iface->pre_imported_symbols.end()) {
+            saved.insert(saved_it->second.begin(), saved_it->second.end());
+        }
+        if (current != saved) {
+            return false;
+        }
+        // 循環依存は通常の展開でエラーを報告させる
+        if (std::find(import_stack.begin(), import_stack.end(), path) != import_stack.end()) {
+            return false;
+        }
+    }
+
+    // 展開による状態変化を適用
+    imported_modules.insert(iface->added_modules.begin(), iface->added_modules.end());
+    imported_files.insert(iface->added_files.begin(), iface->added_files.end());
+    for (const auto& [path, items] : iface->added_symbols) {
+        imported_symbols[path].insert(items.begin(), items.end());
+    }
+
+    module_source = std::move(iface->expanded_source);
+    raw_module_source = std::move(iface->raw_source);
+
+    record_touched(recorder);
+    module_touched[canonical_path] = std::move(recorder);
+
+    if (debug_mode) {
+        std::cout << "[PREPROCESSOR] Loaded module interface: " << canonical_path << "\n";
+    }
+    return true;
+}
+
+std::string ImportPreprocessor::expand_module(const std::filesystem::path& module_path,
+                                              const std::string& canonical_path,
+                                              std::unordered_set<std::string>& imported_files,
+                                              const std::string& module_chain,
+                                              size_t line_number,
+                                              std::string& raw_module_source) {
+    // 再帰呼び出し用のダミーソースマップ（実際のマッピングは出力時に行う）
+    SourceMap dummy_source_map;
+    std::vector<ModuleRange> dummy_module_ranges;
+
+    if (interface_cache_dir.empty()) {
+        // モジュールファイルを読み込む
+        std::string module_source = load_module_file(module_path);
+        // 再帰import展開前のソースを保存（export抽出用）
+        raw_module_source = module_source;
+        // モジュール内のインポートを再帰的に処理（ダミーソースマップを使用）
+        return process_imports(module_source, module_path, imported_files, dummy_source_map,
+                               dummy_module_ranges, module_chain, line_number);
+    }
+
+    std::string module_source;
+    if (load_interface(canonical_path, imported_files, module_source, raw_module_source)) {
+        return module_source;
+    }
+
+    // 展開開始時の状態（.cmiの再利用条件と状態変化の計算に使う）
+    auto modules_before = imported_modules;
+    auto symbols_before = imported_symbols;
+    auto files_before = imported_files;
+
+    InterfaceRecorder recorder;
+    recorder.touched.insert(canonical_path);
+    interface_recorders.push_back(&recorder);
+    try {
+        module_source = load_module_file(module_path);
+        raw_module_source = module_source;
+        module_source = process_imports(module_source, module_path, imported_files,
+                                        dummy_source_map, dummy_module_ranges, module_chain,
+                                        line_number);
+    } catch (...) {
+        interface_recorders.pop_back();
+        throw;
+    }
+    interface_recorders.pop_back();
+    record_touched(recorder);
+    module_touched[canonical_path] = recorder;
+
+    if (!recorder.cacheable) {
+        return module_source;
+    }
+
+    ModuleInterface iface;
+    iface.env_key = interface_env_key();
+    iface.module_path = canonical_path;
+    for (const auto& path : recorder.touched) {
+        ModuleInterface::FileStamp stamp;
+        if (!stamp_file(path, stamp)) {
+            return module_source;
+        }
+        iface.files.push_back(std::move(stamp));
+
+        if (path == canonical_path) {
+            continue;
+        }
+        if (modules_before.count(path) > 0) {
+            iface.pre_imported_modules.push_back(path);
+        }
+        auto symbols_it = symbols_before.find(path);
+        if (symbols_it != symbols_before.end() && !symbols_it->second.empty()) {
+            iface.pre_imported_symbols[path].assign(symbols_it->second.begin(),
+                                                    symbols_it->second.end());
+        }
+    }
+    for (const auto& path : imported_modules) {
+        if (modules_before.count(path) == 0) {
+            iface.added_modules.push_back(path);
+        }
+    }
+    for (const auto& path : imported_files) {
+        if (files_before.count(path) == 0) {
+            iface.added_files.push_back(path);
+        }
+    }
+    for (const auto& [path, items] : imported_symbols) {
+        auto before_it = symbols_before.find(path);
+        for (const auto& item : items) {
+            if (before_it == symbols_before.end() || before_it->second.count(item) == 0) {
+                iface.added_symbols[path].push_back(item);
+            }
+        }
+    }
+    iface.raw_source = raw_module_source;
+    iface.expanded_source = module_source;
+    write_module_interface(interface_path(canonical_path), iface);
+
+    return module_source;
+}
+
+ImportPreprocessor::ExportIndex ImportPreprocessor::build_export_index(
+    const std::string& module_source) {
+    // エクスポートブロックの区切りはインポート項目に依らないので、ここで1回だけ求める
+    ExportIndex index;
     std::stringstream input(module_source);
     std::string line;
-    bool in_wanted_block = false;    // 欲しいエクスポートブロック内
-    bool in_unwanted_block = false;  // 不要なエクスポートブロック内
+    bool in_block = false;  // エクスポートブロック内
     std::string current_export_name;
+
+    // 区切りを追加（エクスポート以外の行は直前の区切りにまとめる）
+    auto add_segment = [&](const std::string& name, const std::vector<std::string>& lines) {
+        if (name.empty() && !index.segments.empty() && index.segments.back().name.empty()) {
+            for (const auto& l : lines)
+                index.segments.back().text += l + "\n";
+            return;
+        }
+        ExportIndex::Segment segment{name, ""};
+        for (const auto& l : lines)
+            segment.text += l + "\n";
+        index.segments.push_back(std::move(segment));
+    };
     std::vector<std::string> block_lines;
     int brace_depth = 0;
     bool found_opening_brace = false;
@@ -949,7 +1272,7 @@ std::string ImportPreprocessor::filter_exports(const std::string& module_source,
         size_t pos = skip_ws(line);
 
         // impl パターンを先にチェック: [export] impl Type for Interface
-        if (!in_wanted_block && !in_unwanted_block) {
+        if (!in_block) {
             size_t impl_pos = pos;
             bool has_exp = starts_with_keyword(line, pos, "export");
             if (has_exp)
@@ -970,7 +1293,7 @@ std::string ImportPreprocessor::filter_exports(const std::string& module_source,
         }
 
         // export キーワードで始まる場合
-        if (!matched && !in_wanted_block && !in_unwanted_block &&
+        if (!matched && !in_block &&
             starts_with_keyword(line, pos, "export")) {
             size_t after_export = skip_ws(line, pos + 6);
 
@@ -1025,10 +1348,11 @@ std::string ImportPreprocessor::filter_exports(const std::string& module_source,
                         break;
                     }
                 }
-                // 型名を取得
+                // 型名を取得（ポインタ T* ・配列/スライス T[N] / T[] を含む）
                 size_t type_start = p;
-                while (p < line.size() && (std::isalnum(static_cast<unsigned char>(line[p])) ||
-                                           line[p] == '_' || line[p] == '*'))
+                while (p < line.size() &&
+                       (std::isalnum(static_cast<unsigned char>(line[p])) || line[p] == '_' ||
+                        line[p] == '*' || line[p] == '[' || line[p] == ']'))
                     p++;
                 if (p > type_start) {
                     p = skip_ws(line, p);
@@ -1046,15 +1370,7 @@ std::string ImportPreprocessor::filter_exports(const std::string& module_source,
         }
 
         if (matched) {
-            // 指定されたアイテムかチェック
-            bool is_wanted = std::find(import_items.begin(), import_items.end(),
-                                       current_export_name) != import_items.end();
-
-            if (is_wanted) {
-                in_wanted_block = true;
-            } else {
-                in_unwanted_block = true;
-            }
+            in_block = true;
 
             block_lines.clear();
             block_lines.push_back(line);
@@ -1075,27 +1391,17 @@ std::string ImportPreprocessor::filter_exports(const std::string& module_source,
 
             // 1行で完結する場合（セミコロンで終わる宣言）
             if (!found_opening_brace && line.find(';') != std::string::npos) {
-                if (in_wanted_block) {
-                    for (const auto& block_line : block_lines) {
-                        result << block_line << "\n";
-                    }
-                }
-                in_wanted_block = false;
-                in_unwanted_block = false;
+                add_segment(current_export_name, block_lines);
+                in_block = false;
                 block_lines.clear();
             }
             // 1行で完結する場合（括弧が閉じている）
             else if (found_opening_brace && brace_depth == 0) {
-                if (in_wanted_block) {
-                    for (const auto& block_line : block_lines) {
-                        result << block_line << "\n";
-                    }
-                }
-                in_wanted_block = false;
-                in_unwanted_block = false;
+                add_segment(current_export_name, block_lines);
+                in_block = false;
                 block_lines.clear();
             }
-        } else if (in_wanted_block || in_unwanted_block) {
+        } else if (in_block) {
             // エクスポートブロック内
             block_lines.push_back(line);
 
@@ -1115,25 +1421,46 @@ std::string ImportPreprocessor::filter_exports(const std::string& module_source,
 
                 // ブロックの終了を検出
                 if (brace_depth == 0) {
-                    // 欲しいブロックの場合のみ出力
-                    if (in_wanted_block) {
-                        for (const auto& block_line : block_lines) {
-                            result << block_line << "\n";
-                        }
-                    }
-                    in_wanted_block = false;
-                    in_unwanted_block = false;
+                    add_segment(current_export_name, block_lines);
+                    in_block = false;
                     block_lines.clear();
                     found_opening_brace = false;
                 }
             }
         } else if (line.find("export") == std::string::npos) {
             // エクスポートされていない行はそのまま保持（コメント、型定義など）
-            result << line << "\n";
+            add_segment("", {line});
         }
     }
 
-    return result.str();
+    return index;
+}
+
+std::string ImportPreprocessor::filter_exports(const ExportIndex& index,
+                                               const std::vector<std::string>& import_items) {
+    // 選択的インポート：エクスポート以外の行と指定されたアイテムのブロックだけを残す
+    std::string result;
+    for (const auto& segment : index.segments) {
+        if (segment.name.empty() || std::find(import_items.begin(), import_items.end(),
+                                              segment.name) != import_items.end()) {
+            result += segment.text;
+        }
+    }
+    return result;
+}
+
+std::string ImportPreprocessor::filter_exports(const std::string& module_source,
+                                               const std::vector<std::string>& import_items) {
+    return filter_exports(build_export_index(module_source), import_items);
+}
+
+const ImportPreprocessor::ExportIndex& ImportPreprocessor::module_export_index(
+    const std::string& canonical_path, const std::string& module_source) {
+    auto it = export_indexes.find(canonical_path);
+    if (it == export_indexes.end()) {
+        it = export_indexes.emplace(canonical_path, build_export_index(module_source)).first;
+    }
+    return it->second;
 }
 
 std::string ImportPreprocessor::remove_export_keywords(const std::string& source) {
@@ -1855,18 +2182,18 @@ std::filesystem::path ImportPreprocessor::resolve_module_path(
         const std::string& last_segment = segments.back();
         if (!last_segment.empty() && std::islower(last_segment[0])) {
             // まずフルパスがモジュールファイルとして存在するかチェック
-            // (例: std/sync/mutex.cm が存在するなら mutex はモジュール名)
+            // (例: std/sync/mutex.cm または std/core/async/mod.cm が存在するならモジュール名)
+            auto is_module_at = [&](const std::filesystem::path& base) {
+                return std::filesystem::exists(base / (full_filename + ".cm")) ||
+                       std::filesystem::exists(base / full_filename / "mod.cm");
+            };
             bool full_path_exists = false;
             if (!current_file.empty()) {
-                auto check_path = current_file.parent_path() / (full_filename + ".cm");
-                if (std::filesystem::exists(check_path)) {
-                    full_path_exists = true;
-                }
+                full_path_exists = is_module_at(current_file.parent_path());
             }
             if (!full_path_exists) {
                 for (const auto& sp : search_paths) {
-                    auto check_path = sp / (full_filename + ".cm");
-                    if (std::filesystem::exists(check_path)) {
+                    if (is_module_at(sp)) {
                         full_path_exists = true;
                         break;
                     }
@@ -2088,13 +2415,9 @@ std::filesystem::path ImportPreprocessor::find_module_entry_point(
             // 最初の数行だけチェック
             int line_count = 0;
             while (std::getline(file, line) && line_count++ < 10) {
-                // コメントをスキップ
-                if (line.find("//") == 0)
-                    continue;
-
-                // module文を検出
-                std::regex module_regex(R"(^\s*module\s+([a-zA-Z_][a-zA-Z0-9_:]*)\s*;)");
-                if (std::regex_search(line, module_regex)) {
+                // module文を検出（コメント行はトークンを持たないので一致しない）
+                if (line_starts_with(line, "module") &&
+                    module_decl_name_length(LineScanner(line)) > 0) {
                     return entry.path();
                 }
             }
@@ -2138,26 +2461,23 @@ std::string ImportPreprocessor::add_module_prefix(const std::string& source,
     std::string line;
 
     while (std::getline(input, line)) {
-        // const定数の宣言を検出してプレフィックスを追加
-        std::regex const_regex(R"(^(\s*const\s+\w+\s+)(\w+)(\s*=.*)$)");
-        std::smatch const_match;
-        if (std::regex_match(line, const_match, const_regex)) {
-            result += const_match[1].str() + module_name + "::" + const_match[2].str() +
-                      const_match[3].str() + "\n";
+        LineScanner s(line);
+
+        // const定数の宣言（const 型 名前 = ...）を検出してプレフィックスを追加
+        if (s.is(0, TokenKind::KwConst) && s.is_word(1) && s.is_word(2) &&
+            s.is(3, TokenKind::Eq)) {
+            result += line.substr(0, s.begin(2)) + module_name + "::" + line.substr(s.begin(2)) +
+                      "\n";
             continue;
         }
 
         // 関数宣言を検出してプレフィックスを追加
-        // 型 関数名(パラメータ) { の形式
-        std::regex func_regex(R"(^(\s*\w+\s+)(\w+)(\s*\([^)]*\)\s*\{.*)$)");
-        std::smatch func_match;
-        if (std::regex_match(line, func_match, func_regex)) {
-            // main関数は除外
-            if (func_match[2].str() != "main") {
-                result += func_match[1].str() + module_name + "::" + func_match[2].str() +
-                          func_match[3].str() + "\n";
-                continue;
-            }
+        // 型 関数名(パラメータ) { の形式（main関数は除外）
+        if (s.is_word(0) && s.is_word(1) && s.is(2, TokenKind::LParen) &&
+            s.is(s.find(TokenKind::RParen, 3) + 1, TokenKind::LBrace) && s.text(1) != "main") {
+            result += line.substr(0, s.begin(1)) + module_name + "::" + line.substr(s.begin(1)) +
+                      "\n";
+            continue;
         }
 
         // その他の行はそのまま出力
@@ -2168,15 +2488,16 @@ std::string ImportPreprocessor::add_module_prefix(const std::string& source,
 }
 
 std::string ImportPreprocessor::extract_module_namespace(const std::string& module_source) {
-    // module M; 宣言を検出
-    std::regex module_regex(R"(^\s*module\s+(\w+)\s*;)");
+    // module M; 宣言を検出（名前は1語のみ）
     std::istringstream input(module_source);
     std::string line;
 
     while (std::getline(input, line)) {
-        std::smatch match;
-        if (std::regex_match(line, match, module_regex)) {
-            return match[1].str();
+        if (!line_starts_with(line, "module"))
+            continue;
+        LineScanner s(line);
+        if (module_decl_name_length(s) == 1 && s.size() == 3) {
+            return std::string(s.text(1));
         }
     }
 
@@ -2186,15 +2507,18 @@ std::string ImportPreprocessor::extract_module_namespace(const std::string& modu
 std::vector<std::string> ImportPreprocessor::extract_reexports(const std::string& module_source) {
     // export { M }; または export { M, N, ... }; 形式を検出
     std::vector<std::string> reexports;
-    std::regex export_regex(R"(^\s*export\s*\{([^}]+)\}\s*;)");
     std::istringstream input(module_source);
     std::string line;
 
     while (std::getline(input, line)) {
-        std::smatch match;
-        if (std::regex_match(line, match, export_regex)) {
+        if (!line_starts_with(line, "export"))
+            continue;
+        LineScanner s(line);
+        size_t close = s.find(TokenKind::RBrace, 2);
+        if (s.is(0, TokenKind::KwExport) && s.is(1, TokenKind::LBrace) && close > 2 &&
+            s.is(close + 1, TokenKind::Semicolon) && s.size() == close + 2) {
             // カンマで分割
-            std::string items = match[1].str();
+            std::string items = line.substr(s.end(1), s.begin(close) - s.end(1));
             std::stringstream ss(items);
             std::string item;
             while (std::getline(ss, item, ',')) {
@@ -2244,27 +2568,22 @@ std::string ImportPreprocessor::extract_namespace_content(const std::string& sou
     bool in_target_namespace = false;
     int brace_depth = 0;
 
-    // namespace X { パターン
-    std::regex ns_start_regex(R"(^\s*namespace\s+(\w+)\s*\{)");
-
     while (std::getline(input, line)) {
-        std::smatch match;
-
-        if (!in_target_namespace && std::regex_search(line, match, ns_start_regex)) {
-            if (match[1].str() == namespace_name) {
-                in_target_namespace = true;
-                brace_depth = 1;
-                // 開き括弧の後の内容があれば追加
-                size_t brace_pos = line.find('{');
-                if (brace_pos != std::string::npos && brace_pos + 1 < line.length()) {
-                    std::string after_brace = line.substr(brace_pos + 1);
-                    if (!after_brace.empty() &&
-                        after_brace.find_first_not_of(" \t\n\r") != std::string::npos) {
-                        result << after_brace << "\n";
-                    }
+        // namespace X { パターン
+        if (!in_target_namespace && !namespace_name.empty() &&
+            namespace_opening(line) == namespace_name) {
+            in_target_namespace = true;
+            brace_depth = 1;
+            // 開き括弧の後の内容があれば追加
+            size_t brace_pos = line.find('{');
+            if (brace_pos != std::string::npos && brace_pos + 1 < line.length()) {
+                std::string after_brace = line.substr(brace_pos + 1);
+                if (!after_brace.empty() &&
+                    after_brace.find_first_not_of(" \t\n\r") != std::string::npos) {
+                    result << after_brace << "\n";
                 }
-                continue;
             }
+            continue;
         }
 
         if (in_target_namespace) {
@@ -2301,12 +2620,19 @@ std::string ImportPreprocessor::process_implicit_impl_export(const std::string&
     // exportされた構造体を検出
     std::set<std::string> exported_structs;
 
-    std::regex export_struct_regex(R"(export\s+struct\s+(\w+))");
-    std::smatch match;
-    std::string::const_iterator search_start = source.cbegin();
-    while (std::regex_search(search_start, source.cend(), match, export_struct_regex)) {
-        exported_structs.insert(match[1].str());
-        search_start = match.suffix().first;
+    // ソース全体を1回だけトークン化して export struct Name を集める
+    {
+        Lexer lexer(source);
+        Token prev2(TokenKind::Eof, 0, 0);
+        Token prev(TokenKind::Eof, 0, 0);
+        for (Token tok = lexer.next(); tok.kind != TokenKind::Eof; tok = lexer.next()) {
+            if (prev2.kind == TokenKind::KwExport && prev.kind == TokenKind::KwStruct &&
+                tok.kind == TokenKind::Ident) {
+                exported_structs.insert(std::string(tok.get_string()));
+            }
+            prev2 = std::move(prev);
+            prev = std::move(tok);
+        }
     }
 
     if (exported_structs.empty()) {
@@ -2318,30 +2644,18 @@ std::string ImportPreprocessor::process_implicit_impl_export(const std::string&
     std::istringstream input(source);
     std::string line;
 
-    // impl Type for Interface パターン
-    std::regex impl_regex(R"(^(\s*)impl\s+(\w+)\s+for\s+(\w+))");
-    // impl Type パターン（コンストラクタ用）
-    std::regex impl_ctor_regex(R"(^(\s*)impl\s+(\w+)\s*\{)");
-
     while (std::getline(input, line)) {
-        std::smatch impl_match;
-
-        // impl Type for Interface をチェック
-        if (std::regex_search(line, impl_match, impl_regex)) {
-            std::string type_name = impl_match[2].str();
+        // impl Type for Interface / impl Type {（コンストラクタ用）をチェック
+        if (line_starts_with(line, "impl")) {
+            LineScanner s(line);
+            bool is_impl = s.is(0, TokenKind::KwImpl) && s.is_word(1) &&
+                           ((s.is(2, TokenKind::KwFor) && s.is_word(3)) ||
+                            s.is(2, TokenKind::LBrace));
             // エクスポートされた構造体のimplの場合、exportキーワードを追加
             // （まだexportキーワードがない場合のみ）
-            if (exported_structs.count(type_name) > 0 && line.find("export") == std::string::npos) {
-                std::string indent = impl_match[1].str();
-                line = indent + "export " + line.substr(indent.length());
-            }
-        }
-        // impl Type { (コンストラクタ用) をチェック
-        else if (std::regex_search(line, impl_match, impl_ctor_regex)) {
-            std::string type_name = impl_match[2].str();
-            if (exported_structs.count(type_name) > 0 && line.find("export") == std::string::npos) {
-                std::string indent = impl_match[1].str();
-                line = indent + "export " + line.substr(indent.length());
+            if (is_impl && exported_structs.count(std::string(s.text(1))) > 0 &&
+                line.find("export") == std::string::npos) {
+                line.insert(s.begin(0), "export ");
             }
         }
 
@@ -2357,16 +2671,36 @@ std::string ImportPreprocessor::process_hierarchical_reexport(const std::string&
     // これは、fileとstreamの名前空間をio名前空間内に移動する
 
     // コメント化された形式: // export { io::{file, stream} }; (processed)
-    std::regex hier_export_regex(R"(//\s*export\s*\{\s*(\w+)::\{([^}]+)\}\s*\};\s*\(processed\))");
-    std::smatch match;
+    // コメントの本文をトークン化して形を判定する
+    std::string parent_ns;  // 例: "io"
+    std::string items_str;  // 例: "file, stream"
+    for (size_t marker = source.find("(processed)");
+         marker != std::string::npos && parent_ns.empty();
+         marker = source.find("(processed)", marker + 1)) {
+        size_t line_start = source.rfind('\n', marker);
+        line_start = line_start == std::string::npos ? 0 : line_start + 1;
+        std::string_view line(source.data() + line_start, marker + 11 - line_start);
+        for (size_t slash = line.find("//"); slash != std::string_view::npos;
+             slash = line.find("//", slash + 1)) {
+            std::string_view body = line.substr(slash + 2);
+            LineScanner s(body);
+            size_t close = s.find(TokenKind::RBrace, 5);
+            if (s.is(0, TokenKind::KwExport) && s.is(1, TokenKind::LBrace) && s.is_word(2) &&
+                s.is(3, TokenKind::ColonColon) && s.is(4, TokenKind::LBrace) && close > 5 &&
+                s.is(close + 1, TokenKind::RBrace) && s.is(close + 2, TokenKind::Semicolon) &&
+                s.is(close + 3, TokenKind::LParen) && s.text(close + 4) == "processed" &&
+                s.is(close + 5, TokenKind::RParen)) {
+                parent_ns = std::string(s.text(2));
+                items_str = std::string(body.substr(s.end(4), s.begin(close) - s.end(4)));
+                break;
+            }
+        }
+    }
 
-    if (!std::regex_search(source, match, hier_export_regex)) {
+    if (parent_ns.empty()) {
         return source;  // 階層再構築パターンがない場合はそのまま返す
     }
 
-    std::string parent_ns = match[1].str();  // 例: "io"
-    std::string items_str = match[2].str();  // 例: "file, stream"
-
     // アイテムをパース
     std::set<std::string> items_to_move;
     std::stringstream items_ss(items_str);
@@ -2398,12 +2732,9 @@ std::string ImportPreprocessor::process_hierarchical_reexport(const std::string&
 
     // Pass 1: 対象の名前空間を収集
     while (std::getline(input, line)) {
-        std::regex ns_start_regex(R"(^\s*namespace\s+(\w+)\s*\{)");
-        std::smatch ns_match;
-
-        if (!in_target_ns && std::regex_search(line, ns_match, ns_start_regex)) {
-            std::string ns_name = ns_match[1].str();
-            if (items_to_move.count(ns_name) > 0) {
+        if (!in_target_ns) {
+            std::string ns_name = namespace_opening(line);
+            if (!ns_name.empty() && items_to_move.count(ns_name) > 0) {
                 current_ns = ns_name;
                 in_target_ns = true;
                 brace_depth = 1;
@@ -2441,13 +2772,10 @@ std::string ImportPreprocessor::process_hierarchical_reexport(const std::string&
     bool items_inserted = false;
 
     while (std::getline(input, line)) {
-        std::regex ns_start_regex(R"(^\s*namespace\s+(\w+)\s*\{)");
-        std::smatch ns_match;
-
         // 対象の名前空間をスキップ
-        if (!in_target_ns && std::regex_search(line, ns_match, ns_start_regex)) {
-            std::string ns_name = ns_match[1].str();
-            if (items_to_move.count(ns_name) > 0) {
+        if (!in_target_ns) {
+            std::string ns_name = namespace_opening(line);
+            if (!ns_name.empty() && items_to_move.count(ns_name) > 0) {
                 in_target_ns = true;
                 brace_depth = 1;
                 current_ns = ns_name;
@@ -2531,14 +2859,17 @@ std::string cm::preprocessor::ImportPreprocessor::extract_exported_blocks(
 
         // module宣言やimport文はスキップ
         if (line.find("module ") != std::string::npos && line.find(';') != std::string::npos) {
-            std::regex module_regex(R"(^\s*/?\s*module\s+[\w:.]+\s*;\s*$)");
-            if (std::regex_match(line, module_regex)) {
+            // 「module 名前;」だけの行（先頭の'/'1つは許容）
+            LineScanner s(line);
+            size_t start = s.is(0, TokenKind::Slash) ? 1 : 0;
+            size_t name_length = module_decl_name_length(s, start);
+            if (name_length > 0 && s.size() == start + name_length + 2) {
                 continue;
             }
         }
         if (line.find("import ") != std::string::npos) {
-            std::regex import_regex(R"(^\s*import\s+)");
-            if (std::regex_search(line, import_regex)) {
+            LineScanner s(line);
+            if (s.is(0, TokenKind::KwImport) && s.space_after(0)) {
                 continue;
             }
         }
@@ -2546,16 +2877,13 @@ std::string cm::preprocessor::ImportPreprocessor::extract_exported_blocks(
         // exportで始まる行を検出（シンプルなパターン）
         if (!in_export_block && !in_non_export_block && line.find("export ") != std::string::npos) {
             // 行がexportで始まるか確認（先頭空白は許容）
-            std::regex export_start(R"(^\s*export\s+)");
-            if (std::regex_search(line, export_start)) {
+            LineScanner s(line);
+            if (s.is(0, TokenKind::KwExport) && s.space_after(0)) {
                 // 再エクスポート構文（export { ... }）はスキップ
                 // export NAME1, NAME2; 形式のリストエクスポートもスキップ
-                std::regex reexport_regex(R"(^\s*export\s*\{)");
-                std::regex list_export_regex(R"(^\s*export\s+\w+\s*,)");
-                std::regex name_only_export_regex(R"(^\s*export\s+\w+\s*;)");
-                if (std::regex_search(line, reexport_regex) ||
-                    std::regex_search(line, list_export_regex) ||
-                    std::regex_search(line, name_only_export_regex)) {
+                if (s.is(1, TokenKind::LBrace) ||
+                    (s.is_word(1) &&
+                     (s.is(2, TokenKind::Comma) || s.is(2, TokenKind::Semicolon)))) {
                     continue;
                 }
                 in_export_block = true;
@@ -2578,8 +2906,7 @@ std::string cm::preprocessor::ImportPreprocessor::extract_exported_blocks(
                 // 1行で完結する場合（セミコロンで終わる宣言、括弧なし）
                 if (!found_opening_brace && line.find(';') != std::string::npos) {
                     for (auto& bl : block_lines) {
-                        std::regex rm_export(R"(\bexport\s+)");
-                        result << std::regex_replace(bl, rm_export, "") << "\n";
+                        result << strip_export_keyword(bl) << "\n";
                     }
                     in_export_block = false;
                     block_lines.clear();
@@ -2587,8 +2914,7 @@ std::string cm::preprocessor::ImportPreprocessor::extract_exported_blocks(
                 // 1行で括弧が閉じている場合
                 else if (found_opening_brace && brace_depth == 0) {
                     for (auto& bl : block_lines) {
-                        std::regex rm_export(R"(\bexport\s+)");
-                        result << std::regex_replace(bl, rm_export, "") << "\n";
+                        result << strip_export_keyword(bl) << "\n";
                     }
                     in_export_block = false;
                     block_lines.clear();
@@ -2615,8 +2941,7 @@ std::string cm::preprocessor::ImportPreprocessor::extract_exported_blocks(
             if (found_opening_brace && brace_depth == 0) {
                 // exportキーワードを除去して出力
                 for (auto& bl : block_lines) {
-                    std::regex rm_export(R"(\bexport\s+)");
-                    result << std::regex_replace(bl, rm_export, "") << "\n";
+                    result << strip_export_keyword(bl) << "\n";
                 }
                 in_export_block = false;
                 block_lines.clear();
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "module_interface.hpp"
+
 #include <filesystem>
 #include <memory>
 #include <set>
@@ -54,6 +56,17 @@ class ImportPreprocessor {
     std::unordered_map<std::string, std::string>
         raw_module_cache;  // オリジナルソースキャッシュ（export抽出用）
 
+    // エクスポート索引：展開済みモジュールソースをエクスポートブロック単位に区切ったもの
+    // 選択的インポートの絞り込みは索引から組み立て、インポートのたびにソースを走査しない
+    struct ExportIndex {
+        struct Segment {
+            std::string name;  // エクスポート名（空ならエクスポート以外の行）
+            std::string text;  // 改行を含む元の行
+        };
+        std::vector<Segment> segments;
+    };
+    std::unordered_map<std::string, ExportIndex> export_indexes;  // 正規化パス -> 索引
+
     // モジュール名前空間の追跡（モジュール名 -> 名前空間）
     std::unordered_map<std::string, std::string> module_namespaces;
     // 再エクスポートの追跡（親モジュール -> {子モジュール名, ...}）
@@ -66,6 +79,20 @@ class ImportPreprocessor {
     // デバッグモード
     bool debug_mode;
 
+    // モジュールインターフェース（.cmi）キャッシュ
+    std::filesystem::path interface_cache_dir;  // 空なら無効
+    std::string interface_compiler_id;          // コンパイラの識別子
+
+    // 展開中のモジュールが参照したファイルの記録
+    // （入れ子の展開でも外側のモジュールへ伝播させるためスタックで保持）
+    struct InterfaceRecorder {
+        std::set<std::string> touched;  // 参照したモジュールの正規化パス
+        bool cacheable = true;          // 再帰ワイルドカード等を含む場合はfalse
+    };
+    std::vector<InterfaceRecorder*> interface_recorders;
+    // 展開済みモジュールの参照記録（module_cacheヒット時の伝播用）
+    std::unordered_map<std::string, InterfaceRecorder> module_touched;
+
    public:
     ImportPreprocessor(bool debug = false);
 
@@ -76,6 +103,10 @@ class ImportPreprocessor {
     // モジュール検索パスを追加
     void add_search_path(const std::filesystem::path& path);
 
+    // モジュールインターフェース（.cmi）キャッシュを有効化
+    // compiler_id: コンパイラの識別子（変わると全インターフェースが無効になる）
+    void enable_interface_cache(const std::filesystem::path& dir, const std::string& compiler_id);
+
    private:
     // インポート文を検出して処理
     std::string process_imports(const std::string& source,
@@ -92,9 +123,38 @@ class ImportPreprocessor {
     // モジュールファイルを読み込む
     std::string load_module_file(const std::filesystem::path& module_path);
 
+    // モジュールを再帰import展開する（.cmiが有効ならそれを使い、なければ展開して保存）
+    std::string expand_module(const std::filesystem::path& module_path,
+                              const std::string& canonical_path,
+                              std::unordered_set<std::string>& imported_files,
+                              const std::string& module_chain, size_t line_number,
+                              std::string& raw_module_source);
+
+    // 参照したモジュールを展開中の全モジュールへ記録
+    void record_touched(const std::string& canonical_path);
+    void record_touched(const InterfaceRecorder& nested);
+
+    // .cmi のパス
+    std::filesystem::path interface_path(const std::string& canonical_path) const;
+
+    // 環境キー（コンパイラ・作業ディレクトリ・検索パスが変わればモジュール解決も変わる）
+    std::string interface_env_key() const;
+
+    // .cmi を読み込み、現在の状態で再利用できれば状態変化を適用する
+    bool load_interface(const std::string& canonical_path,
+                        std::unordered_set<std::string>& imported_files,
+                        std::string& module_source, std::string& raw_module_source);
+
     // エクスポートされていない要素を削除
     std::string filter_exports(const std::string& module_source,
                                const std::vector<std::string>& import_items);
+    std::string filter_exports(const ExportIndex& index,
+                               const std::vector<std::string>& import_items);
+
+    // エクスポート索引を作る / モジュールの索引を取得（初回のみ作成）
+    ExportIndex build_export_index(const std::string& module_source);
+    const ExportIndex& module_export_index(const std::string& canonical_path,
+                                           const std::string& module_source);
 
     // exportキーワードを削除
     std::string remove_export_keywords(const std::string& source);
@@ -0,0 +1,228 @@
+// モジュールインターフェース（.cmi）の読み書き
+
+#include "module_interface.hpp"
+
+#include "../common/cache_manager.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+namespace cm::preprocessor {
+
+namespace {
+
+// ファイル形式: "CMI\0" + バージョン、以降は長さ付き文字列と整数の列
+constexpr char kMagic[4] = {'C', 'M', 'I', '\0'};
+constexpr uint32_t kFormatVersion = 1;
+
+// 破損ファイルで巨大な確保をしないための上限
+constexpr uint64_t kMaxLength = 1ull << 32;
+constexpr uint64_t kMaxCount = 1ull << 20;
+
+class Writer {
+   public:
+    explicit Writer(std::ostream& os) : os_(os) {}
+
+    void u64(uint64_t v) { os_.write(reinterpret_cast<const char*>(&v), sizeof(v)); }
+
+    void str(const std::string& s) {
+        u64(s.size());
+        os_.write(s.data(), static_cast<std::streamsize>(s.size()));
+    }
+
+    void strs(const std::vector<std::string>& v) {
+        u64(v.size());
+        for (const auto& s : v) {
+            str(s);
+        }
+    }
+
+    void symbols(const std::map<std::string, std::vector<std::string>>& m) {
+        u64(m.size());
+        for (const auto& [path, items] : m) {
+            str(path);
+            strs(items);
+        }
+    }
+
+   private:
+    std::ostream& os_;
+};
+
+class Reader {
+   public:
+    explicit Reader(std::istream& is) : is_(is) {}
+
+    bool u64(uint64_t& v) {
+        return static_cast<bool>(is_.read(reinterpret_cast<char*>(&v), sizeof(v)));
+    }
+
+    bool str(std::string& s) {
+        uint64_t n = 0;
+        if (!u64(n) || n > kMaxLength) {
+            return false;
+        }
+        s.resize(n);
+        return n == 0 || static_cast<bool>(is_.read(s.data(), static_cast<std::streamsize>(n)));
+    }
+
+    bool strs(std::vector<std::string>& v) {
+        uint64_t n = 0;
+        if (!u64(n) || n > kMaxCount) {
+            return false;
+        }
+        v.resize(n);
+        for (auto& s : v) {
+            if (!str(s)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool symbols(std::map<std::string, std::vector<std::string>>& m) {
+        uint64_t n = 0;
+        if (!u64(n) || n > kMaxCount) {
+            return false;
+        }
+        for (uint64_t i = 0; i < n; ++i) {
+            std::string path;
+            if (!str(path) || !strs(m[path])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+   private:
+    std::istream& is_;
+};
+
+bool stat_file(const std::string& path, int64_t& mtime_ns, uint64_t& size) {
+    std::error_code ec;
+    auto ftime = std::filesystem::last_write_time(path, ec);
+    if (ec) {
+        return false;
+    }
+    auto fsize = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return false;
+    }
+    mtime_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(ftime.time_since_epoch()).count();
+    size = fsize;
+    return true;
+}
+
+}  // namespace
+
+bool stamp_file(const std::string& path, ModuleInterface::FileStamp& stamp) {
+    stamp.path = path;
+    if (!stat_file(path, stamp.mtime_ns, stamp.size)) {
+        return false;
+    }
+    stamp.hash = cache::CacheManager::compute_file_hash(path);
+    return !stamp.hash.empty();
+}
+
+bool is_stamp_current(const ModuleInterface::FileStamp& stamp) {
+    int64_t mtime_ns = 0;
+    uint64_t size = 0;
+    if (!stat_file(stamp.path, mtime_ns, size)) {
+        return false;
+    }
+    if (mtime_ns == stamp.mtime_ns && size == stamp.size) {
+        return true;
+    }
+    // タイムスタンプだけ変わった場合（checkout等）は内容で判定
+    return size == stamp.size && cache::CacheManager::compute_file_hash(stamp.path) == stamp.hash;
+}
+
+bool write_module_interface(const std::filesystem::path& path, const ModuleInterface& iface) {
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    if (ec) {
+        return false;
+    }
+
+    auto tmp = path;
+    tmp += ".tmp" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    {
+        std::ofstream ofs(tmp, std::ios::binary);
+        if (!ofs.is_open()) {
+            return false;
+        }
+        Writer w(ofs);
+        ofs.write(kMagic, sizeof(kMagic));
+        w.u64(kFormatVersion);
+        w.str(iface.env_key);
+        w.str(iface.module_path);
+        w.u64(iface.files.size());
+        for (const auto& file : iface.files) {
+            w.str(file.path);
+            w.u64(static_cast<uint64_t>(file.mtime_ns));
+            w.u64(file.size);
+            w.str(file.hash);
+        }
+        w.strs(iface.pre_imported_modules);
+        w.symbols(iface.pre_imported_symbols);
+        w.strs(iface.added_modules);
+        w.strs(iface.added_files);
+        w.symbols(iface.added_symbols);
+        w.str(iface.raw_source);
+        w.str(iface.expanded_source);
+        if (!ofs) {
+            ofs.close();
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
+
+std::optional<ModuleInterface> read_module_interface(const std::filesystem::path& path) {
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs.is_open()) {
+        return std::nullopt;
+    }
+
+    char magic[sizeof(kMagic)];
+    uint64_t version = 0;
+    Reader r(ifs);
+    if (!ifs.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+        !r.u64(version) || version != kFormatVersion) {
+        return std::nullopt;
+    }
+
+    ModuleInterface iface;
+    uint64_t file_count = 0;
+    if (!r.str(iface.env_key) || !r.str(iface.module_path) || !r.u64(file_count) ||
+        file_count > kMaxCount) {
+        return std::nullopt;
+    }
+    iface.files.resize(file_count);
+    for (auto& file : iface.files) {
+        uint64_t mtime = 0;
+        if (!r.str(file.path) || !r.u64(mtime) || !r.u64(file.size) || !r.str(file.hash)) {
+            return std::nullopt;
+        }
+        file.mtime_ns = static_cast<int64_t>(mtime);
+    }
+    if (!r.strs(iface.pre_imported_modules) || !r.symbols(iface.pre_imported_symbols) ||
+        !r.strs(iface.added_modules) || !r.strs(iface.added_files) ||
+        !r.symbols(iface.added_symbols) || !r.str(iface.raw_source) ||
+        !r.str(iface.expanded_source)) {
+        return std::nullopt;
+    }
+    return iface;
+}
+
+}  // namespace cm::preprocessor
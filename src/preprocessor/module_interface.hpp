@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace cm::preprocessor {
+
+// モジュールインターフェース（.cmi）
+// インポートされたモジュールの展開結果（再帰import展開済みのソース）と、
+// 展開時に参照した全ファイルのハッシュ・インポート状態の変化を保存する。
+// 参照ファイルが変更されておらず、展開開始時の状態が一致すれば、
+// 次回のビルドでモジュールの読み込み・再帰展開をまるごと省略できる。
+struct ModuleInterface {
+    // 参照ファイルのスタンプ（mtime+sizeが変わった場合のみSHA-256で比較）
+    struct FileStamp {
+        std::string path;
+        int64_t mtime_ns = 0;
+        uint64_t size = 0;
+        std::string hash;
+    };
+
+    std::string env_key;           // コンパイラ・検索パス等の環境キー
+    std::string module_path;       // モジュールの正規化パス
+    std::vector<FileStamp> files;  // 展開中に参照した全ファイル（モジュール自身を含む）
+
+    // 展開開始時のインポート状態（参照ファイルに限定、モジュール自身は除く）
+    std::vector<std::string> pre_imported_modules;
+    std::map<std::string, std::vector<std::string>> pre_imported_symbols;
+
+    // 展開によるインポート状態の変化
+    std::vector<std::string> added_modules;
+    std::vector<std::string> added_files;
+    std::map<std::string, std::vector<std::string>> added_symbols;
+
+    std::string raw_source;       // 元のソース（export抽出用）
+    std::string expanded_source;  // 再帰import展開済みソース
+};
+
+// ファイルのスタンプを作成（読めない場合はfalse）
+bool stamp_file(const std::string& path, ModuleInterface::FileStamp& stamp);
+
+// スタンプが現在のファイル内容と一致するか
+bool is_stamp_current(const ModuleInterface::FileStamp& stamp);
+
+// .cmi を書き込み（一時ファイル経由のrename）
+bool write_module_interface(const std::filesystem::path& path, const ModuleInterface& iface);
+
+// .cmi を読み込み（形式不一致・破損時はnullopt）
+std::optional<ModuleInterface> read_module_interface(const std::filesystem::path& path);
+
+}  // namespace cm::preprocessor
@@ -0,0 +1,48 @@
+// HashMap Benchmark - C++ (std::unordered_map)
+#include <ctime>
+#include <iostream>
+#include <unordered_map>
+
+static long now_ms() {
+    return static_cast<long>(std::clock()) * 1000 / CLOCKS_PER_SEC;
+}
+
+int main() {
+    const int n = 1000000;
+    std::unordered_map<int, int> m;
+
+    // Insert (including rehashes)
+    long t0 = now_ms();
+    for (int i = 0; i < n; i++) {
+        m[i * 7] = i;
+    }
+    long t1 = now_ms();
+
+    // Lookup (half hits, half misses)
+    long long found = 0;
+    for (int i = 0; i < n; i++) {
+        if (m.count(i * 7 + (i & 1))) {
+            found++;
+        }
+    }
+    long long sum = 0;
+    for (int i = 0; i < n; i++) {
+        auto it = m.find(i * 7);
+        sum += (it != m.end()) ? it->second : 0;
+    }
+    long t2 = now_ms();
+
+    // Erase
+    for (int i = 0; i < n; i++) {
+        m.erase(i * 7);
+    }
+    long t3 = now_ms();
+
+    std::cout << "HashMap benchmark completed" << std::endl;
+    std::cout << "Found: " << found << ", Sum: " << sum << ", Len: " << m.size() << std::endl;
+    std::cout << "insert: " << (t1 - t0) << " ms" << std::endl;
+    std::cout << "lookup: " << (t2 - t1) << " ms" << std::endl;
+    std::cout << "erase: " << (t3 - t2) << " ms" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+#!/bin/bash
+
+# Cm言語 HashMap スループット測定スクリプト
+# std::collections::HashMap と C++ std::unordered_map で
+# insert / lookup / erase の各フェーズの時間を比較する
+#
+# 使い方: ./run_hashmap_benchmarks.sh [繰り返し回数（デフォルト3）]
+
+set +e
+
+SCRIPT_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
+RESULTS_DIR="$SCRIPT_DIR/results"
+CM_ROOT="$SCRIPT_DIR/../.."
+CM="$CM_ROOT/cm"
+RUNS="${1:-3}"
+BENCH_NAME="08_hashmap"
+
+# 色付き出力用の設定
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+BLUE='\033[0;34m'
+CYAN='\033[0;36m'
+NC='\033[0m' # No Color
+
+if [ ! -f "$CM" ]; then
+    echo -e "${RED}Cmコンパイラが見つかりません: $CM${NC}"
+    exit 1
+fi
+
+CXX="${CXX:-}"
+if [ -z "$CXX" ]; then
+    if command -v clang++ &> /dev/null; then
+        CXX=clang++
+    else
+        CXX=g++
+    fi
+fi
+
+mkdir -p "$RESULTS_DIR"
+TIMESTAMP=$(date +"%Y%m%d_%H%M%S")
+RESULT_FILE="$RESULTS_DIR/hashmap_results_${TIMESTAMP}.csv"
+echo "Phase,Cm(ms),C++(ms),Ratio" > "$RESULT_FILE"
+
+BUILD_DIR=$(mktemp -d)
+trap 'rm -rf "$BUILD_DIR"' EXIT
+
+echo -e "${BLUE}========================================${NC}"
+echo -e "${BLUE}   HashMap Benchmark (best of $RUNS)${NC}"
+echo -e "${BLUE}========================================${NC}"
+
+if ! "$CM" compile -O3 "$SCRIPT_DIR/cm/${BENCH_NAME}.cm" -o "$BUILD_DIR/${BENCH_NAME}_cm" > /dev/null 2>&1; then
+    echo -e "${RED}Cmビルド失敗${NC}"
+    exit 1
+fi
+if ! "$CXX" -std=c++17 -O3 -o "$BUILD_DIR/${BENCH_NAME}_cpp" "$SCRIPT_DIR/cpp/${BENCH_NAME}.cpp"; then
+    echo -e "${RED}C++ビルド失敗${NC}"
+    exit 1
+fi
+
+# フェーズごとの最良時間（ms）を測定
+best_phase() {
+    local binary="$1"
+    local phase="$2"
+    local best=""
+    for ((i = 0; i < RUNS; i++)); do
+        local t=$("$binary" | awk -v p="$phase:" '$1 == p { print $2 }')
+        if [ -n "$t" ] && { [ -z "$best" ] || [ "$t" -lt "$best" ]; }; then
+            best="$t"
+        fi
+    done
+    echo "$best"
+}
+
+for phase in insert lookup erase; do
+    cm_time=$(best_phase "$BUILD_DIR/${BENCH_NAME}_cm" "$phase")
+    cpp_time=$(best_phase "$BUILD_DIR/${BENCH_NAME}_cpp" "$phase")
+    ratio=$(awk -v a="$cm_time" -v b="$cpp_time" 'BEGIN { printf "%.2f", (b > 0) ? a / b : 0 }')
+
+    echo -e "\n${CYAN}=== $phase (1M ops) ===${NC}"
+    printf "Cm HashMap:          %6s ms\n" "$cm_time"
+    printf "std::unordered_map:  %6s ms\n" "$cpp_time"
+    echo -e "${GREEN}Cm / C++: ${ratio}x${NC}"
+
+    echo "$phase,$cm_time,$cpp_time,$ratio" >> "$RESULT_FILE"
+done
+
+echo -e "\n結果: $RESULT_FILE"
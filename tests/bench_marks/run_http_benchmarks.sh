@@ -0,0 +1,70 @@
+#!/bin/bash
+
+# Cm言語 HTTPサーバ スループット測定スクリプト
+# native::http の accept型サーバ（HttpServer）とイベント駆動サーバ（HttpEventServer）に
+# ローカルの負荷試験クライアントから接続し、1秒あたりのリクエスト数を比較する
+#
+# 使い方: ./run_http_benchmarks.sh [繰り返し回数（デフォルト3）]
+
+set +e
+
+SCRIPT_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
+RESULTS_DIR="$SCRIPT_DIR/results"
+CM_ROOT="$SCRIPT_DIR/../.."
+CM="$CM_ROOT/cm"
+RUNS="${1:-3}"
+BENCH_NAME="09_http_server"
+
+# 色付き出力用の設定
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+BLUE='\033[0;34m'
+CYAN='\033[0;36m'
+NC='\033[0m' # No Color
+
+if [ ! -f "$CM" ]; then
+    echo -e "${RED}Cmコンパイラが見つかりません: $CM${NC}"
+    exit 1
+fi
+
+mkdir -p "$RESULTS_DIR"
+TIMESTAMP=$(date +"%Y%m%d_%H%M%S")
+RESULT_FILE="$RESULTS_DIR/http_results_${TIMESTAMP}.csv"
+echo "Mode,ReqPerSec,SpeedupVsLegacy" > "$RESULT_FILE"
+
+BUILD_DIR=$(mktemp -d)
+trap 'rm -rf "$BUILD_DIR"' EXIT
+
+echo -e "${BLUE}========================================${NC}"
+echo -e "${BLUE}   HTTP Server Benchmark (best of $RUNS)${NC}"
+echo -e "${BLUE}========================================${NC}"
+
+if ! "$CM" compile -O3 "$SCRIPT_DIR/cm/${BENCH_NAME}.cm" -o "$BUILD_DIR/${BENCH_NAME}_cm" > /dev/null 2>&1; then
+    echo -e "${RED}Cmビルド失敗${NC}"
+    exit 1
+fi
+
+# 各回の出力を保存してから、モードごとの最良値（req/s）を取り出す
+for ((i = 0; i < RUNS; i++)); do
+    "$BUILD_DIR/${BENCH_NAME}_cm" > "$BUILD_DIR/run_$i.txt"
+done
+
+best_rate() {
+    local mode="$1"
+    cat "$BUILD_DIR"/run_*.txt |
+        awk -v m="$mode:" '$1 == m && $2 > best { best = $2 } END { print best + 0 }'
+}
+
+legacy=$(best_rate legacy)
+echo -e "\n${CYAN}=== GET / （ローカル負荷試験クライアント） ===${NC}"
+for mode in legacy keepalive pipeline; do
+    rate=$(best_rate "$mode")
+    speedup=$(awk -v a="$rate" -v b="$legacy" 'BEGIN { printf "%.1f", (b > 0) ? a / b : 0 }')
+    printf "%-10s %10s req/s  (%sx)\n" "$mode" "$rate" "$speedup"
+    echo "$mode,$rate,$speedup" >> "$RESULT_FILE"
+done
+
+echo -e "\n${GREEN}legacy: HttpServer（1接続1リクエスト）、4接続${NC}"
+echo -e "${GREEN}keepalive: HttpEventServer 4ワーカー、32接続${NC}"
+echo -e "${GREEN}pipeline: 同上、1接続あたり16件ずつパイプライン送信${NC}"
+echo -e "\n結果: $RESULT_FILE"
@@ -0,0 +1,87 @@
+#!/bin/bash
+
+# Cm言語 TBAA効果測定スクリプト
+# 同じベンチマークを TBAA あり（デフォルト）/ なし（--no-tbaa）でビルドし、
+# 実行時間を比較する
+#
+# 使い方: ./run_tbaa_benchmarks.sh [繰り返し回数（デフォルト5）]
+
+set +e
+
+SCRIPT_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
+RESULTS_DIR="$SCRIPT_DIR/results"
+CM_ROOT="$SCRIPT_DIR/../.."
+CM="$CM_ROOT/cm"
+RUNS="${1:-5}"
+
+# 色付き出力用の設定
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+BLUE='\033[0;34m'
+CYAN='\033[0;36m'
+NC='\033[0m' # No Color
+
+# TBAAの効果が出やすいメモリアクセス主体のベンチマーク
+declare -a BENCHMARKS=(
+    "05_matrix_multiply:Matrix Multiply (300x300) - 1D Array SIMD"
+    "07_struct_array:Struct Array (1000) - Point Distance"
+)
+
+if [ ! -f "$CM" ]; then
+    echo -e "${RED}Cmコンパイラが見つかりません: $CM${NC}"
+    exit 1
+fi
+
+mkdir -p "$RESULTS_DIR"
+TIMESTAMP=$(date +"%Y%m%d_%H%M%S")
+RESULT_FILE="$RESULTS_DIR/tbaa_results_${TIMESTAMP}.csv"
+echo "Algorithm,TBAA,NoTBAA,Speedup,TaggedAccesses" > "$RESULT_FILE"
+
+BUILD_DIR=$(mktemp -d)
+trap 'rm -rf "$BUILD_DIR"' EXIT
+
+echo -e "${BLUE}========================================${NC}"
+echo -e "${BLUE}   Cm TBAA Benchmark (best of $RUNS)${NC}"
+echo -e "${BLUE}========================================${NC}"
+
+# 最良実行時間（秒）を測定
+best_time() {
+    local best=""
+    for ((i = 0; i < RUNS; i++)); do
+        local start=$(date +%s.%N)
+        "$@" > /dev/null 2>&1
+        local end=$(date +%s.%N)
+        best=$(awk -v s="$start" -v e="$end" -v b="$best" \
+            'BEGIN { t = e - s; if (b == "" || t < b) printf "%.4f", t; else print b }')
+    done
+    echo "$best"
+}
+
+for entry in "${BENCHMARKS[@]}"; do
+    bench_name="${entry%%:*}"
+    display_name="${entry#*:}"
+    src="$SCRIPT_DIR/cm/${bench_name}.cm"
+
+    echo -e "\n${CYAN}=== $display_name ===${NC}"
+
+    if ! "$CM" compile -O3 "$src" -o "$BUILD_DIR/${bench_name}_tbaa" > /dev/null 2>&1 ||
+        ! "$CM" compile -O3 --no-tbaa "$src" -o "$BUILD_DIR/${bench_name}_notbaa" > /dev/null 2>&1; then
+        echo -e "${RED}ビルド失敗${NC}"
+        continue
+    fi
+
+    # 最適化後IRで!tbaaが付いたアクセス数
+    tagged=$("$CM" compile -O3 --lir-opt "$src" -o "$BUILD_DIR/${bench_name}_ir" 2>/dev/null | grep -c "!tbaa")
+
+    tbaa_time=$(best_time "$BUILD_DIR/${bench_name}_tbaa")
+    notbaa_time=$(best_time "$BUILD_DIR/${bench_name}_notbaa")
+    speedup=$(awk -v a="$notbaa_time" -v b="$tbaa_time" 'BEGIN { printf "%.2f", (b > 0) ? a / b : 0 }')
+
+    printf "TBAA あり:   %8.4f s\n" "$tbaa_time"
+    printf "TBAA なし:   %8.4f s\n" "$notbaa_time"
+    echo -e "${GREEN}Speedup: ${speedup}x${NC} (!tbaa 付きアクセス: $tagged)"
+
+    echo "$display_name,$tbaa_time,$notbaa_time,$speedup,$tagged" >> "$RESULT_FILE"
+done
+
+echo -e "\n結果: $RESULT_FILE"
@@ -0,0 +1,353 @@
+#!/bin/bash
+# ============================================================
+# Cm CLI テストランナー
+# コマンドラインオプションの解析を確認する
+# ============================================================
+
+# カラー定義
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+NC='\033[0m' # No Color
+
+# パス設定
+TEST_DIR="$(cd "$(dirname "$0")" && pwd)"
+PROJECT_ROOT="$(dirname "$(dirname "$TEST_DIR")")"
+CM="$PROJECT_ROOT/cm"
+
+FIXTURES_DIR="$TEST_DIR/fixtures"
+WORKSPACE_DIR="$(mktemp -d)"
+trap 'rm -rf "$WORKSPACE_DIR"' EXIT
+
+# カウンター
+PASSED=0
+FAILED=0
+
+# 結果表示関数
+pass() {
+    echo -e "${GREEN}✓ PASS${NC}: $1"
+    ((PASSED++))
+}
+
+fail() {
+    echo -e "${RED}✗ FAIL${NC}: $1"
+    echo "  $2"
+    ((FAILED++))
+}
+
+# ============================================================
+# テストケース
+# ============================================================
+
+# Test: -j / -jN / -j N / --jobs=N は受け付ける
+test_jobs_valid() {
+    echo ""
+    echo "=== Test: Valid -j Forms ==="
+
+    local form output
+    for form in "-j 2" "-j2" "--jobs=2"; do
+        # shellcheck disable=SC2086
+        output=$("$CM" check $form "$FIXTURES_DIR/hello.cm" 2>&1)
+        if [ $? -eq 0 ]; then
+            pass "accepted: $form"
+        else
+            fail "rejected: $form" "$output"
+        fi
+    done
+}
+
+# Test: 不正なジョブ数はエラー終了する
+test_jobs_invalid() {
+    echo ""
+    echo "=== Test: Malformed -j Values ==="
+
+    local form output
+    for form in "-j" "-jx" "-j4x" "-j0" "-j -1" "-j 99999" "--jobs=" "--jobs=2k" "-jobs"; do
+        # shellcheck disable=SC2086
+        output=$("$CM" check "$FIXTURES_DIR/hello.cm" $form 2>&1)
+        if [ $? -ne 0 ] && echo "$output" | grep -q "ジョブ数"; then
+            pass "rejected: $form"
+        else
+            fail "accepted: $form" "$output"
+        fi
+    done
+}
+
+# Test: 標準出力の既定方針（環境を固定: パイプ出力、CM_STDOUT_BUFFERで上書き）
+test_stdout_buffering_default() {
+    echo ""
+    echo "=== Test: Stdout Buffering Default ==="
+
+    local setting expected output
+    for setting in "unset:2" "line:1" "block:2" "none:0"; do
+        expected="mode: ${setting#*:}"
+        if [ "${setting%%:*}" = "unset" ]; then
+            output=$(env -u CM_STDOUT_BUFFER "$CM" run "$FIXTURES_DIR/stdout_mode.cm" 2>&1 | cat)
+        else
+            output=$(CM_STDOUT_BUFFER="${setting%%:*}" \
+                "$CM" run "$FIXTURES_DIR/stdout_mode.cm" 2>&1 | cat)
+        fi
+        if [ "$output" = "$expected" ]; then
+            pass "CM_STDOUT_BUFFER=${setting%%:*} -> $expected"
+        else
+            fail "CM_STDOUT_BUFFER=${setting%%:*}" "expected '$expected', got '$output'"
+        fi
+    done
+}
+
+# Test: ブロックバッファ中の出力が異常終了時にも失われない
+test_stdout_flush_on_crash() {
+    echo ""
+    echo "=== Test: Stdout Flush On Crash ==="
+
+    local out="$WORKSPACE_DIR/crash.out"
+    # シェルの "Segmentation fault" 表示も捨てるためサブシェルで実行する
+    (CM_STDOUT_BUFFER=block "$CM" run "$FIXTURES_DIR/crash_after_print.cm" >"$out"; exit $?) \
+        2>/dev/null
+    local status=$?
+    if [ $status -ne 0 ] && grep -q "before crash" "$out"; then
+        pass "buffered output written before crash"
+    else
+        fail "buffered output lost on crash" "exit=$status output=$(cat "$out")"
+    fi
+}
+
+# Test: 各層のノードが全て破棄され、AST/HIR/MIRのアリーナが返却される
+test_arena_release() {
+    echo ""
+    echo "=== Test: Node Arena Release ==="
+
+    local output
+    output=$("$CM" run --debug "$FIXTURES_DIR/hello.cm" 2>&1)
+    if [ $? -ne 0 ]; then
+        fail "cm run --debug failed" "$output"
+    elif echo "$output" | grep -q "arena not released"; then
+        fail "arena kept live nodes" "$(echo "$output" | grep "arena not released")"
+    else
+        pass "AST/HIR/MIR arenas released"
+    fi
+}
+
+# Test: 関数内パスの並列実行（-jN）でも最適化後のMIRと実行結果が -j1 と一致する
+test_parallel_mir_opt_deterministic() {
+    echo ""
+    echo "=== Test: Parallel MIR Optimization Determinism ==="
+
+    local fixture="$FIXTURES_DIR/many_functions.cm"
+    local base="$WORKSPACE_DIR/mir_j1.txt"
+    if ! "$CM" run --mir-opt -O2 -j1 "$fixture" >"$base" 2>&1; then
+        fail "cm run --mir-opt -j1 failed" "$(cat "$base")"
+        return
+    fi
+
+    local jobs out
+    for jobs in 2 4 8; do
+        out="$WORKSPACE_DIR/mir_j$jobs.txt"
+        "$CM" run --mir-opt -O2 -j"$jobs" "$fixture" >"$out" 2>&1
+        if cmp -s "$base" "$out"; then
+            pass "-j$jobs MIR matches -j1"
+        else
+            fail "-j$jobs MIR differs from -j1" "$(diff "$base" "$out" | head -10)"
+        fi
+    done
+}
+
+# Test: 複数ファイルの check -jN は -j1 と同じ診断を同じ順序（入力順）で出力する
+test_check_parallel_diagnostics() {
+    echo ""
+    echo "=== Test: Parallel Check Diagnostics Order ==="
+
+    local dir="$FIXTURES_DIR/check_many"
+    local base="$WORKSPACE_DIR/check_j1.txt"
+    "$CM" check -j1 "$dir" >"$base" 2>&1
+    local order
+    order=$(grep -o "file[0-9]\.cm:[0-9]*" "$base" | tr '\n' ' ')
+    if [ "$order" = "file2.cm:3 file2.cm:4 file4.cm:3 file4.cm:4 file6.cm:3 file6.cm:4 " ]; then
+        pass "-j1 diagnostics in input order"
+    else
+        fail "-j1 diagnostics out of order" "$order"
+    fi
+
+    local jobs out run
+    for jobs in 2 4 6; do
+        # 完了順が揺れても出力が変わらないことを複数回確認する
+        for run in 1 2 3; do
+            out="$WORKSPACE_DIR/check_j$jobs.txt"
+            "$CM" check -j"$jobs" "$dir" >"$out" 2>&1
+            if ! cmp -s "$base" "$out"; then
+                break
+            fi
+        done
+        if cmp -s "$base" "$out"; then
+            pass "-j$jobs diagnostics match -j1"
+        else
+            fail "-j$jobs diagnostics differ from -j1 (run $run)" "$(diff "$base" "$out" | head -10)"
+        fi
+    done
+}
+
+# Test: JITオブジェクトキャッシュ（cm run --incremental）
+# 2回目はキャッシュヒットして同じ出力になり、ソース変更後は古いオブジェクトを使わない
+test_jit_object_cache() {
+    echo ""
+    echo "=== Test: JIT Object Cache ==="
+
+    local dir="$WORKSPACE_DIR/jit_cache"
+    local src="$dir/prog.cm"
+    local hit="✓ JITオブジェクトキャッシュヒット"
+    mkdir -p "$dir"
+    printf 'import std::io::println;\n\nint main() {\n    println("value: 42");\n    return 0;\n}\n' \
+        >"$src"
+
+    local first second third
+    first=$("$CM" run --cache-dir="$dir/cache" --verbose "$src" 2>&1)
+    second=$("$CM" run --cache-dir="$dir/cache" --verbose "$src" 2>&1)
+    if echo "$first" | grep -q "$hit"; then
+        fail "first run hit an empty cache" "$first"
+    elif ! echo "$second" | grep -q "$hit"; then
+        fail "second run missed the cache" "$second"
+    elif [ "$(echo "$first" | grep "^value:")" != "value: 42" ] ||
+        [ "$(echo "$second" | grep "^value:")" != "value: 42" ]; then
+        fail "cached run output differs" "$(echo "$second" | grep "^value:")"
+    else
+        pass "second run hits the cache with identical output"
+    fi
+
+    # ソースを変えるとフィンガープリントが変わり、古いエントリは使われない
+    sed -i 's/value: 42/value: 43/' "$src"
+    third=$("$CM" run --cache-dir="$dir/cache" --verbose "$src" 2>&1)
+    if echo "$third" | grep -q "$hit"; then
+        fail "stale cache entry reused after source change" "$third"
+    elif [ "$(echo "$third" | grep "^value:")" != "value: 43" ]; then
+        fail "changed source produced stale output" "$(echo "$third" | grep "^value:")"
+    else
+        pass "source change invalidates the cached object"
+    fi
+}
+
+# Test: モジュールインターフェース（.cmi）キャッシュ
+# 初回はミスして.cmiを書き、2回目はヒットし、依存先が変わると依存元の.cmiも使わない
+test_module_interface_cache() {
+    echo ""
+    echo "=== Test: Module Interface Cache ==="
+
+    local dir="$WORKSPACE_DIR/cmi"
+    mkdir -p "$dir"
+    cp "$FIXTURES_DIR"/cmi/*.cm "$dir/"
+
+    local loaded="Loaded module interface: $dir/calc.cm"
+    local output
+    run_cmi() {
+        (cd "$dir" && "$CM" run --cache-dir="$dir/cache" --debug main.cm 2>&1)
+    }
+
+    output=$(run_cmi)
+    if echo "$output" | grep -q "$loaded"; then
+        fail "first run loaded a .cmi from an empty cache" "$(echo "$output" | grep "$loaded")"
+    elif ! ls "$dir"/cache/cmi/calc-*.cmi "$dir"/cache/cmi/base-*.cmi >/dev/null 2>&1; then
+        fail "miss did not write .cmi files" "$(ls "$dir/cache/cmi" 2>&1)"
+    elif ! echo "$output" | grep -qx "scaled: 20"; then
+        fail "first run output" "$(echo "$output" | tail -5)"
+    else
+        pass "miss writes .cmi files for calc and base"
+    fi
+
+    output=$(run_cmi)
+    if echo "$output" | grep -q "$loaded" && echo "$output" | grep -qx "scaled: 20"; then
+        pass "hit reuses calc.cmi with identical output"
+    else
+        fail "second run did not reuse calc.cmi" "$(echo "$output" | tail -5)"
+    fi
+
+    # calc が展開時に参照した base を変更すると calc.cmi も無効になる
+    sed -i 's/return 10;/return 7;/' "$dir/base.cm"
+    output=$(run_cmi)
+    if echo "$output" | grep -q "$loaded"; then
+        fail "stale calc.cmi reused after base.cm changed" "$(echo "$output" | grep "$loaded")"
+    elif ! echo "$output" | grep -qx "scaled: 14"; then
+        fail "changed dependency produced stale output" "$(echo "$output" | tail -5)"
+    else
+        pass "changed dependency invalidates calc.cmi"
+    fi
+
+    output=$(run_cmi)
+    if echo "$output" | grep -q "$loaded" && echo "$output" | grep -qx "scaled: 14"; then
+        pass "rewritten calc.cmi is reused"
+    else
+        fail "calc.cmi not rewritten after invalidation" "$(echo "$output" | tail -5)"
+    fi
+}
+
+# Test: ポインタ経由のdouble/intアクセスに型ごとのTBAAタグが付き、--no-tbaa で外れる
+test_tbaa_pointer_access() {
+    echo ""
+    echo "=== Test: TBAA Tags on Pointer Accesses ==="
+
+    local fixture="$FIXTURES_DIR/pointer_alias.cm"
+    local exe="$WORKSPACE_DIR/pointer_alias"
+    local output
+    output=$("$CM" compile -O2 --lir-opt "$fixture" -o "$exe" 2>&1)
+    if [ $? -ne 0 ]; then
+        fail "cm compile --lir-opt failed" "$(echo "$output" | tail -5)"
+        return
+    fi
+    # ポインタ経由のアクセスはvoid*経由の型の読み替えがあり得るため、charタグだけを付ける
+    if echo "$output" | grep -q "store double .*!tbaa" &&
+        echo "$output" | grep -q "store i32 .*!tbaa" &&
+        echo "$output" | grep -q '!"cm_char"' &&
+        ! echo "$output" | grep -qE '!"cm_(double|int|long)"'; then
+        pass "double*/int* accesses carry only the char TBAA tag"
+    else
+        fail "pointer accesses carry typed TBAA tags" "$(echo "$output" | grep -E "^!" | head -5)"
+    fi
+
+    output=$("$CM" compile -O2 --no-tbaa --lir-opt "$fixture" -o "$exe" 2>&1)
+    if echo "$output" | grep -q "!tbaa"; then
+        fail "--no-tbaa still emits TBAA tags" "$(echo "$output" | grep -m3 "!tbaa")"
+    else
+        pass "--no-tbaa emits no TBAA tags"
+    fi
+}
+
+# ============================================================
+# メイン
+# ============================================================
+
+echo "=============================================="
+echo "   Cm CLI Test Suite"
+echo "=============================================="
+
+# cmが存在するか確認
+if [ ! -f "$CM" ]; then
+    echo -e "${RED}Error: cm not found at $CM${NC}"
+    echo "Please build the project first: cmake --build build"
+    exit 1
+fi
+
+# テスト実行
+test_jobs_valid
+test_jobs_invalid
+test_stdout_buffering_default
+test_stdout_flush_on_crash
+test_arena_release
+test_parallel_mir_opt_deterministic
+test_check_parallel_diagnostics
+test_jit_object_cache
+test_module_interface_cache
+test_tbaa_pointer_access
+
+# 結果サマリー
+echo ""
+echo "=============================================="
+echo "   Test Results"
+echo "=============================================="
+echo -e "Passed: ${GREEN}$PASSED${NC}"
+echo -e "Failed: ${RED}$FAILED${NC}"
+echo ""
+
+if [ $FAILED -gt 0 ]; then
+    echo -e "${RED}Some tests failed!${NC}"
+    exit 1
+else
+    echo -e "${GREEN}All tests passed!${NC}"
+    exit 0
+fi
@@ -59,6 +59,7 @@ PARALLEL=false
 TIMEOUT=15
 NO_CACHE=false
 CLEAN_CACHE=false
+INCREMENTAL=false
 
 # タイムアウトコマンドの検出
 TIMEOUT_CMD=""
@@ -168,6 +169,7 @@ usage() {
     echo "  -p, --parallel             Run tests in parallel (experimental)"
     echo "  -t, --timeout <seconds>    Test timeout in seconds (default: 5)"
     echo "  -n, --no-cache             キャッシュを無効化してテスト実行"
+    echo "  -i, --incremental          インクリメンタルキャッシュ（.cmi・JITオブジェクト）を有効化"
     echo "  --clean-cache              テスト前にキャッシュを削除"
     echo "  -h, --help                 Show this help message"
     echo ""
@@ -215,6 +217,10 @@ while [[ $# -gt 0 ]]; do
             NO_CACHE=true
             shift
             ;;
+        -i|--incremental)
+            INCREMENTAL=true
+            shift
+            ;;
         --clean-cache)
             CLEAN_CACHE=true
             shift
@@ -240,6 +246,9 @@ fi
 CACHE_OPTS=""
 if [ "$NO_CACHE" = true ]; then
     CACHE_OPTS="--no-cache"
+elif [ "$INCREMENTAL" = true ]; then
+    # テストはディレクトリを移動して実行するため、キャッシュはプロジェクト直下に集める
+    CACHE_OPTS="--cache-dir=$PROJECT_ROOT/.cm-cache"
 fi
 
 # テスト前キャッシュクリア
@@ -0,0 +1,88 @@
+#include "../../src/common/arena.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace cm;
+
+namespace {
+
+struct TestTag;
+using TestArena = NodeArena<TestTag>;
+
+struct TestNode {
+    CM_ARENA_NODE(TestTag)
+
+    int value;
+    std::unique_ptr<TestNode> next;
+
+    explicit TestNode(int v) : value(v) {}
+};
+
+struct LargeNode {
+    CM_ARENA_NODE(TestTag)
+
+    char payload[TestArena::kMaxNodeSize + 1];
+};
+
+}  // namespace
+
+// 破棄したノードの領域は同じサイズのノードに再利用される
+TEST(NodeArenaTest, ReusesFreedNodes) {
+    auto a = std::make_unique<TestNode>(1);
+    void* addr = a.get();
+    a.reset();
+    auto b = std::make_unique<TestNode>(2);
+    EXPECT_EQ(b.get(), addr);
+    EXPECT_EQ(b->value, 2);
+}
+
+// 生存ノードがある間はチャンクを返却しない
+TEST(NodeArenaTest, ReleaseOnlyWhenEmpty) {
+    auto head = std::make_unique<TestNode>(0);
+    TestNode* tail = head.get();
+    for (int i = 1; i < 10000; ++i) {
+        tail->next = std::make_unique<TestNode>(i);
+        tail = tail->next.get();
+    }
+    EXPECT_EQ(TestArena::live(), 10000u);
+    EXPECT_GT(TestArena::reserved_bytes(), TestArena::kChunkSize);
+    EXPECT_FALSE(TestArena::release());
+    EXPECT_EQ(tail->value, 9999);
+
+    // 再帰的な破棄でスタックを溢れさせないよう先頭から外す
+    while (head)
+        head = std::move(head->next);
+    EXPECT_EQ(TestArena::live(), 0u);
+    EXPECT_TRUE(TestArena::release());
+    EXPECT_EQ(TestArena::reserved_bytes(), 0u);
+
+    // 返却後も新しいチャンクから割り当てられる
+    auto again = std::make_unique<TestNode>(42);
+    EXPECT_EQ(again->value, 42);
+    EXPECT_EQ(TestArena::live(), 1u);
+}
+
+// 別スレッドで割り当てたノードを破棄できる
+TEST(NodeArenaTest, CrossThreadFree) {
+    size_t before = TestArena::live();
+    std::vector<std::unique_ptr<TestNode>> nodes;
+    std::thread producer([&]() {
+        for (int i = 0; i < 1000; ++i)
+            nodes.push_back(std::make_unique<TestNode>(i));
+    });
+    producer.join();
+    EXPECT_EQ(TestArena::live(), before + 1000);
+    nodes.clear();
+    EXPECT_EQ(TestArena::live(), before);
+}
+
+// 大きなノードは通常のヒープに置かれ、生存数に数えない
+TEST(NodeArenaTest, LargeNodesBypassArena) {
+    size_t before = TestArena::live();
+    auto large = std::make_unique<LargeNode>();
+    EXPECT_EQ(TestArena::live(), before);
+}
@@ -1,6 +1,10 @@
 #include "../../src/frontend/lexer/lexer.hpp"
+#include "../../src/frontend/lexer/token_stream.hpp"
 
 #include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace cm;
 
@@ -30,6 +34,49 @@ TEST_F(LexerTest, Identifier) {
     EXPECT_EQ(tokens[2].get_string(), "_baz");
 }
 
+// 識別子はインターンされ、同じ綴りは同じIDになる
+TEST_F(LexerTest, IdentifierInterning) {
+    auto tokens = tokenize("count total count if");
+    ASSERT_EQ(tokens.size(), 5u);
+    ASSERT_TRUE(tokens[0].ident.valid());
+    EXPECT_EQ(tokens[0].ident, tokens[2].ident);
+    EXPECT_NE(tokens[0].ident, tokens[1].ident);
+    EXPECT_EQ(tokens[1].ident.str(), "total");
+    EXPECT_EQ(Ident::find("count"), tokens[0].ident);
+    // キーワードはインターンしない
+    EXPECT_FALSE(tokens[3].ident.valid());
+}
+
+// 複数スレッドから同時に登録しても、同じ綴りは同じIDになる
+TEST_F(LexerTest, IdentifierInterningConcurrent) {
+    constexpr int kThreads = 8;
+    constexpr int kNames = 3000;  // 分割あたりのチャンクを複数使う数
+    std::vector<std::vector<Ident>> ids(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([t, &ids] {
+            for (int i = 0; i < kNames; ++i) {
+                // スレッドごとに登録順を変える
+                int n = (t % 2 == 0) ? i : kNames - 1 - i;
+                Ident id = Ident::intern("concurrent_ident_" + std::to_string(n));
+                EXPECT_EQ(id.str(), "concurrent_ident_" + std::to_string(n));
+                ids[t].push_back(id);
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    for (int i = 0; i < kNames; ++i) {
+        Ident expected = Ident::find("concurrent_ident_" + std::to_string(i));
+        ASSERT_TRUE(expected.valid());
+        for (int t = 0; t < kThreads; ++t) {
+            int n = (t % 2 == 0) ? i : kNames - 1 - i;
+            EXPECT_EQ(ids[t][i], Ident::find("concurrent_ident_" + std::to_string(n)));
+        }
+    }
+}
+
 // キーワード
 TEST_F(LexerTest, Keywords) {
     auto tokens = tokenize("if else while for return struct with");
@@ -143,6 +190,69 @@ TEST_F(LexerTest, Comments) {
     EXPECT_EQ(tokens[2].get_string(), "baz");
 }
 
+// コメントの終端判定（'*'を含む本文・閉じていないコメント）
+TEST_F(LexerTest, CommentEdges) {
+    auto tokens = tokenize("a /* x * y **/ b /*/ c");
+    ASSERT_EQ(tokens.size(), 3u);
+    EXPECT_EQ(tokens[0].get_string(), "a");
+    EXPECT_EQ(tokens[1].get_string(), "b");
+    EXPECT_EQ(tokens[2].kind, TokenKind::Eof);
+
+    tokens = tokenize("a // 末尾のコメント");
+    ASSERT_EQ(tokens.size(), 2u);
+    EXPECT_EQ(tokens[1].kind, TokenKind::Eof);
+}
+
+// 逐次読み出しは一括のトークン化と同じ列を返し、末尾以降はEofを返し続ける
+TEST_F(LexerTest, NextMatchesTokenize) {
+    std::string source = "int x = 0x1F; // c\nfor (i in xs) { x += i; }";
+    auto tokens = tokenize(source);
+    Lexer lexer(source);
+    for (const auto& expected : tokens) {
+        Token tok = lexer.next();
+        EXPECT_EQ(tok.kind, expected.kind);
+        EXPECT_EQ(tok.start, expected.start);
+        EXPECT_EQ(tok.end, expected.end);
+    }
+    EXPECT_EQ(lexer.next().kind, TokenKind::Eof);
+}
+
+// TokenStreamは通し番号で先読みでき、固定した位置へ巻き戻せる
+TEST_F(LexerTest, TokenStreamCheckpoint) {
+    std::string source = "a b c d e";
+    Lexer lexer(source);
+    TokenStream stream(lexer);
+    EXPECT_EQ(stream[2].get_string(), "c");
+    {
+        auto saved = stream.checkpoint(1);
+        stream.discard_before(3);
+        // 固定中の位置以降は残る
+        EXPECT_EQ(stream[1].get_string(), "b");
+        EXPECT_EQ(saved.pos(), 1u);
+    }
+    stream.discard_before(3);
+    EXPECT_EQ(stream[3].get_string(), "d");
+    EXPECT_TRUE(stream.has(5));  // Eof
+    EXPECT_FALSE(stream.has(6));
+    EXPECT_EQ(stream[100].kind, TokenKind::Eof);
+}
+
+// 捨て済みの位置を参照してもバッファ外を読まない（リリースビルドではErrorトークン）
+TEST_F(LexerTest, TokenStreamDiscardedIndex) {
+    std::string source = "a b c d e";
+    Lexer lexer(source);
+    TokenStream stream(lexer);
+    EXPECT_EQ(stream[3].get_string(), "d");
+    stream.discard_before(3);
+#ifdef NDEBUG
+    EXPECT_EQ(stream[0].kind, TokenKind::Error);
+    EXPECT_EQ(stream[2].kind, TokenKind::Error);
+#else
+    EXPECT_DEATH((void)stream[0], "already discarded");
+#endif
+    EXPECT_EQ(stream[3].get_string(), "d");
+}
+
 // 完全な関数定義
 TEST_F(LexerTest, FunctionDefinition) {
     auto tokens = tokenize(R"(
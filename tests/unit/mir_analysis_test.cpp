@@ -0,0 +1,201 @@
+#include "../../src/mir/analysis/analysis_manager.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace cm;
+using namespace cm::mir;
+
+// ============================================================
+// テストヘルパー
+// ============================================================
+class MirAnalysisTest : public ::testing::Test {
+   protected:
+    static MirOperandPtr local(LocalId id) { return MirOperand::copy(MirPlace(id)); }
+
+    static MirOperandPtr int_const(int64_t v) {
+        MirConstant c;
+        c.value = v;
+        return MirOperand::constant(c);
+    }
+
+    // bb0: _1 = 0 → switch(_2) [1: bb1, otherwise: bb2]
+    // bb1: _1 = _1 + 1 → goto bb3
+    // bb2: goto bb3
+    // bb3: _0 = _1 → return
+    static MirFunction diamond() {
+        MirFunction f;
+        f.name = "diamond";
+        f.return_local = f.add_local("_0", nullptr);
+        f.add_local("x", nullptr);
+        f.add_local("cond", nullptr);
+        for (int i = 0; i < 4; ++i) {
+            f.add_block();
+        }
+        f.basic_blocks[0]->statements.push_back(
+            MirStatement::assign(MirPlace(1), MirRvalue::use(int_const(0))));
+        f.basic_blocks[0]->terminator = MirTerminator::switch_int(local(2), {{1, 1}}, 2);
+        f.basic_blocks[1]->statements.push_back(MirStatement::assign(
+            MirPlace(1), MirRvalue::binary(MirBinaryOp::Add, local(1), int_const(1))));
+        f.basic_blocks[1]->terminator = MirTerminator::goto_block(3);
+        f.basic_blocks[2]->terminator = MirTerminator::goto_block(3);
+        f.basic_blocks[3]->statements.push_back(
+            MirStatement::assign(MirPlace(0), MirRvalue::use(local(1))));
+        f.basic_blocks[3]->terminator = MirTerminator::return_value();
+        return f;
+    }
+
+    // bb0 → bb1(header) ⇄ bb2(body)、bb1 → bb3(exit)、bb4は到達不能
+    static MirFunction simple_loop() {
+        MirFunction f;
+        f.name = "simple_loop";
+        f.return_local = f.add_local("_0", nullptr);
+        f.add_local("i", nullptr);
+        for (int i = 0; i < 5; ++i) {
+            f.add_block();
+        }
+        f.basic_blocks[0]->terminator = MirTerminator::goto_block(1);
+        f.basic_blocks[1]->terminator = MirTerminator::switch_int(local(1), {{0, 3}}, 2);
+        f.basic_blocks[2]->statements.push_back(MirStatement::assign(
+            MirPlace(1), MirRvalue::binary(MirBinaryOp::Sub, local(1), int_const(1))));
+        f.basic_blocks[2]->terminator = MirTerminator::goto_block(1);
+        f.basic_blocks[3]->terminator = MirTerminator::return_value();
+        f.basic_blocks[4]->terminator = MirTerminator::goto_block(3);
+        return f;
+    }
+};
+
+// ============================================================
+// 支配木
+// ============================================================
+TEST_F(MirAnalysisTest, Dominators_Diamond) {
+    auto f = diamond();
+    DominatorTree dom(f);
+
+    EXPECT_TRUE(dom.dominates(0, 3));
+    EXPECT_FALSE(dom.dominates(1, 3));
+    EXPECT_FALSE(dom.dominates(2, 3));
+    EXPECT_EQ(dom.get_idom(3), std::optional<BlockId>(0));
+    EXPECT_EQ(dom.get_idom(1), std::optional<BlockId>(0));
+    EXPECT_FALSE(dom.get_idom(0).has_value());
+}
+
+TEST_F(MirAnalysisTest, Dominators_UnreachableBlock) {
+    auto f = simple_loop();
+    DominatorTree dom(f);
+
+    EXPECT_FALSE(dom.is_reachable(4));
+    EXPECT_FALSE(dom.dominates(0, 4));
+    EXPECT_FALSE(dom.get_idom(4).has_value());
+    EXPECT_TRUE(dom.dominates(1, 2));
+    EXPECT_TRUE(dom.dominates(1, 3));
+}
+
+TEST_F(MirAnalysisTest, PostDominators_Diamond) {
+    auto f = diamond();
+    PostDominatorTree pdom(f);
+
+    EXPECT_TRUE(pdom.dominates(3, 0));
+    EXPECT_TRUE(pdom.dominates(3, 1));
+    EXPECT_FALSE(pdom.dominates(1, 0));
+    EXPECT_EQ(pdom.get_idom(0), std::optional<BlockId>(3));
+    // 出口ブロックの即時後支配は仮想出口なのでなし
+    EXPECT_FALSE(pdom.get_idom(3).has_value());
+}
+
+// ============================================================
+// ループ解析
+// ============================================================
+TEST_F(MirAnalysisTest, Loops_SimpleLoop) {
+    auto f = simple_loop();
+    DominatorTree dom(f);
+    LoopAnalysis loops(f, dom);
+
+    ASSERT_EQ(loops.get_top_level_loops().size(), 1u);
+    auto* loop = loops.get_top_level_loops()[0];
+    EXPECT_EQ(loop->header, 1u);
+    EXPECT_TRUE(loop->contains(2));
+    EXPECT_FALSE(loop->contains(3));
+    EXPECT_EQ(loops.get_inner_most_loop(2), loop);
+    EXPECT_EQ(loops.get_inner_most_loop(0), nullptr);
+}
+
+// ============================================================
+// def-use / 生存解析
+// ============================================================
+TEST_F(MirAnalysisTest, DefUse_Diamond) {
+    auto f = diamond();
+    DefUseChains du(f);
+
+    EXPECT_EQ(du.defs(1).size(), 2u);
+    EXPECT_EQ(du.uses(1).size(), 2u);
+    EXPECT_TRUE(du.has_single_def(0));
+    ASSERT_EQ(du.uses(2).size(), 1u);
+    EXPECT_TRUE(du.uses(2)[0].is_terminator());
+    // Returnは戻り値ローカルを使用する
+    ASSERT_EQ(du.uses(0).size(), 1u);
+    EXPECT_EQ(du.uses(0)[0].block, 3u);
+}
+
+TEST_F(MirAnalysisTest, Liveness_Loop) {
+    auto f = simple_loop();
+    LivenessAnalysis live(f);
+
+    // iはループ全体で生存
+    EXPECT_TRUE(live.is_live_in(1, 1));
+    EXPECT_TRUE(live.is_live_out(2, 1));
+    EXPECT_TRUE(live.is_live_in(0, 1));
+    // 出口以降では使われない
+    EXPECT_FALSE(live.is_live_out(3, 1));
+    EXPECT_TRUE(live.is_live_in(3, 0));
+}
+
+TEST_F(MirAnalysisTest, Liveness_KilledBeforeUse) {
+    auto f = diamond();
+    LivenessAnalysis live(f);
+
+    // xはbb0で定義されてから使われるので入口では死んでいる
+    EXPECT_FALSE(live.is_live_in(0, 1));
+    EXPECT_TRUE(live.is_live_in(0, 2));
+    EXPECT_TRUE(live.is_live_out(1, 1));
+    EXPECT_TRUE(live.is_live_out(2, 1));
+}
+
+// ============================================================
+// 解析マネージャ
+// ============================================================
+TEST_F(MirAnalysisTest, AnalysisManager_CachesAndInvalidates) {
+    auto f = simple_loop();
+    FunctionAnalysisManager am;
+
+    const auto* first = &am.loops(f);
+    EXPECT_EQ(&am.loops(f), first);
+    EXPECT_EQ(am.computed_count(), 2u);  // 支配木 + ループ
+
+    // CFGを保つ変更ではループ解析を保持し、def-useは破棄
+    am.def_use(f);
+    am.invalidate(f, PreservedAnalyses::cfg());
+    EXPECT_EQ(&am.loops(f), first);
+    size_t before = am.computed_count();
+    am.def_use(f);
+    EXPECT_EQ(am.computed_count(), before + 1);
+
+    // 全破棄後は再計算
+    am.invalidate(f, PreservedAnalyses::none());
+    before = am.computed_count();
+    am.loops(f);
+    EXPECT_EQ(am.computed_count(), before + 2);
+}
+
+TEST_F(MirAnalysisTest, AnalysisManager_DetectsMissedInvalidation) {
+    auto f = simple_loop();
+    FunctionAnalysisManager am;
+
+    EXPECT_FALSE(am.dominators(f).dominates(1, 5));
+
+    // invalidateせずにブロックを追加しても、ブロック数の変化で作り直す
+    BlockId pre_header = f.add_block();
+    f.basic_blocks[pre_header]->terminator = MirTerminator::goto_block(1);
+    f.basic_blocks[0]->terminator = MirTerminator::goto_block(pre_header);
+    EXPECT_TRUE(am.dominators(f).dominates(pre_header, 1));
+    EXPECT_EQ(am.dominators(f).get_idom(1), std::optional<BlockId>(pre_header));
+}
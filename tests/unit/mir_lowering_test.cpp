@@ -3,9 +3,11 @@
 #include "../../src/hir/lowering/lowering.hpp"
 #include "../../src/mir/lowering/lowering.hpp"
 
+#include <atomic>
 #include <gtest/gtest.h>
 #include <memory>
 #include <sstream>
+#include <thread>
 
 using namespace cm;
 
@@ -309,4 +311,51 @@ TEST_F(MirLoweringTest, MultipleFunctions) {
         EXPECT_FALSE(func->name.empty());
         EXPECT_GE(func->basic_blocks.size(), 1u);
     }
-}
\ No newline at end of file
+}
+
+// ============================================================
+// 関数の検索（名前索引）のテスト
+// ============================================================
+TEST_F(MirLoweringTest, FindFunctionAfterRename) {
+    mir::MirProgram program;
+    for (const char* name : {"first", "second"}) {
+        auto func = std::make_unique<mir::MirFunction>();
+        func->name = name;
+        program.functions.push_back(std::move(func));
+    }
+    ASSERT_NE(program.find_function("second"), nullptr);
+
+    // 索引を作った後の改名でも、新しい名前で引けて古い名前では引けない
+    program.rename_function(*program.functions[1], "renamed");
+    ASSERT_NE(program.find_function("renamed"), nullptr);
+    EXPECT_EQ(program.find_function("renamed"), program.functions[1].get());
+    EXPECT_EQ(program.find_function("second"), nullptr);
+}
+
+TEST_F(MirLoweringTest, FindFunctionConcurrent) {
+    mir::MirProgram program;
+    constexpr int kFunctions = 500;
+    for (int i = 0; i < kFunctions; ++i) {
+        auto func = std::make_unique<mir::MirFunction>();
+        func->name = "fn_" + std::to_string(i);
+        program.functions.push_back(std::move(func));
+    }
+
+    // 並列パスと同様に、索引を作る前の状態から複数スレッドで同時に引く
+    std::atomic<int> misses{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < kFunctions; ++i) {
+                int index = (i * 7 + t * 31) % kFunctions;
+                const auto* found = program.find_function("fn_" + std::to_string(index));
+                if (found != program.functions[index].get())
+                    ++misses;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(misses.load(), 0);
+}
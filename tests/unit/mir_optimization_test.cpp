@@ -5,6 +5,8 @@
 #include "../../src/mir/passes/cleanup/dce.hpp"
 #include "../../src/mir/passes/cleanup/simplify_cfg.hpp"
 #include "../../src/mir/passes/core/manager.hpp"
+#include "../../src/mir/passes/interprocedural/inlining.hpp"
+#include "../../src/mir/passes/redundancy/gvn.hpp"
 #include "../../src/mir/passes/scalar/folding.hpp"
 #include "../../src/mir/passes/scalar/propagation.hpp"
 #include "../../src/mir/printer.hpp"
@@ -258,6 +260,252 @@ TEST_F(MirOptimizationTest, CopyPropagation_Chain) {
     // d + 1 が a + 1 に変換されているはず
 }
 
+// ============================================================
+// 大域値番号付け（GVN）のテスト
+// ============================================================
+TEST_F(MirOptimizationTest, GVN_CommutativeOperands) {
+    const std::string code = R"(
+        int main() {
+            int a = 6;
+            int b = 7;
+            int x = a * b;
+            int y = b * a;
+            return x - y;
+        }
+    )";
+
+    auto mir = compile_to_mir(code);
+    auto& func = *mir->functions[0];
+
+    // b * a は a * b と同じ値番号になり、xのコピーに置き換わる
+    mir::opt::GVN gvn;
+    EXPECT_TRUE(gvn.run(func));
+}
+
+TEST_F(MirOptimizationTest, GVN_PureCallReuse) {
+    // bb0: _1 = 3 → _2 = square(_1) → bb1
+    // bb1: _3 = square(_1) → bb2
+    // bb2: _0 = _2 + _3 → return
+    // （型検査を通さないため、型付きのMIRを直接組み立てる）
+    mir::MirFunction func;
+    func.name = "main";
+    auto int_type = ast::make_int();
+    func.return_local = func.add_local("_0", int_type);
+    func.add_local("a", int_type);
+    func.add_local("p", int_type);
+    func.add_local("q", int_type);
+    for (int i = 0; i < 3; ++i) {
+        func.add_block();
+    }
+
+    mir::MirConstant three;
+    three.value = int64_t{3};
+    three.type = int_type;
+    func.basic_blocks[0]->statements.push_back(mir::MirStatement::assign(
+        mir::MirPlace(1), mir::MirRvalue::use(mir::MirOperand::constant(three))));
+
+    auto pure_call = [&](mir::LocalId dest, mir::BlockId success) {
+        mir::MirTerminator::CallData call;
+        call.func = mir::MirOperand::function_ref("square");
+        call.args.push_back(mir::MirOperand::copy(mir::MirPlace(1), int_type));
+        call.destination = mir::MirPlace(dest);
+        call.success = success;
+        call.is_pure = true;
+        auto term = std::make_unique<mir::MirTerminator>();
+        term->kind = mir::MirTerminator::Call;
+        term->data = std::move(call);
+        return term;
+    };
+    func.basic_blocks[0]->terminator = pure_call(2, 1);
+    func.basic_blocks[1]->terminator = pure_call(3, 2);
+    func.basic_blocks[2]->statements.push_back(mir::MirStatement::assign(
+        mir::MirPlace(0),
+        mir::MirRvalue::binary(mir::MirBinaryOp::Add, mir::MirOperand::copy(mir::MirPlace(2)),
+                               mir::MirOperand::copy(mir::MirPlace(3)))));
+    func.basic_blocks[2]->terminator = mir::MirTerminator::return_value();
+
+    // 2回目の呼び出しは1回目の戻り値のコピー + gotoになる
+    mir::opt::GVN gvn;
+    EXPECT_TRUE(gvn.run(func));
+    EXPECT_EQ(func.basic_blocks[0]->terminator->kind, mir::MirTerminator::Call);
+    EXPECT_EQ(func.basic_blocks[1]->terminator->kind, mir::MirTerminator::Goto);
+    ASSERT_EQ(func.basic_blocks[1]->statements.size(), 1u);
+}
+
+TEST_F(MirOptimizationTest, GVN_KeepsVolatileReads) {
+    // bb0: _1 = copy(src) → _2 = copy(src) → _0 = _1 + _2 → return
+    // volatile修飾のローカルとグローバル（コード生成でvolatileアクセス）は
+    // 連続した読み出しがどちらも残る
+    auto int_type = ast::make_int();
+    auto volatile_int = std::make_shared<ast::Type>(*int_type);
+    volatile_int->qualifiers.is_volatile = true;
+
+    for (bool global : {false, true}) {
+        mir::MirFunction func;
+        func.name = "main";
+        func.return_local = func.add_local("_0", int_type);
+        func.add_local("a", int_type);
+        func.add_local("b", int_type);
+        mir::LocalId src = global ? func.add_local("g", int_type, true, true, false, true)
+                                  : func.add_local("v", volatile_int);
+        func.add_block();
+
+        auto& stmts = func.basic_blocks[0]->statements;
+        for (mir::LocalId dest : {mir::LocalId{1}, mir::LocalId{2}}) {
+            stmts.push_back(mir::MirStatement::assign(
+                mir::MirPlace(dest),
+                mir::MirRvalue::use(mir::MirOperand::copy(mir::MirPlace(src), int_type))));
+        }
+        stmts.push_back(mir::MirStatement::assign(
+            mir::MirPlace(0),
+            mir::MirRvalue::binary(mir::MirBinaryOp::Add, mir::MirOperand::copy(mir::MirPlace(1)),
+                                   mir::MirOperand::copy(mir::MirPlace(2)))));
+        func.basic_blocks[0]->terminator = mir::MirTerminator::return_value();
+
+        mir::opt::GVN gvn;
+        gvn.run(func);
+        ASSERT_EQ(stmts.size(), 3u);
+        for (size_t i = 0; i < 2; ++i) {
+            const auto& assign = std::get<mir::MirStatement::AssignData>(stmts[i]->data);
+            const auto& rvalue = std::get<mir::MirRvalue::UseData>(assign.rvalue->data);
+            EXPECT_EQ(std::get<mir::MirPlace>(rvalue.operand->data).local, src)
+                << (global ? "global" : "volatile local");
+        }
+    }
+}
+
+// ============================================================
+// インライン展開のテスト
+// ============================================================
+TEST_F(MirOptimizationTest, Inlining_SmallCallee) {
+    const std::string code = R"(
+        int add(int a, int b) {
+            return a + b;
+        }
+
+        int main() {
+            int x = 1;
+            int y = 2;
+            return add(x, y);
+        }
+    )";
+
+    auto mir = compile_to_mir(code);
+    mir::MirFunction* main_func = nullptr;
+    for (auto& func : mir->functions) {
+        if (func && func->name == "main")
+            main_func = func.get();
+    }
+    ASSERT_NE(main_func, nullptr);
+
+    // addは常に展開されるコストで、mainから呼び出しが消える
+    mir::opt::FunctionInlining inliner;
+    EXPECT_TRUE(inliner.run_on_program(*mir));
+    for (const auto& block : main_func->basic_blocks) {
+        if (block && block->terminator) {
+            EXPECT_NE(block->terminator->kind, mir::MirTerminator::Call);
+        }
+    }
+}
+
+TEST_F(MirOptimizationTest, Inlining_PreservesOperandTypesAndCallFlags) {
+    // wrap(p: Point, d: double) { sink(p, 1.5) [tail] } を main から wrap(q, 2.5) で呼ぶ
+    // 展開後も実引数・複製した呼び出しのオペランド型と呼び出しフラグが残ること
+    // （型検査を通さないため、型付きのMIRを直接組み立てる）
+    auto point_type = ast::make_named("Point");
+    auto double_type = ast::make_double();
+    auto double_constant = [&](double value) {
+        mir::MirConstant c;
+        c.value = value;
+        c.type = double_type;
+        auto op = mir::MirOperand::constant(c);
+        op->type = double_type;
+        return op;
+    };
+
+    mir::MirProgram program;
+
+    auto wrap = std::make_unique<mir::MirFunction>();
+    wrap->name = "wrap";
+    wrap->return_local = wrap->add_local("_0", ast::make_void());
+    wrap->arg_locals.push_back(wrap->add_local("p", point_type, false, true));
+    wrap->arg_locals.push_back(wrap->add_local("d", double_type, false, true));
+    wrap->add_block();
+    wrap->add_block();
+    {
+        mir::MirTerminator::CallData call;
+        call.func = mir::MirOperand::function_ref("sink");
+        call.args.push_back(mir::MirOperand::copy(mir::MirPlace(1), point_type));
+        call.args.push_back(double_constant(1.5));
+        call.success = 1;
+        call.is_tail_call = true;
+        call.is_pure = true;
+        auto term = std::make_unique<mir::MirTerminator>();
+        term->kind = mir::MirTerminator::Call;
+        term->data = std::move(call);
+        wrap->basic_blocks[0]->terminator = std::move(term);
+    }
+    wrap->basic_blocks[1]->terminator = mir::MirTerminator::return_value();
+
+    auto main_func = std::make_unique<mir::MirFunction>();
+    main_func->name = "main";
+    main_func->return_local = main_func->add_local("_0", ast::make_void());
+    main_func->add_local("q", point_type);
+    main_func->add_block();
+    main_func->add_block();
+    {
+        mir::MirTerminator::CallData call;
+        call.func = mir::MirOperand::function_ref("wrap");
+        call.args.push_back(mir::MirOperand::copy(mir::MirPlace(1), point_type));
+        call.args.push_back(double_constant(2.5));
+        call.success = 1;
+        auto term = std::make_unique<mir::MirTerminator>();
+        term->kind = mir::MirTerminator::Call;
+        term->data = std::move(call);
+        main_func->basic_blocks[0]->terminator = std::move(term);
+    }
+    main_func->basic_blocks[1]->terminator = mir::MirTerminator::return_value();
+
+    auto* main_ptr = main_func.get();
+    program.functions.push_back(std::move(wrap));
+    program.functions.push_back(std::move(main_func));
+
+    mir::opt::FunctionInlining inliner;
+    ASSERT_TRUE(inliner.run_on_program(program));
+
+    // 引数の受け渡し: p = copy(q), d = 2.5
+    const auto& call_block = main_ptr->basic_blocks[0];
+    ASSERT_EQ(call_block->terminator->kind, mir::MirTerminator::Goto);
+    ASSERT_EQ(call_block->statements.size(), 2u);
+    const mir::MirOperand* passed[2];
+    for (size_t i = 0; i < 2; ++i) {
+        const auto& assign =
+            std::get<mir::MirStatement::AssignData>(call_block->statements[i]->data);
+        passed[i] = std::get<mir::MirRvalue::UseData>(assign.rvalue->data).operand.get();
+    }
+    ASSERT_TRUE(passed[0]->type);
+    EXPECT_TRUE(ast::types_equal(passed[0]->type, point_type));
+    ASSERT_TRUE(passed[1]->type);
+    EXPECT_EQ(passed[1]->type->kind, ast::TypeKind::Double);
+
+    // 複製された sink 呼び出し
+    const mir::MirTerminator::CallData* sink_call = nullptr;
+    for (const auto& block : main_ptr->basic_blocks) {
+        if (block && block->terminator && block->terminator->kind == mir::MirTerminator::Call)
+            sink_call = &std::get<mir::MirTerminator::CallData>(block->terminator->data);
+    }
+    ASSERT_NE(sink_call, nullptr);
+    EXPECT_TRUE(sink_call->is_tail_call);
+    EXPECT_TRUE(sink_call->is_pure);
+    ASSERT_EQ(sink_call->args.size(), 2u);
+    ASSERT_TRUE(sink_call->args[0]->type);
+    EXPECT_TRUE(ast::types_equal(sink_call->args[0]->type, point_type));
+    ASSERT_TRUE(sink_call->args[1]->type);
+    EXPECT_EQ(sink_call->args[1]->type->kind, ast::TypeKind::Double);
+    const auto& constant = std::get<mir::MirConstant>(sink_call->args[1]->data);
+    EXPECT_DOUBLE_EQ(std::get<double>(constant.value), 1.5);
+}
+
 // ============================================================
 // 最適化パイプラインのテスト
 // ============================================================
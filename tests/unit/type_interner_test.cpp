@@ -0,0 +1,145 @@
+#include "../../src/frontend/ast/type_interner.hpp"
+#include "../../src/frontend/ast/typedef.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace cm;
+
+// 構造的に等しい型は同じIDと正規インスタンスになる
+TEST(TypeInternerTest, StructurallyEqualTypesShareCanonical) {
+    auto& interner = ast::TypeInterner::instance();
+
+    auto a = ast::make_pointer(ast::make_int());
+    auto b = ast::make_pointer(ast::make_int());
+    ASSERT_NE(a.get(), b.get());
+    EXPECT_EQ(interner.intern(a), interner.intern(b));
+
+    auto canon = interner.canonical(a);
+    EXPECT_EQ(canon.get(), interner.canonical(b).get());
+    EXPECT_TRUE(interner.is_canonical(*canon));
+    EXPECT_FALSE(interner.is_canonical(*a));
+    // 子も正規インスタンスで共有される
+    EXPECT_EQ(canon->element_type.get(), interner.canonical(ast::make_int()).get());
+}
+
+TEST(TypeInternerTest, DistinguishesStructure) {
+    auto& interner = ast::TypeInterner::instance();
+
+    auto vec_int = ast::make_named("Vector");
+    vec_int->type_args.push_back(ast::make_int());
+    auto vec_long = ast::make_named("Vector");
+    vec_long->type_args.push_back(ast::make_long());
+    EXPECT_NE(interner.intern(vec_int), interner.intern(vec_long));
+
+    EXPECT_NE(interner.intern(ast::make_array(ast::make_int(), 4)),
+              interner.intern(ast::make_array(ast::make_int(), 8)));
+
+    auto const_int = ast::make_int();
+    const_int->qualifiers.is_const = true;
+    EXPECT_NE(interner.intern(const_int), interner.intern(ast::make_int()));
+
+    // 型引数と関数の引数型は区別する
+    auto fn = ast::make_function_ptr(ast::make_int(), {ast::make_int()});
+    auto generic = ast::make_named("");
+    generic->kind = ast::TypeKind::Function;
+    generic->return_type = ast::make_int();
+    generic->type_args.push_back(ast::make_int());
+    EXPECT_NE(interner.intern(fn), interner.intern(generic));
+}
+
+TEST(TypeInternerTest, CachesTypeName) {
+    auto& interner = ast::TypeInterner::instance();
+
+    auto pair = ast::make_named("Pair");
+    pair->type_args.push_back(ast::make_int());
+    pair->type_args.push_back(ast::make_pointer(ast::make_char()));
+    const std::string& name = interner.name(pair);
+    EXPECT_EQ(name, ast::type_to_string(*pair));
+
+    auto same = ast::make_named("Pair");
+    same->type_args = pair->type_args;
+    EXPECT_EQ(&interner.name(same), &name);
+}
+
+// ユニオン型もバリアントの構造で同一視する（オブジェクトごとにエントリを増やさない）
+TEST(TypeInternerTest, UnionTypesInternStructurally) {
+    auto& interner = ast::TypeInterner::instance();
+
+    auto a = ast::make_option_type(ast::make_int());
+    auto b = ast::make_option_type(ast::make_int());
+    auto c = ast::make_option_type(ast::make_long());
+    EXPECT_EQ(interner.intern(a), interner.intern(b));
+    EXPECT_NE(interner.intern(a), interner.intern(c));
+    EXPECT_TRUE(ast::types_equal(a, b));
+    EXPECT_FALSE(ast::types_equal(a, c));
+
+    size_t before = interner.size();
+    for (int i = 0; i < 16; ++i) {
+        interner.intern(ast::make_option_type(ast::make_int()));
+    }
+    EXPECT_EQ(interner.size(), before);
+
+    // 正規インスタンスはバリアントごと複製され、フィールド型も正規インスタンスになる
+    auto canon = interner.canonical(a);
+    ASSERT_NE(canon.get(), a.get());
+    EXPECT_EQ(canon.get(), interner.canonical(b).get());
+    const auto& variants = static_cast<const ast::UnionType&>(*canon).variants;
+    ASSERT_EQ(variants.size(), 2u);
+    EXPECT_EQ(variants[0].tag, "some");
+    ASSERT_EQ(variants[0].fields.size(), 1u);
+    EXPECT_EQ(variants[0].fields[0].get(), interner.canonical(ast::make_int()).get());
+
+    auto lit_a = ast::make_literal_union({ast::LiteralType(std::string("a")), ast::LiteralType(int64_t{1})});
+    auto lit_b = ast::make_literal_union({ast::LiteralType(std::string("a")), ast::LiteralType(int64_t{1})});
+    auto lit_c = ast::make_literal_union({ast::LiteralType(std::string("b"))});
+    EXPECT_EQ(interner.intern(lit_a), interner.intern(lit_b));
+    EXPECT_NE(interner.intern(lit_a), interner.intern(lit_c));
+}
+
+// 正規インスタンスの判定はタグで行い、複製した型には引き継がない
+TEST(TypeInternerTest, CopiesAreNotCanonical) {
+    auto& interner = ast::TypeInterner::instance();
+
+    auto canon = interner.canonical(ast::make_pointer(ast::make_double()));
+    EXPECT_TRUE(interner.is_canonical(*canon));
+    EXPECT_EQ(interner.canonical(canon).get(), canon.get());
+
+    auto copy = std::make_shared<ast::Type>(*canon);
+    EXPECT_FALSE(interner.is_canonical(*copy));
+    EXPECT_EQ(interner.canonical(copy).get(), canon.get());
+}
+
+// Scopeの間は専用のインターナーを使い、抜けると元のインターナーに戻る
+TEST(TypeInternerTest, ScopeUsesFreshInterner) {
+    auto& outer = ast::TypeInterner::instance();
+    auto outer_canon = outer.canonical(ast::make_int());
+    {
+        ast::TypeInterner::Scope scope;
+        auto& inner = ast::TypeInterner::instance();
+        EXPECT_EQ(&inner, &scope.interner());
+        EXPECT_NE(&inner, &outer);
+        EXPECT_EQ(inner.size(), 0u);
+
+        // 外側の正規インスタンスはこのインターナーでは正規ではない
+        EXPECT_FALSE(inner.is_canonical(*outer_canon));
+        auto inner_canon = inner.canonical(ast::make_int());
+        EXPECT_NE(inner_canon.get(), outer_canon.get());
+        EXPECT_EQ(inner.canonical(outer_canon).get(), inner_canon.get());
+        EXPECT_EQ(inner.size(), 1u);
+    }
+    EXPECT_EQ(&ast::TypeInterner::instance(), &outer);
+    EXPECT_TRUE(outer.is_canonical(*outer_canon));
+}
+
+TEST(TypeInternerTest, TypesEqualMatchesInterning) {
+    auto fn_a = ast::make_function_ptr(ast::make_void(), {ast::make_int(), ast::make_double()});
+    auto fn_b = ast::make_function_ptr(ast::make_void(), {ast::make_int(), ast::make_double()});
+    auto fn_c = ast::make_function_ptr(ast::make_void(), {ast::make_int()});
+    EXPECT_TRUE(ast::types_equal(fn_a, fn_b));
+    EXPECT_FALSE(ast::types_equal(fn_a, fn_c));
+    EXPECT_FALSE(ast::types_equal(fn_a, nullptr));
+
+    auto& interner = ast::TypeInterner::instance();
+    EXPECT_EQ(interner.intern(fn_a), interner.intern(fn_b));
+    EXPECT_EQ(interner.intern(nullptr), ast::TypeInterner::kNoType);
+}